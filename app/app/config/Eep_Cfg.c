@@ -13,6 +13,18 @@
 #define EEP_BASE_ADDRESS 0
 #endif
 
+#ifndef EEP_TOTAL_SIZE
+#define EEP_TOTAL_SIZE (4 * 1024)
+#endif
+
+#if ((EEP_BASE_ADDRESS + EEP_TOTAL_SIZE) > 0xFFFF) && !defined(EEP_ADDRESS_TYPE_U32)
+#error "EEP_ADDRESS_TYPE_U32 is required for an EEPROM ending at 64KB or above"
+#endif
+
+#ifndef EEP_PAGE_SIZE
+#define EEP_PAGE_SIZE 1
+#endif
+
 #ifndef EEP_MAX_READ_FAST
 #define EEP_MAX_READ_FAST 4096
 #endif
@@ -42,9 +54,9 @@
 static const Eep_SectorType Eep_SectorList[] = {
   {
     EEP_BASE_ADDRESS,
-    EEP_BASE_ADDRESS + 4 * 1024,
+    EEP_BASE_ADDRESS + EEP_TOTAL_SIZE,
     4,
-    1,
+    EEP_PAGE_SIZE,
     1,
   },
 };
@@ -88,6 +88,13 @@
 #include "plugin.h"
 #endif
 
+#ifdef USE_SCHEDULER
+#include "scheduler.h"
+#include <unistd.h>
+#include <signal.h>
+#endif
+#include "trace.h"
+
 #include "app.h"
 /* ================================ [ MACROS    ] ============================================== */
 #define AS_LOG_CANIF 0
@@ -101,70 +108,230 @@
 #define CANID_P2P_TX 0x732
 #endif
 #define CANID_P2A_RX 0x7DF
+
+#ifdef USE_SCHEDULER
+/* SCHED_FIFO priority (0: SCHED_OTHER) and core of each BSW thread */
+#ifndef APP_IO_PRIORITY
+#define APP_IO_PRIORITY 0
+#endif
+#ifndef APP_IO_CPU
+#define APP_IO_CPU SCHED_ANY_CPU
+#endif
+#ifndef APP_COMM_PRIORITY
+#define APP_COMM_PRIORITY 0
+#endif
+#ifndef APP_COMM_CPU
+#define APP_COMM_CPU SCHED_ANY_CPU
+#endif
+#ifndef APP_DIAG_PRIORITY
+#define APP_DIAG_PRIORITY 0
+#endif
+#ifndef APP_DIAG_CPU
+#define APP_DIAG_CPU SCHED_ANY_CPU
+#endif
+#ifndef APP_MEMORY_PRIORITY
+#define APP_MEMORY_PRIORITY 0
+#endif
+#ifndef APP_MEMORY_CPU
+#define APP_MEMORY_CPU SCHED_ANY_CPU
+#endif
+/* longest sleep of the timer wheel task in us when no timer is armed */
+#ifndef APP_TIMER_PERIOD
+#define APP_TIMER_PERIOD 100000
+#endif
+/* seconds between two reports of the task and trace statistics, 0 to disable */
+#ifndef APP_SCHED_REPORT_PERIOD
+#define APP_SCHED_REPORT_PERIOD 60
+#endif
+#endif
+
+#ifndef APP_TRACE_FILE
+#define APP_TRACE_FILE ".trace.json"
+#endif
 /* ================================ [ TYPES     ] ============================================== */
 /* ================================ [ DECLARES  ] ============================================== */
 extern void App_AliveIndicate(void);
 /* ================================ [ DATAS     ] ============================================== */
 static Std_TimerType timer10ms;
 static Std_TimerType timer100ms;
+#if defined(USE_SCHEDULER) && defined(TRACE_ENABLED)
+static volatile sig_atomic_t traceDumpRequest = 0;
+#endif
 /* ================================ [ LOCALS    ] ============================================== */
 static void MemoryTask(void) {
 #ifdef USE_EEP
-  Eep_MainFunction();
+  TRACE_CALL(Eep_MainFunction);
 #endif
 #ifdef USE_EA
-  Ea_MainFunction();
+  TRACE_CALL(Ea_MainFunction);
 #endif
 #ifdef USE_FLS
-  Fls_MainFunction();
+  TRACE_CALL(Fls_MainFunction);
 #endif
 #ifdef USE_FEE
-  Fee_MainFunction();
+  TRACE_CALL(Fee_MainFunction);
 #endif
 #ifdef USE_NVM
-  NvM_MainFunction();
+  TRACE_CALL(NvM_MainFunction);
 #endif
 }
 
-static void MainTask_10ms(void) {
-#ifdef USE_CAN
-#ifdef USE_CANTP
-  CanTp_MainFunction();
+/* the transport protocols and the diagnostic modules they feed */
+static void DiagTask(void) {
+#if defined(USE_CAN) && defined(USE_CANTP)
+  TRACE_CALL(CanTp_MainFunction);
+#endif
+#ifdef USE_LINTP
+  TRACE_CALL(LinTp_MainFunction);
 #endif
+#ifdef USE_DOIP
+  TRACE_CALL(DoIP_MainFunction);
+#endif
+#ifdef USE_DCM
+  TRACE_CALL(Dcm_MainFunction);
+#endif
+
+#ifdef USE_PLUGIN
+  TRACE_CALL(plugin_main);
+#endif
+}
+
+/* signals and network management on the CAN bus */
+static void BusTask(void) {
+#ifdef USE_CAN
 #ifdef USE_OSEKNM
-  OsekNm_MainFunction();
+  TRACE_CALL(OsekNm_MainFunction);
 #endif
 #ifdef USE_CANNM
-  CanNm_MainFunction();
-#endif
+  TRACE_CALL(CanNm_MainFunction);
 #endif
-#ifdef USE_LINTP
-  LinTp_MainFunction();
 #endif
 #ifdef USE_COM
-  Com_MainFunction();
+  TRACE_CALL(Com_MainFunction);
 #endif
+}
 
+/* service discovery and SOME/IP */
+static void NetTask(void) {
+#ifdef USE_SD
+  TRACE_CALL(Sd_MainFunction);
+#endif
+#ifdef USE_SOMEIP
+  TRACE_CALL(SomeIp_MainFunction);
+#endif
+}
+
+static void MainTask_10ms(void) {
+  BusTask();
   MemoryTask();
+  DiagTask();
+  NetTask();
+}
+
+/* the drivers and socket adapters, polled as often as possible */
+static void IoTask(void) {
 #ifdef USE_DCM
-  Dcm_MainFunction();
+  TRACE_CALL(Dcm_MainFunction_Request);
 #endif
-
-#ifdef USE_DOIP
-  DoIP_MainFunction();
+#ifdef USE_CAN
+  TRACE_CALL(Can_MainFunction_Write);
+  TRACE_CALL(Can_MainFunction_Read);
 #endif
-#ifdef USE_SD
-  Sd_MainFunction();
+#ifdef USE_DLL
+  TRACE_CALL(DLL_MainFunction);
+  TRACE_CALL(DLL_MainFunction_Read);
 #endif
-#ifdef USE_SOMEIP
-  SomeIp_MainFunction();
+#ifdef USE_TCPIP
+  TRACE_CALL(TcpIp_MainFunction);
 #endif
+#ifdef USE_SOAD
+  TRACE_CALL(SoAd_MainFunction);
+#endif
+  TRACE_CALL(App_MainFunction);
+}
 
-#ifdef USE_PLUGIN
-  plugin_main();
+#if defined(USE_SCHEDULER) && defined(TRACE_ENABLED)
+/* kill -USR1 <pid> writes the recent main function calls to APP_TRACE_FILE */
+static void TraceDumpHandler(int sig) {
+  (void)sig;
+  traceDumpRequest = 1;
+}
 #endif
+
+#ifdef USE_SCHEDULER
+/* The BSW modules are not reentrant, each one belongs to one lock domain:
+ *  - netLock: TcpIp, SoAd, Sd and SomeIp;
+ *  - comLock: the CAN/LIN drivers and interfaces, Com, CanNm and OsekNm;
+ *  - diagLock: CanTp, LinTp, DoIP, the PduR TP routing and gateway, Dcm and Dem;
+ *  - memoryLock: Eep, Ea, Fls, Fee and NvM.
+ * A task holds the lock of every domain its calls can reach, e.g. the drivers polled by the io
+ * task call PduR, PduR calls CanTp or DoIP then Dcm, and Dcm answers through CanIf or SoAd, so the
+ * io, diag, alive and timer tasks hold netLock, comLock and diagLock. The bus and net tasks stay
+ * in their domain and run in parallel. The locks are always taken in this order:
+ *    memoryLock -> netLock -> comLock -> diagLock -> module locks -> global critical section
+ * The scheduler takes the first lock of a task, appRunAllDomains the other two. The module locks
+ * (mempool, timer wheel) and the global critical section are never held across a call into
+ * another module. What crosses memoryLock:
+ *  - the NvM request API (NvM_ReadBlock/NvM_WriteBlock/...) called by Dem, Dcm and the App under
+ *    diagLock or in the io task, it queues the job under the global critical section and takes no
+ *    domain lock;
+ *  - NvM job end callbacks, none is configured in NvM.json today, they would run in the memory
+ *    task holding memoryLock and must take netLock, comLock and diagLock in that order before
+ *    calling into the communication or diagnostic modules. */
+static STD_LOCK_DEFINE(netLock, 0);
+static STD_LOCK_DEFINE(comLock, 0);
+static STD_LOCK_DEFINE(diagLock, 0);
+static STD_LOCK_DEFINE(memoryLock, 0);
+
+/* runs main holding comLock and diagLock, the scheduler already holds netLock */
+static void appRunAllDomains(void (*main)(void)) {
+  EnterCriticalLock(&comLock);
+  EnterCriticalLock(&diagLock);
+  main();
+  ExitCriticalLock(&diagLock);
+  ExitCriticalLock(&comLock);
 }
 
+static void IoTask_Sched(void) {
+  appRunAllDomains(IoTask);
+}
+
+static void DiagTask_Sched(void) {
+  appRunAllDomains(DiagTask);
+}
+
+static void AliveTask_Sched(void) {
+  appRunAllDomains(App_AliveIndicate);
+}
+
+#ifdef STD_TIMER_WHEEL
+/* the DoIP inactivity timeout closes the connection, which confirms to Dcm through PduR */
+static void TimerTask_Sched(void) {
+  appRunAllDomains(Std_TimerWheelMainFunction);
+}
+#endif
+
+static const sched_task_cfg_t appTasks[] = {
+  {"io", IoTask_Sched, 1000, APP_IO_PRIORITY, APP_IO_CPU, &netLock},
+  {"bus", BusTask, 10000, APP_COMM_PRIORITY, APP_COMM_CPU, &comLock},
+  {"net", NetTask, 10000, APP_COMM_PRIORITY, APP_COMM_CPU, &netLock},
+  {"diag", DiagTask_Sched, 10000, APP_DIAG_PRIORITY, APP_DIAG_CPU, &netLock},
+  {"memory", MemoryTask, 10000, APP_MEMORY_PRIORITY, APP_MEMORY_CPU, &memoryLock},
+  {"alive", AliveTask_Sched, 100000, 0, SCHED_ANY_CPU, &netLock},
+#ifdef STD_TIMER_WHEEL
+  /* expirations wake this task up instead of being polled, must stay the last one */
+  {"timer", TimerTask_Sched, APP_TIMER_PERIOD, 0, SCHED_ANY_CPU, &netLock,
+   Std_TimerWheelGetNextExpiry},
+#endif
+};
+
+#ifdef STD_TIMER_WHEEL
+static void TimerWakeup(void) {
+  sched_wakeup(&appTasks[ARRAY_SIZE(appTasks) - 1]);
+}
+#endif
+#endif
+
 static void BSW_Init(void) {
 #ifdef USE_CAN
   Can_Init(NULL);
@@ -396,9 +563,42 @@ int main(int argc, char *argv[]) {
   ASLOG(INFO, ("application build @ %s %s\n", __DATE__, __TIME__));
 
   Mcu_Init(NULL);
+#ifdef STD_TIMER_WHEEL
+  /* before BSW_Init, the modules arm their timers from now on */
+#ifdef USE_SCHEDULER
+  Std_TimerWheelInit(TimerWakeup);
+#else
+  Std_TimerWheelInit(NULL);
+#endif
+#endif
 
   BSW_Init();
   App_Init();
+#ifdef USE_SCHEDULER
+#ifdef TRACE_ENABLED
+  (void)signal(SIGUSR1, TraceDumpHandler);
+#endif
+  if (0 == sched_start(appTasks, ARRAY_SIZE(appTasks))) {
+    for (;;) {
+#if APP_SCHED_REPORT_PERIOD > 0
+      if (0 == sleep(APP_SCHED_REPORT_PERIOD)) {
+        sched_report();
+#ifdef TRACE_ENABLED
+        trace_report();
+#endif
+      }
+#else
+      pause();
+#endif
+#ifdef TRACE_ENABLED
+      if (traceDumpRequest) {
+        traceDumpRequest = 0;
+        (void)trace_dump_chrome(APP_TRACE_FILE);
+      }
+#endif
+    }
+  }
+#endif
   Std_TimerStart(&timer10ms);
   Std_TimerStart(&timer100ms);
   for (;;) {
@@ -411,24 +611,10 @@ int main(int argc, char *argv[]) {
       Std_TimerStart(&timer100ms);
       App_AliveIndicate();
     }
-#ifdef USE_DCM
-    Dcm_MainFunction_Request();
-#endif
-#ifdef USE_CAN
-    Can_MainFunction_Write();
-    Can_MainFunction_Read();
-#endif
-#ifdef USE_DLL
-    DLL_MainFunction();
-    DLL_MainFunction_Read();
-#endif
-#ifdef USE_TCPIP
-    TcpIp_MainFunction();
-#endif
-#ifdef USE_SOAD
-    SoAd_MainFunction();
+    IoTask();
+#ifdef STD_TIMER_WHEEL
+    Std_TimerWheelMainFunction();
 #endif
-    App_MainFunction();
 #if defined(_WIN32)
 #if !defined(USE_OSEKNM) && !defined(USE_TCPIP)
     usleep(1000);
@@ -0,0 +1,17 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2026 Parai Wang <parai@foxmail.com>
+ */
+#ifndef EEP_AC_H
+#define EEP_AC_H
+/* ================================ [ INCLUDES  ] ============================================== */
+#include "Eep.h"
+/* ================================ [ MACROS    ] ============================================== */
+/* ================================ [ TYPES     ] ============================================== */
+/* ================================ [ DECLARES  ] ============================================== */
+/* ================================ [ DATAS     ] ============================================== */
+/* ================================ [ LOCALS    ] ============================================== */
+/* ================================ [ FUNCTIONS ] ============================================== */
+/* the erase cycles of the cell at address, as counted in Eep.wear */
+uint32_t Eep_AcGetWear(Eep_AddressType address);
+#endif /* EEP_AC_H */
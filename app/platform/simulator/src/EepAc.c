@@ -3,20 +3,68 @@
  * Copyright (C) 2021 Parai Wang <parai@foxmail.com>
  */
 /* ================================ [ INCLUDES  ] ============================================== */
-#include "Eep.h"
+#include "EepAc.h"
 #include "Std_Debug.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <pthread.h>
 #include <semaphore.h>
 #include <string.h>
+#include <time.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 /* ================================ [ MACROS    ] ============================================== */
+#ifndef EEP_TOTAL_SIZE
 #define EEP_TOTAL_SIZE (4 * 1024)
+#endif
+
+#if (EEP_TOTAL_SIZE > 0xFFFF) && !defined(EEP_ADDRESS_TYPE_U32)
+#error "EEP_ADDRESS_TYPE_U32 is required for an EEPROM of 64KB or more"
+#endif
+
+/* the write granularity, a write stays in one page or covers whole pages */
+#ifndef EEP_PAGE_SIZE
+#define EEP_PAGE_SIZE 1
+#endif
+
+/* simulated time to erase or write one byte, can be overridden by the environment variable with
+ * the same name, 0 means as fast as the host */
+#ifndef EEP_BYTE_WRITE_TIME_NS
+#define EEP_BYTE_WRITE_TIME_NS 0
+#endif
+
+/* erase cycles a cell survives, a write to a worn cell fails, 0 means unlimited */
+#ifndef EEP_ENDURANCE
+#define EEP_ENDURANCE 0
+#endif
+
+#ifndef EEP_IMG
+#define EEP_IMG "Eep.img"
+#endif
+
+/* the erase cycles of each cell as uint32_t in host byte order */
+#ifndef EEP_WEAR_IMG
+#define EEP_WEAR_IMG "Eep.wear"
+#endif
 
-#define IS_EEP_ADDRESS(a) ((a) <= EEP_TOTAL_SIZE)
+#define IS_EEP_RANGE(a, l) (((a) <= EEP_TOTAL_SIZE) && ((l) <= (EEP_TOTAL_SIZE - (a))))
 
 #define AS_LOG_EEPAC 0
 /* ================================ [ TYPES     ] ============================================== */
+typedef struct {
+  void *data;
+  size_t size;
+#ifdef _WIN32
+  HANDLE file;
+  HANDLE mapping;
+#endif
+} EepAc_MapType;
 /* ================================ [ DECLARES  ] ============================================== */
 typedef enum
 {
@@ -33,7 +81,8 @@ typedef enum
   EEP_AC_JOB_FAIL,
 } EepAc_JobStatusType;
 /* ================================ [ DATAS     ] ============================================== */
-static FILE *lEep = NULL;
+static EepAc_MapType lEep;
+static EepAc_MapType lWear;
 static pthread_t lThread;
 static pthread_mutex_t lMutex;
 static sem_t lSem;
@@ -44,53 +93,171 @@ static Eep_AddressType lAddress;
 static Eep_LengthType lLength;
 static int lStoped = FALSE;
 static EepAc_JobType lJobType = EEP_AC_JOB_NONE;
-uint8_t g_EepAcMirror[EEP_TOTAL_SIZE];
+static uint32_t lByteWriteTimeNs = EEP_BYTE_WRITE_TIME_NS;
+/* the content of Eep.img mapped */
+uint8_t *g_EepAcMirror = NULL;
+static uint32_t *lWearCounter = NULL;
 /* ================================ [ LOCALS    ] ============================================== */
+/* map the file, a new or too small file is extended with fill */
+static void *_eep_map(EepAc_MapType *map, const char *name, size_t size, uint8_t fill) {
+  size_t sz = 0;
+
+  map->data = NULL;
+  map->size = size;
+#ifdef _WIN32
+  LARGE_INTEGER fsize;
+  map->mapping = NULL;
+  map->file = CreateFileA(name, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL, OPEN_ALWAYS,
+                          FILE_ATTRIBUTE_NORMAL, NULL);
+  if (INVALID_HANDLE_VALUE != map->file) {
+    if (GetFileSizeEx(map->file, &fsize)) {
+      sz = (fsize.QuadPart < size) ? (size_t)fsize.QuadPart : size;
+    }
+    map->mapping = CreateFileMappingA(map->file, NULL, PAGE_READWRITE, 0, size, NULL);
+    if (NULL != map->mapping) {
+      map->data = MapViewOfFile(map->mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+    }
+    if (NULL == map->data) {
+      if (NULL != map->mapping) {
+        CloseHandle(map->mapping);
+      }
+      CloseHandle(map->file);
+    }
+  }
+#else
+  struct stat st;
+  int fd = open(name, O_RDWR | O_CREAT, 0644);
+  if (fd >= 0) {
+    if (0 == fstat(fd, &st)) {
+      sz = ((size_t)st.st_size < size) ? (size_t)st.st_size : size;
+    }
+    if ((sz < size) && (0 != ftruncate(fd, size))) {
+      ASLOG(ERROR, ("failed to resize %s\n", name));
+    } else {
+      map->data = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+      if (MAP_FAILED == map->data) {
+        map->data = NULL;
+      }
+    }
+    close(fd);
+  }
+#endif
+  if (NULL != map->data) {
+    if (sz < size) {
+      memset((uint8_t *)map->data + sz, fill, size - sz);
+    }
+  } else {
+    ASLOG(ERROR, ("Failed to map %s\n", name));
+  }
+
+  return map->data;
+}
+
+static void _eep_unmap(EepAc_MapType *map) {
+  if (NULL != map->data) {
+#ifdef _WIN32
+    (void)FlushViewOfFile(map->data, map->size);
+    UnmapViewOfFile(map->data);
+    CloseHandle(map->mapping);
+    CloseHandle(map->file);
+#else
+    (void)msync(map->data, map->size, MS_SYNC);
+    munmap(map->data, map->size);
+#endif
+    map->data = NULL;
+  }
+}
+
+static void _eep_delay(Eep_LengthType length) {
+  uint64_t ns = (uint64_t)length * lByteWriteTimeNs;
+  struct timespec ts;
+
+  if (ns > 0) {
+    ts.tv_sec = ns / 1000000000;
+    ts.tv_nsec = ns % 1000000000;
+    (void)nanosleep(&ts, NULL);
+  }
+}
+
+static boolean _eep_is_blank(Eep_AddressType address, Eep_LengthType length) {
+  const uint8_t *p = &g_EepAcMirror[address];
+  const uint8_t *end = p + length;
+  uint64_t u64V;
+  boolean blank = TRUE;
+
+  while (((p + 8) <= end) && blank) {
+    memcpy(&u64V, p, 8);
+    blank = (0xFFFFFFFFFFFFFFFFULL == u64V);
+    p += 8;
+  }
+  while ((p < end) && blank) {
+    blank = (0xFF == *p++);
+  }
+
+  return blank;
+}
+
+static boolean _eep_is_worn(Eep_AddressType address, Eep_LengthType length) {
+  boolean worn = FALSE;
+#if EEP_ENDURANCE > 0
+  Eep_LengthType i;
+
+  for (i = 0; (i < length) && (FALSE == worn); i++) {
+    worn = (lWearCounter[address + i] > EEP_ENDURANCE);
+  }
+#endif
+  return worn;
+}
+
 static void _eep_stop(void) {
-  if (NULL != lEep) {
+  if (NULL != g_EepAcMirror) {
     lStoped = TRUE;
     lJobType = EEP_AC_JOB_NONE;
     sem_post(&lSem);
     pthread_join(lThread, NULL);
-    fclose(lEep);
+    _eep_unmap(&lEep);
+    _eep_unmap(&lWear);
+    g_EepAcMirror = NULL;
+    lWearCounter = NULL;
   }
 }
 
 static void *_eep_engine(void *arg) {
-  const uint8_t EraseMask = 0xFF;
-  uint8_t u8V;
-  boolean conditionOk;
+  Eep_LengthType i;
+
   while (FALSE == lStoped) {
     sem_wait(&lSem);
     pthread_mutex_lock(&lMutex);
     switch (lJobType) {
     case EEP_AC_JOB_ERASE:
       ASLOG(EEPAC, ("erase(0x%X, %d)\n", lAddress, lLength));
-      fseek(lEep, lAddress, SEEK_SET);
-      for (int i = 0; i < lLength; i++) {
-        fwrite(&EraseMask, 1, 1, lEep);
-        g_EepAcMirror[lAddress + i] = EraseMask;
+      memset(&g_EepAcMirror[lAddress], 0xFF, lLength);
+      for (i = 0; i < lLength; i++) {
+        lWearCounter[lAddress + i]++;
       }
+      /* the job stays ONGOING, so the API could be polled meanwhile */
+      pthread_mutex_unlock(&lMutex);
+      _eep_delay(lLength);
+      pthread_mutex_lock(&lMutex);
       lJobStatus = EEP_AC_JOB_DONE;
       break;
     case EEP_AC_JOB_WRITE:
       ASLOG(EEPAC, ("write(0x%X, %p, %d)\n", lAddress, lData, lLength));
-      fseek(lEep, lAddress, SEEK_SET);
-      conditionOk = TRUE;
-      for (int i = 0; i < lLength; i++) {
-        fread(&u8V, 1, 1, lEep);
-        if (u8V != 0xFF) {
-          conditionOk = FALSE;
-          break;
-        }
-      }
-      if (FALSE == conditionOk) {
+      if (((lAddress / EEP_PAGE_SIZE) != ((lAddress + lLength - 1) / EEP_PAGE_SIZE)) &&
+          ((0 != (lAddress % EEP_PAGE_SIZE)) || (0 != (lLength % EEP_PAGE_SIZE)))) {
+        ASLOG(ERROR, ("EEP write not page aligned @ %X\n", lAddress));
+        lJobStatus = EEP_AC_JOB_FAIL;
+      } else if (FALSE == _eep_is_blank(lAddress, lLength)) {
         ASLOG(ERROR, ("EEP write without erase\n"));
         lJobStatus = EEP_AC_JOB_FAIL;
+      } else if (_eep_is_worn(lAddress, lLength)) {
+        ASLOG(ERROR, ("EEP write to worn cells @ %X\n", lAddress));
+        lJobStatus = EEP_AC_JOB_FAIL;
       } else {
-        fseek(lEep, lAddress, SEEK_SET);
-        fwrite(lData, lLength, 1, lEep);
         memcpy(&g_EepAcMirror[lAddress], lData, lLength);
+        pthread_mutex_unlock(&lMutex);
+        _eep_delay(lLength);
+        pthread_mutex_lock(&lMutex);
         lJobStatus = EEP_AC_JOB_DONE;
       }
       break;
@@ -104,29 +271,24 @@ static void *_eep_engine(void *arg) {
 }
 #ifdef USE_EEP
 static void __attribute__((constructor)) _eep_start(void) {
-  size_t sz;
-  uint8_t EraseMask = 0xFF;
-  lEep = fopen("Eep.img", "rb+");
-  if (NULL == lEep) {
-    lEep = fopen("Eep.img", "wb+");
+  char *str = getenv("EEP_BYTE_WRITE_TIME_NS");
+
+  if (NULL != str) {
+    lByteWriteTimeNs = strtoul(str, NULL, 10);
   }
-  if (lEep) {
-    fseek(lEep, 0, SEEK_END);
-    sz = ftell(lEep);
-    if (sz < EEP_TOTAL_SIZE) {
-      for (size_t i = sz; i < EEP_TOTAL_SIZE; i++) {
-        fwrite(&EraseMask, 1, 1, lEep);
-      }
-    }
-    fseek(lEep, 0, SEEK_SET);
-    fread(g_EepAcMirror, EEP_TOTAL_SIZE, 1, lEep);
+  g_EepAcMirror = (uint8_t *)_eep_map(&lEep, EEP_IMG, EEP_TOTAL_SIZE, 0xFF);
+  lWearCounter = (uint32_t *)_eep_map(&lWear, EEP_WEAR_IMG, EEP_TOTAL_SIZE * sizeof(uint32_t), 0);
+  if ((NULL != g_EepAcMirror) && (NULL != lWearCounter)) {
     pthread_mutex_init(&lMutex, NULL);
     sem_init(&lSem, 0, 0);
     pthread_create(&lThread, NULL, _eep_engine, NULL);
+    atexit(_eep_stop);
   } else {
-    ASLOG(ERROR, ("Failed to create Eep.img\n"));
+    _eep_unmap(&lEep);
+    _eep_unmap(&lWear);
+    g_EepAcMirror = NULL;
+    lWearCounter = NULL;
   }
-  atexit(_eep_stop);
 }
 #endif
 /* ================================ [ FUNCTIONS ] ============================================== */
@@ -136,7 +298,7 @@ void Eep_AcInit(void) {
 Std_ReturnType Eep_AcErase(Eep_AddressType address, Eep_LengthType length) {
   Std_ReturnType r = E_NOT_OK;
 
-  if (IS_EEP_ADDRESS(address) && IS_EEP_ADDRESS(address + length) && (NULL != lEep)) {
+  if (IS_EEP_RANGE(address, length) && (NULL != g_EepAcMirror)) {
     pthread_mutex_lock(&lMutex);
     switch (lJobType) {
     case EEP_AC_JOB_NONE:
@@ -155,7 +317,8 @@ Std_ReturnType Eep_AcErase(Eep_AddressType address, Eep_LengthType length) {
         r = E_OK;
         lJobType = EEP_AC_JOB_NONE;
       } else {
-        /* Error */
+        /* Error, reported once, then ready for the next job */
+        lJobType = EEP_AC_JOB_NONE;
       }
       break;
     default:
@@ -170,7 +333,7 @@ Std_ReturnType Eep_AcErase(Eep_AddressType address, Eep_LengthType length) {
 Std_ReturnType Eep_AcWrite(Eep_AddressType address, const uint8_t *data, Eep_LengthType length) {
   Std_ReturnType r = E_NOT_OK;
 
-  if (IS_EEP_ADDRESS(address) && IS_EEP_ADDRESS(address + length) && (NULL != lEep)) {
+  if (IS_EEP_RANGE(address, length) && (NULL != g_EepAcMirror)) {
     pthread_mutex_lock(&lMutex);
     switch (lJobType) {
     case EEP_AC_JOB_NONE:
@@ -189,7 +352,8 @@ Std_ReturnType Eep_AcWrite(Eep_AddressType address, const uint8_t *data, Eep_Len
         r = E_OK;
         lJobType = EEP_AC_JOB_NONE;
       } else {
-        /* Error */
+        /* Error, reported once, then ready for the next job */
+        lJobType = EEP_AC_JOB_NONE;
       }
       break;
     default:
@@ -206,11 +370,10 @@ Std_ReturnType Eep_AcWrite(Eep_AddressType address, const uint8_t *data, Eep_Len
 Std_ReturnType Eep_AcRead(Eep_AddressType address, uint8_t *data, Eep_LengthType length) {
   Std_ReturnType r = E_OK;
 
-  if (IS_EEP_ADDRESS(address) && IS_EEP_ADDRESS(address + length) && (NULL != lEep)) {
+  if (IS_EEP_RANGE(address, length) && (NULL != g_EepAcMirror)) {
     ASLOG(EEPAC, ("read(0x%X, %p, %d)\n", address, data, length));
     pthread_mutex_lock(&lMutex);
-    fseek(lEep, address, SEEK_SET);
-    fread(data, length, 1, lEep);
+    memcpy(data, &g_EepAcMirror[address], length);
     pthread_mutex_unlock(&lMutex);
   } else {
     r = E_NOT_OK;
@@ -222,17 +385,10 @@ Std_ReturnType Eep_AcRead(Eep_AddressType address, uint8_t *data, Eep_LengthType
 Std_ReturnType Eep_AcCompare(Eep_AddressType address, uint8_t *data, Eep_LengthType length) {
   Std_ReturnType r = E_OK;
 
-  uint8_t u8V;
-
-  if (IS_EEP_ADDRESS(address) && IS_EEP_ADDRESS(address + length) && (NULL != lEep)) {
+  if (IS_EEP_RANGE(address, length) && (NULL != g_EepAcMirror)) {
     pthread_mutex_lock(&lMutex);
-    fseek(lEep, address, SEEK_SET);
-    for (int i = 0; i < length; i++) {
-      fread(&u8V, 1, 1, lEep);
-      if (u8V != data[i]) {
-        r = E_EEP_INCONSISTENT;
-        break;
-      }
+    if (0 != memcmp(data, &g_EepAcMirror[address], length)) {
+      r = E_EEP_INCONSISTENT;
     }
     pthread_mutex_unlock(&lMutex);
   } else {
@@ -245,17 +401,10 @@ Std_ReturnType Eep_AcCompare(Eep_AddressType address, uint8_t *data, Eep_LengthT
 Std_ReturnType Eep_AcBlankCheck(Eep_AddressType address, Eep_LengthType length) {
   Std_ReturnType r = E_OK;
 
-  uint8_t u8V;
-
-  if (IS_EEP_ADDRESS(address) && IS_EEP_ADDRESS(address + length) && (NULL != lEep)) {
+  if (IS_EEP_RANGE(address, length) && (NULL != g_EepAcMirror)) {
     pthread_mutex_lock(&lMutex);
-    fseek(lEep, address, SEEK_SET);
-    for (int i = 0; i < length; i++) {
-      fread(&u8V, 1, 1, lEep);
-      if (u8V != 0xFF) {
-        r = E_EEP_INCONSISTENT;
-        break;
-      }
+    if (FALSE == _eep_is_blank(address, length)) {
+      r = E_EEP_INCONSISTENT;
     }
     pthread_mutex_unlock(&lMutex);
   } else {
@@ -263,4 +412,14 @@ Std_ReturnType Eep_AcBlankCheck(Eep_AddressType address, Eep_LengthType length)
   }
 
   return r;
+}
+
+uint32_t Eep_AcGetWear(Eep_AddressType address) {
+  uint32_t cycles = 0;
+
+  if ((address < EEP_TOTAL_SIZE) && (NULL != lWearCounter)) {
+    cycles = lWearCounter[address];
+  }
+
+  return cycles;
 }
\ No newline at end of file
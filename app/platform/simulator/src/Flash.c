@@ -7,15 +7,63 @@
 #include <stdio.h>
 #include <stdint.h>
 #include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 #include "Std_Debug.h"
 /* ================================ [ MACROS    ] ============================================== */
+#ifndef FLASH_IMG
 #define FLASH_IMG "Flash.img"
+#endif
+
+#ifndef FLS_TOTAL_SIZE
 #define FLS_TOTAL_SIZE (1 * 1024 * 1024)
+#endif
+
+/* list of {address, sector size, number of sectors}, must cover FLS_TOTAL_SIZE */
+#ifndef FLASH_SECTOR_MAP
+#define FLASH_SECTOR_MAP {0, FLASH_ERASE_SIZE, FLS_TOTAL_SIZE / FLASH_ERASE_SIZE}
+#endif
+
+/* when the image is synced to the disk, the mapping is shared so the data survives a crash of
+ * the process with any policy, only a crash of the host is a concern */
+#define FLASH_SYNC_PER_SECTOR 0
+#define FLASH_SYNC_PER_JOB 1
+#define FLASH_SYNC_ON_EXIT 2
+#ifndef FLASH_SYNC_POLICY
+#define FLASH_SYNC_POLICY FLASH_SYNC_ON_EXIT
+#endif
+
+/* simulated timing of the flash, 0 means as fast as the host, can be overridden by the
+ * environment variable with the same name */
+#ifndef FLASH_ERASE_TIME_US_PER_KB
+#define FLASH_ERASE_TIME_US_PER_KB 0
+#endif
+#ifndef FLASH_WRITE_TIME_US_PER_KB
+#define FLASH_WRITE_TIME_US_PER_KB 0
+#endif
+
+#define FLASH_DELAY_CHUNK_NS 1000000
+
+#define FLASH_SECTOR_MAP_NUM (sizeof(lSectorMap) / sizeof(lSectorMap[0]))
 
 #define IS_FLASH_ADDRESS(a) ((a) <= FLS_TOTAL_SIZE)
 #define AS_LOG_FLS 1
+#define AS_LOG_FLSE 2
 /* ================================ [ TYPES     ] ============================================== */
-
+typedef struct {
+  tAddress address;
+  tLength size;
+  tLength number;
+} Flash_SectorMapType;
 /* ================================ [ DECLARES  ] ============================================== */
 /* ================================ [ DATAS     ] ============================================== */
 const tFlashHeader FlashHeader = {
@@ -30,65 +78,233 @@ const tFlashHeader FlashHeader = {
 };
 
 uint8_t FlashDriverRam[4096];
+
+static const Flash_SectorMapType lSectorMap[] = {FLASH_SECTOR_MAP};
+static uint8_t *lFlash = NULL;
+#ifdef _WIN32
+static HANDLE lFile = INVALID_HANDLE_VALUE;
+static HANDLE lMapping = NULL;
+#endif
+static uint32_t lEraseTimeUsPerKb = FLASH_ERASE_TIME_US_PER_KB;
+static uint32_t lWriteTimeUsPerKb = FLASH_WRITE_TIME_US_PER_KB;
+static int64_t lDelayNs = 0;
 /* ================================ [ LOCALS    ] ============================================== */
+static void Flash_Sync(tAddress address, tLength length) {
+#ifdef _WIN32
+  (void)FlushViewOfFile(&lFlash[address], length);
+#else
+  tAddress start = address & ~((tAddress)sysconf(_SC_PAGESIZE) - 1);
+  (void)msync(&lFlash[start], address + length - start, MS_SYNC);
+#endif
+}
+
+/* the simulated time is accumulated and slept in chunks, as sleeping for a small write costs
+ * more than the write itself */
+static void Flash_Delay(tLength length, uint32_t usPerKb) {
+  struct timespec ts;
+  struct timespec te;
+
+  lDelayNs += ((int64_t)length * usPerKb * 1000) / 1024;
+  if (lDelayNs >= FLASH_DELAY_CHUNK_NS) {
+    ts.tv_sec = lDelayNs / 1000000000;
+    ts.tv_nsec = lDelayNs % 1000000000;
+    clock_gettime(CLOCK_MONOTONIC, &te);
+    (void)nanosleep(&ts, NULL);
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    /* the oversleep is paid back by the next jobs */
+    lDelayNs -= (int64_t)(ts.tv_sec - te.tv_sec) * 1000000000 + (ts.tv_nsec - te.tv_nsec);
+  }
+}
+
+static uint32_t Flash_GetTiming(const char *name, uint32_t dft) {
+  char *str = getenv(name);
+  uint32_t value = dft;
+
+  if (NULL != str) {
+    value = strtoul(str, NULL, 10);
+  }
+
+  return value;
+}
+
+/* the size of the sector which starts at address, 0 if address is not a sector start */
+static tLength Flash_GetSectorSize(tAddress address) {
+  tLength size = 0;
+  tAddress offset;
+  size_t i;
+
+  for (i = 0; i < FLASH_SECTOR_MAP_NUM; i++) {
+    if ((address >= lSectorMap[i].address) &&
+        (address < (lSectorMap[i].address + lSectorMap[i].size * lSectorMap[i].number))) {
+      offset = address - lSectorMap[i].address;
+      if (0 == (offset % lSectorMap[i].size)) {
+        size = lSectorMap[i].size;
+      }
+      break;
+    }
+  }
+
+  return size;
+}
+
+static int Flash_IsSectorMapValid(void) {
+  int valid = TRUE;
+  tAddress address = 0;
+  size_t i;
+
+  for (i = 0; (i < FLASH_SECTOR_MAP_NUM) && valid; i++) {
+    if ((lSectorMap[i].address != address) || (0 == lSectorMap[i].size)) {
+      valid = FALSE;
+    } else {
+      address += lSectorMap[i].size * lSectorMap[i].number;
+    }
+  }
+
+  return valid && (FLS_TOTAL_SIZE == address);
+}
+
+static void Flash_Unmap(void) {
+  if (NULL != lFlash) {
+    Flash_Sync(0, FLS_TOTAL_SIZE);
+#ifdef _WIN32
+    UnmapViewOfFile(lFlash);
+    CloseHandle(lMapping);
+    CloseHandle(lFile);
+    lMapping = NULL;
+    lFile = INVALID_HANDLE_VALUE;
+#else
+    munmap(lFlash, FLS_TOTAL_SIZE);
+#endif
+    lFlash = NULL;
+  }
+}
+
+static void __attribute__((destructor)) __FlashExit(void) {
+  Flash_Unmap();
+}
+
+/* map the image, a new or too small image is extended with the erased value */
+static int Flash_Map(void) {
+  tLength size = 0;
+
+  if (NULL == lFlash) {
+#ifdef _WIN32
+    LARGE_INTEGER fsize;
+    lFile = CreateFileA(FLASH_IMG, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL,
+                        OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (INVALID_HANDLE_VALUE != lFile) {
+      if (GetFileSizeEx(lFile, &fsize)) {
+        size = (fsize.QuadPart < FLS_TOTAL_SIZE) ? (tLength)fsize.QuadPart : FLS_TOTAL_SIZE;
+      }
+      lMapping = CreateFileMappingA(lFile, NULL, PAGE_READWRITE, 0, FLS_TOTAL_SIZE, NULL);
+      if (NULL != lMapping) {
+        lFlash = (uint8_t *)MapViewOfFile(lMapping, FILE_MAP_ALL_ACCESS, 0, 0, FLS_TOTAL_SIZE);
+      }
+      if (NULL == lFlash) {
+        if (NULL != lMapping) {
+          CloseHandle(lMapping);
+          lMapping = NULL;
+        }
+        CloseHandle(lFile);
+        lFile = INVALID_HANDLE_VALUE;
+      }
+    }
+#else
+    struct stat st;
+    int fd = open(FLASH_IMG, O_RDWR | O_CREAT, 0644);
+    if (fd >= 0) {
+      if (0 == fstat(fd, &st)) {
+        size = (st.st_size < FLS_TOTAL_SIZE) ? (tLength)st.st_size : FLS_TOTAL_SIZE;
+      }
+      if ((size < FLS_TOTAL_SIZE) && (0 != ftruncate(fd, FLS_TOTAL_SIZE))) {
+        ASLOG(FLSE, ("failed to resize image %s\n", FLASH_IMG));
+      } else {
+        lFlash = (uint8_t *)mmap(NULL, FLS_TOTAL_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (MAP_FAILED == lFlash) {
+          lFlash = NULL;
+        }
+      }
+      close(fd);
+    }
+#endif
+    if (NULL != lFlash) {
+      if (size < FLS_TOTAL_SIZE) {
+        memset(&lFlash[size], 0xFF, FLS_TOTAL_SIZE - size);
+        Flash_Sync(size, FLS_TOTAL_SIZE - size);
+        ASLOG(FLS, ("simulation on new created image %s(%dKb)\n", FLASH_IMG,
+                    FLS_TOTAL_SIZE / 1024));
+      } else {
+        ASLOG(FLS, ("simulation on old existed image %s(%dKb)\n", FLASH_IMG,
+                    FLS_TOTAL_SIZE / 1024));
+      }
+    } else {
+      ASLOG(FLSE, ("failed to map image %s\n", FLASH_IMG));
+    }
+  }
+
+  return (NULL != lFlash);
+}
 /* ================================ [ FUNCTIONS ] ============================================== */
 void FlashInit(tFlashParam *FlashParam) {
   if ((FLASH_DRIVER_VERSION_PATCH == FlashParam->patchlevel) ||
       (FLASH_DRIVER_VERSION_MINOR == FlashParam->minornumber) ||
       (FLASH_DRIVER_VERSION_MAJOR == FlashParam->majornumber)) {
-    FILE *fp = fopen(FLASH_IMG, "rb");
-    if (NULL == fp) {
-      fp = fopen(FLASH_IMG, "wb+");
-      for (int i = 0; i < FLS_TOTAL_SIZE; i++) {
-        uint8_t data = 0xFF;
-        fwrite(&data, 1, 1, fp);
-      }
-      fclose(fp);
-
-      ASLOG(FLS, ("simulation on new created image %s(%dKb)\n", FLASH_IMG, FLS_TOTAL_SIZE / 1024));
+    lEraseTimeUsPerKb = Flash_GetTiming("FLASH_ERASE_TIME_US_PER_KB", FLASH_ERASE_TIME_US_PER_KB);
+    lWriteTimeUsPerKb = Flash_GetTiming("FLASH_WRITE_TIME_US_PER_KB", FLASH_WRITE_TIME_US_PER_KB);
+    if (FALSE == Flash_IsSectorMapValid()) {
+      ASLOG(FLSE, ("invalid sector map\n"));
+      FlashParam->errorcode = kFlashFailed;
+    } else if (Flash_Map()) {
+      FlashParam->errorcode = kFlashOk;
     } else {
-      ASLOG(FLS, ("simulation on old existed image %s(%dKb)\n", FLASH_IMG, FLS_TOTAL_SIZE / 1024));
-      fclose(fp);
+      FlashParam->errorcode = kFlashFailed;
     }
-    FlashParam->errorcode = kFlashOk;
   } else {
     FlashParam->errorcode = kFlashFailed;
   }
 }
 
 void FlashDeinit(tFlashParam *FlashParam) {
-  /*  TODO: Deinit Flash Controllor */
+  /* the image stays mapped, only make sure it reaches the disk */
+  if (NULL != lFlash) {
+    Flash_Sync(0, FLS_TOTAL_SIZE);
+  }
   FlashParam->errorcode = kFlashOk;
 }
 
 void FlashErase(tFlashParam *FlashParam) {
   tAddress address;
   tLength length;
+  tLength size;
+  tLength offset;
   if ((FLASH_DRIVER_VERSION_PATCH == FlashParam->patchlevel) ||
       (FLASH_DRIVER_VERSION_MINOR == FlashParam->minornumber) ||
       (FLASH_DRIVER_VERSION_MAJOR == FlashParam->majornumber)) {
     length = FlashParam->length;
     address = FlashParam->address;
     if ((FALSE == FLASH_IS_ERASE_ADDRESS_ALIGNED(address)) ||
-        (FALSE == IS_FLASH_ADDRESS(address))) {
+        (FALSE == IS_FLASH_ADDRESS(address)) || (0 == Flash_GetSectorSize(address))) {
       FlashParam->errorcode = kFlashInvalidAddress;
     } else if ((FALSE == IS_FLASH_ADDRESS(address + length)) ||
-               (FALSE == FLASH_IS_ERASE_ADDRESS_ALIGNED(length))) {
+               (FALSE == FLASH_IS_ERASE_ADDRESS_ALIGNED(length)) ||
+               ((address + length < FLS_TOTAL_SIZE) &&
+                (0 == Flash_GetSectorSize(address + length)))) {
       FlashParam->errorcode = kFlashInvalidSize;
+    } else if (FALSE == Flash_Map()) {
+      FlashParam->errorcode = kFlashFailed;
     } else {
-      FILE *fp = NULL;
-      static unsigned char EraseMask[4] = {0xFF, 0xFF, 0xFF, 0xFF};
-      fp = fopen(FLASH_IMG, "rb+");
-      if (NULL == fp) {
-        FlashParam->errorcode = kFlashFailed;
-      } else {
-        fseek(fp, FlashParam->address, SEEK_SET);
-        for (int i = 0; i < (FlashParam->length); i++) {
-          fwrite(EraseMask, 1, 1, fp);
-        }
-        fclose(fp);
-        FlashParam->errorcode = kFlashOk;
+      for (offset = 0; offset < length; offset += size) {
+        size = Flash_GetSectorSize(address + offset);
+        memset(&lFlash[address + offset], 0xFF, size);
+        Flash_Delay(size, lEraseTimeUsPerKb);
+#if FLASH_SYNC_POLICY == FLASH_SYNC_PER_SECTOR
+        Flash_Sync(address + offset, size);
+#endif
       }
+#if FLASH_SYNC_POLICY == FLASH_SYNC_PER_JOB
+      Flash_Sync(address, length);
+#endif
+      FlashParam->errorcode = kFlashOk;
     }
   } else {
     FlashParam->errorcode = kFlashFailed;
@@ -113,17 +329,15 @@ void FlashWrite(tFlashParam *FlashParam) {
       FlashParam->errorcode = kFlashInvalidSize;
     } else if (NULL == data) {
       FlashParam->errorcode = kFlashInvalidData;
+    } else if (FALSE == Flash_Map()) {
+      FlashParam->errorcode = kFlashFailed;
     } else {
-      FILE *fp = NULL;
-      fp = fopen(FLASH_IMG, "rb+");
-      if (NULL == fp) {
-        FlashParam->errorcode = kFlashFailed;
-      } else {
-        fseek(fp, address, SEEK_SET);
-        fwrite(data, length, 1, fp);
-        fclose(fp);
-        FlashParam->errorcode = kFlashOk;
-      }
+      memcpy(&lFlash[address], data, length);
+      Flash_Delay(length, lWriteTimeUsPerKb);
+#if FLASH_SYNC_POLICY != FLASH_SYNC_ON_EXIT
+      Flash_Sync(address, length);
+#endif
+      FlashParam->errorcode = kFlashOk;
     }
   } else {
     FlashParam->errorcode = kFlashFailed;
@@ -147,17 +361,11 @@ void FlashRead(tFlashParam *FlashParam) {
       FlashParam->errorcode = kFlashInvalidSize;
     } else if (NULL == data) {
       FlashParam->errorcode = kFlashInvalidData;
+    } else if (FALSE == Flash_Map()) {
+      FlashParam->errorcode = kFlashFailed;
     } else {
-      FILE *fp = NULL;
-      fp = fopen(FLASH_IMG, "rb+");
-      if (NULL == fp) {
-        FlashParam->errorcode = kFlashFailed;
-      } else {
-        fseek(fp, address, SEEK_SET);
-        fread(data, length, 1, fp);
-        fclose(fp);
-        FlashParam->errorcode = kFlashOk;
-      }
+      memcpy(data, &lFlash[address], length);
+      FlashParam->errorcode = kFlashOk;
     }
   } else {
     FlashParam->errorcode = kFlashFailed;
@@ -10,6 +10,7 @@
 #include <pthread.h>
 #include <semaphore.h>
 #include <string.h>
+#include <time.h>
 /* ================================ [ MACROS    ] ============================================== */
 #ifndef FLS_TOTAL_SIZE
 #define FLS_TOTAL_SIZE (1 * 1024 * 1024)
@@ -22,6 +23,27 @@
 #ifndef FLS_ERASED_VALUE
 #define FLS_ERASED_VALUE 0xFF
 #endif
+
+/* the granularity of the erase and of the write-behind to Fls.img */
+#ifndef FLS_AC_SECTOR_SIZE
+#define FLS_AC_SECTOR_SIZE 512
+#endif
+
+#ifndef FLS_AC_JOB_QUEUE_SIZE
+#define FLS_AC_JOB_QUEUE_SIZE 8
+#endif
+
+/* simulated timing of the flash, 0 means as fast as the host, can be overridden by the
+ * environment variable with the same name */
+#ifndef FLS_AC_ERASE_TIME_US_PER_KB
+#define FLS_AC_ERASE_TIME_US_PER_KB 0
+#endif
+#ifndef FLS_AC_WRITE_TIME_US_PER_KB
+#define FLS_AC_WRITE_TIME_US_PER_KB 0
+#endif
+
+#define FLS_AC_SECTOR_NUM ((FLS_TOTAL_SIZE + FLS_AC_SECTOR_SIZE - 1) / FLS_AC_SECTOR_SIZE)
+#define FLS_ERASED_WORD (0x0101010101010101ULL * FLS_ERASED_VALUE)
 /* ================================ [ TYPES     ] ============================================== */
 /* ================================ [ DECLARES  ] ============================================== */
 typedef enum
@@ -34,103 +56,305 @@ typedef enum
 typedef enum
 {
   FLS_AC_JOB_IDEL,
+  FLS_AC_JOB_QUEUED,
   FLS_AC_JOB_ONGOING,
   FLS_AC_JOB_DONE,
   FLS_AC_JOB_FAIL,
 } FlsAc_JobStatusType;
+
+typedef struct {
+  FlsAc_JobType type;
+  /* From HW perspective status reflect the HW staus idle/busy/completed */
+  FlsAc_JobStatusType status;
+  /* the job was dropped by Fls_AcInit while ongoing, nobody will poll it */
+  boolean orphan;
+  const uint8_t *data;
+  Fls_AddressType address;
+  Fls_LengthType length;
+  uint32_t seq;
+  uint64_t submitUs;
+  uint32_t latencyUs;
+} FlsAc_JobContextType;
 /* ================================ [ DATAS     ] ============================================== */
 #ifndef FLS_AC_RAM_ONLY
 static FILE *lFls = NULL;
+static uint8_t lDirty[(FLS_AC_SECTOR_NUM + 7) / 8];
+static boolean lHasDirty = FALSE;
 #endif
 static pthread_t lThread;
 static pthread_mutex_t lMutex;
 static sem_t lSem;
-/* From HW perspective lJobStatus reflect the HW staus idle/busy/completed */
-static FlsAc_JobStatusType lJobStatus = FLS_AC_JOB_IDEL;
-static uint8_t *lData = NULL;
-static Fls_AddressType lAddress;
-static Fls_LengthType lLength;
+static FlsAc_JobContextType lJobs[FLS_AC_JOB_QUEUE_SIZE];
+static uint32_t lSeq = 0;
 static int lStoped = FALSE;
-static FlsAc_JobType lJobType = FLS_AC_JOB_NONE;
+static Fls_AcStatisticsType lStats;
+static uint32_t lEraseTimeUsPerKb = FLS_AC_ERASE_TIME_US_PER_KB;
+static uint32_t lWriteTimeUsPerKb = FLS_AC_WRITE_TIME_US_PER_KB;
+/* the source of truth of the flash content, Fls.img is only written behind */
 uint8_t g_FlsAcMirror[FLS_TOTAL_SIZE];
 /* ================================ [ LOCALS    ] ============================================== */
+static uint64_t _fls_now_us(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static void _fls_delay(Fls_LengthType length, uint32_t usPerKb) {
+  uint64_t us = ((uint64_t)length * usPerKb) / 1024;
+  struct timespec ts;
+
+  if (us > 0) {
+    ts.tv_sec = us / 1000000;
+    ts.tv_nsec = (us % 1000000) * 1000;
+    (void)nanosleep(&ts, NULL);
+  }
+}
+
+static uint32_t _fls_get_timing(const char *name, uint32_t dft) {
+  char *str = getenv(name);
+  uint32_t value = dft;
+
+  if (NULL != str) {
+    value = strtoul(str, NULL, 10);
+  }
+
+  return value;
+}
+
+static boolean _fls_is_blank(Fls_AddressType address, Fls_LengthType length) {
+  const uint8_t *p = &g_FlsAcMirror[address];
+  const uint8_t *end = p + length;
+  uint64_t u64V;
+  boolean blank = TRUE;
+
+  while ((p < end) && (0 != ((uintptr_t)p & 7)) && blank) {
+    blank = (FLS_ERASED_VALUE == *p++);
+  }
+  while (((p + 8) <= end) && blank) {
+    memcpy(&u64V, p, 8);
+    blank = (FLS_ERASED_WORD == u64V);
+    p += 8;
+  }
+  while ((p < end) && blank) {
+    blank = (FLS_ERASED_VALUE == *p++);
+  }
+
+  return blank;
+}
+
+static void _fls_mark_dirty(Fls_AddressType address, Fls_LengthType length) {
+#ifndef FLS_AC_RAM_ONLY
+  uint32_t sector;
+
+  if (length > 0) {
+    for (sector = address / FLS_AC_SECTOR_SIZE;
+         sector <= (address + length - 1) / FLS_AC_SECTOR_SIZE; sector++) {
+      lDirty[sector / 8] |= 1 << (sector % 8);
+    }
+    lHasDirty = TRUE;
+  }
+#endif
+}
+
+#ifndef FLS_AC_RAM_ONLY
+/* write the dirty sectors back to Fls.img, merging the adjacent ones */
+static void _fls_write_behind(void) {
+  uint32_t sector;
+  uint32_t first;
+  uint32_t address;
+  uint32_t length;
+
+  for (sector = 0; (sector < FLS_AC_SECTOR_NUM) && lHasDirty; sector++) {
+    if (lDirty[sector / 8] & (1 << (sector % 8))) {
+      first = sector;
+      while ((sector < FLS_AC_SECTOR_NUM) && (lDirty[sector / 8] & (1 << (sector % 8)))) {
+        lDirty[sector / 8] &= ~(1 << (sector % 8));
+        sector++;
+      }
+      address = first * FLS_AC_SECTOR_SIZE;
+      length = sector * FLS_AC_SECTOR_SIZE;
+      if (length > FLS_TOTAL_SIZE) {
+        length = FLS_TOTAL_SIZE;
+      }
+      length -= address;
+      fseek(lFls, address, SEEK_SET);
+      fwrite(&g_FlsAcMirror[address], length, 1, lFls);
+    }
+  }
+  if (lHasDirty) {
+    fflush(lFls);
+    lHasDirty = FALSE;
+  }
+}
+#endif
+
 static void _fls_stop(void) {
 #ifndef FLS_AC_RAM_ONLY
   if (NULL != lFls) {
 #endif
     lStoped = TRUE;
-    lJobType = FLS_AC_JOB_NONE;
     sem_post(&lSem);
     pthread_join(lThread, NULL);
 #ifndef FLS_AC_RAM_ONLY
+    _fls_write_behind();
     fclose(lFls);
   }
 #endif
 }
 
+static FlsAc_JobContextType *_fls_find_job(FlsAc_JobType type, Fls_AddressType address,
+                                           const uint8_t *data, Fls_LengthType length) {
+  FlsAc_JobContextType *job = NULL;
+  FlsAc_JobContextType *freeJob = NULL;
+  int i;
+
+  for (i = 0; (i < FLS_AC_JOB_QUEUE_SIZE) && (NULL == job); i++) {
+    if (FLS_AC_JOB_NONE == lJobs[i].type) {
+      if (NULL == freeJob) {
+        freeJob = &lJobs[i];
+      }
+    } else if ((type == lJobs[i].type) && (address == lJobs[i].address) &&
+               (length == lJobs[i].length) && (data == lJobs[i].data) &&
+               (FALSE == lJobs[i].orphan)) {
+      job = &lJobs[i];
+    } else {
+      /* busy with another job */
+    }
+  }
+
+  if ((NULL == job) && (NULL != freeJob)) {
+    job = freeJob;
+    job->type = type;
+    job->status = FLS_AC_JOB_QUEUED;
+    job->orphan = FALSE;
+    job->data = data;
+    job->address = address;
+    job->length = length;
+    job->seq = lSeq++;
+    job->submitUs = _fls_now_us();
+    job->latencyUs = 0;
+    lStats.queued++;
+    if (lStats.queued > lStats.maxQueued) {
+      lStats.maxQueued = lStats.queued;
+    }
+    sem_post(&lSem);
+  }
+
+  return job;
+}
+
+static FlsAc_JobContextType *_fls_next_job(void) {
+  FlsAc_JobContextType *job = NULL;
+  int i;
+
+  for (i = 0; i < FLS_AC_JOB_QUEUE_SIZE; i++) {
+    if ((FLS_AC_JOB_QUEUED == lJobs[i].status) &&
+        ((NULL == job) || ((int32_t)(lJobs[i].seq - job->seq) < 0))) {
+      job = &lJobs[i];
+    }
+  }
+
+  return job;
+}
+
+static void _fls_job_done(FlsAc_JobContextType *job, FlsAc_JobStatusType status) {
+  Fls_AcJobStatisticsType *stats;
+
+  job->latencyUs = (uint32_t)(_fls_now_us() - job->submitUs);
+  stats = (FLS_AC_JOB_ERASE == job->type) ? &lStats.erase : &lStats.write;
+  stats->count++;
+  stats->lastUs = job->latencyUs;
+  stats->totalUs += job->latencyUs;
+  if (job->latencyUs > stats->maxUs) {
+    stats->maxUs = job->latencyUs;
+  }
+  lStats.queued--;
+  ASLOG(FLSAC, ("%s(0x%X, %d) %s in %uus\n", (FLS_AC_JOB_ERASE == job->type) ? "erase" : "write",
+                job->address, job->length, (FLS_AC_JOB_DONE == status) ? "done" : "failed",
+                job->latencyUs));
+  if (job->orphan) {
+    job->type = FLS_AC_JOB_NONE;
+    job->status = FLS_AC_JOB_IDEL;
+  } else {
+    job->status = status;
+  }
+}
+
+static void _fls_erase(FlsAc_JobContextType *job) {
+  Fls_AddressType address = job->address;
+  Fls_AddressType end = job->address + job->length;
+  Fls_LengthType length;
+
+  /* sector by sector, so that reads and new jobs are not blocked by a long erase */
+  while (address < end) {
+    length = FLS_AC_SECTOR_SIZE - (address % FLS_AC_SECTOR_SIZE);
+    if (length > (end - address)) {
+      length = end - address;
+    }
+    memset(&g_FlsAcMirror[address], FLS_ERASED_VALUE, length);
+    _fls_mark_dirty(address, length);
+    address += length;
+    pthread_mutex_unlock(&lMutex);
+    _fls_delay(length, lEraseTimeUsPerKb);
+    pthread_mutex_lock(&lMutex);
+  }
+  _fls_job_done(job, FLS_AC_JOB_DONE);
+}
+
+static void _fls_write(FlsAc_JobContextType *job) {
+  if (FALSE == _fls_is_blank(job->address, job->length)) {
+    ASLOG(ERROR, ("FLS write without erase @ %X\n", job->address));
+    _fls_job_done(job, FLS_AC_JOB_FAIL);
+  } else {
+    memcpy(&g_FlsAcMirror[job->address], job->data, job->length);
+    _fls_mark_dirty(job->address, job->length);
+    pthread_mutex_unlock(&lMutex);
+    _fls_delay(job->length, lWriteTimeUsPerKb);
+    pthread_mutex_lock(&lMutex);
+    _fls_job_done(job, FLS_AC_JOB_DONE);
+  }
+}
+
 static void *_fls_engine(void *arg) {
-  const uint8_t EraseMask = FLS_ERASED_VALUE;
-  uint8_t u8V;
-  boolean conditionOk;
+  FlsAc_JobContextType *job;
+
+  pthread_mutex_lock(&lMutex);
   while (FALSE == lStoped) {
-    sem_wait(&lSem);
-    pthread_mutex_lock(&lMutex);
-    switch (lJobType) {
-    case FLS_AC_JOB_ERASE:
-      ASLOG(FLSAC, ("erase(0x%X, %d)\n", lAddress, lLength));
-#ifndef FLS_AC_RAM_ONLY
-      fseek(lFls, lAddress, SEEK_SET);
-#endif
-      for (int i = 0; i < lLength; i++) {
-#ifndef FLS_AC_RAM_ONLY
-        fwrite(&EraseMask, 1, 1, lFls);
-#endif
-        g_FlsAcMirror[lAddress + i] = EraseMask;
-      }
-      lJobStatus = FLS_AC_JOB_DONE;
-      break;
-    case FLS_AC_JOB_WRITE:
-      ASLOG(FLSAC, ("write(0x%X, %p, %d)\n", lAddress, lData, lLength));
-#ifndef FLS_AC_RAM_ONLY
-      fseek(lFls, lAddress, SEEK_SET);
-#endif
-      conditionOk = TRUE;
-      for (int i = 0; i < lLength; i++) {
-#ifndef FLS_AC_RAM_ONLY
-        fread(&u8V, 1, 1, lFls);
-#else
-        u8V = g_FlsAcMirror[lAddress + i];
-#endif
-        if (u8V != FLS_ERASED_VALUE) {
-          conditionOk = FALSE;
-          break;
-        }
-      }
-      if (FALSE == conditionOk) {
-        ASLOG(ERROR, ("FLS write without erase @ %X\n", lAddress));
-        lJobStatus = FLS_AC_JOB_FAIL;
+    job = _fls_next_job();
+    if (NULL != job) {
+      job->status = FLS_AC_JOB_ONGOING;
+      if (FLS_AC_JOB_ERASE == job->type) {
+        _fls_erase(job);
       } else {
+        _fls_write(job);
+      }
+    } else {
 #ifndef FLS_AC_RAM_ONLY
-        fseek(lFls, lAddress, SEEK_SET);
-        fwrite(lData, lLength, 1, lFls);
+      /* the engine is idle, the image catches up with the mirror */
+      _fls_write_behind();
 #endif
-        memcpy(&g_FlsAcMirror[lAddress], lData, lLength);
-        lJobStatus = FLS_AC_JOB_DONE;
-      }
-      break;
-    default:
-      break;
+      pthread_mutex_unlock(&lMutex);
+      sem_wait(&lSem);
+      pthread_mutex_lock(&lMutex);
     }
-    pthread_mutex_unlock(&lMutex);
   }
+  pthread_mutex_unlock(&lMutex);
 
   return NULL;
 }
+
+static void _fls_start_engine(void) {
+  lEraseTimeUsPerKb = _fls_get_timing("FLS_AC_ERASE_TIME_US_PER_KB", FLS_AC_ERASE_TIME_US_PER_KB);
+  lWriteTimeUsPerKb = _fls_get_timing("FLS_AC_WRITE_TIME_US_PER_KB", FLS_AC_WRITE_TIME_US_PER_KB);
+  pthread_mutex_init(&lMutex, NULL);
+  sem_init(&lSem, 0, 0);
+  pthread_create(&lThread, NULL, _fls_engine, NULL);
+}
+
 #ifdef USE_FLS
 static void __attribute__((constructor)) _fls_start(void) {
 #ifndef FLS_AC_RAM_ONLY
   size_t sz;
-  uint8_t EraseMask = FLS_ERASED_VALUE;
   lFls = fopen("Fls.img", "rb+");
   if (NULL == lFls) {
     lFls = fopen("Fls.img", "wb+");
@@ -138,38 +362,80 @@ static void __attribute__((constructor)) _fls_start(void) {
   if (lFls) {
     fseek(lFls, 0, SEEK_END);
     sz = ftell(lFls);
-    if (sz < FLS_TOTAL_SIZE) {
-      for (size_t i = sz; i < FLS_TOTAL_SIZE; i++) {
-        fwrite(&EraseMask, 1, 1, lFls);
-      }
+    if (sz > FLS_TOTAL_SIZE) {
+      sz = FLS_TOTAL_SIZE;
     }
     fseek(lFls, 0, SEEK_SET);
-    fread(g_FlsAcMirror, FLS_TOTAL_SIZE, 1, lFls);
-    pthread_mutex_init(&lMutex, NULL);
-    sem_init(&lSem, 0, 0);
-    pthread_create(&lThread, NULL, _fls_engine, NULL);
+    if (1 != fread(g_FlsAcMirror, sz, 1, lFls)) {
+      sz = 0;
+    }
+    if (sz < FLS_TOTAL_SIZE) {
+      memset(&g_FlsAcMirror[sz], FLS_ERASED_VALUE, FLS_TOTAL_SIZE - sz);
+      _fls_mark_dirty(sz, FLS_TOTAL_SIZE - sz);
+    }
+    _fls_start_engine();
   } else {
     ASLOG(ERROR, ("Failed to create Fls.img\n"));
   }
 #else
   memset(g_FlsAcMirror, FLS_ERASED_VALUE, sizeof(g_FlsAcMirror));
-  pthread_mutex_init(&lMutex, NULL);
-  sem_init(&lSem, 0, 0);
-  pthread_create(&lThread, NULL, _fls_engine, NULL);
+  _fls_start_engine();
 #endif
   atexit(_fls_stop);
 }
 #endif
+
+static Std_ReturnType _fls_poll(FlsAc_JobType type, Fls_AddressType address,
+                                const uint8_t *data, Fls_LengthType length) {
+  Std_ReturnType r = E_NOT_OK;
+  FlsAc_JobContextType *job;
+
+  pthread_mutex_lock(&lMutex);
+  job = _fls_find_job(type, address, data, length);
+  if (NULL == job) {
+    /* the queue is full, try again on the next poll */
+    r = E_FLS_PENDING;
+  } else if ((FLS_AC_JOB_QUEUED == job->status) || (FLS_AC_JOB_ONGOING == job->status)) {
+    r = E_FLS_PENDING;
+  } else {
+    if (FLS_AC_JOB_DONE == job->status) {
+      r = E_OK;
+    }
+    job->type = FLS_AC_JOB_NONE;
+    job->status = FLS_AC_JOB_IDEL;
+  }
+  pthread_mutex_unlock(&lMutex);
+
+  return r;
+}
 /* ================================ [ FUNCTIONS ] ============================================== */
 void Fls_AcInit(void) {
-  lJobType = FLS_AC_JOB_NONE;
+  int i;
+
+  pthread_mutex_lock(&lMutex);
+  for (i = 0; i < FLS_AC_JOB_QUEUE_SIZE; i++) {
+    if (FLS_AC_JOB_ONGOING == lJobs[i].status) {
+      lJobs[i].orphan = TRUE;
+    } else if (FLS_AC_JOB_NONE != lJobs[i].type) {
+      if (FLS_AC_JOB_QUEUED == lJobs[i].status) {
+        lStats.queued--;
+      }
+      lJobs[i].type = FLS_AC_JOB_NONE;
+      lJobs[i].status = FLS_AC_JOB_IDEL;
+    } else {
+      /* free */
+    }
+  }
+  pthread_mutex_unlock(&lMutex);
 }
 
 boolean Fls_AcIsIdle(void) {
-  boolean idle = TRUE;
-  if ((FLS_AC_JOB_NONE != lJobType) && (lJobStatus == FLS_AC_JOB_ONGOING)) {
-    idle = FALSE;
-  }
+  boolean idle;
+
+  pthread_mutex_lock(&lMutex);
+  idle = (0 == lStats.queued);
+  pthread_mutex_unlock(&lMutex);
+
   return idle;
 }
 
@@ -177,31 +443,7 @@ Std_ReturnType Fls_AcErase(Fls_AddressType address, Fls_LengthType length) {
   Std_ReturnType r = E_NOT_OK;
 
   if (IS_FLS_ADDRESS(address) && IS_FLS_ADDRESS(address + length)) {
-    pthread_mutex_lock(&lMutex);
-    switch (lJobType) {
-    case FLS_AC_JOB_NONE:
-      lData = NULL;
-      lAddress = address;
-      lLength = length;
-      lJobType = FLS_AC_JOB_ERASE;
-      lJobStatus = FLS_AC_JOB_ONGOING;
-      sem_post(&lSem);
-      r = E_FLS_PENDING;
-      break;
-    case FLS_AC_JOB_ERASE:
-      if (FLS_AC_JOB_ONGOING == lJobStatus) {
-        r = E_FLS_PENDING;
-      } else if (FLS_AC_JOB_DONE == lJobStatus) {
-        r = E_OK;
-        lJobType = FLS_AC_JOB_NONE;
-      } else {
-        /* Error */
-      }
-      break;
-    default:
-      break;
-    }
-    pthread_mutex_unlock(&lMutex);
+    r = _fls_poll(FLS_AC_JOB_ERASE, address, NULL, length);
   }
 
   return r;
@@ -211,33 +453,7 @@ Std_ReturnType Fls_AcWrite(Fls_AddressType address, const uint8_t *data, Fls_Len
   Std_ReturnType r = E_NOT_OK;
 
   if (IS_FLS_ADDRESS(address) && IS_FLS_ADDRESS(address + length)) {
-    pthread_mutex_lock(&lMutex);
-    switch (lJobType) {
-    case FLS_AC_JOB_NONE:
-      lData = (uint8_t *)data;
-      lAddress = address;
-      lLength = length;
-      lJobType = FLS_AC_JOB_WRITE;
-      lJobStatus = FLS_AC_JOB_ONGOING;
-      sem_post(&lSem);
-      r = E_FLS_PENDING;
-      break;
-    case FLS_AC_JOB_WRITE:
-      if (FLS_AC_JOB_ONGOING == lJobStatus) {
-        r = E_FLS_PENDING;
-      } else if (FLS_AC_JOB_DONE == lJobStatus) {
-        r = E_OK;
-        lJobType = FLS_AC_JOB_NONE;
-      } else {
-        /* Error */
-      }
-      break;
-    default:
-      break;
-    }
-    pthread_mutex_unlock(&lMutex);
-  } else {
-    r = E_NOT_OK;
+    r = _fls_poll(FLS_AC_JOB_WRITE, address, data, length);
   }
 
   return r;
@@ -249,12 +465,7 @@ Std_ReturnType Fls_AcRead(Fls_AddressType address, uint8_t *data, Fls_LengthType
   if (IS_FLS_ADDRESS(address) && IS_FLS_ADDRESS(address + length)) {
     ASLOG(FLSAC, ("read(0x%X, %p, %d)\n", address, data, length));
     pthread_mutex_lock(&lMutex);
-#ifndef FLS_AC_RAM_ONLY
-    fseek(lFls, address, SEEK_SET);
-    fread(data, length, 1, lFls);
-#else
     memcpy(data, &g_FlsAcMirror[address], length);
-#endif
     pthread_mutex_unlock(&lMutex);
   } else {
     r = E_NOT_OK;
@@ -265,25 +476,12 @@ Std_ReturnType Fls_AcRead(Fls_AddressType address, uint8_t *data, Fls_LengthType
 
 Std_ReturnType Fls_AcCompare(Fls_AddressType address, uint8_t *data, Fls_LengthType length) {
   Std_ReturnType r = E_OK;
-#ifndef FLS_AC_RAM_ONLY
-  uint8_t u8V;
-#endif
+
   if (IS_FLS_ADDRESS(address) && IS_FLS_ADDRESS(address + length)) {
     pthread_mutex_lock(&lMutex);
-#ifndef FLS_AC_RAM_ONLY
-    fseek(lFls, address, SEEK_SET);
-    for (int i = 0; i < length; i++) {
-      fread(&u8V, 1, 1, lFls);
-      if (u8V != data[i]) {
-        r = E_FLS_INCONSISTENT;
-        break;
-      }
-    }
-#else
     if (0 != memcmp(data, &g_FlsAcMirror[address], length)) {
       r = E_FLS_INCONSISTENT;
     }
-#endif
     pthread_mutex_unlock(&lMutex);
   } else {
     r = E_NOT_OK;
@@ -295,32 +493,21 @@ Std_ReturnType Fls_AcCompare(Fls_AddressType address, uint8_t *data, Fls_LengthT
 Std_ReturnType Fls_AcBlankCheck(Fls_AddressType address, Fls_LengthType length) {
   Std_ReturnType r = E_OK;
 
-  uint8_t u8V;
-
   if (IS_FLS_ADDRESS(address) && IS_FLS_ADDRESS(address + length)) {
     pthread_mutex_lock(&lMutex);
-#ifndef FLS_AC_RAM_ONLY
-    fseek(lFls, address, SEEK_SET);
-    for (int i = 0; i < length; i++) {
-      fread(&u8V, 1, 1, lFls);
-      if (u8V != FLS_ERASED_VALUE) {
-        r = E_FLS_INCONSISTENT;
-        break;
-      }
-    }
-#else
-    for (int i = 0; i < length; i++) {
-      u8V = g_FlsAcMirror[address + i];
-      if (u8V != FLS_ERASED_VALUE) {
-        r = E_FLS_INCONSISTENT;
-        break;
-      }
+    if (FALSE == _fls_is_blank(address, length)) {
+      r = E_FLS_INCONSISTENT;
     }
-#endif
     pthread_mutex_unlock(&lMutex);
   } else {
     r = E_NOT_OK;
   }
 
   return r;
+}
+
+void Fls_AcGetStatistics(Fls_AcStatisticsType *stats) {
+  pthread_mutex_lock(&lMutex);
+  *stats = lStats;
+  pthread_mutex_unlock(&lMutex);
 }
\ No newline at end of file
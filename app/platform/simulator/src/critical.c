@@ -5,7 +5,16 @@
 /* ================================ [ INCLUDES  ] ============================================== */
 #include "Std_Critical.h"
 #include <pthread.h>
+#include <sched.h>
+#ifdef linux
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 /* ================================ [ MACROS    ] ============================================== */
+#ifndef STD_LOCK_SPIN_COUNT
+#define STD_LOCK_SPIN_COUNT 100
+#endif
 /* ================================ [ TYPES     ] ============================================== */
 /* ================================ [ DECLARES  ] ============================================== */
 /* ================================ [ DATAS     ] ============================================== */
@@ -17,6 +26,50 @@ static void __attribute__((constructor)) __CriticalInit(void) {
   pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
   pthread_mutex_init(&cirtical_mutex, &attr);
 }
+
+#ifdef STD_NAMED_LOCK
+static unsigned int lockCas(unsigned int *state, unsigned int expected, unsigned int desired) {
+  (void)__atomic_compare_exchange_n(state, &expected, desired, 0, __ATOMIC_ACQUIRE,
+                                    __ATOMIC_RELAXED);
+  return expected;
+}
+
+static void lockWait(Std_LockType *lock) {
+  __atomic_add_fetch(&lock->sleeps, 1, __ATOMIC_RELAXED);
+#ifdef linux
+  (void)syscall(SYS_futex, &lock->state, FUTEX_WAIT_PRIVATE, 2, NULL, NULL, 0);
+#else
+  (void)sched_yield();
+#endif
+}
+
+static void lockWake(Std_LockType *lock) {
+#ifdef linux
+  (void)syscall(SYS_futex, &lock->state, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+#else
+  (void)lock;
+#endif
+}
+
+static imask_t lockRaise(Std_LockType *lock) {
+  imask_t mask = 0;
+  int policy;
+  struct sched_param param;
+
+  if (lock->ceiling > 0) {
+    if (0 == pthread_getschedparam(pthread_self(), &policy, &param)) {
+      if (((SCHED_FIFO == policy) || (SCHED_RR == policy)) &&
+          (param.sched_priority < lock->ceiling)) {
+        if (0 == pthread_setschedprio(pthread_self(), lock->ceiling)) {
+          mask = (imask_t)param.sched_priority + 1;
+        }
+      }
+    }
+  }
+
+  return mask;
+}
+#endif
 /* ================================ [ FUNCTIONS ] ============================================== */
 imask_t Std_EnterCritical(void) {
   pthread_mutex_lock(&cirtical_mutex);
@@ -25,4 +78,42 @@ imask_t Std_EnterCritical(void) {
 
 void Std_ExitCritical(imask_t mask) {
   pthread_mutex_unlock(&cirtical_mutex);
-}
\ No newline at end of file
+}
+
+#ifdef STD_NAMED_LOCK
+imask_t Std_Lock(Std_LockType *lock) {
+  imask_t mask = lockRaise(lock);
+  unsigned int c = lockCas(&lock->state, 0, 1);
+  int spin;
+
+  if (0 != c) {
+    __atomic_add_fetch(&lock->contentions, 1, __ATOMIC_RELAXED);
+    for (spin = 0; (spin < STD_LOCK_SPIN_COUNT) && (1 == c); spin++) {
+      c = lockCas(&lock->state, 0, 1);
+    }
+    if (0 != c) {
+      /* mark it contended so that the owner wakes us up on unlock */
+      c = __atomic_exchange_n(&lock->state, 2, __ATOMIC_ACQUIRE);
+      while (0 != c) {
+        lockWait(lock);
+        c = __atomic_exchange_n(&lock->state, 2, __ATOMIC_ACQUIRE);
+      }
+    }
+  }
+
+  lock->acquisitions++;
+
+  return mask;
+}
+
+void Std_Unlock(Std_LockType *lock, imask_t mask) {
+  if (1 != __atomic_fetch_sub(&lock->state, 1, __ATOMIC_RELEASE)) {
+    __atomic_store_n(&lock->state, 0, __ATOMIC_RELEASE);
+    lockWake(lock);
+  }
+
+  if (0 != mask) {
+    (void)pthread_setschedprio(pthread_self(), (int)mask - 1);
+  }
+}
+#endif
\ No newline at end of file
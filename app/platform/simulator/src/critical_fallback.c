@@ -0,0 +1,26 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2026 Parai Wang <parai@foxmail.com>
+ */
+/* ================================ [ INCLUDES  ] ============================================== */
+#include "Std_Critical.h"
+/* ================================ [ MACROS    ] ============================================== */
+/* ================================ [ TYPES     ] ============================================== */
+/* ================================ [ DECLARES  ] ============================================== */
+/* ================================ [ DATAS     ] ============================================== */
+/* ================================ [ LOCALS    ] ============================================== */
+/* ================================ [ FUNCTIONS ] ============================================== */
+#ifdef STD_NAMED_LOCK
+/* Named locks on the global critical section, for a host build which brings its own
+ * Std_EnterCritical/Std_ExitCritical instead of critical.c. The native ones in critical.c win
+ * wherever critical.c is linked too. */
+imask_t __attribute__((weak)) Std_Lock(Std_LockType *lock) {
+  (void)lock;
+  return Std_EnterCritical();
+}
+
+void __attribute__((weak)) Std_Unlock(Std_LockType *lock, imask_t mask) {
+  (void)lock;
+  Std_ExitCritical(mask);
+}
+#endif
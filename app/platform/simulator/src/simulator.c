@@ -17,14 +17,16 @@
 /* ================================ [ DATAS     ] ============================================== */
 /* ================================ [ LOCALS    ] ============================================== */
 /* ================================ [ FUNCTIONS ] ============================================== */
-std_time_t Std_GetTime(void) {
-  struct timeval now;
-  std_time_t tm;
+std_time64_t Std_GetTime64(void) {
+  struct timespec now;
+
+  (void)clock_gettime(CLOCK_MONOTONIC, &now);
 
-  (void)gettimeofday(&now, NULL);
-  tm = (std_time_t)(now.tv_sec * 1000000 + now.tv_usec);
+  return (std_time64_t)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
 
-  return tm;
+std_time_t Std_GetTime(void) {
+  return (std_time_t)Std_GetTime64();
 }
 
 void Mcu_Init(const Mcu_ConfigType *ConfigPtr) {
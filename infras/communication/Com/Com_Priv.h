@@ -20,6 +20,9 @@
 #define COM_SINT8N COM_UINT8N
 
 #define COM_UPDATE_BIT_NOT_USED ((uint16_t)0xFFFF)
+
+/* shadow offset of a signal group, its members carry the values */
+#define COM_SHADOW_GROUP ((uint16_t)0xFFFF)
 /* ================================ [ TYPES     ] ============================================== */
 /* maximum 16 groups supported by this implementataion */
 typedef uint16_t Com_GroupMaskType;
@@ -123,6 +126,21 @@ typedef struct {
   PduIdType TxPduId;
 } Com_IPduTxConfigType;
 
+#ifdef COM_USE_PACK_ROUTINES
+/* kept out of Com_IPduConfigType, the layout of Com_Config is shared with the prebuilt Com */
+typedef void (*Com_UnpackFncType)(const uint8_t *data, void *shadow);
+
+typedef void (*Com_PackFncType)(uint8_t *data, const void *shadow);
+
+/* the generated Com_Unpack/Pack_<msg> of an I-PDU and the layout of its Com_Shadow_<msg>Type */
+typedef struct {
+  Com_UnpackFncType Unpack;
+  Com_PackFncType Pack;
+  const uint16_t *offsets; /* shadow offset of each I-PDU signal or COM_SHADOW_GROUP */
+  uint16_t size;
+} Com_IPduPackConfigType;
+#endif
+
 typedef struct {
   void *ptr;
   const Com_SignalConfigType **signals;
@@ -146,6 +164,10 @@ struct Com_Config_s {
   uint8_t numOfGroups;
 };
 /* ================================ [ DECLARES  ] ============================================== */
+#ifdef COM_USE_PACK_ROUTINES
+/* indexed by the I-PDU id, as Com_Config.IPduConfigs */
+extern const Com_IPduPackConfigType Com_IPduPackConfigs[];
+#endif
 /* ================================ [ DATAS     ] ============================================== */
 /* ================================ [ LOCALS    ] ============================================== */
 /* ================================ [ FUNCTIONS ] ============================================== */
@@ -0,0 +1,300 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2026 Parai Wang <parai@foxmail.com>
+ *
+ * Compare the generated pack/unpack routines of every I-PDU against the generic Std_Bit path,
+ * which is driven by the signal configuration only.
+ */
+/* ================================ [ INCLUDES  ] ============================================== */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "Com.h"
+#include "Com_Cfg.h"
+#include "Com_Priv.h"
+#include "Std_Bit.h"
+/* ================================ [ MACROS    ] ============================================== */
+/* signals moved per timed path, the loops of a configuration are derived from it */
+#define COM_BENCH_SIGNALS 100000000
+#define COM_BENCH_CHECKS 100000
+/* ================================ [ TYPES     ] ============================================== */
+/* ================================ [ DECLARES  ] ============================================== */
+extern const Com_ConfigType Com_Config;
+/* ================================ [ DATAS     ] ============================================== */
+static volatile uint32_t bench_sink;
+static uint8_t bench_data[256];
+/* ================================ [ LOCALS    ] ============================================== */
+static uint64_t bench_now(void) {
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static uint32_t bench_get(const Com_SignalConfigType *sig) {
+  uint32_t value;
+
+  if (BIG == sig->Endianness) {
+    value = Std_BitGetBigEndian(sig->ptr, sig->BitPosition, (uint8_t)sig->BitSize);
+  } else {
+    value = Std_BitGetLittleEndian(sig->ptr, sig->BitPosition, (uint8_t)sig->BitSize);
+  }
+
+  if ((sig->BitSize < 32) && ((COM_SINT8 == sig->type) || (COM_SINT16 == sig->type) ||
+                              (COM_SINT32 == sig->type))) {
+    if (value & ((uint32_t)1 << (sig->BitSize - 1))) {
+      value |= ~(((uint32_t)1 << sig->BitSize) - 1);
+    }
+  }
+
+  return value;
+}
+
+static void bench_set(const Com_SignalConfigType *sig, uint32_t value) {
+  if (sig->BitSize < 32) {
+    value &= ((uint32_t)1 << sig->BitSize) - 1;
+  }
+
+  if (BIG == sig->Endianness) {
+    Std_BitSetBigEndian(sig->ptr, value, sig->BitPosition, (uint8_t)sig->BitSize);
+  } else {
+    Std_BitSetLittleEndian(sig->ptr, value, sig->BitPosition, (uint8_t)sig->BitSize);
+  }
+}
+
+static void bench_store(const Com_SignalConfigType *sig, uint8_t *field, uint32_t value) {
+  switch (sig->type) {
+  case COM_SINT8:
+    *(int8_t *)field = (int8_t)value;
+    break;
+  case COM_UINT8:
+    *(uint8_t *)field = (uint8_t)value;
+    break;
+  case COM_SINT16:
+    *(int16_t *)field = (int16_t)value;
+    break;
+  case COM_UINT16:
+    *(uint16_t *)field = (uint16_t)value;
+    break;
+  default:
+    *(uint32_t *)field = value;
+    break;
+  }
+}
+
+static uint32_t bench_load(const Com_SignalConfigType *sig, const uint8_t *field) {
+  uint32_t value;
+
+  switch (sig->type) {
+  case COM_SINT8:
+    value = (uint32_t)(int32_t) * (const int8_t *)field;
+    break;
+  case COM_UINT8:
+    value = *(const uint8_t *)field;
+    break;
+  case COM_SINT16:
+    value = (uint32_t)(int32_t) * (const int16_t *)field;
+    break;
+  case COM_UINT16:
+    value = *(const uint16_t *)field;
+    break;
+  default:
+    value = *(const uint32_t *)field;
+    break;
+  }
+
+  return value;
+}
+
+/* the Std_Bit reference of Com_Unpack_<msg>, walking the I-PDU signal configuration */
+static void bench_generic_unpack(PduIdType id, uint8_t *shadow) {
+  const Com_IPduConfigType *IPduConfig = &Com_Config.IPduConfigs[id];
+  const uint16_t *offsets = Com_IPduPackConfigs[id].offsets;
+  const Com_SignalConfigType *sig;
+  uint16_t i;
+
+  /* the group shadow is refreshed from the I-PDU before its members are read */
+  for (i = 0; i < IPduConfig->numOfSignals; i++) {
+    sig = IPduConfig->signals[i];
+    if (COM_SHADOW_GROUP == offsets[i]) {
+      memcpy((void *)sig->initPtr, sig->ptr, sig->BitSize / 8);
+    }
+  }
+
+  for (i = 0; i < IPduConfig->numOfSignals; i++) {
+    sig = IPduConfig->signals[i];
+    if (COM_SHADOW_GROUP == offsets[i]) {
+      /* carried by its members */
+    } else if (COM_UINT8N == sig->type) {
+      memcpy(&shadow[offsets[i]], sig->ptr, (sig->BitSize + 7) / 8);
+    } else {
+      bench_store(sig, &shadow[offsets[i]], bench_get(sig));
+    }
+  }
+}
+
+static void bench_generic_pack(PduIdType id, const uint8_t *shadow) {
+  const Com_IPduConfigType *IPduConfig = &Com_Config.IPduConfigs[id];
+  const uint16_t *offsets = Com_IPduPackConfigs[id].offsets;
+  const Com_SignalConfigType *sig;
+  uint16_t i;
+
+  /* bits of a group owned by none of its members keep their I-PDU value */
+  for (i = 0; i < IPduConfig->numOfSignals; i++) {
+    sig = IPduConfig->signals[i];
+    if (COM_SHADOW_GROUP == offsets[i]) {
+      memcpy((void *)sig->initPtr, sig->ptr, sig->BitSize / 8);
+    }
+  }
+
+  for (i = 0; i < IPduConfig->numOfSignals; i++) {
+    sig = IPduConfig->signals[i];
+    if (COM_SHADOW_GROUP == offsets[i]) {
+      /* sent below, once all members are set */
+    } else if (COM_UINT8N == sig->type) {
+      memcpy(sig->ptr, &shadow[offsets[i]], (sig->BitSize + 7) / 8);
+    } else {
+      bench_set(sig, bench_load(sig, &shadow[offsets[i]]));
+    }
+  }
+
+  for (i = 0; i < IPduConfig->numOfSignals; i++) {
+    sig = IPduConfig->signals[i];
+    if (COM_SHADOW_GROUP == offsets[i]) {
+      memcpy(sig->ptr, sig->initPtr, sig->BitSize / 8);
+    }
+  }
+}
+
+static void bench_random(uint8_t *data, uint32_t length) {
+  uint32_t i;
+
+  for (i = 0; i < length; i++) {
+    data[i] = (uint8_t)rand();
+  }
+}
+
+static uint32_t bench_check(uint8_t *shadow1, uint8_t *shadow2) {
+  const Com_IPduConfigType *IPduConfig;
+  const Com_IPduPackConfigType *packConfig;
+  uint32_t errors = 0;
+  uint32_t i;
+  uint16_t id;
+
+  for (i = 0; i < COM_BENCH_CHECKS; i++) {
+    for (id = 0; id < Com_Config.numOfIPdus; id++) {
+      IPduConfig = &Com_Config.IPduConfigs[id];
+      packConfig = &Com_IPduPackConfigs[id];
+      bench_random(IPduConfig->ptr, IPduConfig->length);
+      memset(shadow1, 0, packConfig->size);
+      memset(shadow2, 0, packConfig->size);
+      bench_generic_unpack(id, shadow1);
+      packConfig->Unpack(IPduConfig->ptr, shadow2);
+      if (0 != memcmp(shadow1, shadow2, packConfig->size)) {
+        errors++;
+      }
+
+      /* pack random values onto a random I-PDU, both paths must leave the same bytes */
+      bench_random(shadow1, packConfig->size);
+      memcpy(bench_data, IPduConfig->ptr, IPduConfig->length);
+      bench_generic_pack(id, shadow1);
+      packConfig->Pack(bench_data, shadow1);
+      if (0 != memcmp(bench_data, IPduConfig->ptr, IPduConfig->length)) {
+        errors++;
+      }
+    }
+  }
+
+  return errors;
+}
+
+static void bench_report(const char *name, uint64_t elapsed, uint32_t loops) {
+  printf("  %-18s %8.1f ns/cycle\n", name, (double)elapsed / loops);
+}
+/* ================================ [ FUNCTIONS ] ============================================== */
+int main(int argc, char *argv[]) {
+  const Com_IPduConfigType *IPduConfig;
+  uint8_t *shadow1;
+  uint8_t *shadow2;
+  uint32_t errors;
+  uint32_t loops;
+  uint32_t size = 1;
+  uint32_t i;
+  uint16_t id;
+  uint64_t start;
+
+  for (id = 0; id < Com_Config.numOfIPdus; id++) {
+    if (Com_IPduPackConfigs[id].size > size) {
+      size = Com_IPduPackConfigs[id].size;
+    }
+  }
+  shadow1 = malloc(size);
+  shadow2 = malloc(size);
+  if ((NULL == shadow1) || (NULL == shadow2)) {
+    return -1;
+  }
+
+  srand(0);
+  errors = bench_check(shadow1, shadow2);
+  printf("%u I-PDUs, %u signals: %u random I-PDUs checked, %u mismatches\n",
+         (uint32_t)Com_Config.numOfIPdus, (uint32_t)Com_Config.numOfSignals,
+         COM_BENCH_CHECKS * Com_Config.numOfIPdus, errors);
+
+  /* one cycle moves every I-PDU once */
+  loops = COM_BENCH_SIGNALS / Com_Config.numOfSignals;
+  for (id = 0; id < Com_Config.numOfIPdus; id++) {
+    bench_random(Com_Config.IPduConfigs[id].ptr, Com_Config.IPduConfigs[id].length);
+  }
+  printf("unpack all I-PDUs, %u cycles\n", loops);
+  start = bench_now();
+  for (i = 0; i < loops; i++) {
+    for (id = 0; id < Com_Config.numOfIPdus; id++) {
+      IPduConfig = &Com_Config.IPduConfigs[id];
+      ((uint8_t *)IPduConfig->ptr)[0] = (uint8_t)i;
+      bench_generic_unpack(id, shadow1);
+      bench_sink += shadow1[0];
+    }
+  }
+  bench_report("Std_Bit", bench_now() - start, loops);
+
+  start = bench_now();
+  for (i = 0; i < loops; i++) {
+    for (id = 0; id < Com_Config.numOfIPdus; id++) {
+      IPduConfig = &Com_Config.IPduConfigs[id];
+      ((uint8_t *)IPduConfig->ptr)[0] = (uint8_t)i;
+      Com_IPduPackConfigs[id].Unpack(IPduConfig->ptr, shadow1);
+      bench_sink += shadow1[0];
+    }
+  }
+  bench_report("generated", bench_now() - start, loops);
+
+  printf("pack all I-PDUs, %u cycles\n", loops);
+  start = bench_now();
+  for (i = 0; i < loops; i++) {
+    for (id = 0; id < Com_Config.numOfIPdus; id++) {
+      IPduConfig = &Com_Config.IPduConfigs[id];
+      shadow1[0] = (uint8_t)i;
+      bench_generic_pack(id, shadow1);
+      bench_sink += ((uint8_t *)IPduConfig->ptr)[0];
+    }
+  }
+  bench_report("Std_Bit", bench_now() - start, loops);
+
+  start = bench_now();
+  for (i = 0; i < loops; i++) {
+    for (id = 0; id < Com_Config.numOfIPdus; id++) {
+      IPduConfig = &Com_Config.IPduConfigs[id];
+      shadow1[0] = (uint8_t)i;
+      Com_IPduPackConfigs[id].Pack(IPduConfig->ptr, shadow1);
+      bench_sink += ((uint8_t *)IPduConfig->ptr)[0];
+    }
+  }
+  bench_report("generated", bench_now() - start, loops);
+
+  free(shadow1);
+  free(shadow2);
+
+  return (0 == errors) ? 0 : -1;
+}
@@ -6,6 +6,7 @@
  */
 /* ================================ [ INCLUDES  ] ============================================== */
 #include "DoIP.h"
+#include "DoIP_Cfg.h"
 #include "DoIP_Priv.h"
 #include "SoAd.h"
 
@@ -46,10 +47,24 @@ typedef struct {
   DoIP_ActivationLineType ActivationLineState;
 } DoIP_ContextType;
 /* ================================ [ DECLARES  ] ============================================== */
+#ifdef STD_TIMER_WHEEL
+static void doipInactivityTimeout(void *param);
+#endif
 extern const DoIP_ConfigType DoIP_Config;
 /* ================================ [ DATAS     ] ============================================== */
 static DoIP_ContextType DoIP_Context;
 /* ================================ [ LOCALS    ] ============================================== */
+/* timeout in main function cycles */
+static void doipStartInactivityTimer(const DoIP_TesterConnectionType *connection,
+                                     uint16_t timeout) {
+#ifdef STD_TIMER_WHEEL
+  Std_TimerEntryStart(&connection->context->inactivityTimer,
+                      (std_time64_t)timeout * DOIP_MAIN_FUNCTION_PERIOD * 1000, 0);
+#else
+  connection->context->InactivityTimer = timeout;
+#endif
+}
+
 static void doipFillHeader(uint8_t *header, uint16_t payloadType, uint32_t payloadLength) {
   header[0] = DOIP_PROTOCOL_VERSION;
   header[1] = ~DOIP_PROTOCOL_VERSION;
@@ -485,7 +500,7 @@ static Std_ReturnType doipHandleRoutineActivation(PduIdType RxPduId, DoIP_MsgTyp
 
     doipBuildRountineActivationResponse(connection, msg, ret, sourceAddress, resCode);
     if (DOIP_E_NOT_OK == ret) {
-      connection->context->InactivityTimer = 1; /* close it the next MainFunction */
+      doipStartInactivityTimer(connection, 1); /* close it the next MainFunction */
     }
   } else {
     *nack = DOIP_INVALID_PAYLOAD_LENGTH_NACK;
@@ -514,11 +529,11 @@ static void doipHandleRoutineActivationMain() {
         doipBuildRountineActivationResponse(connection, &msg, ret,
                                             connection->context->ramgr.tester->TesterSA, resCode);
         if (DOIP_E_NOT_OK == ret) {
-          connection->context->InactivityTimer = 1; /* close it the next MainFunction */
+          doipStartInactivityTimer(connection, 1); /* close it the next MainFunction */
         }
 
         if (E_OK == ret) {
-          connection->context->InactivityTimer = config->GeneralInactivityTime;
+          doipStartInactivityTimer(connection, config->GeneralInactivityTime);
           (void)doipTpSendResponse(connection->SoAdTxPdu, msg.res, msg.resLen);
         } else if (DOIP_E_PENDING == ret) {
         } else {
@@ -584,60 +599,89 @@ doipFindTargetAddress(const DoIP_TesterType *tester, const DoIP_TesterConnection
   return TargetAddressRef;
 }
 
-static void doipRememberDiagMsg(const DoIP_TesterConnectionType *connection, DoIP_MsgType *msg) {
-  PduLengthType bufferSize;
-  if (DOIP_MSG_IDLE == connection->context->msg.state) {
-    bufferSize = msg->payloadLength - 4;
-    if (bufferSize > connection->context->TesterRef->NumByteDiagAckNack) {
-      bufferSize = connection->context->TesterRef->NumByteDiagAckNack;
-    }
-    bufferSize += DOIP_HEADER_LENGTH + 5; /* for header */
-    if (NULL != connection->context->msg.req) {
-      Net_MemFree(connection->context->msg.req);
-    }
-    connection->context->msg.req = Net_MemAlloc(bufferSize);
-    if (NULL != connection->context->msg.req) {
-      /* save sa&ta and uds message */
-      memcpy(&(connection->context->msg.req[DOIP_HEADER_LENGTH]), msg->req, 4);
-      memcpy(&(connection->context->msg.req[DOIP_HEADER_LENGTH + 5]), &msg->req[4],
-             msg->reqLen - 4);
+static uint16_t doipGetNumByteDiagAckNack(const DoIP_TesterConnectionType *connection) {
+  uint16_t num = 0;
+
+  if (NULL != connection->context->TesterRef) {
+    num = connection->context->TesterRef->NumByteDiagAckNack;
+    if (num > DOIP_MAX_NUM_BYTE_DIAG_ACK_NACK) {
+      num = DOIP_MAX_NUM_BYTE_DIAG_ACK_NACK;
     }
+  }
+
+  return num;
+}
+
+static void doipRememberDiagMsg(const DoIP_TesterConnectionType *connection, DoIP_MsgType *msg) {
+  DoIP_MessageContextType *context = &connection->context->msg;
+  uint16_t num = doipGetNumByteDiagAckNack(connection);
+  PduLengthType size;
+
+  if (DOIP_MSG_IDLE == context->state) {
+    /* save sa&ta and the head of the uds message */
+    memcpy(&context->ack[DOIP_HEADER_LENGTH], msg->req, 4);
+    context->ackLen = 0;
+    context->hasAck = TRUE;
+    size = msg->reqLen - 4;
+    if (size > num) {
+      size = num;
+    }
+    memcpy(&context->ack[DOIP_HEADER_LENGTH + 5], &msg->req[4], size);
+    context->ackLen = size;
+  } else if (context->hasAck && (context->ackLen < num)) {
+    size = num - context->ackLen;
+    if (size > msg->reqLen) {
+      size = msg->reqLen;
+    }
+    memcpy(&context->ack[DOIP_HEADER_LENGTH + 5 + context->ackLen], msg->req, size);
+    context->ackLen += size;
   } else {
-    if (NULL != connection->context->msg.req) {
-      if (connection->context->msg.index < connection->context->TesterRef->NumByteDiagAckNack) {
-        bufferSize =
-          connection->context->TesterRef->NumByteDiagAckNack - connection->context->msg.index;
-        if (bufferSize > msg->reqLen) {
-          bufferSize = msg->reqLen;
-        }
-        memcpy(
-          &(connection->context->msg.req[DOIP_HEADER_LENGTH + 5 + connection->context->msg.index]),
-          msg->req, bufferSize);
-      }
-    }
+    /* enough bytes kept */
   }
 }
 
 static void doipForgetDiagMsg(const DoIP_TesterConnectionType *connection) {
-  if (NULL != connection->context->msg.req) {
-    /* @SWS_DoIP_00138 */
-    Net_MemFree(connection->context->msg.req);
-    connection->context->msg.req = NULL;
+  /* @SWS_DoIP_00138 */
+  connection->context->msg.hasAck = FALSE;
+  connection->context->msg.ackLen = 0;
+}
+
+static void doipAbortDiagMsgResponse(const DoIP_TesterConnectionType *connection) {
+  DoIP_MessageContextType *msg = &connection->context->msg;
+
+  if (NULL != msg->txBuf) {
+    Net_MemFree(msg->txBuf);
+    msg->txBuf = NULL;
+  }
+
+  if (DOIP_MSG_TX == msg->state) {
+    msg->state = DOIP_MSG_IDLE;
+    PduR_DoIPTxConfirmation(msg->TargetAddressRef->TxPduId, E_NOT_OK);
   }
 }
 
+static void doipResetConnection(const DoIP_TesterConnectionType *connection) {
+  doipAbortDiagMsgResponse(connection);
+  doipForgetDiagMsg(connection);
+#ifdef STD_TIMER_WHEEL
+  /* unlink it from the wheel before the memset */
+  Std_TimerEntryStop(&connection->context->inactivityTimer);
+#endif
+  memset(connection->context, 0, sizeof(DoIP_TesterConnectionContextType));
+#ifdef STD_TIMER_WHEEL
+  Std_TimerEntryInit(&connection->context->inactivityTimer, doipInactivityTimeout,
+                     (void *)connection);
+#endif
+}
+
 static void doipReplyDiagMsg(const DoIP_TesterConnectionType *connection, DoIP_MsgType *msg,
                              uint8_t resCode) {
   PduLengthType resLen = 5;
   uint16_t payloadType = DOIP_DIAGNOSTIC_MESSAGE_POSITIVE_ACK;
-  if (NULL != connection->context->msg.req) {
+  if (connection->context->msg.hasAck) {
     /* @SWS_DoIP_00138 */
-    msg->res = connection->context->msg.req;
-    resLen = connection->context->msg.index;
-    if (resLen > connection->context->TesterRef->NumByteDiagAckNack) {
-      resLen = connection->context->TesterRef->NumByteDiagAckNack;
-    }
-    resLen += 5;
+    msg->res = connection->context->msg.ack;
+    resLen += connection->context->msg.ackLen;
   }
 
   if (0x0 != resCode) {
@@ -723,6 +767,7 @@ static Std_ReturnType doipHandleDiagnosticMessage(PduIdType RxPduId, DoIP_MsgTyp
           connection->context->msg.state = DOIP_MSG_RX;
           connection->context->msg.index = msg->reqLen - 4;
           connection->context->msg.TpSduLength = msg->payloadLength - 4;
+          connection->context->stats.rxBytes += msg->reqLen - 4;
         }
       }
     } else {
@@ -738,6 +783,7 @@ static Std_ReturnType doipHandleDiagnosticMessage(PduIdType RxPduId, DoIP_MsgTyp
         ret = DOIP_E_NOT_OK;
       } else {
         connection->context->msg.index += msg->reqLen;
+        connection->context->stats.rxBytes += msg->reqLen;
       }
     }
   }
@@ -745,6 +791,7 @@ static Std_ReturnType doipHandleDiagnosticMessage(PduIdType RxPduId, DoIP_MsgTyp
   if (E_OK == ret) {
     if (connection->context->msg.index >= connection->context->msg.TpSduLength) {
       connection->context->msg.state = DOIP_MSG_IDLE;
+      connection->context->stats.rxMessages++;
       PduR_DoIPRxIndication(TargetAddressRef->RxPduId, E_OK);
       doipFillHeader(msg->res, DOIP_DIAGNOSTIC_MESSAGE_POSITIVE_ACK, 5);
       msg->res[DOIP_HEADER_LENGTH + 4] = 0x0; /* ack code */
@@ -800,7 +847,7 @@ static Std_ReturnType doipHandleAliveCheckResponse(PduIdType RxPduId, DoIP_MsgTy
       ASLOG(DOIPE, ("sa %X not right, expected %X, close it\n", sa,
                     connection->context->TesterRef->TesterSA));
       ret = DOIP_E_NOT_OK_SILENT;
-      connection->context->InactivityTimer = 1; /* close it the next MainFunction */
+      doipStartInactivityTimer(connection, 1); /* close it the next MainFunction */
     } else {
       connection->context->isAlive = TRUE;
       connection->context->AliveCheckResponseTimer = 0;
@@ -865,6 +912,18 @@ static Std_ReturnType doipTpCopyRxData(PduIdType RxPduId, DoIP_MsgType *msg, uin
   return ret;
 }
 
+#ifdef STD_TIMER_WHEEL
+/* runs in the timer wheel task, which holds the same lock as the task running DoIP_MainFunction */
+static void doipInactivityTimeout(void *param) {
+  const DoIP_TesterConnectionType *connection = (const DoIP_TesterConnectionType *)param;
+
+  if (DOIP_CON_CLOSED != connection->context->state) {
+    ASLOG(DOIP, ("Tester SoCon %d InactivityTimer timeout\n", connection->SoConId));
+    SoAd_CloseSoCon(connection->SoConId, TRUE);
+    doipResetConnection(connection);
+  }
+}
+#else
 static void doipHandleInactivityTimer(void) {
   const DoIP_ConfigType *config = DOIP_CONFIG;
   const DoIP_TesterConnectionType *connection;
@@ -878,13 +937,13 @@ static void doipHandleInactivityTimer(void) {
         if (0 == connection->context->InactivityTimer) {
           ASLOG(DOIP, ("Tester SoCon %d InactivityTimer timeout\n", i));
           SoAd_CloseSoCon(connection->SoConId, TRUE);
-          doipForgetDiagMsg(connection);
-          memset(connection->context, 0, sizeof(DoIP_TesterConnectionContextType));
+          doipResetConnection(connection);
         }
       }
     }
   }
 }
+#endif
 
 static void doipHandleAliveCheckResponseTimer(void) {
   const DoIP_ConfigType *config = DOIP_CONFIG;
@@ -899,7 +958,7 @@ static void doipHandleAliveCheckResponseTimer(void) {
         if (0 == connection->context->AliveCheckResponseTimer) {
           ASLOG(DOIP, ("Tester SoCon %d AliveCheckResponseTimer timeout\n", i));
           SoAd_CloseSoCon(connection->SoConId, TRUE);
-          memset(connection->context, 0, sizeof(DoIP_TesterConnectionContextType));
+          doipResetConnection(connection);
         }
       }
     }
@@ -934,66 +993,114 @@ static void doipHandleVehicleAnnouncement(void) {
   }
 }
 
-static void doipHandleDiagMsgResponse(void) {
-  Std_ReturnType ret = E_NOT_OK;
+/* send the response chunk by chunk until it is done or the socket is full */
+/* returns E_NOT_OK if the response failed, the caller decides how to abort it */
+static Std_ReturnType doipStreamDiagMsgResponse(const DoIP_TesterConnectionType *connection) {
+  Std_ReturnType ret = E_OK;
   BufReq_ReturnType bret;
+  DoIP_TesterConnectionContextType *context = connection->context;
+  DoIP_MessageContextType *msg = &context->msg;
+  PduIdType TxPduId = msg->TargetAddressRef->TxPduId;
   PduInfoType PduInfo;
   PduLengthType left;
-  PduIdType TxPduId;
-  const DoIP_TargetAddressType *TargetAddressRef;
-  const DoIP_ConfigType *config = DOIP_CONFIG;
-  const DoIP_TesterConnectionType *connection = NULL;
-  int i;
-  uint8_t *res;
-  uint32_t resLen;
+  PduLengthType sent;
+  PduLengthType offset = 0;
+  uint32_t size;
+  uint16_t sa, ta;
 
-  for (i = 0; i < (NULL == connection) && (config->MaxTesterConnections); i++) {
-    connection = &config->testerConnections[i];
-    if (DOIP_CON_CLOSED != connection->context->state) {
-      TargetAddressRef = connection->context->msg.TargetAddressRef;
-      if (NULL != TargetAddressRef) {
-        if (DOIP_MSG_TX == connection->context->msg.state) {
-          TxPduId = TargetAddressRef->TxPduId;
-          connection = &config->testerConnections[i];
-          resLen = connection->context->msg.TpSduLength - connection->context->msg.index;
-          res = Net_MemGet(&resLen);
-          if (NULL != res) {
-            ret = E_OK;
-          }
-        }
+  while ((E_OK == ret) && (DOIP_MSG_TX == msg->state)) {
+    if (NULL == msg->txBuf) {
+      offset = (0u == msg->index) ? (DOIP_HEADER_LENGTH + 4) : 0;
+      size = offset + msg->TpSduLength - msg->index;
+      msg->txBuf = Net_MemGet(&size);
+      if ((NULL != msg->txBuf) && (size <= offset)) {
+        Net_MemFree(msg->txBuf);
+        msg->txBuf = NULL;
+      }
+      if (NULL == msg->txBuf) {
+        ret = DOIP_E_PENDING; /* retry the next MainFunction */
       }
     }
-  }
 
-  if (E_OK == ret) {
-    PduInfo.SduDataPtr = res;
-    PduInfo.SduLength = resLen;
-    if (PduInfo.SduLength >
-        (connection->context->msg.TpSduLength - connection->context->msg.index)) {
-      PduInfo.SduLength = connection->context->msg.TpSduLength - connection->context->msg.index;
-    }
-    bret = PduR_DoIPCopyTxData(TxPduId, &PduInfo, NULL, &left);
-    if (BUFREQ_OK == bret) {
-      ret = doipTpSendResponse(connection->SoAdTxPdu, PduInfo.SduDataPtr, PduInfo.SduLength);
-      if (E_OK != ret) {
-        connection->context->msg.state = DOIP_MSG_IDLE;
-        PduR_DoIPTxConfirmation(TxPduId, E_NOT_OK);
+    if ((E_OK == ret) && (0u == msg->txLen)) {
+      if (0u == msg->index) {
+        doipFillHeader(msg->txBuf, DOIP_DIAGNOSTIC_MESSAGE, msg->TpSduLength + 4);
+        sa = msg->TargetAddressRef->TargetAddress;
+        ta = context->TesterRef->TesterSA;
+        msg->txBuf[DOIP_HEADER_LENGTH + 0] = (sa >> 8) & 0xFF;
+        msg->txBuf[DOIP_HEADER_LENGTH + 1] = sa & 0xFF;
+        msg->txBuf[DOIP_HEADER_LENGTH + 2] = (ta >> 8) & 0xFF;
+        msg->txBuf[DOIP_HEADER_LENGTH + 3] = ta & 0xFF;
+      }
+      PduInfo.SduDataPtr = &msg->txBuf[offset];
+      PduInfo.MetaDataPtr = NULL;
+      PduInfo.SduLength = size - offset;
+      if (PduInfo.SduLength > (msg->TpSduLength - msg->index)) {
+        PduInfo.SduLength = msg->TpSduLength - msg->index;
+      }
+      bret = PduR_DoIPCopyTxData(TxPduId, &PduInfo, NULL, &left);
+      if (BUFREQ_OK == bret) {
+        msg->index += PduInfo.SduLength;
+        msg->txLen = offset + PduInfo.SduLength;
+        msg->txOffset = 0;
+      } else if (BUFREQ_E_BUSY == bret) {
+        Net_MemFree(msg->txBuf);
+        msg->txBuf = NULL;
+        ret = DOIP_E_PENDING;
+      } else {
+        ret = E_NOT_OK;
       }
-    } else {
-      ret = E_NOT_OK;
     }
 
     if (E_OK == ret) {
-      if (PduInfo.SduLength >= connection->context->msg.TpSduLength) {
-        connection->context->msg.state = DOIP_MSG_IDLE;
-        PduR_DoIPTxConfirmation(TxPduId, E_OK);
-        ASLOG(DOIP, ("[%d] send UDS response done\n", TxPduId));
-      } else {
-        ASLOG(DOIP, ("[%d] send UDS response on going\n", TxPduId));
+      PduInfo.SduDataPtr = &msg->txBuf[msg->txOffset];
+      PduInfo.MetaDataPtr = NULL;
+      PduInfo.SduLength = msg->txLen - msg->txOffset;
+      ret = SoAd_TpTransmitPartial(connection->SoAdTxPdu, &PduInfo, &sent);
+      msg->txOffset += sent;
+      context->stats.txBytes += sent;
+      if (msg->txOffset >= msg->txLen) {
+        Net_MemFree(msg->txBuf);
+        msg->txBuf = NULL;
+        msg->txLen = 0;
+        if (msg->index >= msg->TpSduLength) {
+          msg->state = DOIP_MSG_IDLE;
+          context->stats.txMessages++;
+          PduR_DoIPTxConfirmation(TxPduId, E_OK);
+          ASLOG(DOIP, ("[%d] send UDS response done\n", TxPduId));
+        }
+      }
+      if (TCPIP_E_NOSPACE == ret) {
+        /* keep the rest of the chunk until the next MainFunction */
+        context->stats.txStalls++;
       }
     }
+  }
+
+  if (E_NOT_OK == ret) {
+    ASLOG(DOIPE, ("[%d] send UDS response failed\n", TxPduId));
+    msg->txLen = 0;
+  } else {
+    ret = E_OK;
+  }
+
+  return ret;
+}
 
-    Net_MemFree(res);
+static void doipHandleDiagMsgResponse(void) {
+  const DoIP_ConfigType *config = DOIP_CONFIG;
+  const DoIP_TesterConnectionType *connection;
+  int i;
+
+  /* all testers progress each cycle, e.g. parallel flashing through a gateway */
+  for (i = 0; i < config->MaxTesterConnections; i++) {
+    connection = &config->testerConnections[i];
+    if ((DOIP_CON_CLOSED != connection->context->state) &&
+        (DOIP_MSG_TX == connection->context->msg.state)) {
+      if (E_NOT_OK == doipStreamDiagMsgResponse(connection)) {
+        doipAbortDiagMsgResponse(connection);
+      }
+    }
   }
 }
 /* ================================ [ FUNCTIONS ] ============================================== */
@@ -1005,7 +1112,15 @@ void DoIP_Init(const DoIP_ConfigType *ConfigPtr) {
            sizeof(DoIP_UdpVehicleAnnouncementConnectionContextType));
   }
   for (i = 0; i < config->MaxTesterConnections; i++) {
+#ifdef STD_TIMER_WHEEL
+    /* unlink it from the wheel before the memset, DoIP_Init may run again */
+    Std_TimerEntryStop(&config->testerConnections[i].context->inactivityTimer);
+#endif
     memset(config->testerConnections[i].context, 0, sizeof(DoIP_TesterConnectionContextType));
+#ifdef STD_TIMER_WHEEL
+    Std_TimerEntryInit(&config->testerConnections[i].context->inactivityTimer,
+                       doipInactivityTimeout, (void *)&config->testerConnections[i]);
+#endif
   }
 }
 
@@ -1061,6 +1176,7 @@ void DoIP_ActivationLineSwitchInactive(void) {
     for (i = 0; i < config->MaxTesterConnections; i++) {
       if (DOIP_CON_CLOSED != config->testerConnections[i].context->state) {
         SoAd_CloseSoCon(config->testerConnections[i].SoConId, TRUE);
+        doipAbortDiagMsgResponse(&config->testerConnections[i]);
         config->testerConnections[i].context->state = DOIP_CON_CLOSED;
       }
     }
@@ -1108,8 +1224,8 @@ void DoIP_SoConModeChg(SoAd_SoConIdType SoConId, SoAd_SoConModeType Mode) {
     if (SoConId == config->testerConnections[i].SoConId) {
       if (SOAD_SOCON_ONLINE == Mode) {
         assert(DOIP_ACTIVATION_LINE_ACTIVE == context->ActivationLineState);
-        memset(config->testerConnections[i].context, 0, sizeof(DoIP_TesterConnectionContextType));
-        config->testerConnections[i].context->InactivityTimer = config->InitialInactivityTime;
+        doipResetConnection(&config->testerConnections[i]);
+        doipStartInactivityTimer(&config->testerConnections[i], config->InitialInactivityTime);
         config->testerConnections[i].context->state = DOIP_CON_OPEN;
       }
       ASLOG(DOIP, ("Tester SoCon %d Mode %d\n", i, Mode));
@@ -1246,7 +1362,7 @@ BufReq_ReturnType DoIP_SoAdTpCopyRxData(PduIdType RxPduId, const PduInfoType *Pd
   }
 
   if (E_OK == r) {
-    connection->context->InactivityTimer = config->GeneralInactivityTime;
+    doipStartInactivityTimer(connection, config->GeneralInactivityTime);
     (void)doipTpSendResponse(connection->SoAdTxPdu, msg.res, msg.resLen);
   } else if (DOIP_E_NOT_OK_SILENT == r) {
     /* slient */
@@ -1264,7 +1380,9 @@ void DoIP_MainFunction(void) {
   DoIP_ContextType *context = &DoIP_Context;
 
   if (DOIP_ACTIVATION_LINE_ACTIVE == context->ActivationLineState) {
+#ifndef STD_TIMER_WHEEL
     doipHandleInactivityTimer();
+#endif
     doipHandleAliveCheckResponseTimer();
     doipHandleVehicleAnnouncement();
     doipHandleDiagMsgResponse();
@@ -1274,16 +1392,10 @@ void DoIP_MainFunction(void) {
 
 Std_ReturnType DoIP_TpTransmit(PduIdType TxPduId, const PduInfoType *PduInfoPtr) {
   Std_ReturnType ret = E_NOT_OK;
-  BufReq_ReturnType bret;
   int i;
   const DoIP_ConfigType *config = DOIP_CONFIG;
   DoIP_ContextType *context = &DoIP_Context;
   const DoIP_TesterConnectionType *connection = NULL;
-  PduInfoType PduInfo;
-  PduLengthType left;
-  uint16_t sa, ta;
-  uint8_t *res;
-  uint32_t resLen;
 
   if (DOIP_ACTIVATION_LINE_ACTIVE == context->ActivationLineState) {
     for (i = 0; (NULL == connection) && (i < config->MaxTesterConnections); i++) {
@@ -1310,49 +1422,32 @@ Std_ReturnType DoIP_TpTransmit(PduIdType TxPduId, const PduInfoType *PduInfoPtr)
 
   if (E_OK == ret) {
     ASLOG(DOIP, ("[%d] UDS response, len = %d\n", TxPduId, PduInfoPtr->SduLength));
-    resLen = DOIP_HEADER_LENGTH + 4 + PduInfoPtr->SduLength;
-    res = Net_MemGet(&resLen);
-    if (NULL == res) {
-      ret = E_NOT_OK;
-    }
-  }
-  if (E_OK == ret) {
-    doipFillHeader(res, DOIP_DIAGNOSTIC_MESSAGE, PduInfoPtr->SduLength + 4);
-    sa = connection->context->msg.TargetAddressRef->TargetAddress;
-    ta = connection->context->TesterRef->TesterSA;
-    res[DOIP_HEADER_LENGTH + 0] = (sa >> 8) & 0xFF;
-    res[DOIP_HEADER_LENGTH + 1] = sa & 0xFF;
-    res[DOIP_HEADER_LENGTH + 2] = (ta >> 8) & 0xFF;
-    res[DOIP_HEADER_LENGTH + 3] = ta & 0xFF;
-    PduInfo.SduDataPtr = &res[DOIP_HEADER_LENGTH + 4];
-    PduInfo.SduLength = PduInfoPtr->SduLength;
-    if (PduInfo.SduLength > (resLen - DOIP_HEADER_LENGTH - 4)) {
-      PduInfo.SduLength = resLen - DOIP_HEADER_LENGTH - 4;
-    }
-    bret = PduR_DoIPCopyTxData(TxPduId, &PduInfo, NULL, &left);
-    if (BUFREQ_OK == bret) {
-      resLen = DOIP_HEADER_LENGTH + PduInfo.SduLength + 4;
-      ret = doipTpSendResponse(connection->SoAdTxPdu, res, resLen);
-      if (E_OK != ret) {
-        PduR_DoIPTxConfirmation(TxPduId, E_NOT_OK);
+    connection->context->msg.state = DOIP_MSG_TX;
+    connection->context->msg.TpSduLength = PduInfoPtr->SduLength;
+    connection->context->msg.index = 0;
+    connection->context->msg.txLen = 0;
+    /* what the socket does not take now is sent by the MainFunction */
+    ret = doipStreamDiagMsgResponse(connection);
+    if (E_NOT_OK == ret) {
+      /* the caller learns it from the return value, no confirmation from within the request */
+      if (NULL != connection->context->msg.txBuf) {
+        Net_MemFree(connection->context->msg.txBuf);
+        connection->context->msg.txBuf = NULL;
       }
-    } else {
-      ret = E_NOT_OK;
+      connection->context->msg.state = DOIP_MSG_IDLE;
     }
+  }
 
-    if (E_OK == ret) {
-      if (PduInfo.SduLength >= PduInfoPtr->SduLength) {
-        PduR_DoIPTxConfirmation(TxPduId, E_OK);
-        ASLOG(DOIP, ("[%d] send UDS response done\n", TxPduId));
-      } else {
-        connection->context->msg.state = DOIP_MSG_TX;
-        connection->context->msg.TpSduLength = PduInfoPtr->SduLength;
-        connection->context->msg.index = PduInfo.SduLength;
-        ASLOG(DOIP, ("[%d] send UDS response on going\n", TxPduId));
-      }
-    }
+  return ret;
+}
+
+Std_ReturnType DoIP_GetConnectionStats(uint16_t TesterConnection, DoIP_ConnectionStatsType *stats) {
+  Std_ReturnType ret = E_NOT_OK;
+  const DoIP_ConfigType *config = DOIP_CONFIG;
 
-    Net_MemFree(res);
+  if ((TesterConnection < config->MaxTesterConnections) && (NULL != stats)) {
+    *stats = config->testerConnections[TesterConnection].context->stats;
+    ret = E_OK;
   }
 
   return ret;
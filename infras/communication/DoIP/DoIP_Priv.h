@@ -9,6 +9,7 @@
 /* ================================ [ INCLUDES  ] ============================================== */
 #include "DoIP.h"
 #include "SoAd.h"
+#include "Std_Timer.h"
 /* ================================ [ MACROS    ] ============================================== */
 /* @SWS_DoIP_00008, @SWS_DoIP_00009 */
 #define DOIP_GENERAL_HEADER_NEGATIVE_ACK 0x0000u                /* UDP/TCP*/
@@ -42,6 +43,14 @@
 #define DOIP_MAX_ROUTINE_ACTIVATIONS 32
 #endif
 
+/* upper bound of NumByteDiagAckNack of all testers, generated into DoIP_Cfg.h from the largest
+ * one, the bytes beyond are not echoed back */
+#ifndef DOIP_MAX_NUM_BYTE_DIAG_ACK_NACK
+#define DOIP_MAX_NUM_BYTE_DIAG_ACK_NACK 8
+#endif
+/* generic header, sa, ta, ack code and the echoed bytes of the request */
+#define DOIP_DIAG_ACK_SIZE (8 + 5 + DOIP_MAX_NUM_BYTE_DIAG_ACK_NACK)
+
 #define DOIP_GATEWAY 0x00
 #define DOIP_NODE 0x01
 /* ================================ [ TYPES     ] ============================================== */
@@ -92,7 +101,14 @@ typedef struct {
   PduLengthType TpSduLength;
   PduLengthType index;
   const DoIP_TargetAddressType *TargetAddressRef;
-  uint8_t *req; /* len = NumByteDiagAckNack */
+  /* the positive/negative ACK of the last request is built in place */
+  uint8_t ack[DOIP_DIAG_ACK_SIZE];
+  uint16_t ackLen; /* bytes of the request kept in ack */
+  boolean hasAck;
+  /* chunk of the response copied from PduR but not yet accepted by the socket */
+  uint8_t *txBuf;
+  PduLengthType txLen;
+  PduLengthType txOffset;
 } DoIP_MessageContextType;
 
 typedef struct DoIP_Tester_s DoIP_TesterType;
@@ -130,9 +146,14 @@ typedef struct {
   DoIP_RoutineActivationManagerType ramgr;
   uint32_t RAMask; /* maximum 32 Routine can be activated per tester */
   const DoIP_TesterType *TesterRef;
+#ifdef STD_TIMER_WHEEL
+  Std_TimerEntryType inactivityTimer;
+#else
   uint16_t InactivityTimer;
+#endif
   uint16_t AliveCheckResponseTimer;
   boolean isAlive;
+  DoIP_ConnectionStatsType stats;
 } DoIP_TesterConnectionContextType;
 
 typedef struct {
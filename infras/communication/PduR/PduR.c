@@ -11,6 +11,7 @@
 #include "Std_Debug.h"
 #ifdef PDUR_USE_TP_GATEWAY
 #include "PduRMem.h"
+#include "Std_Critical.h"
 #endif
 #include <string.h>
 /* ================================ [ MACROS    ] ============================================== */
@@ -19,34 +20,158 @@
 #define AS_LOG_PDURE 3
 
 #define PDUR_CONFIG (&PduR_Config)
+
+/* time in us the destinations of a gateway path may take to confirm, after that the next message
+ * takes the buffer over, as a destination which never confirms would block the path forever.
+ * Keep it above the TX timeouts of the destinations, e.g. CanTp N_As + N_Bs. */
+#ifndef PDUR_GW_TX_TIMEOUT
+#define PDUR_GW_TX_TIMEOUT 5000000
+#endif
 /* ================================ [ TYPES     ] ============================================== */
 /* ================================ [ DECLARES  ] ============================================== */
 extern const PduR_ConfigType PduR_Config;
 /* ================================ [ DATAS     ] ============================================== */
 /* ================================ [ LOCALS    ] ============================================== */
+#ifdef PDUR_USE_TP_GATEWAY
+static uint16_t PduR_GwUnref(PduR_BufferType *owner) {
+  uint16_t refCount;
+
+  EnterCritical();
+  if (owner->refCount > 0) {
+    owner->refCount--;
+  }
+  refCount = owner->refCount;
+  ExitCritical();
+
+  return refCount;
+}
+
+/* one destination is done with the data, the last one frees it. Nothing is released while the
+ * owner holds no reference, its data is then being received and not transmitted. */
+static void PduR_GwRelease(PduR_BufferType *buffer) {
+  PduR_BufferType *owner = buffer->owner;
+  uint8_t *data = buffer->data;
+  boolean last = FALSE;
+
+  EnterCritical();
+  if (owner->refCount > 0) {
+    buffer->data = NULL;
+    owner->refCount--;
+    last = (0 == owner->refCount);
+  }
+  ExitCritical();
+  if (last) {
+    owner->data = NULL;
+    PduR_MemFree(data);
+  }
+}
+
+/* a destination still transmitting owes its confirmation for the forgotten data */
+static void PduR_GwForgetLeg(PduR_BufferType *view, boolean transmitting) {
+  EnterCritical();
+  if (transmitting && (NULL != view->data)) {
+    view->stale++;
+  }
+  view->data = NULL;
+  ExitCritical();
+}
+
+/* drop the data of the path and of all its fan-out legs, the confirmations the legs still owe for
+ * it are dropped when they come. Returns the data, a leg which already confirmed has cleared its
+ * own pointer. */
+static uint8_t *PduR_GwForget(const PduR_RoutingPathType *RoutingPath) {
+  const PduR_ConfigType *config = PDUR_CONFIG;
+  PduR_BufferType *buffer = RoutingPath->DestTxBufferRef;
+  PduR_BufferType *view;
+  uint8_t *data = buffer->data;
+  boolean transmitting = (buffer->refCount > 0);
+  uint16_t i;
+
+  if (NULL != RoutingPath->DestPathIds) {
+    for (i = 0; i < RoutingPath->numOfDestPdus; i++) {
+      view = config->RoutingPaths[RoutingPath->DestPathIds[i]].DestTxBufferRef;
+      if (NULL == data) {
+        data = view->data;
+      }
+      PduR_GwForgetLeg(view, transmitting);
+    }
+  } else {
+    PduR_GwForgetLeg(buffer, transmitting);
+  }
+  EnterCritical();
+  buffer->refCount = 0;
+  ExitCritical();
+  buffer->data = NULL;
+  buffer->index = 0;
+
+  return data;
+}
+
+/* hand the whole message to an upper layer destination of a fan-out */
+static void PduR_GwDeliver(const PduR_PduType *DestPduRef, const PduInfoType *PduInfo) {
+  const PduR_ApiType *api = DestPduRef->api;
+  BufReq_ReturnType ret = BUFREQ_E_NOT_OK;
+  PduInfoType info;
+  PduLengthType bufferSize = 0;
+  PduLengthType offset = 0;
+
+  if ((NULL != api->StartOfReception) && (NULL != api->CopyRxData) &&
+      (NULL != api->Ind.TpRxIndication)) {
+    info.SduDataPtr = PduInfo->SduDataPtr;
+    info.MetaDataPtr = NULL;
+    info.SduLength = 0;
+    ret = api->StartOfReception(DestPduRef->PduHandleId, &info, PduInfo->SduLength, &bufferSize);
+    while ((BUFREQ_OK == ret) && (offset < PduInfo->SduLength)) {
+      info.SduDataPtr = &PduInfo->SduDataPtr[offset];
+      info.SduLength = PduInfo->SduLength - offset;
+      if (info.SduLength > bufferSize) {
+        info.SduLength = bufferSize;
+      }
+      if (info.SduLength > 0) {
+        offset += info.SduLength;
+        ret = api->CopyRxData(DestPduRef->PduHandleId, &info, &bufferSize);
+      } else {
+        ASLOG(PDURE, ("no rx buffer from destination %d\n", DestPduRef->PduHandleId));
+        ret = BUFREQ_E_OVFL;
+      }
+    }
+    api->Ind.TpRxIndication(DestPduRef->PduHandleId, (BUFREQ_OK == ret) ? E_OK : E_NOT_OK);
+  } else {
+    ASLOG(PDURE, ("null rx API for fan-out\n"));
+  }
+}
+#endif
 /* ================================ [ FUNCTIONS ] ============================================== */
 void PduR_Init(const PduR_ConfigType *ConfigPtr) {
-  #ifdef PDUR_USE_TP_GATEWAY
+#ifdef PDUR_USE_TP_GATEWAY
+  const PduR_ConfigType *config = PDUR_CONFIG;
+  PduR_BufferType *buffer;
+  uint16_t i;
+
   PduR_MemInit();
-  #endif
+  /* the pool is new and the destinations restart too, whatever was in transmission is gone and no
+   * confirmation is owed for it */
+  for (i = 0; i < config->numOfRoutingPaths; i++) {
+    buffer = config->RoutingPaths[i].DestTxBufferRef;
+    if (NULL != buffer) {
+      buffer->data = NULL;
+      buffer->index = 0;
+      buffer->refCount = 0;
+      buffer->stale = 0;
+    }
+  }
+#endif
 }
 
 Std_ReturnType PduR_TpTransmit(PduIdType pathId, const PduInfoType *PduInfoPtr) {
   Std_ReturnType ret = E_NOT_OK;
-  const PduR_ConfigType *config = PDUR_CONFIG;
-  const PduR_PduType *DestPduRef;
-  PduIdType PduHandleId;
+  const PduR_DispatchType *dispatch;
 
   ASLOG(PDUR, ("%s %d\n", __func__, pathId));
-  if (pathId < config->numOfRoutingPaths) {
-    DestPduRef = &config->RoutingPaths[pathId].DestPduRef[0];
-    if (NULL != config->RoutingPaths[pathId].DestTxBufferRef) {
-      PduHandleId = pathId;
-    } else {
-      PduHandleId = DestPduRef->PduHandleId;
-    }
-    if (NULL != DestPduRef->api->Transmit) {
-      ret = DestPduRef->api->Transmit(PduHandleId, PduInfoPtr);
+  if (pathId < PDUR_CONFIG->numOfRoutingPaths) {
+    dispatch = &PDUR_CONFIG->RoutingPaths[pathId].dispatch;
+    if (NULL != dispatch->Transmit) {
+      ret = dispatch->Transmit(dispatch->DestPduHandleId, PduInfoPtr);
     } else {
       ASLOG(PDURE, ("null Transmit\n"));
     }
@@ -58,21 +183,13 @@ Std_ReturnType PduR_TpTransmit(PduIdType pathId, const PduInfoType *PduInfoPtr)
 BufReq_ReturnType PduR_CopyTxData(PduIdType pathId, const PduInfoType *info,
                                   const RetryInfoType *retry, PduLengthType *availableDataPtr) {
   BufReq_ReturnType ret = BUFREQ_E_NOT_OK;
-  const PduR_ConfigType *config = PDUR_CONFIG;
-  PduIdType PduHandleId;
-  const PduR_RoutingPathType *RoutingPath;
+  const PduR_DispatchType *dispatch;
 
   ASLOG(PDUR, ("%s %d\n", __func__, pathId));
-  if (pathId < config->numOfRoutingPaths) {
-    RoutingPath = &config->RoutingPaths[pathId];
-    if (NULL != RoutingPath->DestTxBufferRef) {
-      PduHandleId = pathId;
-    } else {
-      PduHandleId = RoutingPath->SrcPduRef->PduHandleId;
-    }
-
-    if (NULL != RoutingPath->SrcPduRef->api->CopyTxData) {
-      ret = RoutingPath->SrcPduRef->api->CopyTxData(PduHandleId, info, retry, availableDataPtr);
+  if (pathId < PDUR_CONFIG->numOfRoutingPaths) {
+    dispatch = &PDUR_CONFIG->RoutingPaths[pathId].dispatch;
+    if (NULL != dispatch->CopyTxData) {
+      ret = dispatch->CopyTxData(dispatch->SrcPduHandleId, info, retry, availableDataPtr);
     } else {
       ASLOG(PDURE, ("null CopyTxData\n"));
     }
@@ -82,21 +199,13 @@ BufReq_ReturnType PduR_CopyTxData(PduIdType pathId, const PduInfoType *info,
 }
 
 void PduR_TxConfirmation(PduIdType pathId, Std_ReturnType result) {
-  const PduR_ConfigType *config = PDUR_CONFIG;
-  PduIdType PduHandleId;
-  const PduR_RoutingPathType *RoutingPath;
+  const PduR_DispatchType *dispatch;
 
   ASLOG(PDUR, ("%s %d\n", __func__, pathId));
-  if (pathId < config->numOfRoutingPaths) {
-    RoutingPath = &config->RoutingPaths[pathId];
-    if (NULL != RoutingPath->DestTxBufferRef) {
-      PduHandleId = pathId;
-    } else {
-      PduHandleId = RoutingPath->SrcPduRef->PduHandleId;
-    }
-
-    if (NULL != RoutingPath->SrcPduRef->api->TxConfirmation) {
-      RoutingPath->SrcPduRef->api->TxConfirmation(PduHandleId, result);
+  if (pathId < PDUR_CONFIG->numOfRoutingPaths) {
+    dispatch = &PDUR_CONFIG->RoutingPaths[pathId].dispatch;
+    if (NULL != dispatch->TxConfirmation) {
+      dispatch->TxConfirmation(dispatch->SrcPduHandleId, result);
     } else {
       ASLOG(PDURE, ("null TxConfirmation\n"));
     }
@@ -106,20 +215,14 @@ void PduR_TxConfirmation(PduIdType pathId, Std_ReturnType result) {
 BufReq_ReturnType PduR_StartOfReception(PduIdType pathId, const PduInfoType *info,
                                         PduLengthType TpSduLength, PduLengthType *bufferSizePtr) {
   BufReq_ReturnType ret = BUFREQ_E_NOT_OK;
-  const PduR_ConfigType *config = PDUR_CONFIG;
-  const PduR_PduType *DestPduRef;
-  PduIdType PduHandleId;
+  const PduR_DispatchType *dispatch;
 
   ASLOG(PDUR, ("%s %d\n", __func__, pathId));
-  if (pathId < config->numOfRoutingPaths) {
-    DestPduRef = &config->RoutingPaths[pathId].DestPduRef[0];
-    if (NULL != config->RoutingPaths[pathId].DestTxBufferRef) {
-      PduHandleId = pathId;
-    } else {
-      PduHandleId = DestPduRef->PduHandleId;
-    }
-    if (NULL != DestPduRef->api->StartOfReception) {
-      ret = DestPduRef->api->StartOfReception(PduHandleId, info, TpSduLength, bufferSizePtr);
+  if (pathId < PDUR_CONFIG->numOfRoutingPaths) {
+    dispatch = &PDUR_CONFIG->RoutingPaths[pathId].dispatch;
+    if (NULL != dispatch->StartOfReception) {
+      ret = dispatch->StartOfReception(dispatch->DestPduHandleId, info, TpSduLength,
+                                       bufferSizePtr);
     } else {
       ASLOG(PDURE, ("null StartOfReception\n"));
     }
@@ -131,20 +234,13 @@ BufReq_ReturnType PduR_StartOfReception(PduIdType pathId, const PduInfoType *inf
 BufReq_ReturnType PduR_CopyRxData(PduIdType pathId, const PduInfoType *info,
                                   PduLengthType *bufferSizePtr) {
   BufReq_ReturnType ret = BUFREQ_E_NOT_OK;
-  const PduR_ConfigType *config = PDUR_CONFIG;
-  const PduR_PduType *DestPduRef;
-  PduIdType PduHandleId;
+  const PduR_DispatchType *dispatch;
 
   ASLOG(PDUR, ("%s %d\n", __func__, pathId));
-  if (pathId < config->numOfRoutingPaths) {
-    DestPduRef = &config->RoutingPaths[pathId].DestPduRef[0];
-    if (NULL != config->RoutingPaths[pathId].DestTxBufferRef) {
-      PduHandleId = pathId;
-    } else {
-      PduHandleId = DestPduRef->PduHandleId;
-    }
-    if (NULL != DestPduRef->api->CopyRxData) {
-      ret = DestPduRef->api->CopyRxData(PduHandleId, info, bufferSizePtr);
+  if (pathId < PDUR_CONFIG->numOfRoutingPaths) {
+    dispatch = &PDUR_CONFIG->RoutingPaths[pathId].dispatch;
+    if (NULL != dispatch->CopyRxData) {
+      ret = dispatch->CopyRxData(dispatch->DestPduHandleId, info, bufferSizePtr);
     } else {
       ASLOG(PDURE, ("null CopyRxData\n"));
     }
@@ -154,20 +250,13 @@ BufReq_ReturnType PduR_CopyRxData(PduIdType pathId, const PduInfoType *info,
 }
 
 void PduR_TpRxIndication(PduIdType pathId, Std_ReturnType result) {
-  const PduR_ConfigType *config = PDUR_CONFIG;
-  const PduR_PduType *DestPduRef;
-  PduIdType PduHandleId;
+  const PduR_DispatchType *dispatch;
 
   ASLOG(PDUR, ("%s %d\n", __func__, pathId));
-  if (pathId < config->numOfRoutingPaths) {
-    DestPduRef = &config->RoutingPaths[pathId].DestPduRef[0];
-    if (NULL != config->RoutingPaths[pathId].DestTxBufferRef) {
-      PduHandleId = pathId;
-    } else {
-      PduHandleId = DestPduRef->PduHandleId;
-    }
-    if (NULL != DestPduRef->api->Ind.TpRxIndication) {
-      DestPduRef->api->Ind.TpRxIndication(PduHandleId, result);
+  if (pathId < PDUR_CONFIG->numOfRoutingPaths) {
+    dispatch = &PDUR_CONFIG->RoutingPaths[pathId].dispatch;
+    if (NULL != dispatch->TpRxIndication) {
+      dispatch->TpRxIndication(dispatch->DestPduHandleId, result);
     } else {
       ASLOG(PDURE, ("null TpRxIndication\n"));
     }
@@ -185,10 +274,14 @@ BufReq_ReturnType PduR_GwCopyTxData(PduIdType pathId, const PduInfoType *info,
       (NULL != config->RoutingPaths[pathId].DestTxBufferRef)) {
     buffer = config->RoutingPaths[pathId].DestTxBufferRef;
     if (NULL != buffer->data) {
-      memcpy(info->SduDataPtr, &buffer->data[buffer->index], info->SduLength);
-      buffer->index += info->SduLength;
-      *availableDataPtr = buffer->size - buffer->index;
-      ret = BUFREQ_OK;
+      if (info->SduLength <= (buffer->size - buffer->index)) {
+        memcpy(info->SduDataPtr, &buffer->data[buffer->index], info->SduLength);
+        buffer->index += info->SduLength;
+        *availableDataPtr = buffer->size - buffer->index;
+        ret = BUFREQ_OK;
+      } else {
+        ASLOG(PDURE, ("Buffer Underflow\n"));
+      }
     }
   }
   return ret;
@@ -197,14 +290,24 @@ BufReq_ReturnType PduR_GwCopyTxData(PduIdType pathId, const PduInfoType *info,
 void PduR_GwTxConfirmation(PduIdType pathId, Std_ReturnType result) {
   const PduR_ConfigType *config = PDUR_CONFIG;
   PduR_BufferType *buffer;
+  boolean stale = FALSE;
 
   ASLOG(PDUR, ("%s %d\n", __func__, pathId));
   if ((pathId < config->numOfRoutingPaths) &&
       (NULL != config->RoutingPaths[pathId].DestTxBufferRef)) {
     buffer = config->RoutingPaths[pathId].DestTxBufferRef;
-    if (NULL != buffer->data) {
-      PduR_MemFree(buffer->data);
-      buffer->data = NULL;
+    EnterCritical();
+    if (buffer->stale > 0) {
+      buffer->stale--;
+      stale = TRUE;
+    }
+    ExitCritical();
+    if (stale) {
+      ASLOG(PDURE, ("path %d: late confirmation of a dropped message\n", pathId));
+    } else if (NULL != buffer->data) {
+      PduR_GwRelease(buffer);
+    } else {
+      /* do nothing */
     }
   }
 }
@@ -214,20 +317,33 @@ BufReq_ReturnType PduR_GwStartOfReception(PduIdType pathId, const PduInfoType *i
   BufReq_ReturnType ret = BUFREQ_E_NOT_OK;
   const PduR_ConfigType *config = PDUR_CONFIG;
   PduR_BufferType *buffer;
+  uint8_t *data;
 
   ASLOG(PDUR, ("%s %d\n", __func__, pathId));
   if ((pathId < config->numOfRoutingPaths) &&
       (NULL != config->RoutingPaths[pathId].DestTxBufferRef)) {
     buffer = config->RoutingPaths[pathId].DestTxBufferRef;
-    if (buffer->data != NULL) {
-      PduR_MemFree(buffer->data);
+    if ((buffer->refCount > 0) && (Std_GetTimerElapsedTime(&buffer->timer) >= PDUR_GW_TX_TIMEOUT)) {
+      ASLOG(PDURE, ("path %d: destinations did not confirm in time, drop that message\n", pathId));
+      data = PduR_GwForget(&config->RoutingPaths[pathId]);
+      if (NULL != data) {
+        PduR_MemFree(data);
+      }
     }
-    buffer->data = PduR_MemAlloc(TpSduLength);
-    if (NULL != buffer->data) {
-      buffer->size = TpSduLength;
-      buffer->index = 0;
-      *bufferSizePtr = TpSduLength;
-      ret = BUFREQ_OK;
+    if (buffer->refCount > 0) {
+      ASLOG(PDURE, ("previous message still in transmission\n"));
+      ret = BUFREQ_E_BUSY;
+    } else {
+      if (buffer->data != NULL) {
+        PduR_MemFree(buffer->data);
+      }
+      buffer->data = PduR_MemAlloc(TpSduLength);
+      if (NULL != buffer->data) {
+        buffer->size = TpSduLength;
+        buffer->index = 0;
+        *bufferSizePtr = TpSduLength;
+        ret = BUFREQ_OK;
+      }
     }
   }
   return ret;
@@ -260,32 +376,59 @@ BufReq_ReturnType PduR_GwCopyRxData(PduIdType pathId, const PduInfoType *info,
 
 void PduR_GwRxIndication(PduIdType pathId, Std_ReturnType result) {
   const PduR_ConfigType *config = PDUR_CONFIG;
+  const PduR_RoutingPathType *RoutingPath;
   PduR_BufferType *buffer;
+  PduR_BufferType *view;
   const PduR_PduType *DestPduRef;
   PduInfoType PduInfo;
-  Std_ReturnType ret = E_NOT_OK;
+  Std_ReturnType ret;
+  uint16_t i;
 
   ASLOG(PDUR, ("%s %d\n", __func__, pathId));
   if ((pathId < config->numOfRoutingPaths) &&
       (NULL != config->RoutingPaths[pathId].DestTxBufferRef)) {
-    DestPduRef = &config->RoutingPaths[pathId].DestPduRef[0];
-    buffer = config->RoutingPaths[pathId].DestTxBufferRef;
+    RoutingPath = &config->RoutingPaths[pathId];
+    buffer = RoutingPath->DestTxBufferRef;
     if ((E_OK == result) && (NULL != buffer->data)) {
-      if (NULL != DestPduRef->api->Transmit) {
-        PduInfo.SduDataPtr = buffer->data;
-        PduInfo.SduLength = buffer->size;
-        PduInfo.MetaDataPtr = NULL;
-        buffer->index = 0;
-        ret = DestPduRef->api->Transmit(DestPduRef->PduHandleId, &PduInfo);
-      } else {
-        ASLOG(PDURE, ("null Transmit\n"));
+      PduInfo.SduDataPtr = buffer->data;
+      PduInfo.SduLength = buffer->size;
+      PduInfo.MetaDataPtr = NULL;
+      /* hold one reference until all destinations are started, as a destination may confirm
+       * before the next one is started */
+      buffer->refCount = 1;
+      Std_TimerStart(&buffer->timer);
+      for (i = 0; i < RoutingPath->numOfDestPdus; i++) {
+        DestPduRef = &RoutingPath->DestPduRef[i];
+        if (NULL != DestPduRef->api->Transmit) {
+          if (NULL != RoutingPath->DestPathIds) {
+            view = config->RoutingPaths[RoutingPath->DestPathIds[i]].DestTxBufferRef;
+          } else {
+            view = buffer;
+          }
+          view->data = PduInfo.SduDataPtr;
+          view->size = PduInfo.SduLength;
+          view->index = 0;
+          EnterCritical();
+          buffer->refCount++;
+          ExitCritical();
+          ret = DestPduRef->api->Transmit(DestPduRef->PduHandleId, &PduInfo);
+          if (E_OK != ret) {
+            ASLOG(PDURE, ("Transmit to destination %d failed\n", DestPduRef->PduHandleId));
+            PduR_GwRelease(view);
+          }
+        } else {
+          PduR_GwDeliver(DestPduRef, &PduInfo);
+        }
       }
-    }
-    if (E_NOT_OK == ret) {
-      if (NULL != buffer->data) {
-        PduR_MemFree(buffer->data);
+      if (0 == PduR_GwUnref(buffer)) {
         buffer->data = NULL;
+        PduR_MemFree(PduInfo.SduDataPtr);
       }
+    } else if (NULL != buffer->data) {
+      PduR_MemFree(buffer->data);
+      buffer->data = NULL;
+    } else {
+      /* do nothing */
     }
   }
 }
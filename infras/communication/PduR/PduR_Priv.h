@@ -8,6 +8,7 @@
 #define _PDUR_PRIV_H_
 /* ================================ [ INCLUDES  ] ============================================== */
 #include "ComStack_Types.h"
+#include "Std_Timer.h"
 /* ================================ [ MACROS    ] ============================================== */
 /* ================================ [ TYPES     ] ============================================== */
 
@@ -53,18 +54,45 @@ typedef struct {
   const PduR_ApiType *api;
 } PduR_PduType;
 
-typedef struct {
+typedef struct PduR_Buffer_s {
   uint8_t* data;
   PduLengthType size;
   PduLengthType index;
+  /* destinations still transmitting from the data, only counted in the owner */
+  uint16_t refCount;
+  /* the buffer of the routing path which received the data, itself if not a fan-out leg */
+  struct PduR_Buffer_s *owner;
+  /* started when the destinations are started, only used in the owner */
+  Std_TimerType timer;
+  /* confirmations this destination still owes for messages the path gave up on, they are dropped
+   * when they come as they are not for the data in the buffer now */
+  uint16_t stale;
 } PduR_BufferType;
 
+/* the APIs of one routing path resolved at generation time */
+typedef struct {
+  PduIdType DestPduHandleId;
+  PduIdType SrcPduHandleId;
+  Std_ReturnType (*Transmit)(PduIdType id, const PduInfoType *PduInfoPtr);
+  BufReq_ReturnType (*StartOfReception)(PduIdType id, const PduInfoType *info,
+                                        PduLengthType TpSduLength, PduLengthType *bufferSizePtr);
+  BufReq_ReturnType (*CopyRxData)(PduIdType id, const PduInfoType *info,
+                                  PduLengthType *bufferSizePtr);
+  void (*TpRxIndication)(PduIdType id, Std_ReturnType result);
+  BufReq_ReturnType (*CopyTxData)(PduIdType id, const PduInfoType *info, const RetryInfoType *retry,
+                                  PduLengthType *availableDataPtr);
+  void (*TxConfirmation)(PduIdType id, Std_ReturnType result);
+} PduR_DispatchType;
+
 /* @ECUC_PduR_00248 */
 typedef struct {
   const PduR_PduType *SrcPduRef;
   const PduR_PduType *DestPduRef; /* @ECUC_PduR_00354 */
   uint16_t numOfDestPdus;
   PduR_BufferType *DestTxBufferRef; /* @ECUC_PduR_00304 */
+  PduR_DispatchType dispatch;
+  /* the routing path of each destination for a fan-out, NULL if only one destination */
+  const PduIdType *DestPathIds;
 } PduR_RoutingPathType;
 
 struct PduR_Config_s {
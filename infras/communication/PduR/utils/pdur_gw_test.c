@@ -0,0 +1,338 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2026 Parai Wang <parai@foxmail.com>
+ *
+ * Drive the TP gateway fan-out of utils/config with stub CanTp/Dcm destinations: every leg gets
+ * the whole message, the buffer is freed once by the last confirmation, and a confirmation which
+ * comes after the path gave the message up does not touch the next message.
+ */
+/* ================================ [ INCLUDES  ] ============================================== */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "PduR.h"
+#include "PduR_Priv.h"
+#include "PduR_Cfg.h"
+#include "PduRMem.h"
+#include "CanTp.h"
+#include "Dcm.h"
+/* ================================ [ MACROS    ] ============================================== */
+#define TEST_MAX_LEGS 8
+#define TEST_MAX_ALLOCS 64
+/* the PDUR_GW_TX_TIMEOUT default */
+#define TEST_GW_TX_TIMEOUT 5000000
+
+#define TEST_CHECK(cond)                                                                           \
+  do {                                                                                             \
+    if (!(cond)) {                                                                                 \
+      printf("  FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);                                     \
+      test_errors++;                                                                               \
+    }                                                                                              \
+  } while (0)
+/* ================================ [ TYPES     ] ============================================== */
+typedef struct {
+  uint8_t *data;
+  uint32_t size;
+  boolean freed;
+} test_alloc_t;
+/* ================================ [ DECLARES  ] ============================================== */
+extern const PduR_ConfigType PduR_Config;
+/* ================================ [ DATAS     ] ============================================== */
+static int test_errors;
+static std_time_t test_now;
+/* every block stays allocated and poisoned once freed, so a use after free shows in the data */
+static test_alloc_t test_allocs[TEST_MAX_ALLOCS];
+static int test_numOfAllocs;
+
+static const PduR_RoutingPathType *test_primary;
+static PduIdType test_primaryId;
+/* per destination of the primary: transmits accepted by the stub CanTp */
+static int test_transmits[TEST_MAX_LEGS];
+/* what the stub Dcm got */
+static uint8_t test_dcmData[4096];
+static PduLengthType test_dcmLength;
+static int test_dcmIndications;
+/* ================================ [ LOCALS    ] ============================================== */
+static int test_live(void) {
+  int live = 0;
+  int i;
+
+  for (i = 0; i < test_numOfAllocs; i++) {
+    if (FALSE == test_allocs[i].freed) {
+      live++;
+    }
+  }
+
+  return live;
+}
+
+static void test_fill(uint8_t *data, PduLengthType length, uint8_t seed) {
+  PduLengthType i;
+
+  for (i = 0; i < length; i++) {
+    data[i] = (uint8_t)(seed + i * 7);
+  }
+}
+
+static boolean test_match(const uint8_t *data, PduLengthType length, uint8_t seed) {
+  PduLengthType i;
+  boolean match = TRUE;
+
+  for (i = 0; (i < length) && match; i++) {
+    match = (data[i] == (uint8_t)(seed + i * 7));
+  }
+
+  return match;
+}
+
+static int test_legOf(PduIdType CanTpId) {
+  int leg = -1;
+  uint16_t i;
+
+  for (i = 0; (i < test_primary->numOfDestPdus) && (leg < 0); i++) {
+    if ((PDUR_MODULE_CANTP == test_primary->DestPduRef[i].Module) &&
+        (CanTpId == test_primary->DestPduRef[i].PduHandleId)) {
+      leg = i;
+    }
+  }
+
+  return leg;
+}
+
+/* receive the bytes from..upTo of a message of length bytes on the primary path in pieces of 7
+ * bytes, the reception starts at 0 and is indicated once all bytes are in */
+static BufReq_ReturnType test_receive(PduLengthType length, uint8_t seed, PduLengthType from,
+                                      PduLengthType upTo) {
+  static uint8_t message[4096];
+  BufReq_ReturnType ret = BUFREQ_OK;
+  PduInfoType info;
+  PduLengthType bufferSize = 0;
+  PduLengthType offset = from;
+
+  test_fill(message, length, seed);
+  info.SduDataPtr = message;
+  info.MetaDataPtr = NULL;
+  info.SduLength = 0;
+  if (0 == from) {
+    ret = PduR_GwStartOfReception(test_primaryId, &info, length, &bufferSize);
+  }
+  while ((BUFREQ_OK == ret) && (offset < upTo)) {
+    info.SduDataPtr = &message[offset];
+    info.SduLength = ((upTo - offset) > 7) ? 7 : (upTo - offset);
+    offset += info.SduLength;
+    ret = PduR_GwCopyRxData(test_primaryId, &info, &bufferSize);
+  }
+  if ((BUFREQ_OK == ret) && (upTo >= length)) {
+    PduR_GwRxIndication(test_primaryId, E_OK);
+  }
+
+  return ret;
+}
+
+/* a CanTp destination reads the whole message, returns TRUE if it is the one with the seed */
+static boolean test_readLeg(uint16_t leg, PduLengthType length, uint8_t seed) {
+  uint8_t data[4096];
+  PduInfoType info;
+  PduLengthType available = 0;
+  PduLengthType offset = 0;
+  BufReq_ReturnType ret = BUFREQ_OK;
+  PduIdType pathId = test_primary->DestPathIds[leg];
+
+  while ((BUFREQ_OK == ret) && (offset < length)) {
+    info.SduDataPtr = &data[offset];
+    info.MetaDataPtr = NULL;
+    info.SduLength = ((length - offset) > 6) ? 6 : (length - offset);
+    ret = PduR_GwCopyTxData(pathId, &info, NULL, &available);
+    offset += info.SduLength;
+  }
+
+  return (BUFREQ_OK == ret) && test_match(data, length, seed);
+}
+
+static void test_confirm(uint16_t leg) {
+  PduR_GwTxConfirmation(test_primary->DestPathIds[leg], E_OK);
+}
+
+static void test_fanOut(void) {
+  uint16_t i;
+  int legs = 0;
+
+  printf("fan-out of one message to all destinations\n");
+  memset(test_transmits, 0, sizeof(test_transmits));
+  test_dcmIndications = 0;
+  TEST_CHECK(BUFREQ_OK == test_receive(100, 1, 0, 100));
+  for (i = 0; i < test_primary->numOfDestPdus; i++) {
+    if (NULL != test_primary->DestPduRef[i].api->Transmit) {
+      TEST_CHECK(1 == test_transmits[i]);
+      TEST_CHECK(test_readLeg(i, 100, 1));
+      legs++;
+    }
+  }
+  TEST_CHECK(1 == test_dcmIndications);
+  TEST_CHECK((100 == test_dcmLength) && test_match(test_dcmData, 100, 1));
+  TEST_CHECK(legs >= 2);
+  /* a new message is refused until every leg confirmed */
+  TEST_CHECK(BUFREQ_E_BUSY == test_receive(50, 2, 0, 0));
+  for (i = 0; i < test_primary->numOfDestPdus; i++) {
+    if (NULL != test_primary->DestPduRef[i].api->Transmit) {
+      TEST_CHECK(1 == test_live());
+      test_confirm(i);
+    }
+  }
+  TEST_CHECK(0 == test_live());
+}
+
+static void test_lateConfirmation(void) {
+  uint16_t i;
+  uint16_t late = 0xFFFF;
+
+  printf("late confirmation after the path dropped the message\n");
+  TEST_CHECK(BUFREQ_OK == test_receive(100, 3, 0, 100));
+  /* the first CanTp leg, the one on the path which owns the buffer, hangs, the others confirm */
+  for (i = 0; i < test_primary->numOfDestPdus; i++) {
+    if (NULL != test_primary->DestPduRef[i].api->Transmit) {
+      if (0xFFFF == late) {
+        late = i;
+      } else {
+        test_confirm(i);
+      }
+    }
+  }
+  test_now += TEST_GW_TX_TIMEOUT + 1;
+  /* the next message takes the buffer over, half received when the hung leg confirms */
+  TEST_CHECK(BUFREQ_OK == test_receive(200, 4, 0, 100));
+  TEST_CHECK(1 == test_live());
+  test_confirm(late);
+  TEST_CHECK(1 == test_live());
+  TEST_CHECK(BUFREQ_OK == test_receive(200, 4, 100, 200));
+  for (i = 0; i < test_primary->numOfDestPdus; i++) {
+    if (NULL != test_primary->DestPduRef[i].api->Transmit) {
+      TEST_CHECK(test_readLeg(i, 200, 4));
+      test_confirm(i);
+    }
+  }
+  TEST_CHECK(0 == test_live());
+
+  /* and the same while the next message is in transmission */
+  TEST_CHECK(BUFREQ_OK == test_receive(100, 5, 0, 100));
+  test_now += TEST_GW_TX_TIMEOUT + 1;
+  TEST_CHECK(BUFREQ_OK == test_receive(300, 6, 0, 300));
+  /* every leg of the dropped message owes one confirmation, they come now */
+  for (i = 0; i < test_primary->numOfDestPdus; i++) {
+    if (NULL != test_primary->DestPduRef[i].api->Transmit) {
+      test_confirm(i);
+    }
+  }
+  TEST_CHECK(1 == test_live());
+  for (i = 0; i < test_primary->numOfDestPdus; i++) {
+    if (NULL != test_primary->DestPduRef[i].api->Transmit) {
+      TEST_CHECK(test_readLeg(i, 300, 6));
+      test_confirm(i);
+    }
+  }
+  TEST_CHECK(0 == test_live());
+}
+/* ================================ [ FUNCTIONS ] ============================================== */
+std_time_t Std_GetTime(void) {
+  return test_now;
+}
+
+void PduR_MemInit(void) {
+}
+
+uint8_t *PduR_MemAlloc(uint32_t size) {
+  uint8_t *data = NULL;
+
+  if (test_numOfAllocs < TEST_MAX_ALLOCS) {
+    data = malloc(size);
+    test_allocs[test_numOfAllocs].data = data;
+    test_allocs[test_numOfAllocs].size = size;
+    test_allocs[test_numOfAllocs].freed = FALSE;
+    test_numOfAllocs++;
+  }
+
+  return data;
+}
+
+void PduR_MemFree(uint8_t *buffer) {
+  int i;
+  int found = -1;
+
+  for (i = 0; (i < test_numOfAllocs) && (found < 0); i++) {
+    if (buffer == test_allocs[i].data) {
+      found = i;
+    }
+  }
+  if ((found < 0) || test_allocs[found].freed) {
+    printf("  FAIL free of %p which is not allocated\n", buffer);
+    test_errors++;
+  } else {
+    memset(buffer, 0xA5, test_allocs[found].size);
+    test_allocs[found].freed = TRUE;
+  }
+}
+
+Std_ReturnType CanTp_Transmit(PduIdType TxPduId, const PduInfoType *PduInfoPtr) {
+  Std_ReturnType ret = E_NOT_OK;
+  int leg = test_legOf(TxPduId);
+
+  if (leg >= 0) {
+    test_transmits[leg]++;
+    ret = E_OK;
+  }
+
+  return ret;
+}
+
+BufReq_ReturnType Dcm_StartOfReception(PduIdType id, const PduInfoType *info,
+                                       PduLengthType TpSduLength, PduLengthType *bufferSizePtr) {
+  test_dcmLength = 0;
+  *bufferSizePtr = 16;
+
+  return (TpSduLength <= sizeof(test_dcmData)) ? BUFREQ_OK : BUFREQ_E_OVFL;
+}
+
+BufReq_ReturnType Dcm_CopyRxData(PduIdType id, const PduInfoType *info,
+                                 PduLengthType *bufferSizePtr) {
+  memcpy(&test_dcmData[test_dcmLength], info->SduDataPtr, info->SduLength);
+  test_dcmLength += info->SduLength;
+  *bufferSizePtr = 16;
+
+  return BUFREQ_OK;
+}
+
+void Dcm_TpRxIndication(PduIdType id, Std_ReturnType result) {
+  test_dcmIndications++;
+}
+
+BufReq_ReturnType Dcm_CopyTxData(PduIdType id, const PduInfoType *info, const RetryInfoType *retry,
+                                 PduLengthType *availableDataPtr) {
+  return BUFREQ_E_NOT_OK;
+}
+
+void Dcm_TpTxConfirmation(PduIdType id, Std_ReturnType result) {
+}
+
+int main(int argc, char *argv[]) {
+  const PduR_ConfigType *config = &PduR_Config;
+  uint16_t i;
+
+  for (i = 0; (i < config->numOfRoutingPaths) && (NULL == test_primary); i++) {
+    if (NULL != config->RoutingPaths[i].DestPathIds) {
+      test_primary = &config->RoutingPaths[i];
+      test_primaryId = i;
+    }
+  }
+  if ((NULL == test_primary) || (test_primary->numOfDestPdus > TEST_MAX_LEGS)) {
+    printf("no fan-out in the configuration\n");
+    return -1;
+  }
+
+  PduR_Init(NULL);
+  test_fanOut();
+  test_lateConfirmation();
+
+  printf("%s, %d errors\n", (0 == test_errors) ? "PASS" : "FAIL", test_errors);
+
+  return (0 == test_errors) ? 0 : -1;
+}
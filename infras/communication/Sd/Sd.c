@@ -14,7 +14,6 @@
 #include "TcpIp.h"
 #include "Std_Critical.h"
 
-#include <stdlib.h>
 #include <string.h>
 /* ================================ [ MACROS    ] ============================================== */
 #define AS_LOG_SD 0
@@ -81,6 +80,10 @@
 
 #define SD_CONFIG (&Sd_Config)
 
+#ifndef SD_MAIN_FUNCTION_PERIOD
+#define SD_MAIN_FUNCTION_PERIOD 10
+#endif
+
 #define SD_FIND_SERVICE 0x00
 #define SD_OFFER_SERVICE 0x01
 
@@ -90,6 +93,16 @@
 #define SD_SUBSCRIBE_EVENT_GROUP 0x06
 #define SD_SUBSCRIBE_EVENT_GROUP_ACK 0x07
 #define SD_SUBSCRIBE_EVENT_GROUP_NACK 0x07
+
+/* max number of different options in one SD message built by Sd_TxMsgNewEntry */
+#ifndef SD_TX_OPTIONS_MAX
+#define SD_TX_OPTIONS_MAX 16
+#endif
+
+/* max number of entries with pending flags in one SD message built by Sd_TxMsgNewEntry */
+#ifndef SD_TX_ENTRIES_MAX
+#define SD_TX_ENTRIES_MAX 64
+#endif
 /* ================================ [ TYPES     ] ==============================================
  */
 typedef struct {
@@ -121,21 +134,84 @@ typedef struct {
   TcpIp_ProtocolType ProtocolType;
   TcpIp_SockAddrType Addr;
 } Sd_OptionIPv4Type;
+
+/* an unicast SD message being built in Instance->buffer: the entries are placed in the buffer
+ * directly, the options are collected here so that entries can share the same option */
+typedef struct {
+  const Sd_InstanceType *Instance;
+  TcpIp_SockAddrType RemoteAddr;
+  uint32_t lengthOfEntries;
+  uint8_t options[SD_TX_OPTIONS_MAX][12];
+  uint8_t numOfOptions;
+  /* the pending flags to be cleared once the message is sent */
+  uint8_t *flags[SD_TX_ENTRIES_MAX];
+  uint8_t masks[SD_TX_ENTRIES_MAX];
+  uint8_t numOfFlags;
+} Sd_TxMsgType;
 /* ================================ [ DECLARES  ] ============================================== */
 extern const Sd_ConfigType Sd_Config;
 
 static void Sd_InitClientServiceConsumedEventGroups(const Sd_ClientServiceType *config);
+#ifdef STD_TIMER_WHEEL
+static void Sd_ClientServiceTTLTimeout(void *param);
+static void Sd_ServerServiceOfferTimeout(void *param);
+#endif
 /* ================================ [ DATAS     ] ============================================== */
+static uint32_t sd_randSeed = 0x2545F491u;
 /* ================================ [ LOCALS    ] ============================================== */
+/* mix the local addresses into the seed, so that ECUs running the same image and booting together
+ * pick different initial delays */
+static void Sd_RandMix(const uint8_t *data, uint32_t length) {
+  uint32_t i;
+
+  for (i = 0; i < length; i++) {
+    sd_randSeed = (sd_randSeed ^ data[i]) * 16777619u;
+  }
+
+  if (0 == sd_randSeed) {
+    sd_randSeed = 0x2545F491u;
+  }
+}
+
 static uint16_t Sd_RandTime(uint16_t min, uint16_t max) {
   uint16_t ret;
   int range = max - min + 1;
 
-  ret = min + ((uint16_t)rand()) % range;
+  /* xorshift32 */
+  sd_randSeed ^= sd_randSeed << 13;
+  sd_randSeed ^= sd_randSeed >> 17;
+  sd_randSeed ^= sd_randSeed << 5;
+  ret = min + (uint16_t)(sd_randSeed % range);
 
   return ret;
 }
 
+/* set the pending flag of an offer/find, it is counted as a duplicate if not yet sent */
+static void Sd_SetPending(const Sd_InstanceType *Instance, uint16_t *flags, uint16_t mask) {
+  if (*flags & mask) {
+    Instance->context->stats.suppressedDuplicates++;
+  } else {
+    SD_SET(*flags, mask);
+  }
+}
+
+static void Sd_CountTx(const Sd_InstanceType *Instance, boolean isMulticast,
+                       uint32_t numOfEntries) {
+  Sd_StatisticsType *stats = &Instance->context->stats;
+
+  if (isMulticast) {
+    stats->multicastMessages++;
+    stats->multicastEntries += numOfEntries;
+  } else {
+    stats->unicastMessages++;
+    stats->unicastEntries += numOfEntries;
+  }
+
+  if (numOfEntries > stats->maxEntriesPerMessage) {
+    stats->maxEntriesPerMessage = (uint16_t)numOfEntries;
+  }
+}
+
 static void Sd_BuildHeader(uint8_t *header, uint8_t flags, uint16_t sessionId,
                            uint32_t lengthOfEntries, uint32_t lengthOfOptions) {
   uint32_t length = 20 + lengthOfEntries + lengthOfOptions;
@@ -326,6 +402,235 @@ static void Sd_BuildOptionIPv4Multicast(uint8_t *option, TcpIp_SockAddrType *Loc
   Sd_BuildOptionIPv4(option, SD_OPT_IP4_MULTICAST, LocalAddrPtr, ProtocolType);
 }
 
+static void Sd_NextSessionId(const Sd_InstanceType *Instance) {
+  Instance->context->multicastSessionId++;
+  if (0 == Instance->context->multicastSessionId) {
+    Instance->context->multicastSessionId = 1;
+    Instance->context->flags &= ~SD_REBOOT_FLAG;
+  }
+}
+
+static void Sd_TxMsgInit(Sd_TxMsgType *msg, const Sd_InstanceType *Instance,
+                         const TcpIp_SockAddrType *RemoteAddr) {
+  msg->Instance = Instance;
+  msg->RemoteAddr = *RemoteAddr;
+  msg->lengthOfEntries = 0;
+  msg->numOfOptions = 0;
+  msg->numOfFlags = 0;
+}
+
+static Std_ReturnType Sd_TxMsgSend(Sd_TxMsgType *msg) {
+  const Sd_InstanceType *Instance = msg->Instance;
+  uint32_t lengthOfOptions = 12 * (uint32_t)msg->numOfOptions;
+  PduInfoType pduInfo;
+  Std_ReturnType ret = E_OK;
+  int i;
+
+  if (msg->lengthOfEntries > 0) {
+    memcpy(&Instance->buffer[28 + msg->lengthOfEntries], msg->options, lengthOfOptions);
+    Sd_BuildHeader(Instance->buffer, Instance->context->flags,
+                   Instance->context->multicastSessionId, msg->lengthOfEntries, lengthOfOptions);
+    Sd_NextSessionId(Instance);
+    pduInfo.MetaDataPtr = (uint8_t *)&msg->RemoteAddr;
+    pduInfo.SduDataPtr = Instance->buffer;
+    pduInfo.SduLength = 28 + msg->lengthOfEntries + lengthOfOptions;
+    ret = SoAd_IfTransmit(Instance->TxPdu.UnicastTxPduId, &pduInfo);
+    if (E_OK == ret) {
+      Sd_CountTx(Instance, FALSE, msg->lengthOfEntries / 16);
+      for (i = 0; i < msg->numOfFlags; i++) {
+        SD_CLEAR(*msg->flags[i], msg->masks[i]);
+      }
+    } else { /* flags kept pending, retry next time */
+      ASLOG(SDE, ("[%s] Tx %d entries failed\n", Instance->Hostname, msg->lengthOfEntries / 16));
+    }
+  }
+
+  msg->lengthOfEntries = 0;
+  msg->numOfOptions = 0;
+  msg->numOfFlags = 0;
+
+  return ret;
+}
+
+/* reserve one entry which refers to the option if not NULL, the message is sent out first if it
+ * is full. The flags will be cleared by mask once the message is sent. */
+static uint8_t *Sd_TxMsgNewEntry(Sd_TxMsgType *msg, const uint8_t *option, uint8_t *indexOfOpt,
+                                 uint8_t *flags, uint8_t mask) {
+  const Sd_InstanceType *Instance = msg->Instance;
+  uint8_t *entry;
+  uint8_t index = 0;
+  uint32_t numOfNewOpt = 0;
+
+  if (NULL != option) {
+    while ((index < msg->numOfOptions) && (0 != memcmp(msg->options[index], option, 12))) {
+      index++;
+    }
+    if (index == msg->numOfOptions) {
+      numOfNewOpt = 1;
+    }
+  }
+
+  if (((msg->numOfOptions + numOfNewOpt) > SD_TX_OPTIONS_MAX) ||
+      ((NULL != flags) && (msg->numOfFlags >= SD_TX_ENTRIES_MAX)) ||
+      ((28 + msg->lengthOfEntries + 16 + 12 * (msg->numOfOptions + numOfNewOpt)) >
+       Instance->bufLen)) {
+    (void)Sd_TxMsgSend(msg);
+    index = 0;
+    numOfNewOpt = (NULL != option) ? 1 : 0;
+  }
+
+  if (numOfNewOpt > 0) {
+    memcpy(msg->options[index], option, 12);
+    msg->numOfOptions++;
+  }
+
+  if (NULL != flags) {
+    msg->flags[msg->numOfFlags] = flags;
+    msg->masks[msg->numOfFlags] = mask;
+    msg->numOfFlags++;
+  }
+
+  entry = &Instance->buffer[24 + msg->lengthOfEntries];
+  msg->lengthOfEntries += 16;
+  *indexOfOpt = index;
+
+  return entry;
+}
+
+static void Sd_TxMsgAddOffer(Sd_TxMsgType *msg, const Sd_ServerServiceType *config) {
+  TcpIp_SockAddrType LocalAddr;
+  uint8_t option[12];
+  uint8_t *entry;
+  uint8_t index;
+
+  (void)SoAd_GetLocalAddr(config->SoConId, &LocalAddr, NULL, NULL);
+  Sd_BuildOptionIPv4Endpoint(option, &LocalAddr, config->ProtocolType);
+  entry = Sd_TxMsgNewEntry(msg, option, &index, NULL, 0);
+  Sd_BuildEntryType1(entry, SD_OFFER_SERVICE, index, 0, 1, 0, config->ServiceId,
+                     config->InstanceId, config->MajorVersion, config->MinorVersion,
+                     config->ServerTimer->TTL);
+}
+
+static void Sd_TxMsgAddSubscribeAck(Sd_TxMsgType *msg, const Sd_ServerServiceType *config,
+                                    const Sd_EventHandlerType *EventHandler,
+                                    Sd_EventHandlerSubscriberType *sub) {
+  TcpIp_SockAddrType MulticastAddr;
+  uint8_t option[12];
+  uint8_t *entry;
+  uint8_t index;
+  uint8_t numOfOptions = 0;
+
+  if ((NULL != EventHandler->MulticastAddr) && (EventHandler->MulticastThreshold > 0)) {
+    MulticastAddr = *EventHandler->MulticastAddr;
+    Sd_BuildOptionIPv4Multicast(option, &MulticastAddr, TCPIP_IPPROTO_UDP);
+    numOfOptions = 1;
+  }
+  entry = Sd_TxMsgNewEntry(msg, (numOfOptions > 0) ? option : NULL, &index, &sub->flags,
+                           SD_FLG_PENDING_EVENT_GROUP_ACK);
+  Sd_BuildEntryType2(entry, SD_SUBSCRIBE_EVENT_GROUP_ACK, index, 0, numOfOptions, 0,
+                     config->ServiceId, config->InstanceId, config->MajorVersion, 0,
+                     EventHandler->EventGroupId, config->ServerTimer->TTL);
+}
+
+static void Sd_TxMsgAddSubscribe(Sd_TxMsgType *msg, const Sd_ClientServiceType *config,
+                                 const Sd_ConsumedEventGroupType *ConsumedEventGroup) {
+  TcpIp_SockAddrType LocalAddr;
+  uint8_t option[12];
+  uint8_t *entry;
+  uint8_t index;
+  uint32_t TTL = 0;
+
+  if (0 == (ConsumedEventGroup->context->flags & SD_FLG_PENDING_STOP_SUBSCRIBE)) {
+    TTL = config->ClientTimer->TTL;
+  } else {
+    /* send stop */
+  }
+
+  (void)SoAd_GetLocalAddr(config->SoConId, &LocalAddr, NULL, NULL);
+  Sd_BuildOptionIPv4Endpoint(option, &LocalAddr, config->ProtocolType);
+  entry = Sd_TxMsgNewEntry(msg, option, &index, &ConsumedEventGroup->context->flags,
+                           SD_FLG_PENDING_SUBSCRIBE | SD_FLG_PENDING_STOP_SUBSCRIBE);
+  Sd_BuildEntryType2(entry, SD_SUBSCRIBE_EVENT_GROUP, index, 0, 1, 0, config->ServiceId,
+                     config->InstanceId, config->MajorVersion, 0, ConsumedEventGroup->EventGroupId,
+                     TTL);
+}
+
+static uint16_t Sd_ServiceHash(uint16_t serviceId) {
+  return (serviceId ^ (serviceId >> 8)) & (SD_SERVICE_HASH_SIZE - 1);
+}
+
+static void Sd_InitServiceHash(const Sd_InstanceType *Instance) {
+  int i;
+  uint16_t h;
+
+  memset(Instance->context->serverHash, 0, sizeof(Instance->context->serverHash));
+  memset(Instance->context->clientHash, 0, sizeof(Instance->context->clientHash));
+  /* linked in reverse order so that each bucket is in the configuration order */
+  for (i = (int)Instance->numOfServerServices - 1; i >= 0; i--) {
+    h = Sd_ServiceHash(Instance->ServerServices[i].ServiceId);
+    Instance->ServerServices[i].context->hnext = Instance->context->serverHash[h];
+    Instance->context->serverHash[h] = (uint16_t)(i + 1);
+  }
+  for (i = (int)Instance->numOfClientServices - 1; i >= 0; i--) {
+    h = Sd_ServiceHash(Instance->ClientServices[i].ServiceId);
+    Instance->ClientServices[i].context->hnext = Instance->context->clientHash[h];
+    Instance->context->clientHash[h] = (uint16_t)(i + 1);
+  }
+}
+
+/* the next server service after prev (NULL to start) which matches the service and instance ID,
+ * the instance ID SD_ANY_INSTANCE_ID matches all */
+static const Sd_ServerServiceType *Sd_LookupServerService(const Sd_InstanceType *Instance,
+                                                          const Sd_ServerServiceType *prev,
+                                                          uint16_t serviceId,
+                                                          uint16_t instanceId) {
+  const Sd_ServerServiceType *config = NULL;
+  uint16_t next;
+
+  if (NULL == prev) {
+    next = Instance->context->serverHash[Sd_ServiceHash(serviceId)];
+  } else {
+    next = prev->context->hnext;
+  }
+
+  while ((0 != next) && (NULL == config)) {
+    config = &Instance->ServerServices[next - 1];
+    next = config->context->hnext;
+    if ((config->ServiceId != serviceId) ||
+        ((config->InstanceId != instanceId) && (SD_ANY_INSTANCE_ID != instanceId))) {
+      config = NULL;
+    }
+  }
+
+  return config;
+}
+
+static const Sd_ClientServiceType *
+Sd_LookupClientService(const Sd_InstanceType *Instance, uint16_t serviceId, uint16_t instanceId) {
+  const Sd_ClientServiceType *config = NULL;
+  uint16_t next = Instance->context->clientHash[Sd_ServiceHash(serviceId)];
+
+  while ((0 != next) && (NULL == config)) {
+    config = &Instance->ClientServices[next - 1];
+    next = config->context->hnext;
+    if ((config->ServiceId != serviceId) || (config->InstanceId != instanceId)) {
+      config = NULL;
+    }
+  }
+
+  return config;
+}
+
+static uint16_t Sd_SubscriberHash(uint16_t eventGroupId, const TcpIp_SockAddrType *Addr) {
+  uint32_t h = eventGroupId;
+
+  h ^= ((uint32_t)Addr->addr[2] << 8) | Addr->addr[3];
+  h ^= (uint32_t)Addr->port * 0x9E37u;
+  h ^= h >> 8;
+
+  return (uint16_t)(h & (SD_SUBSCRIBER_HASH_SIZE - 1));
+}
+
 static Std_ReturnType Sd_DecodeIpV4Option(const uint8_t *od, uint8_t type,
                                           Sd_OptionIPv4Type *ipv4Opt, uint8_t indexOf1stOpt,
                                           uint8_t numOf1stOpt) {
@@ -465,58 +770,34 @@ static Std_ReturnType Sd_DecodeEntryType2SEGAck(const uint8_t *ed, const uint8_t
 }
 
 static Std_ReturnType Sd_HandleFindService(const Sd_InstanceType *Instance,
-                                           const TcpIp_SockAddrType *RemoteAddr,
-                                           const Sd_HeaderType *header,
-                                           const Sd_EntryType1Type *entry1) {
+                                           const Sd_EntryType1Type *entry1, boolean isMulticast,
+                                           Sd_TxMsgType *msg) {
   Std_ReturnType ret = E_NOT_OK;
-  int i;
-  TcpIp_SockAddrType LocalAddr;
   const Sd_ServerServiceType *config;
   Sd_ServerServiceContextType *context;
-  PduInfoType pduInfo;
 
-  for (i = 0; i < Instance->numOfServerServices; i++) {
-    config = &Instance->ServerServices[i];
+  /* @SWS_SD_00486: answer all the matched instances */
+  config = Sd_LookupServerService(Instance, NULL, entry1->serviceId, entry1->instanceId);
+  while (NULL != config) {
     context = config->context;
-    if ((config->ServiceId == entry1->serviceId) || (config->InstanceId == entry1->instanceId)) {
-      ret = E_OK;
-      break;
-    }
-  }
-
-  if (E_OK == ret) {
-    if ((config->MajorVersion != SD_ANY_MAJOR_VERSION) && (config->MajorVersion != entry1->major)) {
+    if ((config->MajorVersion != SD_ANY_MAJOR_VERSION) &&
+        (entry1->major != SD_ANY_MAJOR_VERSION) && (config->MajorVersion != entry1->major)) {
       ASLOG(SDE, ("major version not matched\n"));
-      ret = E_NOT_OK;
     } else if ((config->MinorVersion != SD_ANY_MINOR_VERSION) &&
+               (entry1->minor != SD_ANY_MINOR_VERSION) &&
                (config->MinorVersion != entry1->minor)) {
       ASLOG(SDE, ("minor version not matched\n"));
-      ret = E_NOT_OK;
+    } else if (isMulticast && (context->flags & SD_FLG_PENDING_OFFER)) {
+      /* all the peers get the multicast offer soon, no need to answer this one alone */
+      Instance->context->stats.suppressedDuplicates++;
+      ret = E_OK;
+    } else if ((SD_PHASE_DOWN != context->phase) || (context->flags & SD_FLG_PENDING_REQUEST)) {
+      Sd_TxMsgAddOffer(msg, config);
+      ret = E_OK;
     } else {
-      /* version okay */
-    }
-  }
-
-  if ((E_OK == ret) &&
-      ((SD_PHASE_DOWN != context->phase) || (context->flags & SD_FLG_PENDING_REQUEST))) {
-    Sd_BuildEntryType1(&Instance->buffer[24], SD_OFFER_SERVICE, 1, 0, 1, 0, config->ServiceId,
-                       config->InstanceId, config->MajorVersion, config->MinorVersion,
-                       config->ServerTimer->TTL);
-    (void)SoAd_GetLocalAddr(config->SoConId, &LocalAddr, NULL, NULL);
-    Sd_BuildOptionIPv4Endpoint(&Instance->buffer[44], &LocalAddr, config->ProtocolType);
-    Sd_BuildHeader(Instance->buffer, Instance->context->flags,
-                   Instance->context->multicastSessionId, 16, 12);
-    if (0 == Instance->context->multicastSessionId) {
-      Instance->context->multicastSessionId = 1;
-      Instance->context->flags &= ~SD_REBOOT_FLAG;
-    }
-    pduInfo.MetaDataPtr = (uint8_t *)RemoteAddr;
-    pduInfo.SduDataPtr = Instance->buffer;
-    pduInfo.SduLength = 56;
-    ret = SoAd_IfTransmit(Instance->TxPdu.UnicastTxPduId, &pduInfo);
-    if (E_OK != ret) {
-      ASLOG(SDE, ("response to find service failed\n"));
+      /* service is down */
     }
+    config = Sd_LookupServerService(Instance, config, entry1->serviceId, entry1->instanceId);
   }
 
   return ret;
@@ -528,17 +809,13 @@ static Std_ReturnType Sd_HandleOfferService(const Sd_InstanceType *Instance,
                                             const Sd_EntryType1Type *entry1,
                                             const Sd_OptionIPv4Type *ipv4Opt) {
   Std_ReturnType ret = E_NOT_OK;
-  int i;
-
   const Sd_ClientServiceType *config;
-  Sd_ClientServiceContextType *context;
-  for (i = 0; i < Instance->numOfClientServices; i++) {
-    config = &Instance->ClientServices[i];
+  Sd_ClientServiceContextType *context = NULL;
+
+  config = Sd_LookupClientService(Instance, entry1->serviceId, entry1->instanceId);
+  if (NULL != config) {
     context = config->context;
-    if ((config->ServiceId == entry1->serviceId) || (config->InstanceId == entry1->instanceId)) {
-      ret = E_OK;
-      break;
-    }
+    ret = E_OK;
   }
 
   if (E_OK == ret) {
@@ -593,91 +870,105 @@ static Std_ReturnType Sd_HandleOfferService(const Sd_InstanceType *Instance,
     context->port = RemoteAddr->port;
     if (0 == entry1->TTL) {
       context->isOffered = FALSE;
+#ifdef STD_TIMER_WHEEL
+      Std_TimerEntryStop(&context->ttlTimer);
+#else
       context->TTL = 0;
+#endif
 
       Sd_InitClientServiceConsumedEventGroups(config);
     } else {
       context->isOffered = TRUE;
+#ifdef STD_TIMER_WHEEL
+      if (DEFAULT_TTL != entry1->TTL) { /* @SWS_SD_00514 */
+        Std_TimerEntryStart(&context->ttlTimer, (std_time64_t)entry1->TTL * 1000000, 0);
+      } else {
+        Std_TimerEntryStop(&context->ttlTimer); /* alive forever */
+      }
+#else
       if (DEFAULT_TTL != entry1->TTL) { /* @SWS_SD_00514 */
         context->TTL = SD_CONVERT_MS_TO_MAIN_CYCLES(entry1->TTL * 1000);
       } else {
         context->TTL = 0; /* alive forever */
       }
+#endif
     }
   }
   return ret;
 }
 
-static Std_ReturnType Sd_ResponseSubscribeEventGroup(const Sd_InstanceType *Instance,
-                                                     const Sd_ServerServiceType *config,
-                                                     const Sd_EventHandlerType *EventHandler,
-                                                     Sd_EventHandlerSubscriberType *sub) {
-  PduInfoType pduInfo;
-  TcpIp_SockAddrType RemoteAddr;
-  Sd_BuildEntryType2(&Instance->buffer[24], SD_SUBSCRIBE_EVENT_GROUP_ACK, 0, 0, 1, 0,
-                     config->ServiceId, config->InstanceId, config->MajorVersion, 0,
-                     EventHandler->EventGroupId, config->ServerTimer->TTL);
-  // Sd_BuildOptionIPv4Multicast(&Instance->buffer[44], &sub->RemoteAddr, TCPIP_IPPROTO_UDP);
-  Sd_BuildHeader(Instance->buffer, Instance->context->flags, Instance->context->multicastSessionId,
-                 16, 0);
-  Instance->context->multicastSessionId++;
-  if (0 == Instance->context->multicastSessionId) {
-    Instance->context->multicastSessionId = 1;
-    Instance->context->flags &= ~SD_REBOOT_FLAG;
+static Sd_EventHandlerSubscriberType *Sd_LookupSubscribe(const Sd_InstanceType *Instance,
+                                                         const Sd_EventHandlerType *EventHandler,
+                                                         const TcpIp_SockAddrType *RemoteAddr) {
+  Sd_EventHandlerSubscriberType *sub =
+    Instance->context->subscriberHash[Sd_SubscriberHash(EventHandler->EventGroupId, RemoteAddr)];
+
+  /* the bucket is shared by all event handlers of this instance */
+  while ((NULL != sub) &&
+         ((sub < EventHandler->Subscribers) ||
+          (sub >= &EventHandler->Subscribers[EventHandler->numOfSubscribers]) ||
+          (0 != memcmp(&sub->RemoteAddr, RemoteAddr, sizeof(TcpIp_SockAddrType))))) {
+    sub = sub->hnext;
   }
-  RemoteAddr = sub->RemoteAddr;
-  RemoteAddr.port = sub->port;
-  pduInfo.MetaDataPtr = (uint8_t *)&RemoteAddr;
-  pduInfo.SduDataPtr = Instance->buffer;
-  pduInfo.SduLength = 44;
-  return SoAd_IfTransmit(Instance->TxPdu.UnicastTxPduId, &pduInfo);
+
+  return sub;
 }
 
-static Sd_EventHandlerSubscriberType *Sd_LookupSubscribe(const Sd_EventHandlerType *EventHandler,
-                                                         const TcpIp_SockAddrType *RemoteAddr) {
+static Sd_EventHandlerSubscriberType *Sd_NewSubscribe(const Sd_InstanceType *Instance,
+                                                      const Sd_EventHandlerType *EventHandler,
+                                                      const TcpIp_SockAddrType *RemoteAddr) {
   Sd_EventHandlerSubscriberType *sub = NULL;
+  uint16_t h;
   int i;
 
-  if (EventHandler->context->numOfSubscribers > 0) {
-    for (i = 0; (i < EventHandler->numOfSubscribers) && (NULL == sub); i++) {
-      if (SD_FLG_EVENT_GROUP_UNSUBSCRIBED != EventHandler->Subscribers[i].flags) {
-        if (0 == memcmp(&EventHandler->Subscribers[i].RemoteAddr, RemoteAddr,
-                        sizeof(TcpIp_SockAddrType))) {
-          sub = &EventHandler->Subscribers[i];
-        }
-      }
-    }
-  }
-
   for (i = 0; (i < EventHandler->numOfSubscribers) && (NULL == sub); i++) {
     if (SD_FLG_EVENT_GROUP_UNSUBSCRIBED == EventHandler->Subscribers[i].flags) {
       sub = &EventHandler->Subscribers[i];
     }
   }
 
+  if (NULL != sub) {
+    sub->RemoteAddr = *RemoteAddr;
+    h = Sd_SubscriberHash(EventHandler->EventGroupId, RemoteAddr);
+    sub->hnext = Instance->context->subscriberHash[h];
+    Instance->context->subscriberHash[h] = sub;
+  }
+
   return sub;
 }
 
+static void Sd_DeleteSubscribe(const Sd_InstanceType *Instance,
+                               const Sd_EventHandlerType *EventHandler,
+                               Sd_EventHandlerSubscriberType *sub) {
+  Sd_EventHandlerSubscriberType **pp =
+    &Instance->context->subscriberHash[Sd_SubscriberHash(EventHandler->EventGroupId,
+                                                         &sub->RemoteAddr)];
+
+  while ((NULL != *pp) && (sub != *pp)) {
+    pp = &(*pp)->hnext;
+  }
+
+  if (NULL != *pp) {
+    *pp = sub->hnext;
+  }
+
+  sub->hnext = NULL;
+  sub->flags = SD_FLG_EVENT_GROUP_UNSUBSCRIBED;
+}
+
 static Std_ReturnType Sd_HandleSubscribeEventGroup(const Sd_InstanceType *Instance,
                                                    const TcpIp_SockAddrType *RemoteAddr,
                                                    const Sd_EntryType2Type *entry2,
-                                                   const Sd_OptionIPv4Type *ipv4Opt) {
+                                                   const Sd_OptionIPv4Type *ipv4Opt,
+                                                   Sd_TxMsgType *msg) {
   Std_ReturnType ret = E_NOT_OK;
   int i;
   const Sd_ServerServiceType *config;
   const Sd_EventHandlerType *EventHandler;
   Sd_EventHandlerSubscriberType *sub = NULL;
 
-  for (i = 0; i < Instance->numOfServerServices; i++) {
-    config = &Instance->ServerServices[i];
-    if ((config->ServiceId == entry2->serviceId) || (config->InstanceId == entry2->instanceId)) {
-      ret = E_OK;
-      break;
-    }
-  }
-
-  if (E_OK == ret) {
-    ret = E_NOT_OK;
+  config = Sd_LookupServerService(Instance, NULL, entry2->serviceId, entry2->instanceId);
+  if (NULL != config) {
     for (i = 0; i < config->numOfEventHandlers; i++) {
       EventHandler = &config->EventHandlers[i];
       if (EventHandler->EventGroupId == entry2->eventGroupId) {
@@ -702,37 +993,37 @@ static Std_ReturnType Sd_HandleSubscribeEventGroup(const Sd_InstanceType *Instan
   }
 
   if (E_OK == ret) {
-    sub = Sd_LookupSubscribe(EventHandler, &ipv4Opt->Addr);
-    if (NULL == sub) {
-      ASLOG(SDE, ("no free subscriber\n"));
-      ret = E_NOT_OK;
-    } else if (SD_FLG_EVENT_GROUP_UNSUBSCRIBED != sub->flags) {
-      ASLOG(SDE, ("already subscribed\n"));
-      ret = E_NOT_OK;
-    } else {
-      /* OK */
-    }
-  }
-
-  if (E_OK == ret) {
+    sub = Sd_LookupSubscribe(Instance, EventHandler, &ipv4Opt->Addr);
     if (entry2->TTL > 0) {
-      SD_SET_CLEAR(sub->flags, SD_FLG_EVENT_GROUP_SUBSCRIBED, ~SD_FLG_EVENT_GROUP_SUBSCRIBED);
-      sub->sessionId = 0;
-      EventHandler->context->numOfSubscribers++;
-      if (EventHandler->context->numOfSubscribers > EventHandler->numOfSubscribers) {
-        ASLOG(SDE, ("numOfSubscribers not correct when start\n"));
+      if (NULL == sub) {
+        sub = Sd_NewSubscribe(Instance, EventHandler, &ipv4Opt->Addr);
+        if (NULL == sub) {
+          ASLOG(SDE, ("no free subscriber\n"));
+          ret = E_NOT_OK;
+        } else {
+          sub->sessionId = 0;
+          EventHandler->context->numOfSubscribers++;
+          if (EventHandler->context->numOfSubscribers > EventHandler->numOfSubscribers) {
+            ASLOG(SDE, ("numOfSubscribers not correct when start\n"));
+          }
+        }
+      } else {
+        /* subscription renewed, ack it again */
       }
-      sub->RemoteAddr = ipv4Opt->Addr;
-      sub->port = RemoteAddr->port;
-      ret = Sd_ResponseSubscribeEventGroup(Instance, config, EventHandler, sub);
-      if (E_OK != ret) { /* retry next time */
-        SD_SET(sub->flags, SD_FLG_PENDING_EVENT_GROUP_ACK);
+      if (E_OK == ret) {
+        SD_SET_CLEAR(sub->flags, SD_FLG_EVENT_GROUP_SUBSCRIBED | SD_FLG_PENDING_EVENT_GROUP_ACK,
+                     ~SD_FLG_EVENT_GROUP_SUBSCRIBED);
+        sub->port = RemoteAddr->port;
+        Sd_TxMsgAddSubscribeAck(msg, config, EventHandler, sub);
       }
-    } else {
-      sub->flags = 0;
+    } else if (NULL != sub) {
+      Sd_DeleteSubscribe(Instance, EventHandler, sub);
       if (EventHandler->context->numOfSubscribers > 0) {
         EventHandler->context->numOfSubscribers--;
       }
+    } else {
+      ASLOG(SDE, ("stop subscribe while not subscribed\n"));
+      ret = E_NOT_OK;
     }
   }
 
@@ -748,16 +1039,8 @@ static Std_ReturnType Sd_HandleSubscribeEventGroupAck(const Sd_InstanceType *Ins
   const Sd_ClientServiceType *config;
   const Sd_ConsumedEventGroupType *ConsumedEventGroup;
 
-  for (i = 0; i < Instance->numOfClientServices; i++) {
-    config = &Instance->ClientServices[i];
-    if ((config->ServiceId == entry2->serviceId) || (config->InstanceId == entry2->instanceId)) {
-      ret = E_OK;
-      break;
-    }
-  }
-
-  if (E_OK == ret) {
-    ret = E_NOT_OK;
+  config = Sd_LookupClientService(Instance, entry2->serviceId, entry2->instanceId);
+  if (NULL != config) {
     for (i = 0; i < config->numOfConsumedEventGroups; i++) {
       ConsumedEventGroup = &config->ConsumedEventGroups[i];
       if (ConsumedEventGroup->EventGroupId == entry2->eventGroupId) {
@@ -794,12 +1077,15 @@ static void Sd_HandleMsg(const Sd_InstanceType *Instance, const PduInfoType *Pdu
   union {
     Sd_OptionIPv4Type ipv4Opt;
   } OPT;
+  Sd_TxMsgType msg;
   int i;
 
   ASLOG(SD, ("[%s] Rx %s %d bytes from %d.%d.%d.%d:%d\n", Instance->Hostname,
              isMulticast ? "Multicast" : "Unicast", PduInfoPtr->SduLength, RemoteAddr->addr[0],
              RemoteAddr->addr[1], RemoteAddr->addr[2], RemoteAddr->addr[3], RemoteAddr->port));
 
+  /* all the responses to this message are aggregated into as few messages as possible */
+  Sd_TxMsgInit(&msg, Instance, RemoteAddr);
   ret = Sd_DecodeHeader(data, length, &header);
   for (i = 0; (i < header.lengthOfEntries) && (E_OK == ret);) {
     type = data[24 + i];
@@ -807,7 +1093,7 @@ static void Sd_HandleMsg(const Sd_InstanceType *Instance, const PduInfoType *Pdu
     case SD_FIND_SERVICE:
       ret = Sd_DecodeEntryType1OF(&data[24 + i], NULL, &header, &ET.entry1, NULL);
       if (E_OK == ret) {
-        (void)Sd_HandleFindService(Instance, RemoteAddr, &header, &ET.entry1);
+        (void)Sd_HandleFindService(Instance, &ET.entry1, isMulticast, &msg);
       }
       i += 16;
       break;
@@ -823,7 +1109,7 @@ static void Sd_HandleMsg(const Sd_InstanceType *Instance, const PduInfoType *Pdu
       ret = Sd_DecodeEntryType2SEG(&data[24 + i], &data[28 + header.lengthOfEntries], &header,
                                    &ET.entry2, &OPT.ipv4Opt);
       if (E_OK == ret) {
-        (void)Sd_HandleSubscribeEventGroup(Instance, RemoteAddr, &ET.entry2, &OPT.ipv4Opt);
+        (void)Sd_HandleSubscribeEventGroup(Instance, RemoteAddr, &ET.entry2, &OPT.ipv4Opt, &msg);
       }
       i += 16;
       break;
@@ -842,13 +1128,21 @@ static void Sd_HandleMsg(const Sd_InstanceType *Instance, const PduInfoType *Pdu
       break;
     }
   }
+
+  (void)Sd_TxMsgSend(&msg);
 }
 
-static void Sd_InitServerServiceEventHandlers(const Sd_ServerServiceType *config) {
-  int i;
+static void Sd_InitServerServiceEventHandlers(const Sd_InstanceType *Instance,
+                                              const Sd_ServerServiceType *config) {
+  int i, j;
   const Sd_EventHandlerType *EventHandler;
   for (i = 0; i < config->numOfEventHandlers; i++) {
     EventHandler = &config->EventHandlers[i];
+    for (j = 0; j < EventHandler->numOfSubscribers; j++) {
+      if (SD_FLG_EVENT_GROUP_UNSUBSCRIBED != EventHandler->Subscribers[j].flags) {
+        Sd_DeleteSubscribe(Instance, EventHandler, &EventHandler->Subscribers[j]);
+      }
+    }
     memset(EventHandler->context, 0, sizeof(Sd_EventHandlerContextType));
     memset(EventHandler->Subscribers, 0,
            EventHandler->numOfSubscribers * sizeof(Sd_EventHandlerSubscriberType));
@@ -863,8 +1157,15 @@ static void Sd_InitServerService(const Sd_InstanceType *Instance) {
   for (i = 0; i < Instance->numOfServerServices; i++) {
     config = &Instance->ServerServices[i];
     context = config->context;
+#ifdef STD_TIMER_WHEEL
+    /* unlink it from the wheel before the memset, Sd_Init may run again */
+    Std_TimerEntryStop(&context->offerTimer);
+#endif
     memset(context, 0, sizeof(*context));
-    Sd_InitServerServiceEventHandlers(config);
+#ifdef STD_TIMER_WHEEL
+    Std_TimerEntryInit(&context->offerTimer, Sd_ServerServiceOfferTimeout, (void *)config);
+#endif
+    Sd_InitServerServiceEventHandlers(Instance, config);
     if (config->AutoAvailable) {
       SD_SET(context->flags, SD_FLG_PENDING_REQUEST);
     }
@@ -891,13 +1192,19 @@ static void Sd_InitClientService(const Sd_InstanceType *Instance) {
   for (i = 0; i < Instance->numOfClientServices; i++) {
     config = &Instance->ClientServices[i];
     context = config->context;
+#ifdef STD_TIMER_WHEEL
+    /* unlink it from the wheel before the memset, Sd_Init may run again */
+    Std_TimerEntryStop(&context->ttlTimer);
+#endif
     memset(context, 0, sizeof(*context));
+#ifdef STD_TIMER_WHEEL
+    Std_TimerEntryInit(&context->ttlTimer, Sd_ClientServiceTTLTimeout, (void *)config);
+#endif
     if (config->AutoRequire) {
       context->phase = SD_PHASE_INITIAL_WAIT;
       context->findTimer = Sd_RandTime(config->ClientTimer->InitialFindDelayMin,
                                        config->ClientTimer->InitialFindDelayMax);
       context->isOffered = FALSE;
-      context->TTL = 0;
     }
     Sd_InitClientServiceConsumedEventGroups(config);
   }
@@ -918,48 +1225,112 @@ static void Sd_ServerServiceLinkControl(const Sd_ServerServiceType *config) {
   }
 }
 
+/* timeout in main function cycles, 0 stops the timer */
+static void Sd_ServerServiceStartOfferTimer(const Sd_ServerServiceType *config, uint16_t timeout) {
+#ifdef STD_TIMER_WHEEL
+  if (timeout > 0) {
+    Std_TimerEntryStart(&config->context->offerTimer,
+                        (std_time64_t)timeout * SD_MAIN_FUNCTION_PERIOD * 1000, 0);
+  } else {
+    Std_TimerEntryStop(&config->context->offerTimer);
+  }
+#else
+  config->context->offerTimer = timeout;
+#endif
+}
+
 static void Sd_ServerServiceMain_Down(const Sd_InstanceType *Instance,
                                       const Sd_ServerServiceType *config) {
   Sd_ServerServiceContextType *context = config->context;
 
   if (context->flags & SD_FLG_PENDING_REQUEST) {
     SD_CLEAR(context->flags, SD_FLG_PENDING_REQUEST);
-    Sd_InitServerServiceEventHandlers(config);
+    Sd_InitServerServiceEventHandlers(Instance, config);
     context->phase = SD_PHASE_INITIAL_WAIT;
-    context->offerTimer = Sd_RandTime(config->ServerTimer->InitialOfferDelayMin,
-                                      config->ServerTimer->InitialOfferDelayMax);
+    Sd_ServerServiceStartOfferTimer(config, Sd_RandTime(config->ServerTimer->InitialOfferDelayMin,
+                                                        config->ServerTimer->InitialOfferDelayMax));
     ASLOG(SD, ("Service %X:%X going up\n", config->ServiceId, config->InstanceId));
   }
 }
 
+/* the offer timer of the current phase expired */
+static void Sd_ServerServiceOfferExpired(const Sd_InstanceType *Instance,
+                                         const Sd_ServerServiceType *config) {
+  Sd_ServerServiceContextType *context = config->context;
+
+  switch (context->phase) {
+  case SD_PHASE_INITIAL_WAIT:
+    /* @SWS_SD_00321 */
+    Sd_SetPending(Instance, &context->flags, SD_FLG_PENDING_OFFER);
+    context->counter = 0;
+    /* @SWS_SD_00434, @SWS_SD_00435 */
+    if (config->ServerTimer->InitialOfferRepetitionsMax > 0) {
+      ASLOG(SD, ("Service %X:%X enter repetition\n", config->ServiceId, config->InstanceId));
+      context->phase = SD_PHASE_REPETITION;
+      Sd_ServerServiceStartOfferTimer(config,
+                                      config->ServerTimer->InitialOfferRepetitionBaseDelay);
+    } else {
+      ASLOG(SD, ("Service %X:%X enter main\n", config->ServiceId, config->InstanceId));
+      context->phase = SD_PHASE_MAIN;
+      Sd_ServerServiceStartOfferTimer(config, config->ServerTimer->OfferCyclicDelay);
+    }
+    break;
+  case SD_PHASE_REPETITION:
+    Sd_SetPending(Instance, &context->flags, SD_FLG_PENDING_OFFER);
+    context->counter++;
+    if (context->counter < config->ServerTimer->InitialOfferRepetitionsMax) {
+      Sd_ServerServiceStartOfferTimer(config, config->ServerTimer->InitialOfferRepetitionBaseDelay *
+                                                (1 << context->counter));
+    } else {
+      ASLOG(SD, ("Service %X:%X enter main\n", config->ServiceId, config->InstanceId));
+      context->phase = SD_PHASE_MAIN;
+      Sd_ServerServiceStartOfferTimer(config, config->ServerTimer->OfferCyclicDelay);
+    }
+    break;
+  case SD_PHASE_MAIN:
+    Sd_SetPending(Instance, &context->flags, SD_FLG_PENDING_OFFER);
+    if (context->counter < 0xFF) {
+      context->counter++;
+    }
+    Sd_ServerServiceStartOfferTimer(config, config->ServerTimer->OfferCyclicDelay);
+    break;
+  default:
+    break;
+  }
+}
+
+#ifdef STD_TIMER_WHEEL
+/* runs in the timer wheel task, which holds the same lock as the task running Sd_MainFunction */
+static void Sd_ServerServiceOfferTimeout(void *param) {
+  const Sd_ServerServiceType *config = (const Sd_ServerServiceType *)param;
+  Sd_ServerServiceOfferExpired(&SD_CONFIG->Instances[config->InstanceIndex], config);
+}
+#else
+static void Sd_ServerServiceMain_OfferTimer(const Sd_InstanceType *Instance,
+                                            const Sd_ServerServiceType *config) {
+  Sd_ServerServiceContextType *context = config->context;
+  if (context->offerTimer > 0) {
+    context->offerTimer--;
+    if (0 == context->offerTimer) {
+      Sd_ServerServiceOfferExpired(Instance, config);
+    }
+  } else {
+    ASLOG(SDE, ("Timer not started in phase %d\n", context->phase));
+  }
+}
+#endif
+
 static void Sd_ServerServiceMain_InitialWait(const Sd_InstanceType *Instance,
                                              const Sd_ServerServiceType *config) {
   Sd_ServerServiceContextType *context = config->context;
   if (context->flags & SD_FLG_PENDING_RELEASE) {
     SD_CLEAR(context->flags, SD_FLG_PENDING_RELEASE);
-    context->offerTimer = 0;
+    Sd_ServerServiceStartOfferTimer(config, 0);
     context->phase = SD_PHASE_DOWN;
   } else {
-    if (context->offerTimer > 0) {
-      context->offerTimer--;
-      if (0 == context->offerTimer) {
-        /* @SWS_SD_00321 */
-        SD_SET(context->flags, SD_FLG_PENDING_OFFER);
-        context->counter = 0;
-        /* @SWS_SD_00434, @SWS_SD_00435 */
-        if (config->ServerTimer->InitialOfferRepetitionsMax > 0) {
-          ASLOG(SD, ("Service %X:%X enter repetition\n", config->ServiceId, config->InstanceId));
-          context->phase = SD_PHASE_REPETITION;
-          context->offerTimer = config->ServerTimer->InitialOfferRepetitionBaseDelay;
-        } else {
-          ASLOG(SD, ("Service %X:%X enter main\n", config->ServiceId, config->InstanceId));
-          context->phase = SD_PHASE_MAIN;
-          context->offerTimer = config->ServerTimer->OfferCyclicDelay;
-        }
-      }
-    } else {
-      ASLOG(SDE, ("Timer not started in phase INITIAL_WAIT\n"));
-    }
+#ifndef STD_TIMER_WHEEL
+    Sd_ServerServiceMain_OfferTimer(Instance, config);
+#endif
   }
 }
 
@@ -968,27 +1339,13 @@ static void Sd_ServerServiceMain_Repetition(const Sd_InstanceType *Instance,
   Sd_ServerServiceContextType *context = config->context;
   if (context->flags & SD_FLG_PENDING_RELEASE) {
     SD_SET_CLEAR(context->flags, SD_FLG_PENDING_STOP_OFFER, SD_FLG_PENDING_RELEASE);
-    Sd_InitServerServiceEventHandlers(config);
-    context->offerTimer = 0;
+    Sd_InitServerServiceEventHandlers(Instance, config);
+    Sd_ServerServiceStartOfferTimer(config, 0);
     context->phase = SD_PHASE_DOWN;
   } else {
-    if (context->offerTimer > 0) {
-      context->offerTimer--;
-      if (0 == context->offerTimer) {
-        SD_SET(context->flags, SD_FLG_PENDING_OFFER);
-        context->counter++;
-        if (context->counter < config->ServerTimer->InitialOfferRepetitionsMax) {
-          context->offerTimer =
-            config->ServerTimer->InitialOfferRepetitionBaseDelay * (1 << context->counter);
-        } else {
-          ASLOG(SD, ("Service %X:%X enter main\n", config->ServiceId, config->InstanceId));
-          context->phase = SD_PHASE_MAIN;
-          context->offerTimer = config->ServerTimer->OfferCyclicDelay;
-        }
-      }
-    } else {
-      ASLOG(SDE, ("Timer not started in phase INITIAL_WAIT\n"));
-    }
+#ifndef STD_TIMER_WHEEL
+    Sd_ServerServiceMain_OfferTimer(Instance, config);
+#endif
   }
 }
 
@@ -996,23 +1353,14 @@ static void Sd_ServerServiceMain_Main(const Sd_InstanceType *Instance,
                                       const Sd_ServerServiceType *config) {
   Sd_ServerServiceContextType *context = config->context;
   if (context->flags & SD_FLG_PENDING_RELEASE) {
-    Sd_InitServerServiceEventHandlers(config);
+    Sd_InitServerServiceEventHandlers(Instance, config);
     SD_SET_CLEAR(context->flags, SD_FLG_PENDING_STOP_OFFER, SD_FLG_PENDING_RELEASE);
-    context->offerTimer = 0;
+    Sd_ServerServiceStartOfferTimer(config, 0);
     context->phase = SD_PHASE_DOWN;
   } else {
-    if (context->offerTimer > 0) {
-      context->offerTimer--;
-      if (0 == context->offerTimer) {
-        SD_SET(context->flags, SD_FLG_PENDING_OFFER);
-        if (context->counter < 0xFF) {
-          context->counter++;
-        }
-        context->offerTimer = config->ServerTimer->OfferCyclicDelay;
-      }
-    } else {
-      ASLOG(SDE, ("Timer not started in phase INITIAL_WAIT\n"));
-    }
+#ifndef STD_TIMER_WHEEL
+    Sd_ServerServiceMain_OfferTimer(Instance, config);
+#endif
   }
 }
 static void Sd_ClientServiceMain_Down(const Sd_InstanceType *Instance,
@@ -1047,7 +1395,7 @@ static void Sd_ClientServiceMain_InitialWait(const Sd_InstanceType *Instance,
     if (context->findTimer > 0) {
       context->findTimer--;
       if (0 == context->findTimer) {
-        SD_SET(context->flags, SD_FLG_PENDING_FIND);
+        Sd_SetPending(Instance, &context->flags, SD_FLG_PENDING_FIND);
         if (config->ClientTimer->InitialFindRepetitionsMax > 0) {
           ASLOG(SD, ("Client %x:%x enter repetition\n", config->ServiceId, config->InstanceId));
           context->phase = SD_PHASE_REPETITION;
@@ -1077,7 +1425,7 @@ static void Sd_ClientServiceMain_Repetition(const Sd_InstanceType *Instance,
     if (context->findTimer > 0) {
       context->findTimer--;
       if (0 == context->findTimer) {
-        SD_SET(context->flags, SD_FLG_PENDING_FIND);
+        Sd_SetPending(Instance, &context->flags, SD_FLG_PENDING_FIND);
         context->counter++;
         if (context->counter < config->ClientTimer->InitialFindRepetitionsMax) {
           context->findTimer =
@@ -1125,46 +1473,54 @@ static void Sd_ClientServiceMain_Main(const Sd_InstanceType *Instance,
   }
 }
 
-static void Sd_ServerServiceOfferCheck(const Sd_InstanceType *Instance, uint32_t *lengthOfEntries,
-                                       uint32_t *lengthOfOptions, uint8_t *numOfOptions) {
+static boolean Sd_ServerServiceOfferCheck(const Sd_InstanceType *Instance, uint32_t limit,
+                                          uint32_t *lengthOfEntries, uint32_t *lengthOfOptions,
+                                          uint8_t *numOfOptions) {
   int i;
   const Sd_ServerServiceType *config;
   Sd_ServerServiceContextType *context;
+  boolean isFull = FALSE;
 
   for (i = 0; i < Instance->numOfServerServices; i++) {
     config = &Instance->ServerServices[i];
     context = config->context;
     if (context->flags & (SD_FLG_PENDING_OFFER | SD_FLG_PENDING_STOP_OFFER)) {
-      if (((28 + *lengthOfEntries + *lengthOfOptions) < (Instance->bufLen - 28)) &&
-          (*numOfOptions < 256)) {
+      if (((28 + *lengthOfEntries + *lengthOfOptions + 28) <= limit) && (*numOfOptions < 255)) {
         /* @SWS_SD_00160 */
         *lengthOfEntries += 16;
         *lengthOfOptions += 12;
         *numOfOptions += 1;
       } else {
+        isFull = TRUE;
         break;
       }
     }
   }
+
+  return isFull;
 }
 
-static void Sd_ClientServiceFindCheck(const Sd_InstanceType *Instance, uint32_t *lengthOfEntries,
-                                      uint32_t lengthOfOptions) {
+static boolean Sd_ClientServiceFindCheck(const Sd_InstanceType *Instance, uint32_t limit,
+                                         uint32_t *lengthOfEntries, uint32_t lengthOfOptions) {
   int i;
   const Sd_ClientServiceType *config;
   Sd_ClientServiceContextType *context;
+  boolean isFull = FALSE;
 
   for (i = 0; i < Instance->numOfClientServices; i++) {
     config = &Instance->ClientServices[i];
     context = config->context;
     if (context->flags & SD_FLG_PENDING_FIND) {
-      if ((28 + *lengthOfEntries + lengthOfOptions) < (Instance->bufLen - 16)) {
+      if ((28 + *lengthOfEntries + lengthOfOptions + 16) <= limit) {
         *lengthOfEntries += 16;
       } else {
+        isFull = TRUE;
         break;
       }
     }
   }
+
+  return isFull;
 }
 
 static void Sd_ServerServiceOfferBuild(const Sd_InstanceType *Instance, uint32_t *offsetOfEntries,
@@ -1256,19 +1612,34 @@ static void Sd_ServerServiceMain(const Sd_InstanceType *Instance) {
   }
 }
 
+static void Sd_ClientServiceTTLExpired(const Sd_ClientServiceType *config) {
+  Sd_ClientServiceContextType *context = config->context;
+  context->isOffered = FALSE;
+  /* @SWS_SD_00600 */
+  context->phase = SD_PHASE_INITIAL_WAIT;
+  context->findTimer = Sd_RandTime(config->ClientTimer->InitialFindDelayMin,
+                                   config->ClientTimer->InitialFindDelayMax);
+}
+
+#ifdef STD_TIMER_WHEEL
+/* runs in the timer wheel task, which holds the same lock as the task running Sd_MainFunction */
+static void Sd_ClientServiceTTLTimeout(void *param) {
+  const Sd_ClientServiceType *config = (const Sd_ClientServiceType *)param;
+  if (config->context->isOffered) {
+    Sd_ClientServiceTTLExpired(config);
+  }
+}
+#else
 static void Sd_ClientServiceMain_TTL(const Sd_ClientServiceType *config) {
   Sd_ClientServiceContextType *context = config->context;
   if (context->isOffered && (context->TTL > 0)) {
     context->TTL--;
     if (0 == context->TTL) {
-      context->isOffered = FALSE;
-      /* @SWS_SD_00600 */
-      context->phase = SD_PHASE_INITIAL_WAIT;
-      context->findTimer = Sd_RandTime(config->ClientTimer->InitialFindDelayMin,
-                                       config->ClientTimer->InitialFindDelayMax);
+      Sd_ClientServiceTTLExpired(config);
     }
   }
 }
+#endif
 
 static void Sd_ClientServiceLinkControl(const Sd_ClientServiceType *config) {
   Sd_ClientServiceContextType *context = config->context;
@@ -1293,7 +1664,9 @@ static void Sd_ClientServiceMain(const Sd_InstanceType *Instance) {
   for (i = 0; i < Instance->numOfClientServices; i++) {
     config = &Instance->ClientServices[i];
     context = config->context;
+#ifndef STD_TIMER_WHEEL
     Sd_ClientServiceMain_TTL(config);
+#endif
     Sd_ClientServiceLinkControl(config);
     switch (context->phase) {
     case SD_PHASE_DOWN:
@@ -1319,96 +1692,114 @@ static boolean Sd_ServerServiceEventGroupAckCheck(const Sd_InstanceType *Instanc
   const Sd_ServerServiceType *config;
   const Sd_EventHandlerType *EventHandler;
   Sd_EventHandlerSubscriberType *sub;
+  Sd_TxMsgType msg;
+  TcpIp_SockAddrType RemoteAddr;
+  boolean hasPending = FALSE;
   boolean TxOne = FALSE;
-  Std_ReturnType ret = E_OK;
 
-  for (i = 0; (i < Instance->numOfServerServices) && (FALSE == TxOne); i++) {
+  /* all the pending acks to the same subscriber as the first one go in one message */
+  for (i = 0; i < Instance->numOfServerServices; i++) {
     config = &Instance->ServerServices[i];
-    for (j = 0; (j < config->numOfEventHandlers) && (FALSE == TxOne); j++) {
+    for (j = 0; j < config->numOfEventHandlers; j++) {
       EventHandler = &config->EventHandlers[j];
-      for (k = 0; (k < EventHandler->numOfSubscribers) && (FALSE == TxOne); k++) {
+      for (k = 0; k < EventHandler->numOfSubscribers; k++) {
         sub = &EventHandler->Subscribers[k];
         if (sub->flags & SD_FLG_PENDING_EVENT_GROUP_ACK) {
-          ret = Sd_ResponseSubscribeEventGroup(Instance, config, EventHandler, sub);
-          if (E_OK == ret) {
-            SD_CLEAR(sub->flags, SD_FLG_PENDING_EVENT_GROUP_ACK);
-            TxOne = TRUE;
-          } else {
-            ASLOG(SDE, ("Sending Subscribe Event Group Ack Failed\n"));
+          if (FALSE == hasPending) {
+            RemoteAddr = sub->RemoteAddr;
+            RemoteAddr.port = sub->port;
+            Sd_TxMsgInit(&msg, Instance, &RemoteAddr);
+            hasPending = TRUE;
+          }
+          if ((sub->port == RemoteAddr.port) &&
+              (0 == memcmp(sub->RemoteAddr.addr, RemoteAddr.addr, sizeof(RemoteAddr.addr)))) {
+            Sd_TxMsgAddSubscribeAck(&msg, config, EventHandler, sub);
           }
         }
       }
     }
   }
 
-  return TxOne;
-}
-
-static Std_ReturnType
-Sd_SendSubscribeEventGroup(const Sd_InstanceType *Instance, const Sd_ClientServiceType *config,
-                           const Sd_ConsumedEventGroupType *ConsumedEventGroup) {
-  Std_ReturnType ret = E_OK;
-  TcpIp_SockAddrType LocalAddr;
-  PduInfoType pduInfo;
-  uint32_t TTL = 0;
-
-  if (0 == (ConsumedEventGroup->context->flags & SD_FLG_PENDING_STOP_SUBSCRIBE)) {
-    TTL = config->ClientTimer->TTL;
-  } else {
-    /* send stop */
-  }
-
-  Sd_BuildEntryType2(&Instance->buffer[24], SD_SUBSCRIBE_EVENT_GROUP, 0, 0, 1, 0, config->ServiceId,
-                     config->InstanceId, config->MajorVersion, 0, ConsumedEventGroup->EventGroupId,
-                     TTL);
-  (void)SoAd_GetLocalAddr(config->SoConId, &LocalAddr, NULL, NULL);
-  Sd_BuildOptionIPv4Endpoint(&Instance->buffer[44], &LocalAddr, config->ProtocolType);
-  Sd_BuildHeader(Instance->buffer, Instance->context->flags, Instance->context->multicastSessionId,
-                 16, 12);
-  Instance->context->multicastSessionId++;
-  if (0 == Instance->context->multicastSessionId) {
-    Instance->context->multicastSessionId = 1;
-    Instance->context->flags &= ~SD_REBOOT_FLAG;
-  }
-  memcpy(LocalAddr.addr, config->context->RemoteAddr.addr, 4);
-  LocalAddr.port = config->context->port;
-  pduInfo.MetaDataPtr = (uint8_t *)&LocalAddr;
-  pduInfo.SduDataPtr = Instance->buffer;
-  pduInfo.SduLength = 56;
-  ret = SoAd_IfTransmit(Instance->TxPdu.UnicastTxPduId, &pduInfo);
-  if (E_OK != ret) {
-    ASLOG(SDE, ("Sending Subscribe Event Group Ack Failed\n"));
+  if (hasPending) {
+    if (E_OK == Sd_TxMsgSend(&msg)) {
+      TxOne = TRUE;
+    } else {
+      ASLOG(SDE, ("Sending Subscribe Event Group Ack Failed\n"));
+    }
   }
 
-  return ret;
+  return TxOne;
 }
 
 static boolean Sd_ClientServiceSubscribeEventGroupCheck(const Sd_InstanceType *Instance) {
   int i, j;
   const Sd_ClientServiceType *config;
   const Sd_ConsumedEventGroupType *ConsumedEventGroup;
+  Sd_TxMsgType msg;
+  TcpIp_SockAddrType RemoteAddr;
+  boolean hasPending = FALSE;
   boolean TxOne = FALSE;
-  Std_ReturnType ret;
 
-  for (i = 0; (i < Instance->numOfClientServices) && (FALSE == TxOne); i++) {
+  /* all the pending subscribes to the same provider as the first one go in one message */
+  for (i = 0; i < Instance->numOfClientServices; i++) {
     config = &Instance->ClientServices[i];
-    for (j = 0; (j < config->numOfConsumedEventGroups) && (FALSE == TxOne); j++) {
+    for (j = 0; j < config->numOfConsumedEventGroups; j++) {
       ConsumedEventGroup = &config->ConsumedEventGroups[j];
       if (ConsumedEventGroup->context->flags &
           (SD_FLG_PENDING_SUBSCRIBE | SD_FLG_PENDING_STOP_SUBSCRIBE)) {
-        ret = Sd_SendSubscribeEventGroup(Instance, config, ConsumedEventGroup);
-        if (E_OK == ret) {
-          SD_CLEAR(ConsumedEventGroup->context->flags,
-                   SD_FLG_PENDING_SUBSCRIBE | SD_FLG_PENDING_STOP_SUBSCRIBE);
-          TxOne = TRUE;
+        if (FALSE == hasPending) {
+          RemoteAddr = config->context->RemoteAddr;
+          RemoteAddr.port = config->context->port;
+          Sd_TxMsgInit(&msg, Instance, &RemoteAddr);
+          hasPending = TRUE;
+        }
+        if ((config->context->port == RemoteAddr.port) &&
+            (0 == memcmp(config->context->RemoteAddr.addr, RemoteAddr.addr,
+                         sizeof(RemoteAddr.addr)))) {
+          Sd_TxMsgAddSubscribe(&msg, config, ConsumedEventGroup);
         }
       }
     }
   }
 
+  if (hasPending) {
+    if (E_OK == Sd_TxMsgSend(&msg)) {
+      TxOne = TRUE;
+    } else {
+      ASLOG(SDE, ("Sending Subscribe Event Group Failed\n"));
+    }
+  }
+
   return TxOne;
 }
 
+/* token bucket of the multicast bytes/s budget, refilled every main cycle, holds at most one full
+ * message or one cycle of budget, return the bytes allowed to send now */
+static uint32_t Sd_MulticastAllowance(const Sd_InstanceType *Instance) {
+  Sd_InstanceContextType *context = Instance->context;
+  uint32_t allowance = Instance->bufLen;
+  uint32_t refill;
+  uint32_t capacity;
+
+  if (Instance->MulticastBudget > 0) {
+    refill = Instance->MulticastBudget * SD_MAIN_FUNCTION_PERIOD;
+    capacity = (uint32_t)Instance->bufLen * 1000;
+    if (refill > capacity) {
+      capacity = refill;
+    }
+    if ((capacity - context->multicastTokens) > refill) {
+      context->multicastTokens += refill;
+    } else {
+      context->multicastTokens = capacity;
+    }
+    if ((context->multicastTokens / 1000) < allowance) {
+      allowance = context->multicastTokens / 1000;
+    }
+  }
+
+  return allowance;
+}
+
 static void Sd_ServerClientServiceMain(const Sd_InstanceType *Instance) {
   uint32_t lengthOfEntries = 0;
   uint32_t lengthOfOptions = 0;
@@ -1418,10 +1809,19 @@ static void Sd_ServerClientServiceMain(const Sd_InstanceType *Instance) {
   uint32_t freeSpace;
   PduInfoType pduInfo;
   boolean TxOne = FALSE;
+  boolean isFull;
+  uint32_t limit;
   Std_ReturnType ret;
 
-  Sd_ClientServiceFindCheck(Instance, &lengthOfEntries, lengthOfOptions);
-  Sd_ServerServiceOfferCheck(Instance, &lengthOfEntries, &lengthOfOptions, &numOfOptions);
+  /* all the offers/finds due in this cycle go in one multicast message within the budget, the
+   * rest stay pending for the next cycles */
+  limit = Sd_MulticastAllowance(Instance);
+  isFull = Sd_ClientServiceFindCheck(Instance, limit, &lengthOfEntries, lengthOfOptions);
+  isFull |= Sd_ServerServiceOfferCheck(Instance, limit, &lengthOfEntries, &lengthOfOptions,
+                                       &numOfOptions);
+  if (isFull && (limit < Instance->bufLen)) {
+    Instance->context->stats.budgetDeferrals++;
+  }
 
   if (lengthOfEntries > 0) {
     offsetOfOptions = offsetOfEntries + lengthOfEntries + 4;
@@ -1432,17 +1832,17 @@ static void Sd_ServerClientServiceMain(const Sd_InstanceType *Instance) {
                                &freeSpace);
     Sd_BuildHeader(Instance->buffer, Instance->context->flags,
                    Instance->context->multicastSessionId, lengthOfEntries, lengthOfOptions);
-    Instance->context->multicastSessionId++;
-    if (0 == Instance->context->multicastSessionId) {
-      Instance->context->multicastSessionId = 1;
-      Instance->context->flags &= ~SD_REBOOT_FLAG;
-    }
+    Sd_NextSessionId(Instance);
 
     pduInfo.MetaDataPtr = NULL;
     pduInfo.SduDataPtr = Instance->buffer;
     pduInfo.SduLength = 28 + lengthOfEntries + lengthOfOptions;
     ret = SoAd_IfTransmit(Instance->TxPdu.MulticastTxPduId, &pduInfo);
     if (E_OK == ret) {
+      Sd_CountTx(Instance, TRUE, lengthOfEntries / 16);
+      if (Instance->MulticastBudget > 0) {
+        Instance->context->multicastTokens -= pduInfo.SduLength * 1000;
+      }
       TxOne = TRUE;
     }
   }
@@ -1459,21 +1859,35 @@ void Sd_Init(const Sd_ConfigType *ConfigPtr) {
   const Sd_InstanceType *Instance;
   (void)ConfigPtr;
   SoAd_SoConIdType SoConId;
+  TcpIp_SockAddrType LocalAddr;
   for (i = 0; i < SD_CONFIG->numOfInstances; i++) {
     Instance = &SD_CONFIG->Instances[i];
     Instance->context->flags = SD_REBOOT_FLAG | SD_UNICAST_FLAG;
     Instance->context->multicastSessionId = 0x0001; /* @SWS_SD_00034 */
+    Instance->context->multicastTokens = (uint32_t)Instance->bufLen * 1000;
+    memset(&Instance->context->stats, 0, sizeof(Instance->context->stats));
     (void)SoAd_GetSoConId(Instance->TxPdu.MulticastTxPduId, &SoConId);
     (void)SoAd_OpenSoCon(SoConId);
     (void)SoAd_GetSoConId(Instance->TxPdu.UnicastTxPduId, &SoConId);
     (void)SoAd_OpenSoCon(SoConId);
+    if (E_OK == SoAd_GetLocalAddr(SoConId, &LocalAddr, NULL, NULL)) {
+      Sd_RandMix(LocalAddr.addr, sizeof(LocalAddr.addr));
+    }
+    memset(Instance->context->subscriberHash, 0, sizeof(Instance->context->subscriberHash));
     Sd_InitServerService(Instance);
     Sd_InitClientService(Instance);
+    Sd_InitServiceHash(Instance);
   }
 }
 
 void Sd_SoConModeChg(SoAd_SoConIdType SoConId, SoAd_SoConModeType Mode) {
+  TcpIp_SockAddrType LocalAddr;
   ASLOG(SD, ("SoConId %d Mode %d\n", SoConId, Mode));
+  if (SOAD_SOCON_ONLINE == Mode) {
+    if (E_OK == SoAd_GetLocalAddr(SoConId, &LocalAddr, NULL, NULL)) {
+      Sd_RandMix(LocalAddr.addr, sizeof(LocalAddr.addr));
+    }
+  }
 }
 
 void Sd_RxIndication(PduIdType RxPduId, const PduInfoType *PduInfoPtr) {
@@ -1594,6 +2008,25 @@ Std_ReturnType Sd_GetSubscribers(uint16_t EventHandlerId,
   return ret;
 }
 
+Std_ReturnType Sd_GetMulticastAddr(uint16_t EventHandlerId, TcpIp_SockAddrType *MulticastAddr) {
+  Std_ReturnType ret = E_NOT_OK;
+  uint16_t index;
+  const Sd_ServerServiceType *config;
+  const Sd_EventHandlerType *EventHandler;
+  if (EventHandlerId < SD_CONFIG->numOfEventHandlers) {
+    index = SD_CONFIG->EventHandlersMap[EventHandlerId];
+    config = SD_CONFIG->ServerServicesMap[index];
+    index = SD_CONFIG->PerServiceEventHandlerMap[EventHandlerId];
+    EventHandler = &config->EventHandlers[index];
+    if ((NULL != EventHandler->MulticastAddr) && (EventHandler->MulticastThreshold > 0) &&
+        (EventHandler->context->numOfSubscribers >= EventHandler->MulticastThreshold)) {
+      *MulticastAddr = *EventHandler->MulticastAddr;
+      ret = E_OK;
+    }
+  }
+  return ret;
+}
+
 Std_ReturnType Sd_GetProviderAddr(uint16_t ClientServiceHandleId, TcpIp_SockAddrType *RemoteAddr) {
   const Sd_ClientServiceType *config;
   Sd_ClientServiceContextType *context;
@@ -1610,4 +2043,19 @@ Std_ReturnType Sd_GetProviderAddr(uint16_t ClientServiceHandleId, TcpIp_SockAddr
     ret = E_NOT_OK;
   }
   return ret;
-}
\ No newline at end of file
+}
+
+Std_ReturnType Sd_GetStatistics(uint8_t InstanceId, Sd_StatisticsType *Statistics) {
+  Std_ReturnType ret = E_NOT_OK;
+  if (InstanceId < SD_CONFIG->numOfInstances) {
+    *Statistics = SD_CONFIG->Instances[InstanceId].context->stats;
+    ret = E_OK;
+  }
+  return ret;
+}
+
+void Sd_ResetStatistics(uint8_t InstanceId) {
+  if (InstanceId < SD_CONFIG->numOfInstances) {
+    memset(&SD_CONFIG->Instances[InstanceId].context->stats, 0, sizeof(Sd_StatisticsType));
+  }
+}
@@ -10,11 +10,24 @@
 #include "Std_Types.h"
 #include "SoAd.h"
 #include "Sd.h"
+#include "Std_Timer.h"
 /* ================================ [ MACROS    ] ============================================== */
 #define DEFAULT_TTL 0xFFFFFF /* @SWS_SD_00514, until next reboot */
 
 #define SD_ANY_MAJOR_VERSION 0xFF
 #define SD_ANY_MINOR_VERSION 0xFFFFFFFF
+#define SD_ANY_INSTANCE_ID 0xFFFF
+
+/* number of hash buckets to look up the services by service ID, must be power of 2 */
+#ifndef SD_SERVICE_HASH_SIZE
+#define SD_SERVICE_HASH_SIZE 16
+#endif
+
+/* number of hash buckets to look up the subscribers by event group and address, must be power of
+ * 2 */
+#ifndef SD_SUBSCRIBER_HASH_SIZE
+#define SD_SUBSCRIBER_HASH_SIZE 32
+#endif
 /* ================================ [ TYPES     ] ============================================== */
 typedef enum
 {
@@ -74,7 +87,8 @@ typedef struct {
 typedef struct {
   uint16_t HandleId;
   uint16_t EventGroupId;
-  uint8_t MulticastThreshold;
+  uint8_t MulticastThreshold; /* 0: never multicast */
+  const TcpIp_SockAddrType *MulticastAddr;
   Sd_EventHandlerContextType *context;
   Sd_EventHandlerSubscriberType *Subscribers;
   uint16_t numOfSubscribers;
@@ -83,9 +97,14 @@ typedef struct {
 typedef struct {
   uint32_t TTL;
   Sd_PhaseType phase;
+#ifdef STD_TIMER_WHEEL
+  Std_TimerEntryType offerTimer;
+#else
   uint16_t offerTimer;
+#endif
   uint16_t flags;
   uint8_t counter;
+  uint16_t hnext; /* index + 1 of the next service in the same hash bucket, 0: end */
 } Sd_ServerServiceContextType;
 
 /* @ECUC_SD_00004 */
@@ -111,7 +130,11 @@ typedef struct {
 } Sd_ServerServiceType;
 
 typedef struct {
+#ifdef STD_TIMER_WHEEL
+  Std_TimerEntryType ttlTimer;
+#else
   uint32_t TTL;
+#endif
   Sd_PhaseType phase;
   uint16_t findTimer;
   uint16_t flags;
@@ -121,6 +144,7 @@ typedef struct {
   TcpIp_SockAddrType RemoteAddr;
   uint16_t port; /* subscribe port */
   uint16_t sessionId;
+  uint16_t hnext; /* index + 1 of the next service in the same hash bucket, 0: end */
 } Sd_ClientServiceContextType;
 
 /* @ECUC_SD_00005 */
@@ -159,6 +183,12 @@ typedef struct {
 typedef struct {
   uint16_t multicastSessionId;
   uint8_t flags;
+  /* index + 1 of the first service in each bucket, 0: empty */
+  uint16_t serverHash[SD_SERVICE_HASH_SIZE];
+  uint16_t clientHash[SD_SERVICE_HASH_SIZE];
+  Sd_EventHandlerSubscriberType *subscriberHash[SD_SUBSCRIBER_HASH_SIZE];
+  uint32_t multicastTokens; /* in 1/1000 byte */
+  Sd_StatisticsType stats;
 } Sd_InstanceContextType;
 
 /* @ECUC_SD_00084 */
@@ -177,6 +207,7 @@ typedef struct {
   uint8_t *buffer;
   PduLengthType bufLen;
   Sd_InstanceContextType *context;
+  uint32_t MulticastBudget; /* bytes per second on the multicast socket, 0: unlimited */
 } Sd_InstanceType;
 
 struct Sd_Config_s {
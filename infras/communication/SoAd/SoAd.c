@@ -13,16 +13,85 @@
 #ifndef DISABLE_NET_MEM
 #include "NetMem.h"
 #endif
+#ifdef SOAD_USE_EPOLL
+#include <sys/epoll.h>
+#include <unistd.h>
+#endif
 /* ================================ [ MACROS    ] ============================================== */
 #define AS_LOG_SOAD 0
 #define AS_LOG_SOADE 2
 
 #define SOAD_CONFIG (&SoAd_Config)
+
+#ifndef SOAD_EPOLL_MAX_EVENTS
+#define SOAD_EPOLL_MAX_EVENTS 32
+#endif
 /* ================================ [ TYPES     ] ============================================== */
 /* ================================ [ DECLARES  ] ============================================== */
 extern const SoAd_ConfigType SoAd_Config;
 /* ================================ [ DATAS     ] ============================================== */
+#ifdef SOAD_USE_EPOLL
+static int soAdEpollFd = -1;
+#endif
+#ifdef SOAD_USE_RX_RING
+static uint32_t soAdMeasRxRingFull = 0;
+static uint32_t soAdMeasRxHoldOverdue = 0;
+#elif SOAD_UDP_RX_BATCH > 1
+static uint8_t soAdUdpRxBuf[SOAD_UDP_RX_BATCH][SOAD_UDP_RX_BUF_SIZE];
+#endif
 /* ================================ [ LOCALS    ] ============================================== */
+#ifdef SOAD_USE_EPOLL
+static void soAdReactorAdd(SoAd_SoConIdType SoConId) {
+  SoAd_SocketContextType *context = &SOAD_CONFIG->Contexts[SoConId];
+  struct epoll_event event;
+
+  event.events = EPOLLIN | EPOLLRDHUP | EPOLLET;
+  event.data.u32 = SoConId;
+  if (0 != epoll_ctl(soAdEpollFd, EPOLL_CTL_ADD, context->sock, &event)) {
+    ASLOG(SOADE, ("[%d] epoll add socket %d failed\n", SoConId, context->sock));
+  }
+  /* data may already be queued before the registration, service it once */
+  context->events = EPOLLIN;
+}
+
+static void soAdReactorDel(SoAd_SoConIdType SoConId) {
+  SoAd_SocketContextType *context = &SOAD_CONFIG->Contexts[SoConId];
+
+  (void)epoll_ctl(soAdEpollFd, EPOLL_CTL_DEL, context->sock, NULL);
+  context->events = 0;
+}
+
+static void soAdReactorWait(void) {
+  struct epoll_event events[SOAD_EPOLL_MAX_EVENTS];
+  int n, i;
+
+  do {
+    n = epoll_wait(soAdEpollFd, events, SOAD_EPOLL_MAX_EVENTS, 0);
+    for (i = 0; i < n; i++) {
+      if (events[i].data.u32 < SOAD_CONFIG->numOfConnections) {
+        SOAD_CONFIG->Contexts[events[i].data.u32].events |= events[i].events;
+      }
+    }
+  } while (SOAD_EPOLL_MAX_EVENTS == n);
+}
+#endif
+
+static void soAdSocketCloseMain(SoAd_SoConIdType SoConId) {
+  const SoAd_SocketConnectionType *connection = &SOAD_CONFIG->Connections[SoConId];
+  const SoAd_SocketConnectionGroupType *conG = &SOAD_CONFIG->ConnectionGroups[connection->GID];
+  SoAd_SocketContextType *context = &SOAD_CONFIG->Contexts[SoConId];
+
+#ifdef SOAD_USE_EPOLL
+  soAdReactorDel(SoConId);
+#endif
+  TcpIp_Close(context->sock, TRUE);
+  if (conG->SoConModeChgNotification) {
+    conG->SoConModeChgNotification(SoConId, SOAD_SOCON_OFFLINE);
+  }
+  context->state = SOAD_SOCKET_CLOSED;
+  ASLOG(SOADE, ("[%d] close, goto accept\n", SoConId));
+}
+
 static void soAdCreateSocket(SoAd_SoConIdType SoConId) {
   const SoAd_SocketConnectionType *connection = &SOAD_CONFIG->Connections[SoConId];
   const SoAd_SocketConnectionGroupType *conG = &SOAD_CONFIG->ConnectionGroups[connection->GID];
@@ -72,6 +141,9 @@ static void soAdCreateSocket(SoAd_SoConIdType SoConId) {
       context->state = SOAD_SOCKET_READY;
     }
     context->sock = sockId;
+#ifdef SOAD_USE_EPOLL
+    soAdReactorAdd(SoConId);
+#endif
     if (conG->SoConModeChgNotification) {
       conG->SoConModeChgNotification(SoConId, SOAD_SOCON_ONLINE);
     }
@@ -113,12 +185,150 @@ static void soAdSocketTpRxNotify(SoAd_SocketContextType *context,
   }
 }
 
-static void soAdSocketUdpReadyMain(SoAd_SoConIdType SoConId) {
+#ifdef SOAD_USE_RX_RING
+static void soAdRxRingCheckOverdue(SoAd_SoConIdType SoConId, SoAd_RxSlotType *rxSlot,
+                                   std_time_t now) {
+  if ((SOAD_RX_SLOT_HELD == rxSlot->state) && (FALSE == rxSlot->overdue) &&
+      ((now - rxSlot->holdTime) > SOAD_RX_HOLD_WARN_TIME)) {
+    rxSlot->overdue = TRUE;
+    soAdMeasRxHoldOverdue++;
+    ASLOG(SOADE, ("[%d] rx buffer held for %u us\n", SoConId, now - rxSlot->holdTime));
+  }
+}
+
+/* collect up to maxSlots free slots of the ring, return the number found */
+static uint8_t soAdRxRingAcquire(SoAd_SoConIdType SoConId, uint8_t *slots, uint8_t maxSlots) {
+  SoAd_RxRingType *rxRing = SOAD_CONFIG->Connections[SoConId].rxRing;
+  std_time_t now;
+  uint8_t slot;
+  uint8_t n = 0;
+  uint8_t i;
+
+  if (NULL == rxRing) {
+    ASLOG(SOADE, ("[%d] no rx ring assigned\n", SoConId));
+    return 0;
+  }
+
+  for (i = 0; (i < SOAD_RX_RING_SLOTS) && (n < maxSlots); i++) {
+    slot = (rxRing->head + i) % SOAD_RX_RING_SLOTS;
+    if (SOAD_RX_SLOT_FREE == rxRing->slots[slot].state) {
+      slots[n] = slot;
+      n++;
+    }
+  }
+
+  if (0 == n) {
+    /* all held by the upper layer, leave the data in the socket */
+    soAdMeasRxRingFull++;
+    now = Std_GetTime();
+    for (i = 0; i < SOAD_RX_RING_SLOTS; i++) {
+      soAdRxRingCheckOverdue(SoConId, &rxRing->slots[i], now);
+    }
+    ASLOG(SOAD, ("[%d] rx ring full\n", SoConId));
+  }
+
+  return n;
+}
+
+/* the slot is BUSY while the upper layer has it, that is what SoAd_HoldRxBuffer looks for */
+static void soAdRxRingDeliver(SoAd_SoConIdType SoConId, uint8_t slot, uint16_t rxLen) {
+  const SoAd_SocketConnectionType *connection = &SOAD_CONFIG->Connections[SoConId];
+  const SoAd_SocketConnectionGroupType *conG = &SOAD_CONFIG->ConnectionGroups[connection->GID];
+  SoAd_SocketContextType *context = &SOAD_CONFIG->Contexts[SoConId];
+  SoAd_RxSlotType *rxSlot = &connection->rxRing->slots[slot];
+
+  rxSlot->state = SOAD_RX_SLOT_BUSY;
+  if (conG->IsTP) {
+    soAdSocketTpRxNotify(context, connection, connection->rxRing->data[slot], rxLen);
+  } else {
+    soAdSocketIfRxNotify(context, connection, connection->rxRing->data[slot], rxLen);
+  }
+  if (SOAD_RX_SLOT_BUSY == rxSlot->state) {
+    /* not held, reuse it right away */
+    rxSlot->state = SOAD_RX_SLOT_FREE;
+  }
+}
+#endif
+
+#if SOAD_UDP_RX_BATCH > 1
+/* Drain the socket with batched receive, at most SOAD_UDP_RX_BUDGET batches per call so that one
+ * flooded socket can't starve the others. return E_OK if the budget ran out or the rx ring is full
+ * before the socket was drained. */
+static Std_ReturnType soAdSocketUdpReadyMain(SoAd_SoConIdType SoConId) {
+  SoAd_SocketContextType *context = &SOAD_CONFIG->Contexts[SoConId];
+  TcpIp_MsgType msgs[SOAD_UDP_RX_BATCH];
+#ifdef SOAD_USE_RX_RING
+  SoAd_RxRingType *rxRing = SOAD_CONFIG->Connections[SoConId].rxRing;
+  uint8_t slots[SOAD_UDP_RX_BATCH];
+#else
+  const SoAd_SocketConnectionType *connection = &SOAD_CONFIG->Connections[SoConId];
+  const SoAd_SocketConnectionGroupType *conG = &SOAD_CONFIG->ConnectionGroups[connection->GID];
+#endif
+  Std_ReturnType ret = E_OK;
+  uint16_t budget = SOAD_UDP_RX_BUDGET;
+  uint16_t number = 0;
+  uint16_t n;
+  uint16_t i;
+
+  do {
+#ifdef SOAD_USE_RX_RING
+    n = soAdRxRingAcquire(SoConId, slots, SOAD_UDP_RX_BATCH);
+    for (i = 0; i < n; i++) {
+      msgs[i].BufPtr = rxRing->data[slots[i]];
+      msgs[i].Length = SOAD_RX_RING_SLOT_SIZE;
+    }
+#else
+    n = SOAD_UDP_RX_BATCH;
+    for (i = 0; i < n; i++) {
+      msgs[i].BufPtr = soAdUdpRxBuf[i];
+      msgs[i].Length = SOAD_UDP_RX_BUF_SIZE;
+    }
+#endif
+    if (0 == n) {
+      break;
+    }
+    for (i = 0; i < n; i++) {
+      msgs[i].HeaderPtr = NULL;
+      msgs[i].HeaderLength = 0;
+    }
+    number = n;
+    ret = TcpIp_RecvFromBatch(context->sock, msgs, &number);
+    if (E_OK != ret) {
+      ASLOG(SOADE, ("[%d] UDP read failed\n", SoConId));
+    }
+    for (i = 0; i < number; i++) {
+      ASLOG(SOAD, ("[%d] UDP read %d bytes\n", SoConId, msgs[i].Length));
+      if (0 == msgs[i].Length) {
+        continue; /* dropped by TcpIp, e.g. truncated */
+      }
+      context->RemoteAddr = msgs[i].RemoteAddr;
+#ifdef SOAD_USE_RX_RING
+      soAdRxRingDeliver(SoConId, slots[i], msgs[i].Length);
+#else
+      if (conG->IsTP) {
+        soAdSocketTpRxNotify(context, connection, msgs[i].BufPtr, msgs[i].Length);
+      } else {
+        soAdSocketIfRxNotify(context, connection, msgs[i].BufPtr, msgs[i].Length);
+      }
+#endif
+    }
+    budget--;
+  } while ((E_OK == ret) && (n == number) && (budget > 0));
+
+  if ((E_OK == ret) && (0 != n) && (n != number)) {
+    ret = E_NOT_OK; /* drained */
+  }
+
+  return ret;
+}
+#else
+/* return E_OK if data was consumed, so the socket may still have more to read */
+static Std_ReturnType soAdSocketUdpReadyMain(SoAd_SoConIdType SoConId) {
   const SoAd_SocketConnectionType *connection = &SOAD_CONFIG->Connections[SoConId];
   const SoAd_SocketConnectionGroupType *conG = &SOAD_CONFIG->ConnectionGroups[connection->GID];
   SoAd_SocketContextType *context = &SOAD_CONFIG->Contexts[SoConId];
   Std_ReturnType ret = E_NOT_OK;
-  uint16_t rxLen;
+  uint16_t rxLen = 0;
   uint8_t *data = NULL;
 
 #ifndef DISABLE_NET_MEM
@@ -159,17 +369,58 @@ static void soAdSocketUdpReadyMain(SoAd_SoConIdType SoConId) {
     Net_MemFree(data);
 #endif
   }
+
+  if ((E_OK == ret) && (0 == rxLen)) {
+    ret = E_NOT_OK;
+  }
+
+  return ret;
+}
+#endif
+
+#ifdef SOAD_USE_RX_RING
+/* read the stream straight into a free slot of the connection's ring, a full ring leaves the data
+ * in the socket for a retry. return E_OK if data was consumed or the ring is full. */
+static Std_ReturnType soAdSocketTcpRxRingMain(SoAd_SoConIdType SoConId) {
+  SoAd_SocketContextType *context = &SOAD_CONFIG->Contexts[SoConId];
+  SoAd_RxRingType *rxRing = SOAD_CONFIG->Connections[SoConId].rxRing;
+  Std_ReturnType ret = E_OK;
+  uint16_t rxLen;
+  uint8_t slot;
+
+  if (0 != soAdRxRingAcquire(SoConId, &slot, 1)) {
+    rxLen = SOAD_RX_RING_SLOT_SIZE;
+    ret = TcpIp_Recv(context->sock, rxRing->data[slot], &rxLen);
+    if (E_OK == ret) {
+      if (rxLen > 0) {
+        ASLOG(SOAD, ("[%d] TCP read %d bytes\n", SoConId, rxLen));
+        soAdRxRingDeliver(SoConId, slot, rxLen);
+      } else {
+        ret = E_NOT_OK;
+      }
+    } else {
+      ASLOG(SOADE, ("[%d] TCP read failed\n", SoConId));
+    }
+  }
+
+  return ret;
 }
+#endif
 
-static void soAdSocketTcpReadyMain(SoAd_SoConIdType SoConId) {
+static Std_ReturnType soAdSocketTcpReadyMain(SoAd_SoConIdType SoConId) {
   const SoAd_SocketConnectionType *connection = &SOAD_CONFIG->Connections[SoConId];
   const SoAd_SocketConnectionGroupType *conG = &SOAD_CONFIG->ConnectionGroups[connection->GID];
   SoAd_SocketContextType *context = &SOAD_CONFIG->Contexts[SoConId];
   Std_ReturnType ret;
-  uint16_t rxLen;
+  uint16_t rxLen = 0;
   uint8_t *data = NULL;
 
   ret = TcpIp_IsTcpStatusOK(context->sock);
+#ifdef SOAD_USE_RX_RING
+  if ((E_OK == ret) && (NULL != connection->rxRing)) {
+    ret = soAdSocketTcpRxRingMain(SoConId);
+  } else
+#endif
   if (E_OK == ret) {
 #ifndef DISABLE_NET_MEM
     rxLen = TcpIp_Tell(context->sock);
@@ -209,17 +460,18 @@ static void soAdSocketTcpReadyMain(SoAd_SoConIdType SoConId) {
       Net_MemFree(data);
 #endif
     }
-  } else {
-    TcpIp_Close(context->sock, TRUE);
-    if (conG->SoConModeChgNotification) {
-      conG->SoConModeChgNotification(SoConId, SOAD_SOCON_OFFLINE);
+    if ((E_OK == ret) && (0 == rxLen)) {
+      ret = E_NOT_OK;
     }
-    context->state = SOAD_SOCKET_CLOSED;
-    ASLOG(SOADE, ("[%d] close, goto accept\n", SoConId));
+  } else {
+    soAdSocketCloseMain(SoConId);
   }
+
+  return ret;
 }
 
-static void soAdSocketAcceptMain(SoAd_SoConIdType SoConId) {
+/* return E_OK if a connection was taken from the listen backlog */
+static Std_ReturnType soAdSocketAcceptMain(SoAd_SoConIdType SoConId) {
   SoAd_SocketContextType *context = &SOAD_CONFIG->Contexts[SoConId];
   const SoAd_SocketConnectionType *connection = &SOAD_CONFIG->Connections[SoConId];
   const SoAd_SocketConnectionGroupType *conG = &SOAD_CONFIG->ConnectionGroups[connection->GID];
@@ -231,11 +483,13 @@ static void soAdSocketAcceptMain(SoAd_SoConIdType SoConId) {
   SoAd_SocketContextType *actCtx = NULL;
   const SoAd_SocketConnectionType *actCnt = NULL;
   TcpIp_SockAddrType RemoteAddr;
+  Std_ReturnType accepted = E_NOT_OK;
   int i;
 
   if (TCPIP_IPPROTO_TCP == conG->ProtocolType) {
     ret = TcpIp_TcpAccept(context->sock, &SocketId, &RemoteAddr);
     if (E_OK == ret) {
+      accepted = E_OK;
       ret = E_NOT_OK;
       for (i = 0; i < conG->numOfConnections; i++) {
         if (SOAD_SOCKET_CLOSED == SOAD_CONFIG->Contexts[i + conG->SoConId].state) {
@@ -256,6 +510,9 @@ static void soAdSocketAcceptMain(SoAd_SoConIdType SoConId) {
       }
     }
     if (E_OK == ret) {
+#ifdef SOAD_USE_EPOLL
+      soAdReactorAdd(i + conG->SoConId);
+#endif
       if (conG->SoConModeChgNotification) {
         conG->SoConModeChgNotification(i + conG->SoConId, SOAD_SOCON_ONLINE);
       }
@@ -269,17 +526,53 @@ static void soAdSocketAcceptMain(SoAd_SoConIdType SoConId) {
   } else {
     ASLOG(SOADE, ("[%d] UDP can't do accept\n", SoConId));
   }
+
+  return accepted;
 }
 
-static void soAdSocketReadyMain(SoAd_SoConIdType SoConId) {
+static Std_ReturnType soAdSocketReadyMain(SoAd_SoConIdType SoConId) {
   const SoAd_SocketConnectionType *connection = &SOAD_CONFIG->Connections[SoConId];
   const SoAd_SocketConnectionGroupType *conG = &SOAD_CONFIG->ConnectionGroups[connection->GID];
+  Std_ReturnType ret;
+
   if (TCPIP_IPPROTO_TCP == conG->ProtocolType) {
-    soAdSocketTcpReadyMain(SoConId);
+    ret = soAdSocketTcpReadyMain(SoConId);
   } else {
-    soAdSocketUdpReadyMain(SoConId);
+    ret = soAdSocketUdpReadyMain(SoConId);
+  }
+
+  return ret;
+}
+
+#ifdef SOAD_USE_EPOLL
+/* The sockets are registered edge triggered, so the pending events are kept until the socket is
+ * drained: one read per main function call as the polling mode does, but with no syscall at all
+ * for the idle connections. */
+static void soAdSocketEventMain(SoAd_SoConIdType SoConId) {
+  const SoAd_SocketConnectionType *connection = &SOAD_CONFIG->Connections[SoConId];
+  const SoAd_SocketConnectionGroupType *conG = &SOAD_CONFIG->ConnectionGroups[connection->GID];
+  SoAd_SocketContextType *context = &SOAD_CONFIG->Contexts[SoConId];
+  uint32_t events = context->events;
+  Std_ReturnType ret;
+
+  if (0 != events) {
+    if (SOAD_SOCKET_ACCEPT == context->state) {
+      ret = soAdSocketAcceptMain(SoConId);
+    } else {
+      ret = soAdSocketReadyMain(SoConId);
+    }
+
+    if (E_OK != ret) {
+      context->events = 0;
+      if ((SOAD_SOCKET_READY == context->state) && (TCPIP_IPPROTO_TCP == conG->ProtocolType) &&
+          (0 != (events & (EPOLLRDHUP | EPOLLHUP | EPOLLERR)))) {
+        /* peer closed and nothing left to read */
+        soAdSocketCloseMain(SoConId);
+      }
+    }
   }
 }
+#endif
 /* ================================ [ FUNCTIONS ] ============================================== */
 void SoAd_Init(const SoAd_ConfigType *ConfigPtr) {
   int i;
@@ -288,10 +581,27 @@ void SoAd_Init(const SoAd_ConfigType *ConfigPtr) {
   SoAd_SocketContextType *context;
 
   Net_MemInit();
+#ifdef SOAD_USE_EPOLL
+  if (soAdEpollFd < 0) {
+    soAdEpollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (soAdEpollFd < 0) {
+      ASLOG(SOADE, ("epoll create failed\n"));
+    }
+  }
+#endif
   for (i = 0; i < SOAD_CONFIG->numOfConnections; i++) {
     connection = &SOAD_CONFIG->Connections[i];
     context = &SOAD_CONFIG->Contexts[i];
     context->state = SOAD_SOCKET_CLOSED;
+#ifdef SOAD_USE_EPOLL
+    context->events = 0;
+#endif
+#ifdef SOAD_USE_RX_RING
+    if (NULL != connection->rxRing) {
+      memset(connection->rxRing->slots, 0, sizeof(connection->rxRing->slots));
+      connection->rxRing->head = 0;
+    }
+#endif
     if (connection->GID < SOAD_CONFIG->numOfGroups) {
       conG = &SOAD_CONFIG->ConnectionGroups[connection->GID];
       if (connection->isGroup && conG->AutomaticSoConSetup) {
@@ -308,18 +618,28 @@ void SoAd_MainFunction(void) {
   int i;
   SoAd_SocketContextType *context;
 
+#ifdef SOAD_USE_EPOLL
+  soAdReactorWait();
+#endif
   for (i = 0; i < SOAD_CONFIG->numOfConnections; i++) {
     context = &SOAD_CONFIG->Contexts[i];
     switch (context->state) {
     case SOAD_SOCKET_CREATE:
       soAdCreateSocket(i);
       break;
+#ifdef SOAD_USE_EPOLL
+    case SOAD_SOCKET_ACCEPT:
+    case SOAD_SOCKET_READY:
+      soAdSocketEventMain(i);
+      break;
+#else
     case SOAD_SOCKET_ACCEPT:
       soAdSocketAcceptMain(i);
       break;
     case SOAD_SOCKET_READY:
       soAdSocketReadyMain(i);
       break;
+#endif
     default:
       break;
     }
@@ -357,6 +677,29 @@ Std_ReturnType SoAd_IfTransmit(PduIdType TxPduId, const PduInfoType *PduInfoPtr)
   return ret;
 }
 
+Std_ReturnType SoAd_IfTransmitBatch(PduIdType TxPduId, const TcpIp_MsgType *Msgs,
+                                    uint16_t *Number /* InOut */) {
+  Std_ReturnType ret = E_NOT_OK;
+  SoAd_SoConIdType SoConId;
+  const SoAd_SocketConnectionType *connection;
+  const SoAd_SocketConnectionGroupType *conG;
+  SoAd_SocketContextType *context;
+
+  if ((TxPduId < SOAD_CONFIG->numOfTxPduIds) && (NULL != Msgs) && (NULL != Number)) {
+    SoConId = SOAD_CONFIG->TxPduIdToSoCondIdMap[TxPduId];
+    connection = &SOAD_CONFIG->Connections[SoConId];
+    conG = &SOAD_CONFIG->ConnectionGroups[connection->GID];
+    context = &SOAD_CONFIG->Contexts[SoConId];
+    if ((SOAD_SOCKET_READY == context->state) && (TCPIP_IPPROTO_UDP == conG->ProtocolType)) {
+      ret = TcpIp_SendToBatch(context->sock, Msgs, Number);
+    } else {
+      *Number = 0;
+    }
+  }
+
+  return ret;
+}
+
 Std_ReturnType SoAd_TpTransmit(PduIdType TxPduId, const PduInfoType *PduInfoPtr) {
   Std_ReturnType ret = E_NOT_OK;
   SoAd_SoConIdType SoConId;
@@ -379,6 +722,33 @@ Std_ReturnType SoAd_TpTransmit(PduIdType TxPduId, const PduInfoType *PduInfoPtr)
   return ret;
 }
 
+Std_ReturnType SoAd_TpTransmitPartial(PduIdType TxPduId, const PduInfoType *PduInfoPtr,
+                                      PduLengthType *SentLength) {
+  Std_ReturnType ret = E_NOT_OK;
+  SoAd_SoConIdType SoConId;
+  const SoAd_SocketConnectionType *connection;
+  const SoAd_SocketConnectionGroupType *conG;
+  SoAd_SocketContextType *context;
+  uint16_t length = 0;
+
+  if (TxPduId < SOAD_CONFIG->numOfTxPduIds) {
+    SoConId = SOAD_CONFIG->TxPduIdToSoCondIdMap[TxPduId];
+    connection = &SOAD_CONFIG->Connections[SoConId];
+    conG = &SOAD_CONFIG->ConnectionGroups[connection->GID];
+    context = &SOAD_CONFIG->Contexts[SoConId];
+    if (SOAD_SOCKET_READY == context->state) {
+      if (TCPIP_IPPROTO_TCP == conG->ProtocolType) {
+        length = (PduInfoPtr->SduLength > 0xFFFFu) ? 0xFFFFu : (uint16_t)PduInfoPtr->SduLength;
+        ret = TcpIp_SendPartial(context->sock, PduInfoPtr->SduDataPtr, &length);
+      }
+    }
+  }
+
+  *SentLength = length;
+
+  return ret;
+}
+
 Std_ReturnType SoAd_GetSoConId(PduIdType TxPduId, SoAd_SoConIdType *SoConIdPtr) {
   Std_ReturnType ret = E_NOT_OK;
 
@@ -433,6 +803,21 @@ Std_ReturnType SoAd_SetRemoteAddr(SoAd_SoConIdType SoConId,
 
   return ret;
 }
+Std_ReturnType SoAd_GetRemoteAddr(SoAd_SoConIdType SoConId, TcpIp_SockAddrType *IpAddrPtr) {
+  Std_ReturnType ret = E_NOT_OK;
+  SoAd_SocketContextType *context;
+
+  if ((SoConId < SOAD_CONFIG->numOfConnections) && (NULL != IpAddrPtr)) {
+    context = &SOAD_CONFIG->Contexts[SoConId];
+    if (SOAD_SOCKET_READY == context->state) {
+      *IpAddrPtr = context->RemoteAddr;
+      ret = E_OK;
+    }
+  }
+
+  return ret;
+}
+
 Std_ReturnType SoAd_OpenSoCon(SoAd_SoConIdType SoConId) {
   Std_ReturnType ret = E_NOT_OK;
   SoAd_SocketContextType *context;
@@ -458,6 +843,9 @@ Std_ReturnType SoAd_CloseSoCon(SoAd_SoConIdType SoConId, boolean abort) {
     connection = &SOAD_CONFIG->Connections[SoConId];
     conG = &SOAD_CONFIG->ConnectionGroups[connection->GID];
     if (SOAD_SOCKET_CLOSED != context->state) {
+#ifdef SOAD_USE_EPOLL
+      soAdReactorDel(SoConId);
+#endif
       ret = TcpIp_Close(context->sock, abort);
       if (E_OK == ret) {
         context->state = SOAD_SOCKET_CLOSED;
@@ -468,5 +856,108 @@ Std_ReturnType SoAd_CloseSoCon(SoAd_SoConIdType SoConId, boolean abort) {
     }
   }
 
+  return ret;
+}
+
+Std_ReturnType SoAd_GetAndResetMeasurementData(SoAd_MeasurementIdxType MeasurementIdx,
+                                               boolean MeasurementResetNeeded,
+                                               uint32_t *MeasurementDataPtr) {
+  Std_ReturnType ret = E_NOT_OK;
+#ifdef SOAD_USE_RX_RING
+  uint32_t *counter = NULL;
+
+  switch (MeasurementIdx) {
+  case SOAD_MEAS_RX_RING_FULL:
+    counter = &soAdMeasRxRingFull;
+    break;
+  case SOAD_MEAS_RX_HOLD_OVERDUE:
+    counter = &soAdMeasRxHoldOverdue;
+    break;
+  case SOAD_MEAS_ALL:
+    if (MeasurementResetNeeded) {
+      soAdMeasRxRingFull = 0;
+      soAdMeasRxHoldOverdue = 0;
+      ret = E_OK;
+    }
+    break;
+  default:
+    break;
+  }
+
+  if (NULL != counter) {
+    if (NULL != MeasurementDataPtr) {
+      *MeasurementDataPtr = *counter;
+    }
+    if (MeasurementResetNeeded) {
+      *counter = 0;
+    }
+    ret = E_OK;
+  }
+#else
+  (void)MeasurementIdx;
+  (void)MeasurementResetNeeded;
+  (void)MeasurementDataPtr;
+#endif
+
+  return ret;
+}
+
+Std_ReturnType SoAd_HoldRxBuffer(const uint8_t *DataPtr, SoAd_RxBufferRefType *RefPtr) {
+  Std_ReturnType ret = E_NOT_OK;
+#ifdef SOAD_USE_RX_RING
+  SoAd_RxRingType *rxRing;
+  SoAd_RxSlotType *rxSlot;
+  const uint8_t *base;
+  SoAd_SoConIdType SoConId;
+  uint8_t slot;
+
+  /* only a slot under delivery is BUSY, so the owner is found by the data address */
+  for (SoConId = 0; (SoConId < SOAD_CONFIG->numOfConnections) && (NULL != RefPtr); SoConId++) {
+    rxRing = SOAD_CONFIG->Connections[SoConId].rxRing;
+    if (NULL != rxRing) {
+      base = rxRing->data[0];
+      if ((DataPtr >= base) && (DataPtr < &base[sizeof(rxRing->data)])) {
+        slot = (uint8_t)((DataPtr - base) / SOAD_RX_RING_SLOT_SIZE);
+        rxSlot = &rxRing->slots[slot];
+        if (SOAD_RX_SLOT_BUSY == rxSlot->state) {
+          rxSlot->state = SOAD_RX_SLOT_HELD;
+          rxSlot->holdTime = Std_GetTime();
+          rxSlot->overdue = FALSE;
+          rxRing->head = (slot + 1) % SOAD_RX_RING_SLOTS;
+          *RefPtr = ((SoAd_RxBufferRefType)SoConId << 8) | slot;
+          ret = E_OK;
+        }
+        break;
+      }
+    }
+  }
+#else
+  (void)DataPtr;
+  (void)RefPtr;
+#endif
+
+  return ret;
+}
+
+Std_ReturnType SoAd_ReleaseRxBuffer(SoAd_RxBufferRefType Ref) {
+  Std_ReturnType ret = E_NOT_OK;
+#ifdef SOAD_USE_RX_RING
+  SoAd_SoConIdType SoConId = (SoAd_SoConIdType)(Ref >> 8);
+  uint8_t slot = (uint8_t)(Ref & 0xFF);
+  SoAd_RxSlotType *rxSlot;
+
+  if ((SoConId < SOAD_CONFIG->numOfConnections) && (slot < SOAD_RX_RING_SLOTS) &&
+      (NULL != SOAD_CONFIG->Connections[SoConId].rxRing)) {
+    rxSlot = &SOAD_CONFIG->Connections[SoConId].rxRing->slots[slot];
+    if (SOAD_RX_SLOT_HELD == rxSlot->state) {
+      soAdRxRingCheckOverdue(SoConId, rxSlot, Std_GetTime());
+      rxSlot->state = SOAD_RX_SLOT_FREE;
+      ret = E_OK;
+    }
+  }
+#else
+  (void)Ref;
+#endif
+
   return ret;
 }
\ No newline at end of file
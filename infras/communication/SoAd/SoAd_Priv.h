@@ -9,7 +9,52 @@
 /* ================================ [ INCLUDES  ] ============================================== */
 #include "ComStack_Types.h"
 #include "TcpIp.h"
+#include "Std_Timer.h"
 /* ================================ [ MACROS    ] ============================================== */
+/* On the linux socket build, SoAd_MainFunction is driven by an edge-triggered epoll reactor so
+ * that only the connections with pending events are serviced. The lwIP build keeps polling. */
+#if defined(linux) && !defined(USE_LWIP) && !defined(SOAD_DISABLE_EPOLL)
+#define SOAD_USE_EPOLL
+#endif
+
+/* number of datagrams read per TcpIp_RecvFromBatch call, 1 keeps the one read per pass mode */
+#ifndef SOAD_UDP_RX_BATCH
+#if defined(linux) && !defined(USE_LWIP)
+#define SOAD_UDP_RX_BATCH 16
+#else
+#define SOAD_UDP_RX_BATCH 1
+#endif
+#endif
+
+#ifndef SOAD_UDP_RX_BUF_SIZE
+#define SOAD_UDP_RX_BUF_SIZE 1472
+#endif
+
+/* max batches drained from one UDP socket per main function call */
+#ifndef SOAD_UDP_RX_BUDGET
+#define SOAD_UDP_RX_BUDGET 8
+#endif
+
+/* Zero copy receive: each UDP connection and each TCP data connection owns a ring of receive slots,
+ * the socket is read straight into a free slot and the upper layer gets it by reference, it may
+ * keep it beyond the rx callback by SoAd_HoldRxBuffer until SoAd_ReleaseRxBuffer. A TCP stream is
+ * read in pieces of at most SOAD_RX_RING_SLOT_SIZE. */
+#if defined(linux) && !defined(USE_LWIP) && !defined(SOAD_DISABLE_RX_RING)
+#define SOAD_USE_RX_RING
+#endif
+
+#ifndef SOAD_RX_RING_SLOTS
+#define SOAD_RX_RING_SLOTS 8
+#endif
+
+#ifndef SOAD_RX_RING_SLOT_SIZE
+#define SOAD_RX_RING_SLOT_SIZE SOAD_UDP_RX_BUF_SIZE
+#endif
+
+/* a slot held longer than this (us) is reported as allocator pressure */
+#ifndef SOAD_RX_HOLD_WARN_TIME
+#define SOAD_RX_HOLD_WARN_TIME 100000
+#endif
 /* ================================ [ TYPES     ] ============================================== */
 
 typedef void (*SoAd_SoConModeChgNotificationFncType)(SoAd_SoConIdType SoConId,
@@ -83,10 +128,32 @@ typedef struct {
   uint16_t Port;
 } SoAd_SocketRemoteAddressType;
 
+typedef enum
+{
+  SOAD_RX_SLOT_FREE,
+  SOAD_RX_SLOT_BUSY, /* being delivered to the upper layer */
+  SOAD_RX_SLOT_HELD, /* borrowed by the upper layer */
+} SoAd_RxSlotStateType;
+
+typedef struct {
+  std_time_t holdTime;
+  SoAd_RxSlotStateType state;
+  boolean overdue; /* already reported as held too long */
+} SoAd_RxSlotType;
+
+typedef struct {
+  SoAd_RxSlotType slots[SOAD_RX_RING_SLOTS];
+  uint8_t data[SOAD_RX_RING_SLOTS][SOAD_RX_RING_SLOT_SIZE];
+  uint8_t head; /* where to start looking for a free slot */
+} SoAd_RxRingType;
+
 /* @ECUC_SoAd_00009 */
 typedef struct {
 #ifdef DISABLE_NET_MEM
   uint8_t *rxBuf;
+#endif
+#ifdef SOAD_USE_RX_RING
+  SoAd_RxRingType *rxRing; /* NULL for a TCP listen socket */
 #endif
   PduIdType RxPduId;
   SoAd_SoConIdType SoConId;
@@ -124,6 +191,9 @@ typedef struct {
   int sock;
   SoAd_SocketStateType state;
   TcpIp_SockAddrType RemoteAddr;
+#ifdef SOAD_USE_EPOLL
+  uint32_t events; /* pending epoll events not yet fully serviced */
+#endif
 } SoAd_SocketContextType;
 
 struct SoAd_Config_s {
@@ -0,0 +1,297 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2026 Parai Wang <parai@foxmail.com>
+ *
+ * Stream a pattern over loopback TCP into an accepted SoAd connection: every byte reaches the
+ * upper layer in order, a buffer held by SoAd_HoldRxBuffer is not overwritten until it is
+ * released, a ring full of held buffers leaves the data in the socket, and the receive path does
+ * no Net_MemAlloc.
+ */
+/* ================================ [ INCLUDES  ] ============================================== */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include "SoAd.h"
+#include "SoAd_Priv.h"
+#include "NetMem.h"
+/* ================================ [ MACROS    ] ============================================== */
+#define TEST_PORT 13499
+#define TEST_TOTAL (4 * 1024 * 1024)
+#define TEST_MAX_HELD 16
+#define TEST_MAX_CYCLES 1000000
+
+#define TEST_SOCKID_SERVER 0
+#define TEST_SOCKID_APT0 1
+
+#define TEST_CHECK(cond)                                                                           \
+  do {                                                                                             \
+    if (!(cond)) {                                                                                 \
+      printf("  FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);                                     \
+      test_errors++;                                                                               \
+    }                                                                                              \
+  } while (0)
+/* ================================ [ TYPES     ] ============================================== */
+typedef struct {
+  SoAd_RxBufferRefType ref;
+  const uint8_t *data;
+  uint32_t offset; /* of data in the stream */
+  PduLengthType length;
+} test_held_t;
+/* ================================ [ DECLARES  ] ============================================== */
+static BufReq_ReturnType test_StartOfReception(PduIdType RxPduId, const PduInfoType *PduInfoPtr,
+                                               PduLengthType TpSduLength,
+                                               PduLengthType *bufferSizePtr);
+static BufReq_ReturnType test_CopyRxData(PduIdType RxPduId, const PduInfoType *PduInfoPtr,
+                                         PduLengthType *bufferSizePtr);
+static void test_SoConModeChg(SoAd_SoConIdType SoConId, SoAd_SoConModeType Mode);
+/* ================================ [ DATAS     ] ============================================== */
+static int test_errors;
+static uint32_t test_allocs;
+static uint32_t test_received;
+static int test_online;
+/* hold every buffer until the ring is full, then hold one in three */
+static boolean test_holdAll = TRUE;
+static test_held_t test_held[TEST_MAX_HELD];
+static int test_numOfHeld;
+static uint8_t test_stream[TEST_TOTAL];
+
+static const SoAd_TpInterfaceType test_TpIf = {
+  test_StartOfReception,
+  test_CopyRxData,
+  NULL,
+  NULL,
+  NULL,
+};
+
+#ifdef SOAD_USE_RX_RING
+static SoAd_RxRingType test_RxRing_APT0;
+#endif
+
+static const SoAd_SocketConnectionType test_Connections[] = {
+  {
+#ifdef SOAD_USE_RX_RING
+    .rxRing = NULL,
+#endif
+    .RxPduId = (PduIdType)-1,
+    .SoConId = TEST_SOCKID_SERVER,
+    .GID = 0,
+    .isGroup = TRUE,
+  },
+  {
+#ifdef SOAD_USE_RX_RING
+    .rxRing = &test_RxRing_APT0,
+#endif
+    .RxPduId = 0,
+    .SoConId = TEST_SOCKID_APT0,
+    .GID = 0,
+    .isGroup = FALSE,
+  },
+};
+
+static SoAd_SocketContextType test_Contexts[ARRAY_SIZE(test_Connections)];
+
+static const SoAd_SocketConnectionGroupType test_ConnectionGroups[] = {
+  {
+    &test_TpIf,         /* Interface */
+    NULL,               /* IpAddress */
+    test_SoConModeChg,  /* SoConModeChgNotification */
+    TCPIP_IPPROTO_TCP,  /* ProtocolType */
+    TEST_SOCKID_APT0,   /* SoConId */
+    TEST_PORT,          /* Port */
+    1,                  /* numOfConnections */
+    FALSE,              /* AutomaticSoConSetup */
+    TRUE,               /* IsTP */
+    TRUE,               /* IsServer */
+  },
+};
+
+static const SoAd_SoConIdType test_TxPduIdToSoCondIdMap[] = {
+  TEST_SOCKID_APT0,
+};
+
+const SoAd_ConfigType SoAd_Config = {
+  test_Connections,
+  test_Contexts,
+  ARRAY_SIZE(test_Connections),
+  test_TxPduIdToSoCondIdMap,
+  ARRAY_SIZE(test_TxPduIdToSoCondIdMap),
+  test_ConnectionGroups,
+  ARRAY_SIZE(test_ConnectionGroups),
+};
+/* ================================ [ LOCALS    ] ============================================== */
+static BufReq_ReturnType test_StartOfReception(PduIdType RxPduId, const PduInfoType *PduInfoPtr,
+                                               PduLengthType TpSduLength,
+                                               PduLengthType *bufferSizePtr) {
+  (void)RxPduId;
+  (void)PduInfoPtr;
+  (void)TpSduLength;
+  (void)bufferSizePtr;
+  return BUFREQ_OK;
+}
+
+static BufReq_ReturnType test_CopyRxData(PduIdType RxPduId, const PduInfoType *PduInfoPtr,
+                                         PduLengthType *bufferSizePtr) {
+  test_held_t *held;
+
+  (void)RxPduId;
+  (void)bufferSizePtr;
+  TEST_CHECK((test_received + PduInfoPtr->SduLength) <= TEST_TOTAL);
+  if ((test_received + PduInfoPtr->SduLength) <= TEST_TOTAL) {
+    TEST_CHECK(0 == memcmp(PduInfoPtr->SduDataPtr, &test_stream[test_received],
+                           PduInfoPtr->SduLength));
+  }
+
+  if ((test_numOfHeld < TEST_MAX_HELD) && (test_holdAll || (0 == (rand() % 3)))) {
+    held = &test_held[test_numOfHeld];
+#ifdef SOAD_USE_RX_RING
+    TEST_CHECK(E_OK == SoAd_HoldRxBuffer(PduInfoPtr->SduDataPtr, &held->ref));
+    /* only the upper layer in delivery may hold it */
+    TEST_CHECK(E_NOT_OK == SoAd_HoldRxBuffer(PduInfoPtr->SduDataPtr, &held->ref));
+    held->data = PduInfoPtr->SduDataPtr;
+    held->offset = test_received;
+    held->length = PduInfoPtr->SduLength;
+    test_numOfHeld++;
+#else
+    TEST_CHECK(E_NOT_OK == SoAd_HoldRxBuffer(PduInfoPtr->SduDataPtr, &held->ref));
+#endif
+  }
+
+  test_received += PduInfoPtr->SduLength;
+
+  return BUFREQ_OK;
+}
+
+static void test_SoConModeChg(SoAd_SoConIdType SoConId, SoAd_SoConModeType Mode) {
+  if ((TEST_SOCKID_APT0 == SoConId) && (SOAD_SOCON_ONLINE == Mode)) {
+    test_online++;
+  }
+}
+
+static void test_release(int index) {
+  test_held_t *held = &test_held[index];
+
+  TEST_CHECK(0 == memcmp(held->data, &test_stream[held->offset], held->length));
+  TEST_CHECK(E_OK == SoAd_ReleaseRxBuffer(held->ref));
+  TEST_CHECK(E_NOT_OK == SoAd_ReleaseRxBuffer(held->ref));
+  test_numOfHeld--;
+  test_held[index] = test_held[test_numOfHeld];
+}
+
+static void *test_client(void *param) {
+  struct sockaddr_in addr;
+  uint32_t offset = 0;
+  ssize_t n;
+  int fd;
+
+  (void)param;
+  fd = socket(AF_INET, SOCK_STREAM, 0);
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(TEST_PORT);
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  while (0 != connect(fd, (struct sockaddr *)&addr, sizeof(addr))) {
+    usleep(1000);
+  }
+  while (offset < TEST_TOTAL) {
+    n = send(fd, &test_stream[offset], TEST_TOTAL - offset, 0);
+    if (n <= 0) {
+      break;
+    }
+    offset += (uint32_t)n;
+  }
+  /* let the server drain it before the close */
+  sleep(1);
+  close(fd);
+
+  return NULL;
+}
+/* ================================ [ FUNCTIONS ] ============================================== */
+std_time_t Std_GetTime(void) {
+  struct timespec now;
+
+  (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+  return (std_time_t)((uint64_t)now.tv_sec * 1000000 + now.tv_nsec / 1000);
+}
+
+void Net_MemInit(void) {
+}
+
+uint8_t *Net_MemAlloc(uint32_t size) {
+  test_allocs++;
+  return (uint8_t *)malloc(size);
+}
+
+uint8_t *Net_MemGet(uint32_t *size) {
+  test_allocs++;
+  return (uint8_t *)malloc(*size);
+}
+
+void Net_MemFree(uint8_t *buffer) {
+  free(buffer);
+}
+
+int main(int argc, char *argv[]) {
+  pthread_t client;
+  uint32_t received;
+  uint32_t ringFull = 0;
+  uint32_t cycle;
+  int i;
+
+  (void)argc;
+  (void)argv;
+  srand(1);
+  for (i = 0; i < TEST_TOTAL; i++) {
+    test_stream[i] = (uint8_t)(i * 13 + (i >> 8));
+  }
+
+  SoAd_Init(NULL);
+  TEST_CHECK(E_OK == SoAd_OpenSoCon(TEST_SOCKID_SERVER));
+  pthread_create(&client, NULL, test_client, NULL);
+
+  for (cycle = 0; (cycle < TEST_MAX_CYCLES) && (test_received < TEST_TOTAL); cycle++) {
+    SoAd_MainFunction();
+#ifdef SOAD_USE_RX_RING
+    if (test_holdAll && (SOAD_RX_RING_SLOTS == test_numOfHeld)) {
+      /* nothing more may be delivered until a slot is released */
+      received = test_received;
+      for (i = 0; i < 10; i++) {
+        SoAd_MainFunction();
+      }
+      TEST_CHECK(received == test_received);
+      TEST_CHECK(E_OK == SoAd_GetAndResetMeasurementData(SOAD_MEAS_RX_RING_FULL, TRUE, &ringFull));
+      TEST_CHECK(ringFull > 0);
+      while (test_numOfHeld > 0) {
+        test_release(test_numOfHeld - 1);
+      }
+      test_holdAll = FALSE;
+    }
+#endif
+    if ((test_numOfHeld > 0) && (0 == (rand() % 2))) {
+      test_release(rand() % test_numOfHeld);
+    }
+    usleep(10);
+  }
+  while (test_numOfHeld > 0) {
+    test_release(test_numOfHeld - 1);
+  }
+  pthread_join(client, NULL);
+
+  printf("online %d, received %u of %u bytes in %u cycles, %u Net_MemAlloc, ring full %u\n",
+         test_online, test_received, TEST_TOTAL, cycle, test_allocs, ringFull);
+  TEST_CHECK(1 == test_online);
+  TEST_CHECK(TEST_TOTAL == test_received);
+#ifdef SOAD_USE_RX_RING
+  TEST_CHECK(FALSE == test_holdAll);
+  TEST_CHECK(0 == test_allocs);
+#endif
+
+  printf("%s, %d errors\n", (0 == test_errors) ? "PASS" : "FAIL", test_errors);
+
+  return (0 == test_errors) ? 0 : -1;
+}
@@ -55,6 +55,16 @@
 #define SOMEIP_TX_TP_MESSAGE_POOL_SIZE 8
 #endif
 
+/* number of hash buckets to look up the RX TP messages, must be power of 2 */
+#ifndef SOMEIP_RX_TP_HASH_SIZE
+#define SOMEIP_RX_TP_HASH_SIZE 16
+#endif
+
+/* how far ahead of the contiguous part a TP segment could be and still be accepted */
+#ifndef SOMEIP_TP_RX_WINDOW
+#define SOMEIP_TP_RX_WINDOW (64 * 1024)
+#endif
+
 #ifndef SOMEIP_TCP_BUFFER_POOL_SIZE
 #define SOMEIP_TCP_BUFFER_POOL_SIZE 8
 #endif
@@ -63,6 +73,56 @@
 #define SOMEIP_TX_NOK_RETRY_MAX 3
 #endif
 
+/* max number of TP segments of one message sent per main cycle */
+#ifndef SOMEIP_TP_TX_SEGMENTS_PER_CYCLE
+#define SOMEIP_TP_TX_SEGMENTS_PER_CYCLE 8
+#endif
+
+/* frames of the TP segments in flight: those built in one call, plus one per TCP message whose
+ * last segment the socket took only partly */
+#ifndef SOMEIP_TP_TX_FRAME_POOL_SIZE
+#define SOMEIP_TP_TX_FRAME_POOL_SIZE (SOMEIP_TP_TX_SEGMENTS_PER_CYCLE + 4)
+#endif
+
+/* bytes of all TP messages sent per main cycle, 0 for no limit. Use it to pace the TX to the
+ * rate the receivers could take, e.g. 100 KB/s with a 10 ms main cycle is 1024. */
+#ifndef SOMEIP_TP_TX_BYTES_PER_CYCLE
+#define SOMEIP_TP_TX_BYTES_PER_CYCLE 0
+#endif
+
+/* max number of subscribers notified by one SoAd_IfTransmitBatch call */
+#ifndef SOMEIP_NOTIFY_BATCH
+#define SOMEIP_NOTIFY_BATCH 16
+#endif
+
+/* max length of a SOME/IP message received over TCP, header included, larger ones are dropped.
+ * A message split over several reads is further limited by SOMEIP_TCP_RX_BUFFER_MAX. */
+#ifndef SOMEIP_TCP_RX_MSG_MAX
+#define SOMEIP_TCP_RX_MSG_MAX (64 * 1024)
+#endif
+
+/* initial size of the TCP reassembly buffer, it grows by doubling */
+#ifndef SOMEIP_TCP_RX_BUFFER_MIN
+#define SOMEIP_TCP_RX_BUFFER_MIN 256
+#endif
+
+/* the reassembly buffer comes from the Net pool, so a message split over several reads can't be
+ * larger than its largest block, a larger one is dropped */
+#ifndef SOMEIP_TCP_RX_BUFFER_MAX
+#define SOMEIP_TCP_RX_BUFFER_MAX MEMPOOL_NET_MAX_SIZE
+#endif
+
+/* max number of main cycles to retransmit the last value of an event to the subscribers which
+ * missed it */
+#ifndef SOMEIP_EVENT_RETRY_MAX
+#define SOMEIP_EVENT_RETRY_MAX 10
+#endif
+
+#define SOMEIP_EVENT_ALL_SUBSCRIBERS 0xFFFFFFFFUL
+/* only the first 32 subscribers are tracked for the retransmit, the generator makes sure no event
+ * group has more */
+#define SOMEIP_EVENT_SUBSCRIBER_BIT(i) (((i) < 32) ? (1UL << (i)) : 0UL)
+
 /* SQP: SOMEIP Queue and Pool */
 
 /* CRM: context RM */
@@ -74,15 +134,6 @@
     mp_free(&someIp##T##Pool, (uint8_t *)var);                                                     \
   } while (0)
 
-/* LRM: list RM */
-#define SQP_LRM_AND_FREE(T, var)                                                                   \
-  do {                                                                                             \
-    EnterCritical();                                                                               \
-    STAILQ_REMOVE(pending##T##s, var, SomeIp_##T##_s, entry);                                      \
-    ExitCritical();                                                                                \
-    mp_free(&someIp##T##Pool, (uint8_t *)var);                                                     \
-  } while (0)
-
 /* Context Append */
 #define SQP_CAPPEND(T, var)                                                                        \
   do {                                                                                             \
@@ -91,41 +142,44 @@
     ExitCritical();                                                                                \
   } while (0)
 
-/* List Append */
-#define SQP_LAPPEND(T, var)                                                                        \
-  do {                                                                                             \
-    EnterCritical();                                                                               \
-    STAILQ_INSERT_TAIL(pending##T##s, var, entry);                                                 \
-    ExitCritical();                                                                                \
-  } while (0)
-
 #define SQP_FREE(T, var)                                                                           \
   do {                                                                                             \
     mp_free(&someIp##T##Pool, (uint8_t *)var);                                                     \
   } while (0)
 
-#define SQP_CLEAR(T)                                                                               \
-  do {                                                                                             \
-    SomeIp_##T##Type *var;                                                                         \
-    var = STAILQ_FIRST(&context->pending##T##s);                                                   \
-    while (NULL != var) {                                                                          \
-      STAILQ_REMOVE_HEAD(&context->pending##T##s, entry);                                          \
-      mp_free(&someIp##T##Pool, (uint8_t *)var);                                                   \
-      var = STAILQ_FIRST(&context->pending##T##s);                                                 \
-    }                                                                                              \
-  } while (0)
+/* below this number of methods/events the linear search is faster, utils/someip_bench.c puts the
+ * crossover between 75 and 100 on the linux host */
+#ifndef SOMEIP_INDEX_SEARCH_MIN
+#define SOMEIP_INDEX_SEARCH_MIN 100
+#endif
+
+#define SOMEIP_USE_INDEX(table, num) ((NULL != (table)) && ((num) >= SOMEIP_INDEX_SEARCH_MIN))
 /* ================================ [ TYPES     ] ============================================== */
+/* a frame of the TP TX pool, a multiple of the pointer size as the pool links them */
+typedef union {
+  void *link;
+  uint8_t data[(SOMEIP_TP_FRAME_MAX + 7) & ~7];
+} SomeIp_TpTxFrameType;
 /* ================================ [ DECLARES  ] ============================================== */
 extern const SomeIp_ConfigType SomeIp_Config;
+#ifdef STD_TIMER_WHEEL
+static void SomeIp_RxTpMsgTimeout(void *param);
+#endif
 /* ================================ [ DATAS     ] ============================================== */
 static SomeIp_AsyncReqMsgType someIpAsyncReqMsgSlots[SOMEIP_ASYNC_REQUEST_MESSAGE_POOL_SIZE];
 static mempool_t someIpAsyncReqMsgPool;
 
 static SomeIp_RxTpMsgType someIpRxTpMsgSlots[SOMEIP_RX_TP_MESSAGE_POOL_SIZE];
 static mempool_t someIpRxTpMsgPool;
+static SomeIp_RxTpMsgType *someIpRxTpMsgHash[SOMEIP_RX_TP_HASH_SIZE];
 
 static SomeIp_TxTpMsgType someIpTxTpMsgSlots[SOMEIP_TX_TP_MESSAGE_POOL_SIZE];
 static mempool_t someIpTxTpMsgPool;
+
+static SomeIp_TpTxFrameType someIpTpTxFrameSlots[SOMEIP_TP_TX_FRAME_POOL_SIZE];
+static mempool_t someIpTpTxFramePool;
+
+static uint32_t someIpTpTxBudget;
 /* ================================ [ LOCALS    ] ============================================== */
 static Std_ReturnType SomeIp_DecodeHeader(const uint8_t *data, uint32_t length,
                                           SomeIp_HeaderType *header) {
@@ -195,58 +249,61 @@ static Std_ReturnType SomeIp_DecodeMsg(const PduInfoType *PduInfoPtr, SomeIp_Msg
   return ret;
 }
 
-static Std_ReturnType SomeIp_DecodeMsgTcp(uint8_t *header, uint8_t *data, uint32_t length,
-                                          const TcpIp_SockAddrType *RemoteAddr,
-                                          SomeIp_MsgType *msg) {
-  Std_ReturnType ret;
-  uint32_t offset;
+static uint32_t SomeIp_TcpMsgLength(const uint8_t *header) {
+  uint32_t length =
+    ((uint32_t)header[4] << 24) + ((uint32_t)header[5] << 16) + ((uint32_t)header[6] << 8) + header[7];
 
-  ret = SomeIp_DecodeHeader(header, length + 16, &msg->header);
-  if (E_OK == ret) {
-    msg->RemoteAddr = *RemoteAddr;
-    if (msg->header.isTpFlag) {
-      offset =
-        ((uint32_t)data[0] << 24) + ((uint32_t)data[1] << 16) + ((uint32_t)data[2] << 8) + data[3];
-      msg->tpHeader.offset = offset & 0xFFFFFFF0UL;
-      msg->tpHeader.moreSegmentsFlag = offset & 0x01;
-      msg->req.data = &data[4];
-      msg->req.length = length - 4;
-    } else {
-      msg->req.data = data;
-      msg->req.length = length;
-    }
+  if ((length < 8) || (length > (0xFFFFFFFFUL - 8))) {
+    length = 0; /* invalid, the stream is out of sync */
+  } else {
+    length += 8;
   }
 
-  return ret;
+  return length;
 }
 
-static Std_ReturnType SomeIp_HandleTcpHeader(SomeIp_TcpBufferType *tcpBuf, PduInfoType *PduInfoPtr,
-                                             SomeIp_MsgType *msg) {
-  Std_ReturnType ret;
-  uint32_t leftLen;
-  leftLen = sizeof(tcpBuf->header) - tcpBuf->lenOfHd;
-  if (PduInfoPtr->SduLength < leftLen) {
-    leftLen = PduInfoPtr->SduLength;
-  }
-  if (leftLen > 0) {
-    memcpy(&tcpBuf->header[tcpBuf->lenOfHd], PduInfoPtr->SduDataPtr, leftLen);
-    PduInfoPtr->SduDataPtr = &PduInfoPtr->SduDataPtr[leftLen];
-    PduInfoPtr->SduLength -= leftLen;
-    tcpBuf->lenOfHd += leftLen;
-  }
-
-  ASLOG(SOMEIP, ("header %d(+%d), data %d\n", tcpBuf->lenOfHd, leftLen, PduInfoPtr->SduLength));
+static Std_ReturnType SomeIp_TcpBufferReserve(SomeIp_TcpBufferType *tcpBuf, uint32_t size) {
+  Std_ReturnType ret = E_OK;
+  uint32_t newSize;
+  uint8_t *data;
 
-  if (sizeof(tcpBuf->header) == tcpBuf->lenOfHd) {
-    ret = SomeIp_DecodeMsgTcp(tcpBuf->header, PduInfoPtr->SduDataPtr, PduInfoPtr->SduLength,
-                              (const TcpIp_SockAddrType *)PduInfoPtr->MetaDataPtr, msg);
-  } else {
-    ret = SOMEIP_E_PENDING;
+  if (size > SOMEIP_TCP_RX_BUFFER_MAX) {
+    ret = E_NOT_OK;
+  } else if (size > tcpBuf->size) {
+    newSize = (0 == tcpBuf->size) ? SOMEIP_TCP_RX_BUFFER_MIN : (tcpBuf->size * 2);
+    if (newSize < size) {
+      newSize = size;
+    }
+    if (newSize > SOMEIP_TCP_RX_BUFFER_MAX) {
+      newSize = SOMEIP_TCP_RX_BUFFER_MAX;
+    }
+    data = Net_MemAlloc(newSize);
+    if (NULL == data) {
+      newSize = size;
+      data = Net_MemAlloc(newSize);
+    }
+    if (NULL != data) {
+      if (NULL != tcpBuf->data) {
+        memcpy(data, tcpBuf->data, tcpBuf->length);
+        Net_MemFree(tcpBuf->data);
+      }
+      tcpBuf->data = data;
+      tcpBuf->size = newSize;
+    } else {
+      ret = E_NOT_OK;
+    }
   }
 
   return ret;
 }
 
+static void SomeIp_TcpBufferFree(SomeIp_TcpBufferType *tcpBuf) {
+  if (NULL != tcpBuf->data) {
+    Net_MemFree(tcpBuf->data);
+  }
+  memset(tcpBuf, 0, sizeof(SomeIp_TcpBufferType));
+}
+
 static void SomeIp_BuildHeader(uint8_t *header, uint16_t serviceId, uint16_t methodId,
                                uint16_t clientId, uint16_t sessionId, uint8_t interfaceVersion,
                                uint8_t messageType, uint8_t returnCode, uint32_t payloadLength) {
@@ -314,6 +371,35 @@ static Std_ReturnType SomeIp_TransError(PduIdType TxPduId, TcpIp_SockAddrType *R
   return ret;
 }
 
+/* position of the first candidate of id, the index table could be NULL for a linear search */
+static uint16_t SomeIp_IndexFirst(const SomeIp_IndexType *table, uint16_t num, uint16_t id) {
+  uint16_t pos = 0;
+
+  if (SOMEIP_USE_INDEX(table, num)) {
+    pos = SomeIp_IndexLookup(table, num, id);
+  }
+
+  return pos;
+}
+
+/* array index of the candidate at pos, num if no more candidates */
+static uint16_t SomeIp_IndexAt(const SomeIp_IndexType *table, uint16_t num, uint16_t id,
+                               uint16_t pos) {
+  uint16_t index = num;
+
+  if (pos < num) {
+    if (FALSE == SOMEIP_USE_INDEX(table, num)) {
+      index = pos;
+    } else if (table[pos].id == id) {
+      index = table[pos].index;
+    } else {
+      /* no more */
+    }
+  }
+
+  return index;
+}
+
 static Std_ReturnType SomeIp_ReplyError(PduIdType TxPduId, SomeIp_MsgType *msg, uint8_t errorCode) {
   Std_ReturnType ret = SomeIp_TransError(
     TxPduId, &msg->RemoteAddr, msg->header.serviceId, msg->header.methodId, msg->header.clientId,
@@ -332,6 +418,9 @@ static void SomeIp_InitServer(const SomeIp_ServerServiceType *config) {
       memset(config->connections[i].tcpBuf, 0, sizeof(SomeIp_TcpBufferType));
     }
   }
+  for (i = 0; i < config->numOfEvents; i++) {
+    memset(config->events[i].context, 0, sizeof(SomeIp_ServerEventContextType));
+  }
 }
 
 static void SomeIp_InitClient(const SomeIp_ClientServiceType *config) {
@@ -344,83 +433,300 @@ static void SomeIp_InitClient(const SomeIp_ClientServiceType *config) {
   }
 }
 
+static uint32_t SomeIp_RxTpMsgHash(const void *owner, const TcpIp_SockAddrType *RemoteAddr,
+                                   uint16_t methodId, uint16_t clientId, uint16_t sessionId) {
+  uint32_t h;
+
+  h = (uint32_t)((uintptr_t)owner >> 3);
+  h ^= ((uint32_t)RemoteAddr->addr[0] << 24) + ((uint32_t)RemoteAddr->addr[1] << 16) +
+       ((uint32_t)RemoteAddr->addr[2] << 8) + RemoteAddr->addr[3];
+  h ^= ((uint32_t)RemoteAddr->port << 16) + methodId;
+  h ^= ((uint32_t)clientId << 16) + sessionId;
+  h *= 0x9E3779B1UL;
+
+  return (h >> 16) & (SOMEIP_RX_TP_HASH_SIZE - 1);
+}
+
 static SomeIp_RxTpMsgType *SomeIp_RxTpMsgFind(SomeIp_RxTpMsgList *pendingRxTpMsgs,
-                                              uint16_t methodId) {
+                                              uint16_t methodId, const SomeIp_MsgType *msg) {
   SomeIp_RxTpMsgType *rxTpMsg = NULL;
   SomeIp_RxTpMsgType *var;
+  uint32_t h = SomeIp_RxTpMsgHash(pendingRxTpMsgs, &msg->RemoteAddr, methodId,
+                                  msg->header.clientId, msg->header.sessionId);
   EnterCritical();
-  STAILQ_FOREACH(var, pendingRxTpMsgs, entry) {
-    if (var->methodId == methodId) {
+  for (var = someIpRxTpMsgHash[h]; (NULL != var) && (NULL == rxTpMsg); var = var->hnext) {
+    if ((var->owner == pendingRxTpMsgs) && (var->methodId == methodId) &&
+        (var->clientId == msg->header.clientId) && (var->sessionId == msg->header.sessionId) &&
+        (0 == memcmp(&var->RemoteAddr, &msg->RemoteAddr, sizeof(TcpIp_SockAddrType)))) {
       rxTpMsg = var;
-      break;
     }
   }
   ExitCritical();
   return rxTpMsg;
 }
 
+static Std_ReturnType SomeIp_RxTpMsgAdd(SomeIp_RxTpMsgList *pendingRxTpMsgs,
+                                        SomeIp_RxTpMsgType *rxTpMsg) {
+  Std_ReturnType ret = SOMEIP_E_NOMEM;
+  SomeIp_RxTpMsgType *var;
+  uint32_t used = 0;
+  uint8_t slot;
+  uint32_t h = SomeIp_RxTpMsgHash(pendingRxTpMsgs, &rxTpMsg->RemoteAddr, rxTpMsg->methodId,
+                                  rxTpMsg->clientId, rxTpMsg->sessionId);
+  rxTpMsg->owner = pendingRxTpMsgs;
+  EnterCritical();
+  STAILQ_FOREACH(var, pendingRxTpMsgs, entry) {
+    if ((var->methodId == rxTpMsg->methodId) && (var->slot < 32)) {
+      used |= (uint32_t)1 << var->slot;
+    }
+  }
+  for (slot = 0; (slot < 32) && (E_OK != ret); slot++) {
+    if (0 == (used & ((uint32_t)1 << slot))) {
+      rxTpMsg->slot = slot;
+      rxTpMsg->hnext = someIpRxTpMsgHash[h];
+      someIpRxTpMsgHash[h] = rxTpMsg;
+      STAILQ_INSERT_TAIL(pendingRxTpMsgs, rxTpMsg, entry);
+      ret = E_OK;
+    }
+  }
+  ExitCritical();
+
+  return ret;
+}
+
+static void SomeIp_RxTpMsgRemove(SomeIp_RxTpMsgList *pendingRxTpMsgs,
+                                 SomeIp_RxTpMsgType *rxTpMsg) {
+  SomeIp_RxTpMsgType **pp;
+  uint32_t h = SomeIp_RxTpMsgHash(pendingRxTpMsgs, &rxTpMsg->RemoteAddr, rxTpMsg->methodId,
+                                  rxTpMsg->clientId, rxTpMsg->sessionId);
+  EnterCritical();
+  pp = &someIpRxTpMsgHash[h];
+  while ((NULL != *pp) && (rxTpMsg != *pp)) {
+    pp = &(*pp)->hnext;
+  }
+  if (NULL != *pp) {
+    *pp = rxTpMsg->hnext;
+  }
+  STAILQ_REMOVE(pendingRxTpMsgs, rxTpMsg, SomeIp_RxTpMsg_s, entry);
+  ExitCritical();
+#ifdef STD_TIMER_WHEEL
+  Std_TimerEntryStop(&rxTpMsg->timer);
+#endif
+  mp_free(&someIpRxTpMsgPool, (uint8_t *)rxTpMsg);
+}
+
+/* timeout in main function cycles, restarting a running timer re-arms it */
+static void SomeIp_RxTpMsgStartTimer(SomeIp_RxTpMsgType *rxTpMsg, uint16_t timeout) {
+#ifdef STD_TIMER_WHEEL
+  Std_TimerEntryStart(&rxTpMsg->timer, (std_time64_t)timeout * SOMEIP_MAIN_FUNCTION_PERIOD * 1000,
+                      0);
+#else
+  rxTpMsg->timer = timeout;
+#endif
+}
+
+static void SomeIp_AsyncReqMsgRemove(SomeIp_AsyncReqMsgList *pendingAsyncReqMsgs,
+                                     SomeIp_AsyncReqMsgType *asyncReqMsg) {
+  EnterCritical();
+  STAILQ_REMOVE(pendingAsyncReqMsgs, asyncReqMsg, SomeIp_AsyncReqMsg_s, entry);
+  ExitCritical();
+  if (asyncReqMsg->rxHeld) {
+    (void)SoAd_ReleaseRxBuffer(asyncReqMsg->rxRef);
+  } else {
+    Net_MemFree(asyncReqMsg->req.data);
+  }
+  mp_free(&someIpAsyncReqMsgPool, (uint8_t *)asyncReqMsg);
+}
+
+static void SomeIp_ClearAsyncReqMsgs(SomeIp_AsyncReqMsgList *pendingAsyncReqMsgs) {
+  SomeIp_AsyncReqMsgType *var;
+  do {
+    EnterCritical();
+    var = STAILQ_FIRST(pendingAsyncReqMsgs);
+    ExitCritical();
+    if (NULL != var) {
+      SomeIp_AsyncReqMsgRemove(pendingAsyncReqMsgs, var);
+    }
+  } while (NULL != var);
+}
+
+static void SomeIp_ClearRxTpMsgs(SomeIp_RxTpMsgList *pendingRxTpMsgs) {
+  SomeIp_RxTpMsgType *var;
+  do {
+    EnterCritical();
+    var = STAILQ_FIRST(pendingRxTpMsgs);
+    ExitCritical();
+    if (NULL != var) {
+      SomeIp_RxTpMsgRemove(pendingRxTpMsgs, var);
+    }
+  } while (NULL != var);
+}
+
+/* Record the segment [start, end) in the ranges, returns SOMEIP_E_OK_SILENT if the segment should
+ * be ignored: duplicated, out of the window or too many gaps ahead. */
+static Std_ReturnType SomeIp_TpRxRangesUpdate(SomeIp_TpRxRangesType *rx, uint32_t start,
+                                              uint32_t end, boolean isLast) {
+  Std_ReturnType ret = E_OK;
+  uint8_t i;
+  uint8_t k;
+
+  if (isLast) {
+    if ((0 != rx->length) && (rx->length != end)) {
+      ret = SOMEIPXF_E_MALFORMED_MESSAGE;
+    } else if ((rx->numOfRanges > 0) && (rx->ranges[rx->numOfRanges - 1][1] > end)) {
+      ret = SOMEIPXF_E_MALFORMED_MESSAGE;
+    } else {
+      rx->length = end;
+    }
+  } else if ((0 != rx->length) && (end > rx->length)) {
+    ret = SOMEIPXF_E_MALFORMED_MESSAGE;
+  } else {
+  }
+
+  if (E_OK != ret) {
+    ASLOG(SOMEIPE, ("Tp segment [%u, %u) beyond the length %u\n", start, end, rx->length));
+  } else if (end <= rx->offset) {
+    ASLOG(SOMEIP, ("Tp segment [%u, %u) duplicated\n", start, end));
+    ret = SOMEIP_E_OK_SILENT;
+  } else if (start > (rx->offset + SOMEIP_TP_RX_WINDOW)) {
+    ASLOG(SOMEIPW, ("Tp segment [%u, %u) out of window at %u\n", start, end, rx->offset));
+    ret = SOMEIP_E_OK_SILENT;
+  } else if (start <= rx->offset) {
+    rx->offset = end;
+  } else {
+    /* find the first range which ends at or after start, merge all that overlaps [start, end) */
+    for (i = 0; (i < rx->numOfRanges) && (rx->ranges[i][1] < start); i++) {
+    }
+    k = i;
+    while ((k < rx->numOfRanges) && (rx->ranges[k][0] <= end)) {
+      if (rx->ranges[k][0] < start) {
+        start = rx->ranges[k][0];
+      }
+      if (rx->ranges[k][1] > end) {
+        end = rx->ranges[k][1];
+      }
+      k++;
+    }
+    if (k > i) { /* ranges i..k-1 merged into i */
+      rx->ranges[i][0] = start;
+      rx->ranges[i][1] = end;
+      memmove(&rx->ranges[i + 1], &rx->ranges[k], sizeof(rx->ranges[0]) * (rx->numOfRanges - k));
+      rx->numOfRanges -= k - i - 1;
+    } else if (rx->numOfRanges < SOMEIP_TP_RX_MAX_RANGES) {
+      memmove(&rx->ranges[i + 1], &rx->ranges[i], sizeof(rx->ranges[0]) * (rx->numOfRanges - i));
+      rx->ranges[i][0] = start;
+      rx->ranges[i][1] = end;
+      rx->numOfRanges++;
+    } else {
+      ASLOG(SOMEIPW, ("Tp segment [%u, %u) dropped, too many gaps\n", start, end));
+      ret = SOMEIP_E_OK_SILENT;
+    }
+  }
+
+  if (E_OK == ret) {
+    /* the contiguous part has grown, absorb the ranges it reaches */
+    i = 0;
+    while ((i < rx->numOfRanges) && (rx->ranges[i][0] <= rx->offset)) {
+      if (rx->ranges[i][1] > rx->offset) {
+        rx->offset = rx->ranges[i][1];
+      }
+      i++;
+    }
+    if (i > 0) {
+      memmove(&rx->ranges[0], &rx->ranges[i], sizeof(rx->ranges[0]) * (rx->numOfRanges - i));
+      rx->numOfRanges -= i;
+    }
+  }
+
+  return ret;
+}
+
 static Std_ReturnType
 SomeIp_ProcessRxTpMsg(uint16_t conId, SomeIp_RxTpMsgList *pendingRxTpMsgs, uint16_t methodId,
-                      SomeIp_OnTpCopyRxDataFncType onTpCopyRxData, SomeIp_MsgType *msg)
+                      SomeIp_OnTpCopyRxDataFncType onTpCopyRxData, SomeIp_MsgType *msg,
+                      PduIdType TxPduId, uint16_t serviceId)
 
 {
   Std_ReturnType ret = E_OK;
   SomeIp_TpMessageType tpMsg;
   SomeIp_RxTpMsgType *rxTpMsg = NULL;
+  SomeIp_TpRxRangesType rx;
+  boolean isComplete = FALSE;
+
   if (NULL != onTpCopyRxData) {
-    rxTpMsg = SomeIp_RxTpMsgFind(pendingRxTpMsgs, methodId);
+    rxTpMsg = SomeIp_RxTpMsgFind(pendingRxTpMsgs, methodId, msg);
     if (NULL == rxTpMsg) {
-      if ((0 == msg->tpHeader.offset) && (msg->tpHeader.moreSegmentsFlag)) {
-        ASLOG(SOMEIP, ("FF lenght = %d\n", msg->req.length));
+      /* the first received could be any segment but not a single one */
+      if ((0 != msg->tpHeader.offset) || (msg->tpHeader.moreSegmentsFlag)) {
+        ASLOG(SOMEIP, ("FF lenght = %d, offset = %d\n", msg->req.length, msg->tpHeader.offset));
         rxTpMsg = (SomeIp_RxTpMsgType *)mp_alloc(&someIpRxTpMsgPool);
         if (NULL == rxTpMsg) {
           ret = SOMEIP_E_NOMEM;
           ASLOG(SOMEIPE, ("OoM for Tp Rx\n"));
         } else {
-          rxTpMsg->offset = 0;
+          memset(&rxTpMsg->rx, 0, sizeof(rxTpMsg->rx));
+          rxTpMsg->methodId = methodId;
           rxTpMsg->clientId = msg->header.clientId;
           rxTpMsg->sessionId = msg->header.sessionId;
           rxTpMsg->RemoteAddr = msg->RemoteAddr;
-          rxTpMsg->timer = SOMEIP_CONFIG->TpRxTimeoutTime;
-          SQP_LAPPEND(RxTpMsg, rxTpMsg);
+#ifdef STD_TIMER_WHEEL
+          Std_TimerEntryInit(&rxTpMsg->timer, SomeIp_RxTpMsgTimeout, (void *)rxTpMsg);
+          rxTpMsg->TxPduId = TxPduId;
+          rxTpMsg->serviceId = serviceId;
+          rxTpMsg->messageMethodId = msg->header.methodId;
+          rxTpMsg->interfaceVersion = msg->header.interfaceVersion;
+#endif
+          ret = SomeIp_RxTpMsgAdd(pendingRxTpMsgs, rxTpMsg);
+          if (E_OK != ret) {
+            ASLOG(SOMEIPE, ("no Tp Rx slot for method %x\n", methodId));
+            mp_free(&someIpRxTpMsgPool, (uint8_t *)rxTpMsg);
+            rxTpMsg = NULL;
+          } else {
+            SomeIp_RxTpMsgStartTimer(rxTpMsg, SOMEIP_CONFIG->TpRxTimeoutTime);
+          }
         }
       } else {
         ret = SOMEIPXF_E_MALFORMED_MESSAGE;
-        ASLOG(SOMEIPE, ("Tp message malformed or loss\n"));
+        ASLOG(SOMEIPE, ("Tp message malformed\n"));
       }
     } else {
-      if ((rxTpMsg->clientId == msg->header.clientId) &&
-          (rxTpMsg->sessionId == msg->header.sessionId) &&
-          (rxTpMsg->offset == msg->tpHeader.offset) &&
-          (0 == memcmp(&rxTpMsg->RemoteAddr, &msg->RemoteAddr, sizeof(TcpIp_SockAddrType)))) {
-        ASLOG(SOMEIP,
-              ("%s lenght = %d, offset = %d\n", msg->tpHeader.moreSegmentsFlag ? "CF" : "LF",
-               msg->req.length, rxTpMsg->offset));
-        rxTpMsg->timer = SOMEIP_CONFIG->TpRxTimeoutTime;
-      } else {
-        SQP_LRM_AND_FREE(RxTpMsg, rxTpMsg);
-        ret = SOMEIPXF_E_MALFORMED_MESSAGE;
-        ASLOG(SOMEIPE, ("Tp message not as expected, loss maybe\n"));
-      }
+      ASLOG(SOMEIP,
+            ("%s lenght = %d, offset = %d\n", msg->tpHeader.moreSegmentsFlag ? "CF" : "LF",
+             msg->req.length, msg->tpHeader.offset));
+      SomeIp_RxTpMsgStartTimer(rxTpMsg, SOMEIP_CONFIG->TpRxTimeoutTime);
     }
   } else {
     ret = SOMEIPXF_E_MALFORMED_MESSAGE;
   }
 
+  if (E_OK == ret) {
+    rx = rxTpMsg->rx;
+    ret = SomeIp_TpRxRangesUpdate(&rx, msg->tpHeader.offset,
+                                  msg->tpHeader.offset + msg->req.length,
+                                  FALSE == msg->tpHeader.moreSegmentsFlag);
+    if (SOMEIPXF_E_MALFORMED_MESSAGE == ret) {
+      SomeIp_RxTpMsgRemove(pendingRxTpMsgs, rxTpMsg);
+    } else if (E_OK == ret) {
+      isComplete = (0 != rx.length) && (rx.offset >= rx.length);
+    } else {
+    }
+  }
+
   if (E_OK == ret) {
     tpMsg.data = msg->req.data;
     tpMsg.length = msg->req.length;
     tpMsg.offset = msg->tpHeader.offset;
-    tpMsg.moreSegmentsFlag = msg->tpHeader.moreSegmentsFlag;
+    tpMsg.moreSegmentsFlag = !isComplete;
+    tpMsg.slot = rxTpMsg->slot;
     ret = onTpCopyRxData(conId, &tpMsg);
     if (E_OK == ret) {
-      rxTpMsg->offset += msg->req.length;
-      if (msg->tpHeader.moreSegmentsFlag) {
+      rxTpMsg->rx = rx;
+      if (FALSE == isComplete) {
         ret = SOMEIP_E_OK_SILENT;
       } else {
         msg->req.data = tpMsg.data;
-        msg->req.length = rxTpMsg->offset;
-        SQP_LRM_AND_FREE(RxTpMsg, rxTpMsg);
+        msg->req.length = rx.length;
+        SomeIp_RxTpMsgRemove(pendingRxTpMsgs, rxTpMsg);
       }
     }
   }
@@ -428,58 +734,202 @@ SomeIp_ProcessRxTpMsg(uint16_t conId, SomeIp_RxTpMsgList *pendingRxTpMsgs, uint1
   return ret;
 }
 
-static Std_ReturnType SomeIp_SendNextTxTpMsg(PduIdType TxPduId, uint16_t conId, uint16_t serviceId,
-                                             uint16_t methodId, uint8_t interfaceVersion,
-                                             uint8_t messageType,
+static void SomeIp_TxTpMsgFreeTail(SomeIp_TxTpMsgType *txTpMsg) {
+  if (NULL != txTpMsg->tail) {
+    mp_free(&someIpTpTxFramePool, txTpMsg->tail);
+    txTpMsg->tail = NULL;
+  }
+}
+
+/* TCP: the message whose frame is only partly in the stream, no other frame may go into the stream
+ * before the rest of it. NULL when there is none. */
+static SomeIp_TxTpMsgType *SomeIp_FindTxTpTail(SomeIp_TxTpMsgList *pendingTxTpMsgs) {
+  SomeIp_TxTpMsgType *var;
+
+  EnterCritical();
+  var = STAILQ_FIRST(pendingTxTpMsgs);
+  while ((NULL != var) && (NULL == var->tail)) {
+    var = STAILQ_NEXT(var, entry);
+  }
+  ExitCritical();
+
+  return var;
+}
+
+static void SomeIp_TpTxCharge(uint32_t *budget, uint32_t length) {
+  if (NULL != budget) {
+    *budget = (*budget > length) ? (*budget - length) : 0;
+  }
+}
+
+/* Push the rest of the frame the TCP socket took only partly, its segment is sent once all of the
+ * frame is in the stream. */
+static Std_ReturnType SomeIp_SendTxTpTail(PduIdType TxPduId, SomeIp_TxTpMsgType *txTpMsg,
+                                          uint32_t *budget) {
+  Std_ReturnType ret;
+  PduInfoType PduInfo;
+  PduLengthType sentLength = 0;
+
+  PduInfo.SduDataPtr = &txTpMsg->tail[txTpMsg->tailOffset];
+  PduInfo.SduLength = txTpMsg->tailLength - txTpMsg->tailOffset;
+  PduInfo.MetaDataPtr = (uint8_t *)&txTpMsg->RemoteAddr;
+  ret = SoAd_TpTransmitPartial(TxPduId, &PduInfo, &sentLength);
+  txTpMsg->tailOffset += sentLength;
+  SomeIp_TpTxCharge(budget, sentLength);
+  if (txTpMsg->tailOffset >= txTpMsg->tailLength) {
+    txTpMsg->offset += txTpMsg->tailLength - 20;
+    SomeIp_TxTpMsgFreeTail(txTpMsg);
+  }
+
+  return ret;
+}
+
+static void SomeIp_ClearTxTpMsgs(SomeIp_TxTpMsgList *pendingTxTpMsgs) {
+  SomeIp_TxTpMsgType *var;
+  do {
+    EnterCritical();
+    var = STAILQ_FIRST(pendingTxTpMsgs);
+    if (NULL != var) {
+      STAILQ_REMOVE_HEAD(pendingTxTpMsgs, entry);
+    }
+    ExitCritical();
+    if (NULL != var) {
+      SomeIp_TxTpMsgFreeTail(var);
+      mp_free(&someIpTxTpMsgPool, (uint8_t *)var);
+    }
+  } while (NULL != var);
+}
+
+/* Send up to maxSegs segments of the TP message, each built in a frame of the TP TX pool and sent
+ * with one SoAd_IfTransmitBatch call for UDP. The budget is the bytes that could be sent, NULL for
+ * no limit, only the bytes really sent are taken from it. A socket which is full is not an error,
+ * the rest will be built and sent next time. Over TCP a frame the socket took only partly is kept
+ * as the tail of the message and its rest is sent first next time, nothing is sent twice. The
+ * other frames are only held during the call. */
+static Std_ReturnType SomeIp_SendNextTxTpMsg(PduIdType TxPduId, boolean isTcp, uint16_t conId,
+                                             uint16_t serviceId, uint16_t methodId,
+                                             uint8_t interfaceVersion, uint8_t messageType,
                                              SomeIp_OnTpCopyTxDataFncType onTpCopyTxData,
-                                             SomeIp_TxTpMsgType *txTpMsg) {
+                                             SomeIp_TxTpMsgType *txTpMsg, uint8_t maxSegs,
+                                             uint32_t *budget) {
   Std_ReturnType ret = E_OK;
+  Std_ReturnType txRet = E_OK;
   SomeIp_TpMessageType tpMsg;
-  uint32_t len = txTpMsg->length - txTpMsg->offset;
-  uint32_t offset = txTpMsg->offset;
-  uint8_t *data;
+  TcpIp_MsgType msgs[SOMEIP_TP_TX_SEGMENTS_PER_CYCLE];
+  PduInfoType PduInfo;
+  PduLengthType sentLength;
+  uint32_t offset;
+  uint32_t tpOffset;
+  uint32_t len;
+  uint32_t built = 0;
+  uint16_t number = 0;
+  uint16_t sent = 0;
+  uint16_t i;
+  uint8_t *frame;
+
+  if (maxSegs > SOMEIP_TP_TX_SEGMENTS_PER_CYCLE) {
+    maxSegs = SOMEIP_TP_TX_SEGMENTS_PER_CYCLE;
+  }
 
-  if (len > SOMEIP_TP_MAX) {
-    len = SOMEIP_TP_MAX;
-    offset |= 0x01; /* setup more flag */
-    tpMsg.moreSegmentsFlag = TRUE;
-  } else {
-    tpMsg.moreSegmentsFlag = FALSE;
+  if (NULL != txTpMsg->tail) {
+    txRet = SomeIp_SendTxTpTail(TxPduId, txTpMsg, budget);
+    if (NULL != txTpMsg->tail) {
+      maxSegs = 0; /* the stream is still behind this frame */
+    }
   }
 
-  data = Net_MemAlloc(len + 20);
-  if (NULL != data) {
-    tpMsg.data = &data[20];
-    tpMsg.length = len;
-    tpMsg.offset = txTpMsg->offset;
-    ret = onTpCopyTxData(conId, &tpMsg);
-    if (E_OK == ret) {
-      data[16] = (offset >> 24) & 0xFF;
-      data[17] = (offset >> 16) & 0xFF;
-      data[18] = (offset >> 8) & 0xFF;
-      data[19] = offset & 0xFF;
-      ret = SomeIp_Transmit(TxPduId, &txTpMsg->RemoteAddr, data, serviceId, methodId,
-                            txTpMsg->clientId, txTpMsg->sessionId, interfaceVersion,
-                            messageType | SOMEIP_TP_FLAG, E_OK, len + 4);
+  offset = txTpMsg->offset;
+  while ((E_OK == ret) && (E_OK == txRet) && (number < maxSegs) && (offset < txTpMsg->length) &&
+         ((NULL == budget) || (*budget > built))) {
+    frame = mp_alloc(&someIpTpTxFramePool);
+    if (NULL == frame) {
+      ASLOG(SOMEIPW, ("no TP frame, %d segments this time\n", number));
+      maxSegs = (uint8_t)number;
+    } else {
+      len = txTpMsg->length - offset;
+      tpOffset = offset;
+      if (len > SOMEIP_TP_MAX) {
+        len = SOMEIP_TP_MAX;
+        tpOffset |= 0x01; /* setup more flag */
+        tpMsg.moreSegmentsFlag = TRUE;
+      } else {
+        tpMsg.moreSegmentsFlag = FALSE;
+      }
+      tpMsg.data = &frame[20];
+      tpMsg.length = len;
+      tpMsg.offset = offset;
+      tpMsg.slot = 0;
+      ret = onTpCopyTxData(conId, &tpMsg);
       if (E_OK == ret) {
-        txTpMsg->offset += len;
-#ifndef DISABLE_SOMEIP_TX_NOK_RETRY
-      } else if ((E_NOT_OK == ret) && (txTpMsg->retryCounter < SOMEIP_TX_NOK_RETRY_MAX)) {
-        txTpMsg->retryCounter++;
-        ASLOG(SOMEIPW, ("Tx TP NOK, try %d\n", txTpMsg->retryCounter));
-        ret = E_OK;
-#endif
+        SomeIp_BuildHeader(frame, serviceId, methodId, txTpMsg->clientId, txTpMsg->sessionId,
+                           interfaceVersion, messageType | SOMEIP_TP_FLAG, E_OK, len + 4);
+        frame[16] = (tpOffset >> 24) & 0xFF;
+        frame[17] = (tpOffset >> 16) & 0xFF;
+        frame[18] = (tpOffset >> 8) & 0xFF;
+        frame[19] = tpOffset & 0xFF;
+        msgs[number].RemoteAddr = txTpMsg->RemoteAddr;
+        msgs[number].HeaderPtr = NULL;
+        msgs[number].HeaderLength = 0;
+        msgs[number].BufPtr = frame;
+        msgs[number].Length = (uint16_t)(len + 20);
+        number++;
+        offset += len;
+        built += len + 20;
       } else {
-        ASLOG(SOMEIPE, ("Tx TP NOK\n"));
+        mp_free(&someIpTpTxFramePool, frame);
       }
     }
-  } else {
-    ASLOG(SOMEIPW, ("OoM, schedule Tx TP msg next time\n"));
-    ret = E_OK;
   }
 
-  if (NULL != data) {
-    Net_MemFree(data);
+  if ((E_OK == ret) && (number > 0)) {
+    if (isTcp) {
+      PduInfo.MetaDataPtr = (uint8_t *)&txTpMsg->RemoteAddr;
+      for (i = 0; (E_OK == txRet) && (i < number); i++) {
+        PduInfo.SduDataPtr = msgs[i].BufPtr;
+        PduInfo.SduLength = msgs[i].Length;
+        sentLength = 0;
+        txRet = SoAd_TpTransmitPartial(TxPduId, &PduInfo, &sentLength);
+        if (sentLength >= msgs[i].Length) {
+          sent++;
+        } else if (sentLength > 0) {
+          /* the head of this frame is in the stream, keep the rest for the next time */
+          txTpMsg->tail = msgs[i].BufPtr;
+          txTpMsg->tailOffset = (uint16_t)sentLength;
+          txTpMsg->tailLength = msgs[i].Length;
+          msgs[i].BufPtr = NULL;
+          SomeIp_TpTxCharge(budget, sentLength);
+        } else {
+        }
+      }
+    } else {
+      sent = number;
+      txRet = SoAd_IfTransmitBatch(TxPduId, msgs, &sent);
+    }
+    for (i = 0; i < sent; i++) {
+      txTpMsg->offset += msgs[i].Length - 20;
+      SomeIp_TpTxCharge(budget, msgs[i].Length);
+    }
+  }
+
+  for (i = 0; i < number; i++) {
+    if (NULL != msgs[i].BufPtr) {
+      mp_free(&someIpTpTxFramePool, (uint8_t *)msgs[i].BufPtr);
+    }
+  }
+
+  if (E_OK != ret) {
+    ASLOG(SOMEIPE, ("Tx TP copy NOK\n"));
+  } else if (TCPIP_E_NOSPACE == txRet) {
+    ASLOG(SOMEIP, ("Tx TP %d/%d segments, socket full\n", sent, number));
+#ifndef DISABLE_SOMEIP_TX_NOK_RETRY
+  } else if ((E_NOT_OK == txRet) && (txTpMsg->retryCounter < SOMEIP_TX_NOK_RETRY_MAX)) {
+    txTpMsg->retryCounter++;
+    ASLOG(SOMEIPW, ("Tx TP NOK, try %d\n", txTpMsg->retryCounter));
+#endif
+  } else if (E_OK != txRet) {
+    ASLOG(SOMEIPE, ("Tx TP NOK\n"));
+    ret = txRet;
+  } else {
   }
 
   return ret;
@@ -506,12 +956,19 @@ static Std_ReturnType SomeIp_ReplyRequest(const SomeIp_ServerServiceType *config
 #ifndef DISABLE_SOMEIP_TX_NOK_RETRY
       txTpMsg->retryCounter = 0;
 #endif
-      ret = SomeIp_SendNextTxTpMsg(connection->TxPduId, conId, config->serviceId, method->methodId,
-                                   method->interfaceVersion, SOMEIP_MSG_RESPONSE,
-                                   method->onTpCopyTxData, txTpMsg);
+      txTpMsg->tail = NULL;
+      ret = SomeIp_SendNextTxTpMsg(
+        connection->TxPduId, (NULL != connection->tcpBuf), conId, config->serviceId,
+        method->methodId, method->interfaceVersion, SOMEIP_MSG_RESPONSE, method->onTpCopyTxData,
+        txTpMsg,
+        ((NULL != SomeIp_FindTxTpTail(&context->pendingTxTpMsgs)) || (NULL != context->eventTail))
+          ? 0
+          : 1,
+        NULL);
       if (E_OK == ret) {
         SQP_CAPPEND(TxTpMsg, txTpMsg);
       } else {
+        SomeIp_TxTpMsgFreeTail(txTpMsg);
         SQP_FREE(TxTpMsg, txTpMsg);
       }
     } else {
@@ -548,12 +1005,15 @@ static Std_ReturnType SomeIp_SendRequest(const SomeIp_ClientServiceType *config,
 #ifndef DISABLE_SOMEIP_TX_NOK_RETRY
       txTpMsg->retryCounter = 0;
 #endif
-      ret = SomeIp_SendNextTxTpMsg(config->TxPduId, 0, config->serviceId, method->methodId,
-                                   method->interfaceVersion, SOMEIP_MSG_REQUEST,
-                                   method->onTpCopyTxData, txTpMsg);
+      txTpMsg->tail = NULL;
+      ret = SomeIp_SendNextTxTpMsg(
+        config->TxPduId, (NULL != config->tcpBuf), 0, config->serviceId, method->methodId,
+        method->interfaceVersion, SOMEIP_MSG_REQUEST, method->onTpCopyTxData, txTpMsg,
+        (NULL != SomeIp_FindTxTpTail(&context->pendingTxTpMsgs)) ? 0 : 1, NULL);
       if (E_OK == ret) {
         SQP_CAPPEND(TxTpMsg, txTpMsg);
       } else {
+        SomeIp_TxTpMsgFreeTail(txTpMsg);
         SQP_FREE(TxTpMsg, txTpMsg);
       }
     } else {
@@ -613,9 +1073,26 @@ static Std_ReturnType SomeIp_ProcessRequest(const SomeIp_ServerServiceType *conf
       asyncReqMsg->sessionId = msg->header.sessionId;
       asyncReqMsg->methodId = methodId;
       asyncReqMsg->RemoteAddr = msg->RemoteAddr;
-      EnterCritical();
-      STAILQ_INSERT_TAIL(&context->pendingAsyncReqMsgs, asyncReqMsg, entry);
-      ExitCritical();
+      asyncReqMsg->req = msg->req;
+      /* keep the request where SoAd received it, copy only if it is not in a rx ring */
+      if (E_OK == SoAd_HoldRxBuffer(msg->req.data, &asyncReqMsg->rxRef)) {
+        asyncReqMsg->rxHeld = TRUE;
+      } else {
+        asyncReqMsg->rxHeld = FALSE;
+        asyncReqMsg->req.data = Net_MemAlloc(msg->req.length + 1);
+        if (NULL != asyncReqMsg->req.data) {
+          memcpy(asyncReqMsg->req.data, msg->req.data, msg->req.length);
+        }
+      }
+      if (NULL != asyncReqMsg->req.data) {
+        EnterCritical();
+        STAILQ_INSERT_TAIL(&context->pendingAsyncReqMsgs, asyncReqMsg, entry);
+        ExitCritical();
+      } else {
+        mp_free(&someIpAsyncReqMsgPool, (uint8_t *)asyncReqMsg);
+        ret = SOMEIP_E_NOMEM;
+        ASLOG(SOMEIPE, ("OoM for cache request data\n"));
+      }
     } else {
       ret = SOMEIP_E_NOMEM;
       ASLOG(SOMEIPE, ("OoM for cache request\n"));
@@ -636,8 +1113,15 @@ static Std_ReturnType SomeIp_HandleServerMessage_Request(const SomeIp_ServerServ
   const SomeIp_ServerConnectionType *connection = &config->connections[conId];
   SomeIp_ServerServiceContextType *context = connection->context;
   const SomeIp_ServerMethodType *method = NULL;
+  uint16_t pos;
 
-  for (methodId = 0; methodId < config->numOfMethods; methodId++) {
+  pos = SomeIp_IndexFirst(config->methodIndex, config->numOfMethods, msg->header.methodId);
+  for (; pos < config->numOfMethods; pos++) {
+    methodId =
+      SomeIp_IndexAt(config->methodIndex, config->numOfMethods, msg->header.methodId, pos);
+    if (methodId >= config->numOfMethods) {
+      break;
+    }
     if (config->methods[methodId].methodId == msg->header.methodId) {
       if (((0xFF == config->methods[methodId].interfaceVersion) ||
            (config->methods[methodId].interfaceVersion == msg->header.interfaceVersion))) {
@@ -653,7 +1137,8 @@ static Std_ReturnType SomeIp_HandleServerMessage_Request(const SomeIp_ServerServ
   if (E_OK == ret) {
     if (msg->header.isTpFlag) {
       ret = SomeIp_ProcessRxTpMsg(conId, &context->pendingRxTpMsgs, methodId,
-                                  method->onTpCopyRxData, msg);
+                                  method->onTpCopyRxData, msg, connection->TxPduId,
+                                  config->serviceId);
     }
   }
 
@@ -677,8 +1162,15 @@ static Std_ReturnType SomeIp_HandleClientMessage_Respose(const SomeIp_ClientServ
   const SomeIp_ClientMethodType *method = NULL;
   SomeIp_ClientServiceContextType *context = config->context;
   uint16_t methodId;
+  uint16_t pos;
 
-  for (methodId = 0; methodId < config->numOfMethods; methodId++) {
+  pos = SomeIp_IndexFirst(config->methodIndex, config->numOfMethods, msg->header.methodId);
+  for (; pos < config->numOfMethods; pos++) {
+    methodId =
+      SomeIp_IndexAt(config->methodIndex, config->numOfMethods, msg->header.methodId, pos);
+    if (methodId >= config->numOfMethods) {
+      break;
+    }
     if (config->methods[methodId].methodId == msg->header.methodId) {
       if (((0xFF == config->methods[methodId].interfaceVersion) ||
            (config->methods[methodId].interfaceVersion == msg->header.interfaceVersion))) {
@@ -693,8 +1185,8 @@ static Std_ReturnType SomeIp_HandleClientMessage_Respose(const SomeIp_ClientServ
 
   if (E_OK == ret) {
     if (msg->header.isTpFlag) {
-      ret =
-        SomeIp_ProcessRxTpMsg(0, &context->pendingRxTpMsgs, methodId, method->onTpCopyRxData, msg);
+      ret = SomeIp_ProcessRxTpMsg(0, &context->pendingRxTpMsgs, methodId, method->onTpCopyRxData,
+                                  msg, config->TxPduId, config->serviceId);
     }
   }
 
@@ -746,10 +1238,17 @@ static Std_ReturnType SomeIp_HandleServerMessage(const SomeIp_ServerServiceType
 static Std_ReturnType
 SomeIp_HandleClientMessage_Notification(const SomeIp_ClientServiceType *config,
                                         SomeIp_MsgType *msg) {
-  Std_ReturnType ret;
+  Std_ReturnType ret = SOMEIPXF_E_UNKNOWN_METHOD;
   const SomeIp_ClientEventType *event = NULL;
-  int i;
-  for (i = 0; i < config->numOfEvents; i++) {
+  uint16_t pos;
+  uint16_t i;
+
+  pos = SomeIp_IndexFirst(config->eventIndex, config->numOfEvents, msg->header.methodId);
+  for (; pos < config->numOfEvents; pos++) {
+    i = SomeIp_IndexAt(config->eventIndex, config->numOfEvents, msg->header.methodId, pos);
+    if (i >= config->numOfEvents) {
+      break;
+    }
     if (config->events[i].eventId == msg->header.methodId) {
       if (((0xFF == config->events[i].interfaceVersion) ||
            (config->events[i].interfaceVersion == msg->header.interfaceVersion))) {
@@ -763,8 +1262,6 @@ SomeIp_HandleClientMessage_Notification(const SomeIp_ClientServiceType *config,
 
   if (NULL != event) {
     ret = event->onNotification(&msg->req);
-  } else {
-    ret = SOMEIPXF_E_UNKNOWN_METHOD;
   }
 
   return ret;
@@ -819,7 +1316,7 @@ static void SomeIp_MainServerAsyncRequest(const SomeIp_ServerServiceType *config
     if (NULL != resData) {
       res.data = &resData[16];
       res.length = method->resMaxLen;
-      ret = method->onAsyncRequest(conId, &res);
+      ret = method->onAsyncRequest(conId, &ayncReqMsg->req, &res);
       res.data = resData;
       if (E_OK == ret) {
         ret = SomeIp_ReplyRequest(config, conId, ayncReqMsg->methodId, ayncReqMsg->clientId,
@@ -830,10 +1327,7 @@ static void SomeIp_MainServerAsyncRequest(const SomeIp_ServerServiceType *config
                                   method->interfaceVersion, SOMEIP_MSG_ERROR, ret);
         }
 
-        EnterCritical();
-        STAILQ_REMOVE(&context->pendingAsyncReqMsgs, ayncReqMsg, SomeIp_AsyncReqMsg_s, entry);
-        ExitCritical();
-        mp_free(&someIpAsyncReqMsgPool, (uint8_t *)ayncReqMsg);
+        SomeIp_AsyncReqMsgRemove(&context->pendingAsyncReqMsgs, ayncReqMsg);
       } else if (SOMEIP_E_PENDING == ret) {
         /* do nothing */
       } else {
@@ -841,10 +1335,7 @@ static void SomeIp_MainServerAsyncRequest(const SomeIp_ServerServiceType *config
                                 method->methodId, ayncReqMsg->clientId, ayncReqMsg->sessionId,
                                 method->interfaceVersion, SOMEIP_MSG_ERROR, ret);
 
-        EnterCritical();
-        STAILQ_REMOVE(&context->pendingAsyncReqMsgs, ayncReqMsg, SomeIp_AsyncReqMsg_s, entry);
-        ExitCritical();
-        mp_free(&someIpAsyncReqMsgPool, (uint8_t *)ayncReqMsg);
+        SomeIp_AsyncReqMsgRemove(&context->pendingAsyncReqMsgs, ayncReqMsg);
       }
       Net_MemFree(resData);
     } else {
@@ -854,6 +1345,22 @@ static void SomeIp_MainServerAsyncRequest(const SomeIp_ServerServiceType *config
   }
 }
 
+#ifdef STD_TIMER_WHEEL
+/* runs in the timer wheel task, which holds the same lock as the task running SomeIp_MainFunction */
+static void SomeIp_RxTpMsgTimeout(void *param) {
+  SomeIp_RxTpMsgType *rxTpMsg = (SomeIp_RxTpMsgType *)param;
+  Std_ReturnType ret;
+
+  ret = SomeIp_TransError(rxTpMsg->TxPduId, &rxTpMsg->RemoteAddr, rxTpMsg->serviceId,
+                          rxTpMsg->messageMethodId, rxTpMsg->clientId, rxTpMsg->sessionId,
+                          rxTpMsg->interfaceVersion, SOMEIP_MSG_ERROR, SOMEIPXF_E_TIMEOUT);
+  if (E_NOT_OK == ret) {
+    SomeIp_RxTpMsgStartTimer(rxTpMsg, 1); /* retry next time */
+  } else {
+    SomeIp_RxTpMsgRemove((SomeIp_RxTpMsgList *)rxTpMsg->owner, rxTpMsg);
+  }
+}
+#else
 static void SomeIp_MainServerRxTpMsg(const SomeIp_ServerServiceType *config, uint16_t conId) {
   const SomeIp_ServerConnectionType *connection = &config->connections[conId];
   SomeIp_ServerServiceContextType *context = connection->context;
@@ -880,58 +1387,404 @@ static void SomeIp_MainServerRxTpMsg(const SomeIp_ServerServiceType *config, uin
         if (E_NOT_OK == ret) {
           rxTpMsg->timer = 1; /* retry next time */
         } else {
-          EnterCritical();
-          STAILQ_REMOVE(&context->pendingRxTpMsgs, rxTpMsg, SomeIp_RxTpMsg_s, entry);
-          ExitCritical();
-          mp_free(&someIpRxTpMsgPool, (uint8_t *)rxTpMsg);
+          SomeIp_RxTpMsgRemove(&context->pendingRxTpMsgs, rxTpMsg);
         }
       }
     }
     rxTpMsg = next;
   }
 }
+#endif
+
+static void SomeIp_FreeEventTail(SomeIp_ServerServiceContextType *context) {
+  if (NULL != context->eventTail) {
+    Net_MemFree(context->eventTail);
+    context->eventTail = NULL;
+  }
+}
+
+/* Push the rest of the event frame the TCP socket took only partly, E_OK once nothing is left. A
+ * stream which can't take it any more is out of sync, the connection is closed. */
+static Std_ReturnType SomeIp_SendEventTail(const SomeIp_ServerConnectionType *connection) {
+  Std_ReturnType ret = E_OK;
+  SomeIp_ServerServiceContextType *context = connection->context;
+  PduInfoType PduInfo;
+  PduLengthType sentLength = 0;
+
+  if (NULL != context->eventTail) {
+    PduInfo.MetaDataPtr = NULL;
+    PduInfo.SduDataPtr = &context->eventTail[context->eventTailOffset];
+    PduInfo.SduLength = context->eventTailLength - context->eventTailOffset;
+    ret = SoAd_TpTransmitPartial(connection->TxPduId, &PduInfo, &sentLength);
+    context->eventTailOffset += sentLength;
+    if (context->eventTailOffset >= context->eventTailLength) {
+      SomeIp_FreeEventTail(context);
+      ret = E_OK;
+    } else if (TCPIP_E_NOSPACE != ret) {
+      ASLOG(SOMEIPE, ("SoConId %d: event tail lost, close\n", connection->SoConId));
+      SomeIp_FreeEventTail(context);
+      (void)SoAd_CloseSoCon(connection->SoConId, TRUE);
+      ret = E_NOT_OK;
+    } else {
+      /* socket full, the rest next time */
+    }
+  }
+
+  return ret;
+}
+
+/* Send the whole frame or keep what the TCP socket didn't take as the event tail of the connection,
+ * E_OK when all of it is in the stream or in the tail. */
+static Std_ReturnType SomeIp_SendEventFrameTcp(const SomeIp_ServerConnectionType *connection,
+                                               uint8_t *frame, uint32_t size) {
+  Std_ReturnType ret;
+  SomeIp_ServerServiceContextType *context = connection->context;
+  PduInfoType PduInfo;
+  PduLengthType sentLength = 0;
+
+  PduInfo.MetaDataPtr = NULL;
+  PduInfo.SduDataPtr = frame;
+  PduInfo.SduLength = size;
+  ret = SoAd_TpTransmitPartial(connection->TxPduId, &PduInfo, &sentLength);
+  if (sentLength >= size) {
+    ret = E_OK;
+  } else if (sentLength > 0) {
+    /* the head of this frame is in the stream, only its rest may follow */
+    context->eventTail = Net_MemAlloc(size - sentLength);
+    if (NULL != context->eventTail) {
+      memcpy(context->eventTail, &frame[sentLength], size - sentLength);
+      context->eventTailOffset = 0;
+      context->eventTailLength = size - sentLength;
+      ret = E_OK;
+    } else {
+      ASLOG(SOMEIPE, ("SoConId %d: OoM for event tail, close\n", connection->SoConId));
+      (void)SoAd_CloseSoCon(connection->SoConId, TRUE);
+      ret = E_NOT_OK;
+    }
+  } else if (E_OK == ret) {
+    ret = TCPIP_E_NOSPACE;
+  } else {
+  }
+
+  return ret;
+}
 
 static void SomeIp_MainServerTxTpMsg(const SomeIp_ServerServiceType *config, uint16_t conId) {
   const SomeIp_ServerConnectionType *connection = &config->connections[conId];
   SomeIp_ServerServiceContextType *context = connection->context;
   SomeIp_TxTpMsgType *txTpMsg;
   SomeIp_TxTpMsgType *next;
+  SomeIp_TxTpMsgType *tailMsg;
   const SomeIp_ServerMethodType *method = NULL;
   Std_ReturnType ret;
 
+  tailMsg = SomeIp_FindTxTpTail(&context->pendingTxTpMsgs);
   EnterCritical();
   txTpMsg = STAILQ_FIRST(&context->pendingTxTpMsgs);
   ExitCritical();
+  if (E_OK != SomeIp_SendEventTail(connection)) {
+    txTpMsg = NULL; /* the stream is still behind an event frame */
+  }
   while (NULL != txTpMsg) {
     EnterCritical();
     next = STAILQ_NEXT(txTpMsg, entry);
     ExitCritical();
     method = &config->methods[txTpMsg->methodId];
 
-    ret = SomeIp_SendNextTxTpMsg(connection->TxPduId, conId, config->serviceId, method->methodId,
-                                 method->interfaceVersion, SOMEIP_MSG_RESPONSE,
-                                 method->onTpCopyTxData, txTpMsg);
-    if (E_OK == ret) {
-      if (txTpMsg->offset >= txTpMsg->length) {
+    if ((NULL == tailMsg) || (tailMsg == txTpMsg)) {
+      ret = SomeIp_SendNextTxTpMsg(
+        connection->TxPduId, (NULL != connection->tcpBuf), conId, config->serviceId,
+        method->methodId, method->interfaceVersion, SOMEIP_MSG_RESPONSE, method->onTpCopyTxData,
+        txTpMsg, SOMEIP_TP_TX_SEGMENTS_PER_CYCLE,
+        (SOMEIP_TP_TX_BYTES_PER_CYCLE > 0) ? &someIpTpTxBudget : NULL);
+      tailMsg = (NULL != txTpMsg->tail) ? txTpMsg : NULL;
+      if ((E_OK != ret) || (txTpMsg->offset >= txTpMsg->length)) { /* done or abort this tx */
+        SomeIp_TxTpMsgFreeTail(txTpMsg);
         SQP_CRM_AND_FREE(TxTpMsg, txTpMsg);
+        tailMsg = NULL;
       }
-    } else { /* abort this tx */
-      SQP_CRM_AND_FREE(TxTpMsg, txTpMsg);
     }
     txTpMsg = next;
   }
 }
 
+static void SomeIp_SetEventSessionId(uint8_t *header, uint16_t sessionId) {
+  header[10] = (sessionId >> 8) & 0xFF;
+  header[11] = sessionId & 0xFF;
+}
+
+static uint32_t SomeIp_SendEventUdp(const SomeIp_ServerConnectionType *connection,
+                                    const uint8_t *header,
+                                    Sd_EventHandlerSubscriberType *Subscribers,
+                                    uint16_t numOfSubscribers, uint32_t mask, uint8_t *data,
+                                    uint32_t length) {
+  uint32_t failed = 0;
+  boolean isFull = FALSE;
+  Std_ReturnType ret;
+  Sd_EventHandlerSubscriberType *sub;
+  TcpIp_MsgType msgs[SOMEIP_NOTIFY_BATCH];
+  uint8_t headers[SOMEIP_NOTIFY_BATCH][16];
+  uint16_t index[SOMEIP_NOTIFY_BATCH];
+  uint16_t number;
+  uint16_t start;
+  uint16_t sent;
+  uint16_t i = 0;
+  uint16_t k;
+
+  /* the payload is shared by all subscribers, only the header differs by the sessionId, so
+   * send it with gather IO straight from the caller's buffer */
+  while (i < numOfSubscribers) {
+    number = 0;
+    for (; (i < numOfSubscribers) && (number < SOMEIP_NOTIFY_BATCH); i++) {
+      sub = &Subscribers[i];
+      if ((0 != sub->flags) &&
+          ((SOMEIP_EVENT_ALL_SUBSCRIBERS == mask) || (mask & SOMEIP_EVENT_SUBSCRIBER_BIT(i)))) {
+        if (0 == sub->sessionId) {
+          sub->sessionId = 1;
+        }
+        memcpy(headers[number], header, 16);
+        SomeIp_SetEventSessionId(headers[number], sub->sessionId);
+        msgs[number].RemoteAddr = sub->RemoteAddr;
+        msgs[number].HeaderPtr = headers[number];
+        msgs[number].HeaderLength = 16;
+        msgs[number].BufPtr = data;
+        msgs[number].Length = (uint16_t)length;
+        index[number] = i;
+        number++;
+      }
+    }
+
+    start = 0;
+    while ((start < number) && (FALSE == isFull)) {
+      sent = number - start;
+      ret = SoAd_IfTransmitBatch(connection->TxPduId, &msgs[start], &sent);
+      for (k = 0; k < sent; k++) {
+        Subscribers[index[start + k]].sessionId++;
+      }
+      start += sent;
+      if (start < number) {
+        sub = &Subscribers[index[start]];
+        ASLOG(SOMEIPW, ("Failed to notify %d.%d.%d.%d:%d: %d\n", sub->RemoteAddr.addr[0],
+                        sub->RemoteAddr.addr[1], sub->RemoteAddr.addr[2], sub->RemoteAddr.addr[3],
+                        sub->RemoteAddr.port, ret));
+        if (TCPIP_E_NOSPACE == ret) {
+          isFull = TRUE; /* no need to try the others */
+        } else {
+          failed |= SOMEIP_EVENT_SUBSCRIBER_BIT(index[start]);
+          start++;
+        }
+      }
+    }
+    for (; start < number; start++) {
+      failed |= SOMEIP_EVENT_SUBSCRIBER_BIT(index[start]);
+    }
+  }
+
+  return failed;
+}
+
+static const SomeIp_ServerConnectionType *
+SomeIp_FindTcpConnection(const SomeIp_ServerServiceType *config,
+                         const TcpIp_SockAddrType *RemoteAddr) {
+  const SomeIp_ServerConnectionType *connection = NULL;
+  TcpIp_SockAddrType addr;
+  uint16_t conId;
+
+  for (conId = 0; (conId < config->numOfConnections) && (NULL == connection); conId++) {
+    if (config->connections[conId].context->online) {
+      if (E_OK == SoAd_GetRemoteAddr(config->connections[conId].SoConId, &addr)) {
+        if (0 == memcmp(&addr, RemoteAddr, sizeof(TcpIp_SockAddrType))) {
+          connection = &config->connections[conId];
+        }
+      }
+    }
+  }
+
+  return connection;
+}
+
+static uint32_t SomeIp_SendEventTcp(const SomeIp_ServerServiceType *config, const uint8_t *header,
+                                    Sd_EventHandlerSubscriberType *Subscribers,
+                                    uint16_t numOfSubscribers, uint32_t mask, uint8_t *data,
+                                    uint32_t length) {
+  uint32_t failed = 0;
+  Sd_EventHandlerSubscriberType *sub;
+  const SomeIp_ServerConnectionType *connection;
+  uint32_t size = length + 16;
+  uint8_t *frame;
+  uint16_t i;
+
+  /* one frame for all, the stream needs the header and payload in one piece */
+  frame = Net_MemGet(&size);
+  if ((NULL != frame) && (size < (length + 16))) {
+    Net_MemFree(frame);
+    frame = NULL;
+  }
+  if (NULL != frame) {
+    memcpy(frame, header, 16);
+    memcpy(&frame[16], data, length);
+  }
+
+  for (i = 0; i < numOfSubscribers; i++) {
+    sub = &Subscribers[i];
+    if ((0 != sub->flags) &&
+        ((SOMEIP_EVENT_ALL_SUBSCRIBERS == mask) || (mask & SOMEIP_EVENT_SUBSCRIBER_BIT(i)))) {
+      connection = SomeIp_FindTcpConnection(config, &sub->RemoteAddr);
+      if ((NULL != frame) && (NULL != connection)) {
+        if (0 == sub->sessionId) {
+          sub->sessionId = 1;
+        }
+        SomeIp_SetEventSessionId(frame, sub->sessionId);
+        /* nothing goes into the stream while the head of another frame is waiting for its rest,
+         * the subscriber is retried then */
+        if ((E_OK == SomeIp_SendEventTail(connection)) &&
+            (NULL == SomeIp_FindTxTpTail(&connection->context->pendingTxTpMsgs)) &&
+            (E_OK == SomeIp_SendEventFrameTcp(connection, frame, length + 16))) {
+          sub->sessionId++;
+        } else {
+          failed |= SOMEIP_EVENT_SUBSCRIBER_BIT(i);
+        }
+      } else {
+        ASLOG(SOMEIPW, ("Failed to notify %d.%d.%d.%d:%d: %s\n", sub->RemoteAddr.addr[0],
+                        sub->RemoteAddr.addr[1], sub->RemoteAddr.addr[2], sub->RemoteAddr.addr[3],
+                        sub->RemoteAddr.port, (NULL == frame) ? "OoM" : "not connected"));
+        failed |= SOMEIP_EVENT_SUBSCRIBER_BIT(i);
+      }
+    }
+  }
+
+  if (NULL != frame) {
+    Net_MemFree(frame);
+  }
+
+  return failed;
+}
+
+/* Send the event to the subscribers selected by the mask, or to the multicast address once there
+ * are enough subscribers. The subscribers which missed it are reported by failed. */
+static Std_ReturnType SomeIp_SendEvent(const SomeIp_ServerServiceType *config,
+                                       const SomeIp_ServerEventType *event, uint32_t mask,
+                                       uint8_t *data, uint32_t length, uint32_t *failed,
+                                       boolean *failedMulticast) {
+  Std_ReturnType ret;
+  const SomeIp_ServerConnectionType *connection = &config->connections[0];
+  SomeIp_ServerEventContextType *context = event->context;
+  Sd_EventHandlerSubscriberType *Subscribers;
+  uint16_t numOfSubscribers;
+  TcpIp_MsgType msg;
+  uint8_t header[16];
+  uint16_t number = 1;
+
+  *failed = 0;
+  *failedMulticast = FALSE;
+  ret = Sd_GetSubscribers(event->sdHandleID, &Subscribers, &numOfSubscribers);
+  if (E_OK == ret) {
+    SomeIp_BuildHeader(header, config->serviceId, event->eventId, config->clientId, 0,
+                       event->interfaceVersion, SOMEIP_MSG_NOTIFICATION, 0, length);
+    if (NULL != connection->tcpBuf) {
+      *failed =
+        SomeIp_SendEventTcp(config, header, Subscribers, numOfSubscribers, mask, data, length);
+    } else if (FALSE == connection->context->online) {
+      ret = E_NOT_OK;
+    } else if (E_OK == Sd_GetMulticastAddr(event->sdHandleID, &msg.RemoteAddr)) {
+      if (0 == context->sessionId) {
+        context->sessionId = 1;
+      }
+      SomeIp_SetEventSessionId(header, context->sessionId);
+      msg.HeaderPtr = header;
+      msg.HeaderLength = 16;
+      msg.BufPtr = data;
+      msg.Length = (uint16_t)length;
+      if (E_OK == SoAd_IfTransmitBatch(connection->TxPduId, &msg, &number)) {
+        context->sessionId++;
+      } else {
+        ASLOG(SOMEIPW, ("Failed to notify event %x:%x by multicast\n", config->serviceId,
+                        event->eventId));
+        *failedMulticast = TRUE;
+      }
+    } else {
+      *failed = SomeIp_SendEventUdp(connection, header, Subscribers, numOfSubscribers, mask, data,
+                                    length);
+    }
+  }
+
+  return ret;
+}
+
+static void SomeIp_MainServerEvents(const SomeIp_ServerServiceType *config) {
+  const SomeIp_ServerEventType *event;
+  SomeIp_ServerEventContextType *context;
+  Std_ReturnType ret;
+  uint8_t *data;
+  uint32_t length = 0;
+  uint32_t pending = 0;
+  boolean pendingMulticast = FALSE;
+  uint8_t retryCounter = 0;
+  uint32_t failed;
+  boolean failedMulticast;
+  uint16_t i;
+
+  for (i = 0; i < config->numOfEvents; i++) {
+    event = &config->events[i];
+    context = event->context;
+    /* take the cached value, the SomeIp_Notification may replace it meanwhile */
+    EnterCritical();
+    data = context->data;
+    if (NULL != data) {
+      length = context->length;
+      pending = context->pending;
+      pendingMulticast = context->pendingMulticast;
+      retryCounter = context->retryCounter + 1;
+      context->data = NULL;
+    }
+    ExitCritical();
+    if (NULL != data) {
+      ret = SomeIp_SendEvent(config, event,
+                             pendingMulticast ? SOMEIP_EVENT_ALL_SUBSCRIBERS : pending, data,
+                             length, &failed, &failedMulticast);
+      if (E_OK == ret) {
+        pending = failed;
+        pendingMulticast = failedMulticast;
+      }
+      if ((E_OK == ret) && (0 == pending) && (FALSE == pendingMulticast)) {
+        ASLOG(SOMEIP, ("event %x:%x delivered after %d retries\n", config->serviceId,
+                       event->eventId, retryCounter));
+      } else if (retryCounter >= SOMEIP_EVENT_RETRY_MAX) {
+        ASLOG(SOMEIPE, ("event %x:%x lost for 0x%x\n", config->serviceId, event->eventId,
+                        pending));
+      } else {
+        EnterCritical();
+        if (NULL == context->data) { /* not replaced by a new value */
+          context->data = data;
+          context->length = length;
+          context->pending = pending;
+          context->pendingMulticast = pendingMulticast;
+          context->retryCounter = retryCounter;
+          data = NULL;
+        }
+        ExitCritical();
+      }
+      if (NULL != data) {
+        Net_MemFree(data);
+      }
+    }
+  }
+}
+
 static void SomeIp_MainServer(const SomeIp_ServerServiceType *config) {
   uint16_t conId;
 
   for (conId = 0; conId < config->numOfConnections; conId++) {
     SomeIp_MainServerAsyncRequest(config, conId);
     SomeIp_MainServerTxTpMsg(config, conId);
+#ifndef STD_TIMER_WHEEL
     SomeIp_MainServerRxTpMsg(config, conId);
+#endif
   }
+  SomeIp_MainServerEvents(config);
 }
 
+#ifndef STD_TIMER_WHEEL
 static void SomeIp_MainClientRxTpMsg(const SomeIp_ClientServiceType *config) {
   SomeIp_ClientServiceContextType *context = config->context;
   SomeIp_RxTpMsgType *rxTpMsg;
@@ -958,24 +1811,24 @@ static void SomeIp_MainClientRxTpMsg(const SomeIp_ClientServiceType *config) {
         if (E_NOT_OK == ret) {
           rxTpMsg->timer = 1; /* retry next time */
         } else {
-          EnterCritical();
-          STAILQ_REMOVE(&context->pendingRxTpMsgs, rxTpMsg, SomeIp_RxTpMsg_s, entry);
-          ExitCritical();
-          mp_free(&someIpRxTpMsgPool, (uint8_t *)rxTpMsg);
+          SomeIp_RxTpMsgRemove(&context->pendingRxTpMsgs, rxTpMsg);
         }
       }
     }
     rxTpMsg = next;
   }
 }
+#endif
 
 static void SomeIp_MainClientTxTpMsg(const SomeIp_ClientServiceType *config) {
   SomeIp_ClientServiceContextType *context = config->context;
   SomeIp_TxTpMsgType *txTpMsg;
   SomeIp_TxTpMsgType *next;
+  SomeIp_TxTpMsgType *tailMsg;
   const SomeIp_ClientMethodType *method = NULL;
   Std_ReturnType ret;
 
+  tailMsg = SomeIp_FindTxTpTail(&context->pendingTxTpMsgs);
   EnterCritical();
   txTpMsg = STAILQ_FIRST(&context->pendingTxTpMsgs);
   ExitCritical();
@@ -985,15 +1838,18 @@ static void SomeIp_MainClientTxTpMsg(const SomeIp_ClientServiceType *config) {
     ExitCritical();
     method = &config->methods[txTpMsg->methodId];
 
-    ret = SomeIp_SendNextTxTpMsg(config->TxPduId, 0, config->serviceId, method->methodId,
-                                 method->interfaceVersion, SOMEIP_MSG_REQUEST,
-                                 method->onTpCopyTxData, txTpMsg);
-    if (E_OK == ret) {
-      if (txTpMsg->offset >= txTpMsg->length) {
+    if ((NULL == tailMsg) || (tailMsg == txTpMsg)) {
+      ret = SomeIp_SendNextTxTpMsg(
+        config->TxPduId, (NULL != config->tcpBuf), 0, config->serviceId, method->methodId,
+        method->interfaceVersion, SOMEIP_MSG_REQUEST, method->onTpCopyTxData, txTpMsg,
+        SOMEIP_TP_TX_SEGMENTS_PER_CYCLE,
+        (SOMEIP_TP_TX_BYTES_PER_CYCLE > 0) ? &someIpTpTxBudget : NULL);
+      tailMsg = (NULL != txTpMsg->tail) ? txTpMsg : NULL;
+      if ((E_OK != ret) || (txTpMsg->offset >= txTpMsg->length)) { /* done or abort this tx */
+        SomeIp_TxTpMsgFreeTail(txTpMsg);
         SQP_CRM_AND_FREE(TxTpMsg, txTpMsg);
+        tailMsg = NULL;
       }
-    } else { /* abort this tx */
-      SQP_CRM_AND_FREE(TxTpMsg, txTpMsg);
     }
 
     txTpMsg = next;
@@ -1002,16 +1858,22 @@ static void SomeIp_MainClientTxTpMsg(const SomeIp_ClientServiceType *config) {
 
 static void SomeIp_MainClient(const SomeIp_ClientServiceType *config) {
   SomeIp_MainClientTxTpMsg(config);
+#ifndef STD_TIMER_WHEEL
   SomeIp_MainClientRxTpMsg(config);
+#endif
 }
 
 static void SomeIp_ServerServiceModeChg(const SomeIp_ServerServiceType *service, uint16_t conId,
                                         SoAd_SoConModeType Mode) {
   SomeIp_ServerServiceContextType *context = service->connections[conId].context;
   if (SOAD_SOCON_OFFLINE == Mode) {
-    SQP_CLEAR(AsyncReqMsg);
-    SQP_CLEAR(RxTpMsg);
-    SQP_CLEAR(TxTpMsg);
+    SomeIp_ClearAsyncReqMsgs(&context->pendingAsyncReqMsgs);
+    SomeIp_ClearRxTpMsgs(&context->pendingRxTpMsgs);
+    SomeIp_ClearTxTpMsgs(&context->pendingTxTpMsgs);
+    SomeIp_FreeEventTail(context);
+    if (NULL != service->connections[conId].tcpBuf) {
+      SomeIp_TcpBufferFree(service->connections[conId].tcpBuf);
+    }
     context->online = FALSE;
   } else {
     context->online = TRUE;
@@ -1023,8 +1885,11 @@ static void SomeIp_ClientServiceModeChg(const SomeIp_ClientServiceType *service,
   SomeIp_ClientServiceContextType *context = service->context;
 
   if (SOAD_SOCON_OFFLINE == Mode) {
-    SQP_CLEAR(RxTpMsg);
-    SQP_CLEAR(TxTpMsg);
+    SomeIp_ClearRxTpMsgs(&context->pendingRxTpMsgs);
+    SomeIp_ClearTxTpMsgs(&context->pendingTxTpMsgs);
+    if (NULL != service->tcpBuf) {
+      SomeIp_TcpBufferFree(service->tcpBuf);
+    }
     context->online = FALSE;
     service->onAvailability(FALSE);
   } else {
@@ -1064,6 +1929,24 @@ static Std_ReturnType SomeIp_HandleRxMsg(PduIdType RxPduId, SomeIp_MsgType *msg)
 
   return ret;
 }
+
+/* decode and dispatch one complete message of the TCP stream, in place */
+static void SomeIp_TcpRxMsg(PduIdType RxPduId, uint8_t *data, uint32_t length,
+                            const PduInfoType *PduInfoPtr) {
+  Std_ReturnType ret;
+  SomeIp_MsgType msg;
+  PduInfoType PduInfo;
+
+  PduInfo.SduDataPtr = data;
+  PduInfo.SduLength = length;
+  PduInfo.MetaDataPtr = PduInfoPtr->MetaDataPtr;
+  ret = SomeIp_DecodeMsg(&PduInfo, &msg);
+  if (E_OK == ret) {
+    (void)SomeIp_HandleRxMsg(RxPduId, &msg);
+  } else {
+    ASLOG(SOMEIPE, ("TCP message malformed: %d\n", ret));
+  }
+}
 /* ================================ [ FUNCTIONS ] ============================================== */
 void SomeIp_RxIndication(PduIdType RxPduId, const PduInfoType *PduInfoPtr) {
   SomeIp_MsgType msg;
@@ -1086,14 +1969,14 @@ BufReq_ReturnType SomeIp_SoAdTpStartOfReception(PduIdType RxPduId, const PduInfo
 BufReq_ReturnType SomeIp_SoAdTpCopyRxData(PduIdType RxPduId, const PduInfoType *PduInfoPtr,
                                           PduLengthType *bufferSizePtr) {
   BufReq_ReturnType bret = BUFREQ_E_NOT_OK;
-  Std_ReturnType ret = E_NOT_OK;
-  SomeIp_MsgType msg;
   const SomeIp_ClientServiceType *cs;
   const SomeIp_ServerServiceType *ss;
   SomeIp_TcpBufferType *tcpBuf = NULL;
-  PduInfoType PduInfo;
+  uint8_t *data;
   uint16_t index;
-  uint32_t leftLen;
+  PduLengthType leftLen;
+  uint32_t copyLen;
+  uint32_t msgLen;
 
   if (RxPduId < SOMEIP_CONFIG->numOfPIDs) {
     index = SOMEIP_CONFIG->PID2ServiceMap[RxPduId];
@@ -1111,76 +1994,90 @@ BufReq_ReturnType SomeIp_SoAdTpCopyRxData(PduIdType RxPduId, const PduInfoType *
 
   *bufferSizePtr = 0;
   if (NULL != tcpBuf) {
-    PduInfo = *PduInfoPtr;
-    ASLOG(SOMEIP, ("Tcp input(%d)\n", PduInfo.SduLength));
-    while (PduInfo.SduLength > 0) {
-      if (NULL == tcpBuf->data) {
-        ret = SomeIp_HandleTcpHeader(tcpBuf, &PduInfo, &msg);
-        if (E_OK == ret) {
-          ASLOG(SOMEIP, ("consume all\n"));
-          SomeIp_HandleRxMsg(RxPduId, &msg);
-          *bufferSizePtr += msg.header.length + 8;
-          memset(tcpBuf, 0, sizeof(SomeIp_TcpBufferType));
-          PduInfo.SduLength = 0;
-          bret = BUFREQ_OK;
-        } else if (SOMEIP_E_PENDING == ret) {
-          /* do nothing as header not full */
-          ASLOG(SOMEIP, ("not enough header, wait\n"));
-        } else if (SOMEIP_E_MSG_TOO_SHORT == ret) {
-          tcpBuf->data = Net_MemAlloc(msg.header.length - 8);
-          if (NULL != tcpBuf->data) {
-            tcpBuf->length = msg.header.length - 8;
-            tcpBuf->offset = PduInfo.SduLength;
-            memcpy(tcpBuf->data, PduInfo.SduDataPtr, PduInfo.SduLength);
-            *bufferSizePtr += msg.header.length + 8;
-            PduInfo.SduLength = 0;
-            bret = BUFREQ_OK;
-            ASLOG(SOMEIP, ("too short, offset %d, length %d\n", tcpBuf->offset, tcpBuf->length));
-          } else {
-            memset(tcpBuf, 0, sizeof(SomeIp_TcpBufferType));
-            ASLOG(SOMEIPE, ("OoM for tcp buffer, abort\n"));
-          }
-        } else if (SOMEIP_E_MSG_TOO_LARGE == ret) {
-          leftLen = PduInfo.SduLength - (msg.header.length - 8);
-          PduInfo.SduLength = msg.header.length - 8;
-          ASLOG(SOMEIP, ("too large, consume %d, left %d\n", PduInfo.SduLength, leftLen));
-          ret = SomeIp_DecodeMsgTcp(tcpBuf->header, PduInfo.SduDataPtr, PduInfo.SduLength,
-                                    (const TcpIp_SockAddrType *)PduInfo.MetaDataPtr, &msg);
-          if (E_OK == ret) {
-            SomeIp_HandleRxMsg(RxPduId, &msg);
+    data = PduInfoPtr->SduDataPtr;
+    leftLen = PduInfoPtr->SduLength;
+    ASLOG(SOMEIP, ("Tcp input(%d)\n", leftLen));
+    bret = BUFREQ_OK;
+    while (leftLen > 0) {
+      if (tcpBuf->discard > 0) {
+        /* the rest of a message which can't be buffered */
+        copyLen = (tcpBuf->discard < leftLen) ? tcpBuf->discard : leftLen;
+        tcpBuf->discard -= copyLen;
+      } else if (tcpBuf->length > 0) {
+        /* continue the split message, the header first */
+        msgLen = 16;
+        if (tcpBuf->length >= 16) {
+          msgLen = SomeIp_TcpMsgLength(tcpBuf->data);
+        }
+        copyLen = msgLen - tcpBuf->length;
+        if (copyLen > leftLen) {
+          copyLen = leftLen;
+        }
+        memcpy(&tcpBuf->data[tcpBuf->length], data, copyLen);
+        tcpBuf->length += copyLen;
+        if (16 == tcpBuf->length) {
+          msgLen = SomeIp_TcpMsgLength(tcpBuf->data);
+          if (0 == msgLen) {
+            ASLOG(SOMEIPE, ("TCP message malformed, drop %d bytes\n", leftLen - copyLen));
+            tcpBuf->discard = leftLen - copyLen;
+            tcpBuf->length = 0;
+            bret = BUFREQ_E_NOT_OK;
+          } else if ((msgLen > SOMEIP_TCP_RX_MSG_MAX) ||
+                     (E_OK != SomeIp_TcpBufferReserve(tcpBuf, msgLen))) {
+            ASLOG(SOMEIPE, ("TCP message of %u bytes dropped\n", msgLen));
+            tcpBuf->discard = msgLen - 16;
+            tcpBuf->length = 0;
+            bret = BUFREQ_E_NOT_OK;
           } else {
-            ASLOG(SOMEIPE, ("Fatal Protol error\n"));
+            /* buffered, wait for the rest */
           }
-          memset(tcpBuf, 0, sizeof(SomeIp_TcpBufferType));
-          PduInfo.SduDataPtr = &PduInfo.SduDataPtr[PduInfo.SduLength];
-          PduInfo.SduLength = leftLen;
+        }
+        if ((tcpBuf->length >= 16) && (tcpBuf->length == msgLen)) {
+          SomeIp_TcpRxMsg(RxPduId, tcpBuf->data, msgLen, PduInfoPtr);
+          /* split messages are rare, don't keep the block for the next one */
+          SomeIp_TcpBufferFree(tcpBuf);
+        }
+      } else if (leftLen < 16) {
+        /* not even the header, keep it */
+        copyLen = leftLen;
+        if (E_OK == SomeIp_TcpBufferReserve(tcpBuf, 16)) {
+          memcpy(tcpBuf->data, data, copyLen);
+          tcpBuf->length = copyLen;
         } else {
-          memset(tcpBuf, 0, sizeof(SomeIp_TcpBufferType));
-          ASLOG(SOMEIPE, ("TP message malformed, abort\n"));
+          ASLOG(SOMEIPE, ("OoM for tcp buffer\n"));
+          bret = BUFREQ_E_NOT_OK;
         }
       } else {
-        leftLen = tcpBuf->length - tcpBuf->offset;
-        if (leftLen >= PduInfo.SduLength) {
-          leftLen = PduInfo.SduLength;
-        }
-        memcpy(&tcpBuf->data[tcpBuf->offset], PduInfo.SduDataPtr, leftLen);
-        PduInfo.SduDataPtr = &PduInfo.SduDataPtr[leftLen];
-        PduInfo.SduLength -= leftLen;
-        tcpBuf->offset += leftLen;
-        if (tcpBuf->offset >= tcpBuf->length) {
-          ret = SomeIp_DecodeMsgTcp(tcpBuf->header, tcpBuf->data, tcpBuf->length,
-                                    (const TcpIp_SockAddrType *)PduInfo.MetaDataPtr, &msg);
-          if (E_OK == ret) {
-            SomeIp_HandleRxMsg(RxPduId, &msg);
+        msgLen = SomeIp_TcpMsgLength(data);
+        if (0 == msgLen) {
+          /* the stream is out of sync, drop what is read */
+          ASLOG(SOMEIPE, ("TCP message malformed, drop %d bytes\n", leftLen));
+          copyLen = leftLen;
+          bret = BUFREQ_E_NOT_OK;
+        } else if (msgLen > SOMEIP_TCP_RX_MSG_MAX) {
+          ASLOG(SOMEIPE, ("TCP message of %u bytes dropped\n", msgLen));
+          copyLen = (msgLen < leftLen) ? msgLen : leftLen;
+          tcpBuf->discard = msgLen - copyLen;
+          bret = BUFREQ_E_NOT_OK;
+        } else if (msgLen <= leftLen) {
+          /* the common case, dispatch it from the receive buffer */
+          copyLen = msgLen;
+          SomeIp_TcpRxMsg(RxPduId, data, msgLen, PduInfoPtr);
+        } else {
+          copyLen = leftLen;
+          if (E_OK == SomeIp_TcpBufferReserve(tcpBuf, msgLen)) {
+            memcpy(tcpBuf->data, data, copyLen);
+            tcpBuf->length = copyLen;
           } else {
-            ASLOG(SOMEIPE, ("Fatal Protol error\n"));
+            ASLOG(SOMEIPE, ("OoM for tcp message of %u bytes, dropped\n", msgLen));
+            tcpBuf->discard = msgLen - copyLen;
+            bret = BUFREQ_E_NOT_OK;
           }
-          Net_MemFree(tcpBuf->data);
-          memset(tcpBuf, 0, sizeof(SomeIp_TcpBufferType));
-          *bufferSizePtr += tcpBuf->length + 16;
-          bret = BUFREQ_OK;
         }
       }
+      data = &data[copyLen];
+      leftLen -= copyLen;
+      *bufferSizePtr += copyLen;
     }
   } else {
     ASLOG(SOMEIPE, ("Invalid TP RxPduId = %d\n", RxPduId));
@@ -1280,70 +2177,64 @@ Std_ReturnType SomeIp_Request(uint16_t TxMethodId, uint8_t *data, uint32_t lengt
 
 Std_ReturnType SomeIp_Notification(uint16_t TxEventId, uint8_t *data, uint32_t length) {
   Std_ReturnType ret = E_OK;
-  Std_ReturnType ret2 = E_OK;
   const SomeIp_ServerServiceType *config;
-  const SomeIp_ServerConnectionType *connection;
   const SomeIp_ServerEventType *event;
+  SomeIp_ServerEventContextType *context;
   uint16_t index;
-  PduInfoType PduInfo;
-  Sd_EventHandlerSubscriberType *Subscribers;
-  Sd_EventHandlerSubscriberType *sub;
-  uint16_t numOfSubscribers;
-  int i;
-  uint8_t *req;
+  uint32_t failed = 0;
+  boolean failedMulticast = FALSE;
+  uint8_t *cache = NULL;
+  uint32_t size = length;
 
   if (TxEventId < SOMEIP_CONFIG->numOfTxEvents) {
     index = SOMEIP_CONFIG->TxEvent2ServiceMap[TxEventId];
     config = (const SomeIp_ServerServiceType *)SOMEIP_CONFIG->services[index].service;
-    /* TODO: going to support TCP, now this only works for UDP */
-    connection = &config->connections[0];
-    if (FALSE == connection->context->online) {
-      ret = E_NOT_OK;
-    }
+    index = SOMEIP_CONFIG->TxEvent2PerServiceMap[TxEventId];
+    event = &config->events[index];
+    context = event->context;
   } else {
     ret = E_NOT_OK;
   }
 
   if (E_OK == ret) {
-    index = SOMEIP_CONFIG->TxEvent2PerServiceMap[TxEventId];
-    event = &config->events[index];
-    ret = Sd_GetSubscribers(event->sdHandleID, &Subscribers, &numOfSubscribers);
+    if (length > (0xFFFF - 16)) {
+      ret = E_NOT_OK;
+      ASLOG(SOMEIPE, ("notification too large: %u\n", length));
+    }
   }
 
   if (E_OK == ret) {
-    req = Net_MemAlloc(length + 16);
-    if (NULL == req) {
-      ret = E_NOT_OK;
-      ASLOG(SOMEIPE, ("OoM for notification\n"));
-    }
+    ret = SomeIp_SendEvent(config, event, SOMEIP_EVENT_ALL_SUBSCRIBERS, data, length, &failed,
+                           &failedMulticast);
   }
 
   if (E_OK == ret) {
-    memcpy(&req[16], data, length);
-    for (i = 0; i < numOfSubscribers; i++) {
-      sub = &Subscribers[i];
-      if (0 != sub->flags) {
-        if (0 == sub->sessionId) {
-          sub->sessionId = 1;
-        }
-        SomeIp_BuildHeader(req, config->serviceId, event->eventId, config->clientId, sub->sessionId,
-                           event->interfaceVersion, SOMEIP_MSG_NOTIFICATION, 0, length);
-        PduInfo.MetaDataPtr = (uint8_t *)&sub->RemoteAddr;
-        PduInfo.SduDataPtr = req;
-        PduInfo.SduLength = length + 16;
-        ret2 = SoAd_IfTransmit(connection->TxPduId, &PduInfo);
-        if (E_OK == ret2) {
-          sub->sessionId++;
-        } else {
-          ret = E_NOT_OK;
-          ASLOG(SOMEIPE, ("Failed to notify event %x:%x to %d.%d.%d.%d:%d\n", config->serviceId,
-                          event->eventId, sub->RemoteAddr.addr[0], sub->RemoteAddr.addr[1],
-                          sub->RemoteAddr.addr[2], sub->RemoteAddr.addr[3], sub->RemoteAddr.port));
-          /* TODO: cache data and schedule transmit next time */
-        }
+    if ((0 != failed) || failedMulticast) {
+      /* keep the value for the ones missed it, retransmitted by the SomeIp_MainFunction */
+      cache = Net_MemGet(&size);
+      if ((NULL != cache) && (size < length)) {
+        Net_MemFree(cache);
+        cache = NULL;
       }
+      if (NULL != cache) {
+        memcpy(cache, data, length);
+      } else {
+        ASLOG(SOMEIPE, ("OoM to cache event %x:%x\n", config->serviceId, event->eventId));
+        ret = E_NOT_OK;
+      }
+    }
+    /* the new value replaces the old one even if that was not delivered to all */
+    EnterCritical();
+    data = context->data;
+    context->data = cache;
+    context->length = length;
+    context->pending = failed;
+    context->pendingMulticast = failedMulticast;
+    context->retryCounter = 0;
+    ExitCritical();
+    if (NULL != data) {
+      Net_MemFree(data);
     }
-    Net_MemFree(req);
   }
 
   return ret;
@@ -1353,10 +2244,13 @@ void SomeIp_Init(const SomeIp_ConfigType *ConfigPtr) {
   int i;
   mp_init(&someIpAsyncReqMsgPool, (uint8_t *)&someIpAsyncReqMsgSlots,
           sizeof(SomeIp_AsyncReqMsgType), ARRAY_SIZE(someIpAsyncReqMsgSlots));
-  mp_init(&someIpTxTpMsgPool, (uint8_t *)&someIpTxTpMsgSlots, sizeof(SomeIp_RxTpMsgType),
+  mp_init(&someIpTxTpMsgPool, (uint8_t *)&someIpTxTpMsgSlots, sizeof(SomeIp_TxTpMsgType),
           ARRAY_SIZE(someIpTxTpMsgSlots));
-  mp_init(&someIpRxTpMsgPool, (uint8_t *)&someIpRxTpMsgSlots, sizeof(SomeIp_TxTpMsgType),
+  mp_init(&someIpTpTxFramePool, (uint8_t *)&someIpTpTxFrameSlots, sizeof(SomeIp_TpTxFrameType),
+          ARRAY_SIZE(someIpTpTxFrameSlots));
+  mp_init(&someIpRxTpMsgPool, (uint8_t *)&someIpRxTpMsgSlots, sizeof(SomeIp_RxTpMsgType),
           ARRAY_SIZE(someIpRxTpMsgSlots));
+  memset(someIpRxTpMsgHash, 0, sizeof(someIpRxTpMsgHash));
   for (i = 0; i < SOMEIP_CONFIG->numOfService; i++) {
     if (SOMEIP_CONFIG->services[i].isServer) {
       SomeIp_InitServer((const SomeIp_ServerServiceType *)SOMEIP_CONFIG->services[i].service);
@@ -1368,6 +2262,7 @@ void SomeIp_Init(const SomeIp_ConfigType *ConfigPtr) {
 
 void SomeIp_MainFunction(void) {
   int i;
+  someIpTpTxBudget = SOMEIP_TP_TX_BYTES_PER_CYCLE;
   for (i = 0; i < SOMEIP_CONFIG->numOfService; i++) {
     if (SOMEIP_CONFIG->services[i].isServer) {
       SomeIp_MainServer((const SomeIp_ServerServiceType *)SOMEIP_CONFIG->services[i].service);
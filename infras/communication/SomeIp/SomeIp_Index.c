@@ -0,0 +1,36 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2026 Parai Wang <parai@foxmail.com>
+ */
+/* ================================ [ INCLUDES  ] ============================================== */
+#include "SomeIp.h"
+#include "SomeIp_Priv.h"
+/* ================================ [ MACROS    ] ============================================== */
+/* ================================ [ TYPES     ] ============================================== */
+/* ================================ [ DECLARES  ] ============================================== */
+/* ================================ [ DATAS     ] ============================================== */
+/* ================================ [ LOCALS    ] ============================================== */
+/* ================================ [ FUNCTIONS ] ============================================== */
+uint16_t SomeIp_IndexLookup(const SomeIp_IndexType *table, uint16_t num, uint16_t id) {
+  uint16_t low = 0;
+  uint16_t n = num;
+  uint16_t half;
+
+  /* lower bound, the same ID may be there more than once with different interface versions.
+   * The loop has no data dependent branch, the compiler makes it a conditional move. */
+  while (n > 1) {
+    half = n >> 1;
+    low = (table[low + half - 1].id < id) ? (low + half) : low;
+    n -= half;
+  }
+
+  if ((n > 0) && (table[low].id < id)) {
+    low++;
+  }
+
+  if ((low < num) && (table[low].id != id)) {
+    low = num;
+  }
+
+  return low;
+}
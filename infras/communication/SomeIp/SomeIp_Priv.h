@@ -7,8 +7,14 @@
 /* ================================ [ INCLUDES  ] ============================================== */
 #include "ComStack_Types.h"
 #include "TcpIp.h"
+#include "SoAd.h"
+#include "Std_Timer.h"
 #include "sys/queue.h"
 /* ================================ [ MACROS    ] ============================================== */
+/* max number of segment ranges received ahead of the contiguous part of a TP message */
+#ifndef SOMEIP_TP_RX_MAX_RANGES
+#define SOMEIP_TP_RX_MAX_RANGES 8
+#endif
 /* ================================ [ TYPES     ] ============================================== */
 /* API for service */
 typedef void (*SomeIp_OnAvailabilityFncType)(boolean isAvailable);
@@ -20,9 +26,13 @@ typedef void (*SomeIp_OnSubscribeFncType)(boolean isSubscribe);
 typedef Std_ReturnType (*SomeIp_OnRequestFncType)(uint16_t conId, SomeIp_MessageType *req,
                                                   SomeIp_MessageType *res);
 typedef Std_ReturnType (*SomeIp_OnFireForgotFncType)(uint16_t conId, SomeIp_MessageType *req);
-typedef Std_ReturnType (*SomeIp_OnAsyncRequestFncType)(uint16_t conId, SomeIp_MessageType *res);
+/* req is the request which was answered with SOMEIP_E_PENDING, kept until the response is sent */
+typedef Std_ReturnType (*SomeIp_OnAsyncRequestFncType)(uint16_t conId, SomeIp_MessageType *req,
+                                                       SomeIp_MessageType *res);
 
-/* For the LF, set the msg->data as beginning of the buffer */
+/* For the LF, set the msg->data as beginning of the buffer. The segments could come out of order,
+ * copy each one to msg->offset, the LF is the one which completes the message. Each RX session has
+ * its own msg->slot, the buffer of a slot is reused once the completed message is handled. */
 typedef Std_ReturnType (*SomeIp_OnTpCopyRxDataFncType)(uint16_t conId, SomeIp_TpMessageType *msg);
 
 typedef Std_ReturnType (*SomeIp_OnTpCopyTxDataFncType)(uint16_t conId, SomeIp_TpMessageType *msg);
@@ -32,6 +42,12 @@ typedef Std_ReturnType (*SomeIp_OnResponseFncType)(SomeIp_MessageType *res);
 /* API for events */
 typedef Std_ReturnType (*SomeIp_OnNotificationFncType)(SomeIp_MessageType *evt);
 
+/* method/event ID to the position in the methods/events array, sorted by the ID */
+typedef struct {
+  uint16_t id;
+  uint16_t index;
+} SomeIp_IndexType;
+
 typedef struct {
   uint16_t methodId;
   uint8_t interfaceVersion;
@@ -43,10 +59,21 @@ typedef struct {
   uint32_t resMaxLen;
 } SomeIp_ServerMethodType;
 
+/* the last value of an event which is not yet delivered to all of the subscribers */
+typedef struct {
+  uint8_t *data;
+  uint32_t length;
+  uint32_t pending; /* bit i for the subscriber i */
+  boolean pendingMulticast;
+  uint8_t retryCounter;
+  uint16_t sessionId; /* for multicast */
+} SomeIp_ServerEventContextType;
+
 typedef struct {
   uint16_t sdHandleID;
   uint16_t eventId;
   uint8_t interfaceVersion;
+  SomeIp_ServerEventContextType *context;
 } SomeIp_ServerEventType;
 
 typedef struct {
@@ -91,19 +118,42 @@ typedef struct {
 typedef struct SomeIp_AsyncReqMsg_s {
   STAILQ_ENTRY(SomeIp_AsyncReqMsg_s) entry;
   TcpIp_SockAddrType RemoteAddr;
+  SomeIp_MessageType req; /* held in the SoAd rx ring, or a Net_Mem copy */
+  SoAd_RxBufferRefType rxRef;
+  boolean rxHeld;
   uint16_t clientId;
   uint16_t sessionId;
   uint16_t methodId;
 } SomeIp_AsyncReqMsgType;
 
+typedef struct {
+  uint32_t offset; /* all data before offset is received */
+  uint32_t length; /* total length, 0 if the last segment is not received yet */
+  uint32_t ranges[SOMEIP_TP_RX_MAX_RANGES][2]; /* sorted [start, end) received after offset */
+  uint8_t numOfRanges;
+} SomeIp_TpRxRangesType;
+
 typedef struct SomeIp_RxTpMsg_s {
   STAILQ_ENTRY(SomeIp_RxTpMsg_s) entry;
+  struct SomeIp_RxTpMsg_s *hnext;
+  const void *owner; /* the pending list of this message */
+  /* key: owner, RemoteAddr, methodId, clientId and sessionId */
   TcpIp_SockAddrType RemoteAddr;
-  uint32_t offset;
-  uint16_t methodId; /* this is the key */
+  uint16_t methodId;
   uint16_t clientId;
   uint16_t sessionId;
+#ifdef STD_TIMER_WHEEL
+  Std_TimerEntryType timer;
+  /* for the timeout error message */
+  PduIdType TxPduId;
+  uint16_t serviceId;
+  uint16_t messageMethodId;
+  uint8_t interfaceVersion;
+#else
   uint16_t timer;
+#endif
+  uint8_t slot; /* lowest one free among the messages of the same method */
+  SomeIp_TpRxRangesType rx;
 } SomeIp_RxTpMsgType;
 
 typedef struct SomeIp_TxTpMsg_s {
@@ -117,24 +167,32 @@ typedef struct SomeIp_TxTpMsg_s {
 #ifndef DISABLE_SOMEIP_TX_NOK_RETRY
   uint8_t retryCounter;
 #endif
+  /* TCP: the frame the socket took only partly, its rest goes first in the next call */
+  uint8_t *tail;
+  uint16_t tailOffset; /* bytes of the tail already in the stream */
+  uint16_t tailLength;
 } SomeIp_TxTpMsgType;
 
-/* For TCP large messages */
+/* For the TCP stream, only a message split over several reads is copied here */
 typedef struct {
   uint8_t *data;
-  uint32_t length;
-  uint32_t offset;
-  uint8_t header[16];
-  uint8_t lenOfHd;
+  uint32_t size;    /* capacity of data, released once the split message is dispatched */
+  uint32_t length;  /* bytes of the split message received so far */
+  uint32_t discard; /* bytes still to drop of a message which can't be buffered */
 } SomeIp_TcpBufferType;
 
+typedef STAILQ_HEAD(reqMsgHead, SomeIp_AsyncReqMsg_s) SomeIp_AsyncReqMsgList;
 typedef STAILQ_HEAD(rxTpMsgHead, SomeIp_RxTpMsg_s) SomeIp_RxTpMsgList;
 typedef STAILQ_HEAD(txTpMsgHead, SomeIp_TxTpMsg_s) SomeIp_TxTpMsgList;
 
 typedef struct {
-  STAILQ_HEAD(reqMsgHead, SomeIp_AsyncReqMsg_s) pendingAsyncReqMsgs;
+  SomeIp_AsyncReqMsgList pendingAsyncReqMsgs;
   SomeIp_RxTpMsgList pendingRxTpMsgs;
   SomeIp_TxTpMsgList pendingTxTpMsgs;
+  /* TCP: the rest of the event frame the socket took only partly, it goes first in the stream */
+  uint8_t *eventTail;
+  uint32_t eventTailOffset;
+  uint32_t eventTailLength;
   bool online;
 } SomeIp_ServerServiceContextType;
 
@@ -161,6 +219,7 @@ typedef struct {
   uint16_t numOfEvents;
   const SomeIp_ServerConnectionType *connections;
   uint8_t numOfConnections;
+  const SomeIp_IndexType *methodIndex; /* NULL: linear search */
 } SomeIp_ServerServiceType;
 
 typedef struct {
@@ -175,6 +234,8 @@ typedef struct {
   PduIdType TxPduId;
   SomeIp_OnAvailabilityFncType onAvailability;
   SomeIp_TcpBufferType *tcpBuf;
+  const SomeIp_IndexType *methodIndex; /* NULL: linear search */
+  const SomeIp_IndexType *eventIndex;  /* NULL: linear search */
 } SomeIp_ClientServiceType;
 
 typedef struct {
@@ -202,5 +263,7 @@ struct SomeIp_Config_s {
 /* ================================ [ DATAS     ] ============================================== */
 /* ================================ [ LOCALS    ] ============================================== */
 /* ================================ [ FUNCTIONS ] ============================================== */
+/* return the first position of id in the sorted table, or num if not found */
+uint16_t SomeIp_IndexLookup(const SomeIp_IndexType *table, uint16_t num, uint16_t id);
 
 #endif /* _SOMEIP_PRIV_H */
@@ -0,0 +1,140 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2026 Parai Wang <parai@foxmail.com>
+ */
+/* ================================ [ INCLUDES  ] ============================================== */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "SomeIp.h"
+#include "SomeIp_Priv.h"
+/* ================================ [ MACROS    ] ============================================== */
+#define SOMEIP_BENCH_LOOKUPS 10000000
+/* ================================ [ TYPES     ] ============================================== */
+/* ================================ [ DECLARES  ] ============================================== */
+/* ================================ [ DATAS     ] ============================================== */
+static volatile uint32_t bench_sink;
+/* fine enough around the crossover to place SOMEIP_INDEX_SEARCH_MIN */
+static const uint16_t bench_methods[] = {10, 25, 50, 75, 100, 125, 150, 200, 300, 500, 1000};
+/* ================================ [ LOCALS    ] ============================================== */
+static uint64_t bench_now(void) {
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static int bench_compare(const void *a, const void *b) {
+  const SomeIp_IndexType *ia = (const SomeIp_IndexType *)a;
+  const SomeIp_IndexType *ib = (const SomeIp_IndexType *)b;
+
+  return ((int)ia->id - (int)ib->id);
+}
+
+/* the way the methods were looked up before the index table */
+static uint16_t bench_linear(const SomeIp_ServerMethodType *methods, uint16_t num, uint16_t id) {
+  uint16_t i;
+
+  for (i = 0; i < num; i++) {
+    if (methods[i].methodId == id) {
+      break;
+    }
+  }
+
+  return i;
+}
+
+static uint16_t bench_index(const SomeIp_ServerMethodType *methods, const SomeIp_IndexType *table,
+                            uint16_t num, uint16_t id) {
+  uint16_t pos = SomeIp_IndexLookup(table, num, id);
+  uint16_t i = num;
+
+  if (pos < num) {
+    i = table[pos].index;
+    if (methods[i].methodId != id) {
+      i = num;
+    }
+  }
+
+  return i;
+}
+
+static void bench_run(uint16_t num, uint32_t lookups) {
+  SomeIp_ServerMethodType *methods;
+  SomeIp_IndexType *table;
+  uint16_t *queries;
+  uint32_t i;
+  uint32_t sum = 0;
+  uint64_t start;
+  uint64_t linear;
+  uint64_t index;
+  uint16_t j;
+  uint16_t tmp;
+
+  methods = calloc(num, sizeof(SomeIp_ServerMethodType));
+  table = calloc(num, sizeof(SomeIp_IndexType));
+  queries = calloc(4096, sizeof(uint16_t));
+
+  /* unique method IDs in random order, as a configuration tool would list them */
+  for (i = 0; i < num; i++) {
+    methods[i].methodId = (uint16_t)(0x100 + i * 3);
+  }
+  for (i = num - 1; i > 0; i--) {
+    j = (uint16_t)(rand() % (i + 1));
+    tmp = methods[i].methodId;
+    methods[i].methodId = methods[j].methodId;
+    methods[j].methodId = tmp;
+  }
+  for (i = 0; i < num; i++) {
+    table[i].id = methods[i].methodId;
+    table[i].index = (uint16_t)i;
+  }
+  qsort(table, num, sizeof(SomeIp_IndexType), bench_compare);
+
+  /* mostly hits, 1 of 16 is an unknown method */
+  for (i = 0; i < 4096; i++) {
+    if (0 == (i & 0xF)) {
+      queries[i] = 0xFFFF;
+    } else {
+      queries[i] = methods[rand() % num].methodId;
+    }
+  }
+
+  start = bench_now();
+  for (i = 0; i < lookups; i++) {
+    sum += bench_linear(methods, num, queries[i & 4095]);
+  }
+  linear = bench_now() - start;
+
+  start = bench_now();
+  for (i = 0; i < lookups; i++) {
+    sum -= bench_index(methods, table, num, queries[i & 4095]);
+  }
+  index = bench_now() - start;
+
+  bench_sink = sum; /* 0 if both agree */
+  printf("%5u methods: linear %7.2f ns, index %7.2f ns per lookup%s\n", num,
+         (double)linear / lookups, (double)index / lookups, (0 == sum) ? "" : " MISMATCH");
+
+  free(methods);
+  free(table);
+  free(queries);
+}
+/* ================================ [ FUNCTIONS ] ============================================== */
+int main(int argc, char *argv[]) {
+  uint32_t lookups = SOMEIP_BENCH_LOOKUPS;
+  uint32_t i;
+
+  if (argc > 1) {
+    lookups = (uint32_t)strtoul(argv[1], NULL, 0);
+  }
+
+  srand(0x50ED);
+  for (i = 0; i < sizeof(bench_methods) / sizeof(bench_methods[0]); i++) {
+    bench_run(bench_methods[i], lookups);
+  }
+
+  return 0;
+}
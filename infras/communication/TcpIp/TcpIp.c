@@ -5,11 +5,17 @@
  * ref: Specification of TCP/IP Stack AUTOSAR CP Release 4.4.0
  */
 /* ================================ [ INCLUDES  ] ============================================== */
+#if defined(linux) && !defined(USE_LWIP) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE /* recvmmsg/sendmmsg */
+#endif
 #include <string.h>
 #include <stdlib.h>
 
 #include "TcpIp.h"
 #include "Std_Debug.h"
+#ifndef DISABLE_NET_MEM
+#include "NetMem.h"
+#endif
 
 #if defined(linux) && !defined(USE_LWIP)
 #include <arpa/inet.h>
@@ -55,6 +61,14 @@
 #ifndef TCPIP_MAX_DATA_SIZE
 #define TCPIP_MAX_DATA_SIZE 1420
 #endif
+
+#ifndef TCPIP_MAX_BATCH
+#define TCPIP_MAX_BATCH 32
+#endif
+
+#if defined(linux) && !defined(USE_LWIP)
+#define TCPIP_USE_MMSG
+#endif
 /* ================================ [ TYPES     ] ============================================== */
 /* ================================ [ DECLARES  ] ============================================== */
 /* ================================ [ DATAS     ] ============================================== */
@@ -420,6 +434,36 @@ Std_ReturnType TcpIp_SendTo(TcpIp_SocketIdType SocketId, const TcpIp_SockAddrTyp
   return ret;
 }
 
+Std_ReturnType TcpIp_SendPartial(TcpIp_SocketIdType SocketId, const uint8_t *BufPtr,
+                                 uint16_t *Length /* InOut */) {
+  Std_ReturnType ret = E_OK;
+  int nbytes;
+
+  nbytes = send(SocketId, (char *)BufPtr, *Length, 0);
+  ASLOG(TCPIP, ("[%d] send(%d/%d)\n", SocketId, nbytes, *Length));
+
+  if (nbytes < 0) {
+#if defined(_WIN32) && !defined(USE_LWIP)
+    if (WSAEWOULDBLOCK == WSAGetLastError()) {
+#else
+    if ((EAGAIN == errno) || (EWOULDBLOCK == errno)) {
+#endif
+      ret = TCPIP_E_NOSPACE;
+    } else {
+      ASLOG(TCPIPE, ("[%d] send(%d), error is %d\n", SocketId, *Length, nbytes));
+      ret = E_NOT_OK;
+    }
+    *Length = 0;
+  } else {
+    if (nbytes != *Length) {
+      ret = TCPIP_E_NOSPACE;
+    }
+    *Length = (uint16_t)nbytes;
+  }
+
+  return ret;
+}
+
 Std_ReturnType TcpIp_Send(TcpIp_SocketIdType SocketId, const uint8_t *BufPtr, uint16_t Length) {
   Std_ReturnType ret = E_OK;
   int nbytes;
@@ -439,6 +483,176 @@ Std_ReturnType TcpIp_Send(TcpIp_SocketIdType SocketId, const uint8_t *BufPtr, ui
   return ret;
 }
 
+#ifdef TCPIP_USE_MMSG
+Std_ReturnType TcpIp_RecvFromBatch(TcpIp_SocketIdType SocketId, TcpIp_MsgType *Msgs,
+                                   uint16_t *Number /* InOut */) {
+  Std_ReturnType ret = E_OK;
+  struct mmsghdr msgs[TCPIP_MAX_BATCH];
+  struct iovec iovs[TCPIP_MAX_BATCH];
+  struct sockaddr_in fromAddrs[TCPIP_MAX_BATCH];
+  int number = *Number;
+  int i, r;
+
+  if (number > TCPIP_MAX_BATCH) {
+    number = TCPIP_MAX_BATCH;
+  }
+
+  memset(msgs, 0, sizeof(struct mmsghdr) * number);
+  for (i = 0; i < number; i++) {
+    iovs[i].iov_base = Msgs[i].BufPtr;
+    iovs[i].iov_len = Msgs[i].Length;
+    msgs[i].msg_hdr.msg_iov = &iovs[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+    msgs[i].msg_hdr.msg_name = &fromAddrs[i];
+    msgs[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+  }
+
+  r = recvmmsg(SocketId, msgs, number, MSG_DONTWAIT, NULL);
+  *Number = 0;
+  if (r > 0) {
+    for (i = 0; i < r; i++) {
+      Msgs[i].RemoteAddr.port = htons(fromAddrs[i].sin_port);
+      memcpy(Msgs[i].RemoteAddr.addr, &fromAddrs[i].sin_addr.s_addr, 4);
+      if (0 != (msgs[i].msg_hdr.msg_flags & MSG_TRUNC)) {
+        ASLOG(TCPIPE, ("[%d] datagram truncated to %d bytes, dropped\n", SocketId, Msgs[i].Length));
+        Msgs[i].Length = 0;
+      } else {
+        Msgs[i].Length = msgs[i].msg_len;
+      }
+    }
+    *Number = r;
+    ASLOG(TCPIP, ("[%d] recv %d datagrams\n", SocketId, r));
+  } else if ((r < 0) && (EAGAIN != errno) && (EWOULDBLOCK != errno)) {
+    ret = E_NOT_OK;
+    ASLOG(TCPIPE, ("[%d] recvmmsg got error %d\n", SocketId, errno));
+  } else {
+    /* got nothing */
+  }
+
+  return ret;
+}
+
+Std_ReturnType TcpIp_SendToBatch(TcpIp_SocketIdType SocketId, const TcpIp_MsgType *Msgs,
+                                 uint16_t *Number /* InOut */) {
+  Std_ReturnType ret = E_OK;
+  struct mmsghdr msgs[TCPIP_MAX_BATCH];
+  struct iovec iovs[TCPIP_MAX_BATCH][2];
+  struct sockaddr_in toAddrs[TCPIP_MAX_BATCH];
+  int number = *Number;
+  int sent = 0;
+  int i, n, r;
+
+  while ((E_OK == ret) && (sent < number)) {
+    n = number - sent;
+    if (n > TCPIP_MAX_BATCH) {
+      n = TCPIP_MAX_BATCH;
+    }
+    memset(msgs, 0, sizeof(struct mmsghdr) * n);
+    for (i = 0; i < n; i++) {
+      const TcpIp_MsgType *msg = &Msgs[sent + i];
+      toAddrs[i].sin_family = AF_INET;
+      memcpy(&toAddrs[i].sin_addr.s_addr, msg->RemoteAddr.addr, 4);
+      toAddrs[i].sin_port = htons(msg->RemoteAddr.port);
+      msgs[i].msg_hdr.msg_name = &toAddrs[i];
+      msgs[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+      msgs[i].msg_hdr.msg_iov = iovs[i];
+      if ((NULL != msg->HeaderPtr) && (msg->HeaderLength > 0)) {
+        iovs[i][0].iov_base = (void *)msg->HeaderPtr;
+        iovs[i][0].iov_len = msg->HeaderLength;
+        iovs[i][1].iov_base = msg->BufPtr;
+        iovs[i][1].iov_len = msg->Length;
+        msgs[i].msg_hdr.msg_iovlen = 2;
+      } else {
+        iovs[i][0].iov_base = msg->BufPtr;
+        iovs[i][0].iov_len = msg->Length;
+        msgs[i].msg_hdr.msg_iovlen = 1;
+      }
+    }
+
+    r = sendmmsg(SocketId, msgs, n, MSG_DONTWAIT);
+    ASLOG(TCPIP, ("[%d] send %d/%d datagrams\n", SocketId, r, n));
+    if (r > 0) {
+      sent += r;
+    }
+    if (r != n) {
+      ASLOG(TCPIPE, ("[%d] sendmmsg(%d), error is %d\n", SocketId, n, r));
+      if ((r >= 0) || (EAGAIN == errno) || (EWOULDBLOCK == errno)) {
+        ret = TCPIP_E_NOSPACE;
+      } else {
+        ret = E_NOT_OK;
+      }
+    }
+  }
+
+  *Number = sent;
+
+  return ret;
+}
+#else
+Std_ReturnType TcpIp_RecvFromBatch(TcpIp_SocketIdType SocketId, TcpIp_MsgType *Msgs,
+                                   uint16_t *Number /* InOut */) {
+  Std_ReturnType ret = E_OK;
+  uint16_t i = 0;
+
+  while (i < *Number) {
+    ret = TcpIp_RecvFrom(SocketId, &Msgs[i].RemoteAddr, Msgs[i].BufPtr, &Msgs[i].Length);
+    if ((E_OK != ret) || (0 == Msgs[i].Length)) {
+      break;
+    }
+    i++;
+  }
+  *Number = i;
+
+  return ret;
+}
+
+Std_ReturnType TcpIp_SendToBatch(TcpIp_SocketIdType SocketId, const TcpIp_MsgType *Msgs,
+                                 uint16_t *Number /* InOut */) {
+  Std_ReturnType ret = E_OK;
+  const TcpIp_MsgType *msg;
+  uint8_t *data;
+  uint16_t i = 0;
+#ifdef DISABLE_NET_MEM
+  static uint8_t txBuf[TCPIP_MAX_DATA_SIZE];
+#endif
+
+  while (i < *Number) {
+    msg = &Msgs[i];
+    if ((NULL != msg->HeaderPtr) && (msg->HeaderLength > 0)) {
+#ifndef DISABLE_NET_MEM
+      data = Net_MemAlloc((uint32_t)msg->HeaderLength + msg->Length);
+#else
+      data = NULL;
+      if (((uint32_t)msg->HeaderLength + msg->Length) <= sizeof(txBuf)) {
+        data = txBuf;
+      }
+#endif
+      if (NULL != data) {
+        memcpy(data, msg->HeaderPtr, msg->HeaderLength);
+        memcpy(&data[msg->HeaderLength], msg->BufPtr, msg->Length);
+        ret = TcpIp_SendTo(SocketId, &msg->RemoteAddr, data, msg->HeaderLength + msg->Length);
+#ifndef DISABLE_NET_MEM
+        Net_MemFree(data);
+#endif
+      } else {
+        ASLOG(TCPIPE, ("[%d] no buffer for %d bytes datagram\n", SocketId,
+                       msg->HeaderLength + msg->Length));
+        ret = E_NOT_OK;
+      }
+    } else {
+      ret = TcpIp_SendTo(SocketId, &msg->RemoteAddr, msg->BufPtr, msg->Length);
+    }
+    if (E_OK != ret) {
+      break;
+    }
+    i++;
+  }
+  *Number = i;
+
+  return ret;
+}
+#endif
+
 Std_ReturnType TcpIp_TcpConnect(TcpIp_SocketIdType SocketId,
                                 const TcpIp_SockAddrType *RemoteAddrPtr) {
   Std_ReturnType ret = E_NOT_OK;
@@ -17,7 +17,19 @@
 /* ================================ [ DATAS     ] ============================================== */
 /* ================================ [ LOCALS    ] ============================================== */
 /* ================================ [ FUNCTIONS ] ============================================== */
+/* @SWS_Crc_00031 */
+uint8_t Crc_CalculateCRC8(const uint8_t *Crc_DataPtr, uint32_t Crc_Length, uint8_t Crc_StartValue8,
+                          boolean Crc_IsFirstCall);
+
 /* @SWS_Crc_00002 */
 uint16_t Crc_CalculateCRC16(const uint8_t *Crc_DataPtr, uint32_t Crc_Length,
                             uint16_t Crc_StartValue16, boolean Crc_IsFirstCall);
+
+/* @SWS_Crc_00020 */
+uint32_t Crc_CalculateCRC32(const uint8_t *Crc_DataPtr, uint32_t Crc_Length,
+                            uint32_t Crc_StartValue32, boolean Crc_IsFirstCall);
+
+/* @SWS_Crc_00058 */
+uint32_t Crc_CalculateCRC32P4(const uint8_t *Crc_DataPtr, uint32_t Crc_Length,
+                              uint32_t Crc_StartValue32, boolean Crc_IsFirstCall);
 #endif /* CRC_H */
\ No newline at end of file
@@ -14,6 +14,15 @@
 #define DOIP_E_PENDING ((Std_ReturnType)16)
 /* ================================ [ TYPES     ] ============================================== */
 typedef struct DoIP_Config_s DoIP_ConfigType;
+
+/* counters of a tester connection, cleared when the tester connects */
+typedef struct {
+  uint32_t rxMessages; /* diagnostic requests received completely */
+  uint32_t rxBytes;    /* UDS bytes of the requests */
+  uint32_t txMessages; /* diagnostic responses sent completely */
+  uint32_t txBytes;    /* UDS bytes of the responses handed over to the socket */
+  uint32_t txStalls;   /* times a response was held back by TCP backpressure */
+} DoIP_ConnectionStatsType;
 /* ================================ [ DECLARES  ] ============================================== */
 /* ================================ [ DATAS     ] ============================================== */
 /* ================================ [ LOCALS    ] ============================================== */
@@ -65,4 +74,6 @@ BufReq_ReturnType DoIP_SoAdTpCopyRxData(PduIdType RxPduId, const PduInfoType *in
 
 /* @SWS_DoIP_00039 */
 void DoIP_SoConModeChg(SoAd_SoConIdType SoConId, SoAd_SoConModeType Mode);
+
+Std_ReturnType DoIP_GetConnectionStats(uint16_t TesterConnection, DoIP_ConnectionStatsType *stats);
 #endif /* _DOIP_H */
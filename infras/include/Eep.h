@@ -13,8 +13,14 @@
 #define E_EEP_PENDING ((Std_ReturnType)100)
 #define E_EEP_INCONSISTENT ((Std_ReturnType)101)
 /* ================================ [ TYPES     ] ============================================== */
+/* EEP_ADDRESS_TYPE_U32 for an EEPROM of 64KB or more, it must be set for every library using Eep */
+#ifdef EEP_ADDRESS_TYPE_U32
+typedef uint32_t Eep_AddressType;
+typedef uint32_t Eep_LengthType;
+#else
 typedef uint16_t Eep_AddressType;
 typedef uint16_t Eep_LengthType;
+#endif
 
 typedef struct Eep_Config_s Eep_ConfigType;
 /* ================================ [ DECLARES  ] ============================================== */
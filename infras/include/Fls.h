@@ -25,6 +25,20 @@ typedef uint32_t Fls_LengthType;
 #endif
 
 typedef struct Fls_Config_s Fls_ConfigType;
+
+typedef struct {
+  uint32_t count;
+  uint32_t lastUs; /* latency from the first call to completion */
+  uint32_t maxUs;
+  uint64_t totalUs;
+} Fls_AcJobStatisticsType;
+
+typedef struct {
+  Fls_AcJobStatisticsType erase;
+  Fls_AcJobStatisticsType write;
+  uint32_t queued; /* jobs accepted by the engine but not completed */
+  uint32_t maxQueued;
+} Fls_AcStatisticsType;
 /* ================================ [ DECLARES  ] ============================================== */
 void Fls_AcInit(void);
 /*   For Flash AC Erase/Write, the HW engine generally require the driver located in RAM,
@@ -47,6 +61,8 @@ Std_ReturnType Fls_AcWrite(Fls_AddressType address, const uint8_t *data, Fls_Len
 Std_ReturnType Fls_AcRead(Fls_AddressType address, uint8_t *data, Fls_LengthType length);
 Std_ReturnType Fls_AcCompare(Fls_AddressType address, uint8_t *data, Fls_LengthType length);
 Std_ReturnType Fls_AcBlankCheck(Fls_AddressType address, Fls_LengthType length);
+/* optional, for the simulator to benchmark the Fls stack */
+void Fls_AcGetStatistics(Fls_AcStatisticsType *stats);
 /* ================================ [ DATAS     ] ============================================== */
 /* ================================ [ LOCALS    ] ============================================== */
 /* ================================ [ FUNCTIONS ] ============================================== */
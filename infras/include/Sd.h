@@ -53,18 +53,32 @@ typedef enum
   SD_EVENT_HANDLER_REQUESTED,
 } Sd_EventHandlerCurrentStateType;
 
-typedef struct {
+typedef struct Sd_EventHandlerSubscriber_s {
   /* subscriber response port */
   uint16_t port;
   uint16_t sessionId;
   /* remote subscriber address */
   TcpIp_SockAddrType RemoteAddr;
   uint8_t flags;
+  struct Sd_EventHandlerSubscriber_s *hnext; /* for the SD internal lookup */
 } Sd_EventHandlerSubscriberType;
 
 /* @SWS_SD_91002 */
 typedef uint8_t *Sd_ConfigOptionStringType;
 
+/* transmit counters of one SD instance */
+typedef struct {
+  uint32_t multicastMessages;
+  uint32_t multicastEntries;
+  uint32_t unicastMessages;
+  uint32_t unicastEntries;
+  uint16_t maxEntriesPerMessage;
+  /* offers/finds already pending when due again, or finds answered by a pending multicast offer */
+  uint32_t suppressedDuplicates;
+  /* main cycles the multicast message was cut short by the bytes/s budget */
+  uint32_t budgetDeferrals;
+} Sd_StatisticsType;
+
 typedef struct Sd_Config_s Sd_ConfigType;
 /* ================================ [ DECLARES  ] ============================================== */
 /* ================================ [ DATAS     ] ============================================== */
@@ -99,4 +113,11 @@ Std_ReturnType Sd_GetProviderAddr(uint16_t ClientServiceHandleId, TcpIp_SockAddr
 Std_ReturnType Sd_GetSubscribers(uint16_t EventHandlerId,
                                  Sd_EventHandlerSubscriberType **Subscribers,
                                  uint16_t *numOfSubscribers);
+
+/* E_OK if the events of this event group should be sent to the multicast address as the number
+ * of subscribers reached the MulticastThreshold */
+Std_ReturnType Sd_GetMulticastAddr(uint16_t EventHandlerId, TcpIp_SockAddrType *MulticastAddr);
+
+Std_ReturnType Sd_GetStatistics(uint8_t InstanceId, Sd_StatisticsType *Statistics);
+void Sd_ResetStatistics(uint8_t InstanceId);
 #endif /* _SD_H */
@@ -12,7 +12,11 @@
 /* ================================ [ MACROS    ] ============================================== */
 #define SOAD_MEAS_DROP_TCP ((SoAd_MeasurementIdxType)0x01)
 #define SOAD_MEAS_DROP_UDP ((SoAd_MeasurementIdxType)0x02)
-#define SOAD_MEAS_ALL ((SoAd_MeasurementIdxType)0x0xFF)
+/* receive ring had no free slot, reading was postponed */
+#define SOAD_MEAS_RX_RING_FULL ((SoAd_MeasurementIdxType)0x80)
+/* receive buffer held by the upper layer longer than SOAD_RX_HOLD_WARN_TIME */
+#define SOAD_MEAS_RX_HOLD_OVERDUE ((SoAd_MeasurementIdxType)0x81)
+#define SOAD_MEAS_ALL ((SoAd_MeasurementIdxType)0xFF)
 /* ================================ [ TYPES     ] ============================================== */
 /* @SWS_SoAd_00518 */
 typedef uint16_t SoAd_SoConIdType;
@@ -31,6 +35,9 @@ typedef uint16_t SoAd_RoutingGroupIdType;
 /* @SWS_SoAd_91010 */
 typedef uint8_t SoAd_MeasurementIdxType;
 
+/* reference to a receive buffer borrowed by SoAd_HoldRxBuffer */
+typedef uint32_t SoAd_RxBufferRefType;
+
 typedef struct SoAd_Config_s SoAd_ConfigType;
 /* ================================ [ DECLARES  ] ============================================== */
 /* ================================ [ DATAS     ] ============================================== */
@@ -42,6 +49,11 @@ void SoAd_Init(const SoAd_ConfigType *ConfigPtr);
 /* @SWS_SoAd_00091 */
 Std_ReturnType SoAd_IfTransmit(PduIdType TxPduId, const PduInfoType *PduInfoPtr);
 
+/* Transmit several datagrams over the UDP socket of TxPduId with one syscall where the TcpIp
+ * supports it, *Number is updated to the number of datagrams sent. */
+Std_ReturnType SoAd_IfTransmitBatch(PduIdType TxPduId, const TcpIp_MsgType *Msgs,
+                                    uint16_t *Number /* InOut */);
+
 /* @SWS_SoAd_00656 */
 Std_ReturnType SoAd_IfRoutingGroupTransmit(SoAd_RoutingGroupIdType id);
 
@@ -52,6 +64,11 @@ Std_ReturnType SoAd_IfSpecificRoutingGroupTransmit(SoAd_RoutingGroupIdType id,
 /* @SWS_SoAd_00105 */
 Std_ReturnType SoAd_TpTransmit(PduIdType TxPduId, const PduInfoType *PduInfoPtr);
 
+/* Like SoAd_TpTransmit but stops at TCP backpressure instead of dropping the rest of the data,
+ * *SentLength is the number of bytes the socket accepted, TCPIP_E_NOSPACE if not all of them. */
+Std_ReturnType SoAd_TpTransmitPartial(PduIdType TxPduId, const PduInfoType *PduInfoPtr,
+                                      PduLengthType *SentLength);
+
 /* @SWS_SoAd_00522 */
 Std_ReturnType SoAd_TpCancelTransmit(PduIdType TxPduId);
 
@@ -94,6 +111,18 @@ Std_ReturnType SoAd_GetRemoteAddr(SoAd_SoConIdType SoConId, TcpIp_SockAddrType *
 Std_ReturnType SoAd_SetRemoteAddr(SoAd_SoConIdType SoConId,
                                   const TcpIp_SockAddrType *RemoteAddrPtr);
 
+/* @SWS_SoAd_91011 */
+Std_ReturnType SoAd_GetAndResetMeasurementData(SoAd_MeasurementIdxType MeasurementIdx,
+                                               boolean MeasurementResetNeeded,
+                                               uint32_t *MeasurementDataPtr);
+
+/* Only callable from within the rx indication or copy rx data callback: keep the buffer of
+ * PduInfoPtr->SduDataPtr instead of copying it. It stays valid until SoAd_ReleaseRxBuffer.
+ * E_NOT_OK if the data is not in a receive ring (ring disabled), the caller must copy. */
+Std_ReturnType SoAd_HoldRxBuffer(const uint8_t *DataPtr, SoAd_RxBufferRefType *RefPtr);
+
+Std_ReturnType SoAd_ReleaseRxBuffer(SoAd_RxBufferRefType Ref);
+
 /* @SWS_SoAd_00121 */
 void SoAd_MainFunction(void);
 #endif /* _SOAD_H */
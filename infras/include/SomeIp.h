@@ -33,6 +33,9 @@ typedef struct {
   uint32_t offset;
   uint32_t length;
   boolean moreSegmentsFlag;
+  /* RX: the session of this message among the ones pending on the same method, from 0 up, so
+   * concurrent uploads each copy to their own buffer. Always 0 for TX. */
+  uint8_t slot;
 } SomeIp_TpMessageType;
 
 typedef struct {
@@ -9,12 +9,42 @@
 #define EnterCritical() do { imask_t imask = Std_EnterCritical()
 #define ExitCritical() Std_ExitCritical(imask); } while(0)
 
+/* Named locks: modules that opt in serialize only on their own resource. Host builds implement them
+ * natively, other targets fall back to the global critical section. Not recursive. */
+#if (defined(linux) || defined(_WIN32)) && !defined(STD_DISABLE_NAMED_LOCK)
+#define STD_NAMED_LOCK
+#endif
+
+#define EnterCriticalLock(lock) do { imask_t imask = Std_Lock(lock)
+#define ExitCriticalLock(lock) Std_Unlock(lock, imask); } while(0)
+
+/* ceiling is the SCHED_FIFO/SCHED_RR priority a realtime owner is raised to, 0 for none */
+#define STD_LOCK_INIT(name, ceiling) { name, ceiling, 0, 0, 0, 0 }
+#define STD_LOCK_DEFINE(lock, ceiling) Std_LockType lock = STD_LOCK_INIT(#lock, ceiling)
+
 /* ================================ [ TYPES     ] ============================================== */
 typedef unsigned int imask_t;
+
+typedef struct Std_Lock_s {
+  const char *name;
+  int ceiling;
+  unsigned int state; /* 0: free, 1: locked, 2: locked with waiters */
+  unsigned int acquisitions;
+  unsigned int contentions; /* acquisitions that found the lock taken */
+  unsigned int sleeps;      /* times a contender had to block in the kernel */
+} Std_LockType;
 /* ================================ [ DECLARES  ] ============================================== */
 /* ================================ [ DATAS     ] ============================================== */
 /* ================================ [ LOCALS    ] ============================================== */
 /* ================================ [ FUNCTIONS ] ============================================== */
 imask_t Std_EnterCritical(void);
 void Std_ExitCritical(imask_t);
+
+#ifdef STD_NAMED_LOCK
+imask_t Std_Lock(Std_LockType *lock);
+void Std_Unlock(Std_LockType *lock, imask_t mask);
+#else
+#define Std_Lock(lock) ((void)(lock), Std_EnterCritical())
+#define Std_Unlock(lock, mask) Std_ExitCritical(mask)
+#endif
 #endif /* STD_CRITICAL_H */
@@ -10,6 +10,17 @@
 #include <stdbool.h>
 /* ================================ [ MACROS    ] ============================================== */
 #define STD_TIME_MAX 0xFFFFFFFFUL
+#define STD_TIME64_MAX 0xFFFFFFFFFFFFFFFFULL
+
+/* the timer wheel needs Std_GetTime64, which only the host platforms provide */
+#if (defined(linux) || defined(_WIN32)) && !defined(STD_DISABLE_TIMER_WHEEL)
+#define STD_TIMER_WHEEL
+#endif
+
+/* resolution of the timer wheel in us */
+#ifndef STD_TIMER_WHEEL_TICK
+#define STD_TIMER_WHEEL_TICK 1000
+#endif
 
 #define PERF_BEGIN()                                                                               \
   do {                                                                                             \
@@ -25,8 +36,25 @@ typedef struct {
   std_time_t time; /* time in us(microseconds), range 0~4294.9 seconds */
   uint8_t status;  /* 1: started, 0: stopped */
 } Std_TimerType;
+
+/* monotonic time in us, on the simulator the same clock as CLOCK_MONOTONIC */
+typedef uint64_t std_time64_t;
+
+#ifdef STD_TIMER_WHEEL
+typedef void (*Std_TimerCallbackType)(void *param);
+
+typedef struct Std_TimerEntry_s {
+  struct Std_TimerEntry_s *next;
+  struct Std_TimerEntry_s *prev; /* NULL when not armed */
+  uint64_t expire;               /* tick */
+  uint64_t period;               /* ticks, 0 for one-shot */
+  Std_TimerCallbackType callback;
+  void *param;
+} Std_TimerEntryType;
+#endif
 /* ================================ [ DECLARES  ] ============================================== */
 extern std_time_t Std_GetTime(void);
+extern std_time64_t Std_GetTime64(void);
 /* ================================ [ DATAS     ] ============================================== */
 /* ================================ [ LOCALS    ] ============================================== */
 /* ================================ [ FUNCTIONS ] ============================================== */
@@ -37,4 +65,19 @@ std_time_t Std_GetTimerElapsedTime(Std_TimerType *timer);
 
 void Std_TimerSet(Std_TimerType *timer, std_time_t timeout);
 bool Std_IsTimerTimeout(Std_TimerType *timer);
+
+#ifdef STD_TIMER_WHEEL
+/* notify is called when a timer armed from another thread expires before the time last returned by
+ * Std_TimerWheelGetNextExpiry, so that a sleeping timer thread can be woken up */
+void Std_TimerWheelInit(void (*notify)(void));
+void Std_TimerEntryInit(Std_TimerEntryType *entry, Std_TimerCallbackType callback, void *param);
+/* arm after timeout us, then every period us if not 0; the callback runs in the thread calling
+ * Std_TimerWheelMainFunction, restarting an armed timer re-arms it */
+void Std_TimerEntryStart(Std_TimerEntryType *entry, std_time64_t timeout, std_time64_t period);
+void Std_TimerEntryStop(Std_TimerEntryType *entry);
+bool Std_IsTimerEntryStarted(Std_TimerEntryType *entry);
+/* absolute time of the next expiry or cascade, STD_TIME64_MAX if no timer is armed */
+std_time64_t Std_TimerWheelGetNextExpiry(void);
+void Std_TimerWheelMainFunction(void);
+#endif
 #endif /* STD_TIMER_H */
\ No newline at end of file
@@ -62,6 +62,15 @@ typedef enum
 
 typedef struct TcpIp_Config_s TcpIp_ConfigType;
 
+/* one datagram of a TcpIp_RecvFromBatch/TcpIp_SendToBatch request */
+typedef struct {
+  TcpIp_SockAddrType RemoteAddr;
+  const uint8_t *HeaderPtr; /* TX only: optional header sent in front of BufPtr, may be NULL */
+  uint8_t *BufPtr;
+  uint16_t HeaderLength;
+  uint16_t Length; /* InOut for RX: buffer size in, datagram size out */
+} TcpIp_MsgType;
+
 /* ================================ [ DECLARES  ] ============================================== */
 /* ================================ [ DATAS     ] ============================================== */
 /* ================================ [ LOCALS    ] ============================================== */
@@ -108,6 +117,22 @@ Std_ReturnType TcpIp_SendTo(TcpIp_SocketIdType SocketId, const TcpIp_SockAddrTyp
 
 Std_ReturnType TcpIp_Send(TcpIp_SocketIdType SocketId, const uint8_t *BufPtr, uint16_t Length);
 
+/* Send as much as the TCP socket accepts without blocking, *Length is updated to the number of
+ * bytes sent, TCPIP_E_NOSPACE is returned if that's less than requested. */
+Std_ReturnType TcpIp_SendPartial(TcpIp_SocketIdType SocketId, const uint8_t *BufPtr,
+                                 uint16_t *Length /* InOut */);
+
+/* Receive up to *Number datagrams with one syscall (recvmmsg on linux), *Number is updated to the
+ * number of datagrams received, 0 if nothing is pending. A datagram larger than its buffer is
+ * dropped and reported with Length 0. */
+Std_ReturnType TcpIp_RecvFromBatch(TcpIp_SocketIdType SocketId, TcpIp_MsgType *Msgs,
+                                   uint16_t *Number /* InOut */);
+
+/* Send *Number datagrams with one syscall (sendmmsg on linux), *Number is updated to the number of
+ * datagrams sent, if it's less than requested, Msgs[*Number] is the one failed. */
+Std_ReturnType TcpIp_SendToBatch(TcpIp_SocketIdType SocketId, const TcpIp_MsgType *Msgs,
+                                 uint16_t *Number /* InOut */);
+
 /*
  * Idel: The time (in seconds) the connection needs to remain idle before TCP starts sending
  * keepalive probes,
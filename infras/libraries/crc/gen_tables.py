@@ -0,0 +1,121 @@
+# SSAS - Simple Smart Automotive Software
+# Copyright (C) 2026 Parai Wang <parai@foxmail.com>
+
+# generate the slicing-by-8 tables and the PCLMULQDQ folding constants of the CRC library, one
+# source per model so only the models in use are linked, usage: python gen_tables.py src
+
+import os
+import sys
+
+# name, width, poly, reflected
+CRC_MODELS = [
+    ('8', 8, 0x1D, False),  # SAE J1850
+    ('16', 16, 0x1021, False),  # CCITT
+    ('32', 32, 0x04C11DB7, True),  # IEEE 802.3
+    ('32P4', 32, 0xF4ACFB13, True),  # AUTOSAR E2E profile 4
+]
+
+
+def reflect(v, n):
+    r = 0
+    for i in range(n):
+        if (v >> i) & 1:
+            r |= 1 << (n - 1 - i)
+    return r
+
+
+def gen_table(width, poly, reflected):
+    mask = (1 << width) - 1
+    table = []
+    for i in range(256):
+        if reflected:
+            crc = i
+            for _ in range(8):
+                crc = (crc >> 1) ^ (reflect(poly, width) if crc & 1 else 0)
+        else:
+            crc = i << (width - 8)
+            for _ in range(8):
+                crc = ((crc << 1) ^ (poly if crc >> (width - 1) else 0)) & mask
+        table.append(crc)
+    tables = [table]
+    for k in range(1, 8):
+        prev = tables[-1]
+        if reflected:
+            tables.append([(prev[i] >> 8) ^ table[prev[i] & 0xFF] for i in range(256)])
+        else:
+            tables.append([((prev[i] << 8) & mask) ^ table[prev[i] >> (width - 8)]
+                           for i in range(256)])
+    return tables
+
+
+def xpow_mod(n, poly33):
+    r = 1
+    for _ in range(n):
+        r <<= 1
+        if (r >> 32) & 1:
+            r ^= poly33
+    return r
+
+
+def xdiv(n, poly33):
+    q, r = 0, 1 << n
+    for i in range(n, 31, -1):
+        if (r >> i) & 1:
+            r ^= poly33 << (i - 32)
+            q |= 1 << (i - 32)
+    return q
+
+
+def gen_clmul(poly):
+    # the constants of the bit-reflected folding, see "Fast CRC Computation for Generic
+    # Polynomials Using PCLMULQDQ Instruction" from Intel
+    poly33 = (1 << 32) | poly
+
+    def k(n):
+        return reflect(xpow_mod(n, poly33), 32) << 1
+    return [k(4 * 128 + 32), k(4 * 128 - 32), k(128 + 32), k(128 - 32), k(64),
+            reflect(poly33, 33), reflect(xdiv(64, poly33), 33)]
+
+
+def table_sources(dir):
+    return ['%s/Crc_Tables%s.c' % (dir, name) for name, _, _, _ in CRC_MODELS]
+
+
+def main(dir):
+    for (name, width, poly, reflected), out in zip(CRC_MODELS, table_sources(dir)):
+        C = open(out, 'w')
+        C.write('/**\n')
+        C.write(' * SSAS - Simple Smart Automotive Software\n')
+        C.write(' * Copyright (C) 2026 Parai Wang <parai@foxmail.com>\n')
+        C.write(' *\n')
+        C.write(' * Generated by gen_tables.py, do not modify.\n')
+        C.write(' */\n')
+        C.write(
+            '/* ================================ [ INCLUDES  ] ============================================== */\n')
+        C.write('#include "Crc_Priv.h"\n')
+        C.write(
+            '/* ================================ [ DATAS     ] ============================================== */\n')
+        ctype = 'uint%d_t' % (width)
+        digits = width // 4
+        perLine = {8: 16, 16: 12, 32: 8}[width]
+        C.write('const %s Crc_Table%s[CRC_TABLE_SLICES][256] = {\n' % (ctype, name))
+        for k, table in enumerate(gen_table(width, poly, reflected)):
+            if 1 == k:
+                C.write('#ifndef CRC_DISABLE_SLICING_BY_8\n')
+            C.write('  {\n')
+            for i in range(0, 256, perLine):
+                C.write('    %s,\n' % (', '.join(['0x%0*X' % (digits, v)
+                        for v in table[i:i + perLine]])))
+            C.write('  },\n')
+        C.write('#endif\n')
+        C.write('};\n')
+        if reflected and (32 == width):
+            C.write('\nconst Crc_ClmulConstantsType Crc_Clmul%s = {\n' % (name))
+            for v in gen_clmul(poly):
+                C.write('  0x%09X,\n' % (v))
+            C.write('};\n')
+        C.close()
+
+
+if __name__ == '__main__':
+    main(sys.argv[1])
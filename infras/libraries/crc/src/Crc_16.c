@@ -7,24 +7,40 @@
  */
 /* ================================ [ INCLUDES  ] ============================================== */
 #include "Crc.h"
+#include "Crc_Priv.h"
 /* ================================ [ MACROS    ] ============================================== */
-#define crc_update crc16_update
+/* CCITT-FALSE */
+#define CRC16_INIT 0xFFFFu
 /* ================================ [ TYPES     ] ============================================== */
 /* ================================ [ DECLARES  ] ============================================== */
 /* ================================ [ DATAS     ] ============================================== */
 /* ================================ [ LOCALS    ] ============================================== */
-#include "crc16/crc16.h"
-#include "crc16/crc16.c"
 /* ================================ [ FUNCTIONS ] ============================================== */
 uint16_t Crc_CalculateCRC16(const uint8_t *Crc_DataPtr, uint32_t Crc_Length,
                             uint16_t Crc_StartValue16, boolean Crc_IsFirstCall) {
   uint16_t u16Crc = Crc_StartValue16;
 
   if (Crc_IsFirstCall) {
-    Crc_StartValue16 = 0xFFFF;
+    u16Crc = CRC16_INIT;
   }
 
-  u16Crc = crc_update(Crc_StartValue16, Crc_DataPtr, Crc_Length);
+#ifndef CRC_DISABLE_SLICING_BY_8
+  while (Crc_Length >= 8) {
+    u16Crc = Crc_Table16[7][(u16Crc >> 8) ^ Crc_DataPtr[0]] ^
+             Crc_Table16[6][(u16Crc & 0xFF) ^ Crc_DataPtr[1]] ^ Crc_Table16[5][Crc_DataPtr[2]] ^
+             Crc_Table16[4][Crc_DataPtr[3]] ^ Crc_Table16[3][Crc_DataPtr[4]] ^
+             Crc_Table16[2][Crc_DataPtr[5]] ^ Crc_Table16[1][Crc_DataPtr[6]] ^
+             Crc_Table16[0][Crc_DataPtr[7]];
+    Crc_DataPtr += 8;
+    Crc_Length -= 8;
+  }
+#endif
+
+  while (Crc_Length > 0) {
+    u16Crc = (uint16_t)(u16Crc << 8) ^ Crc_Table16[0][(u16Crc >> 8) ^ *Crc_DataPtr];
+    Crc_DataPtr++;
+    Crc_Length--;
+  }
 
   return u16Crc;
 }
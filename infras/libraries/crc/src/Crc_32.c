@@ -0,0 +1,70 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2026 Parai Wang <parai@foxmail.com>
+ *
+ * ref:
+ * https://www.autosar.org/fileadmin/user_upload/standards/classic/4-3/AUTOSAR_SWS_CRCLibrary.pdf
+ */
+/* ================================ [ INCLUDES  ] ============================================== */
+#include "Crc.h"
+#include "Crc_Priv.h"
+/* ================================ [ MACROS    ] ============================================== */
+#define CRC32_INIT 0xFFFFFFFFu
+#define CRC32_XOR 0xFFFFFFFFu
+/* ================================ [ TYPES     ] ============================================== */
+/* ================================ [ DECLARES  ] ============================================== */
+/* ================================ [ DATAS     ] ============================================== */
+/* ================================ [ LOCALS    ] ============================================== */
+/* ================================ [ FUNCTIONS ] ============================================== */
+uint32_t Crc_Update32(uint32_t crc, const uint32_t table[CRC_TABLE_SLICES][256],
+                      const Crc_ClmulConstantsType *clmul, const uint8_t *data, uint32_t length) {
+  uint32_t one;
+#ifdef CRC_USE_PCLMUL
+  uint32_t len;
+
+  if ((NULL != clmul) && (length >= CRC_CLMUL_MIN_LENGTH) && Crc_ClmulSupported()) {
+    len = length & ~(uint32_t)15;
+    crc = Crc_ClmulFold32(crc, clmul, data, len);
+    data += len;
+    length -= len;
+  }
+#else
+  (void)clmul;
+#endif
+
+#ifndef CRC_DISABLE_SLICING_BY_8
+  while (length >= 8) {
+    one = crc ^ ((uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) |
+                 ((uint32_t)data[3] << 24));
+    crc = table[7][one & 0xFF] ^ table[6][(one >> 8) & 0xFF] ^ table[5][(one >> 16) & 0xFF] ^
+          table[4][one >> 24] ^ table[3][data[4]] ^ table[2][data[5]] ^ table[1][data[6]] ^
+          table[0][data[7]];
+    data += 8;
+    length -= 8;
+  }
+#endif
+
+  while (length > 0) {
+    one = (crc ^ *data) & 0xFF;
+    crc = (crc >> 8) ^ table[0][one];
+    data++;
+    length--;
+  }
+
+  return crc;
+}
+
+uint32_t Crc_CalculateCRC32(const uint8_t *Crc_DataPtr, uint32_t Crc_Length,
+                            uint32_t Crc_StartValue32, boolean Crc_IsFirstCall) {
+  uint32_t u32Crc;
+
+  if (Crc_IsFirstCall) {
+    u32Crc = CRC32_INIT;
+  } else {
+    u32Crc = Crc_StartValue32 ^ CRC32_XOR;
+  }
+
+  u32Crc = Crc_Update32(u32Crc, Crc_Table32, &Crc_Clmul32, Crc_DataPtr, Crc_Length);
+
+  return u32Crc ^ CRC32_XOR;
+}
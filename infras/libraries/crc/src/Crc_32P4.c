@@ -0,0 +1,32 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2026 Parai Wang <parai@foxmail.com>
+ *
+ * ref:
+ * https://www.autosar.org/fileadmin/user_upload/standards/classic/4-3/AUTOSAR_SWS_CRCLibrary.pdf
+ */
+/* ================================ [ INCLUDES  ] ============================================== */
+#include "Crc.h"
+#include "Crc_Priv.h"
+/* ================================ [ MACROS    ] ============================================== */
+#define CRC32P4_INIT 0xFFFFFFFFu
+#define CRC32P4_XOR 0xFFFFFFFFu
+/* ================================ [ TYPES     ] ============================================== */
+/* ================================ [ DECLARES  ] ============================================== */
+/* ================================ [ DATAS     ] ============================================== */
+/* ================================ [ LOCALS    ] ============================================== */
+/* ================================ [ FUNCTIONS ] ============================================== */
+uint32_t Crc_CalculateCRC32P4(const uint8_t *Crc_DataPtr, uint32_t Crc_Length,
+                              uint32_t Crc_StartValue32, boolean Crc_IsFirstCall) {
+  uint32_t u32Crc;
+
+  if (Crc_IsFirstCall) {
+    u32Crc = CRC32P4_INIT;
+  } else {
+    u32Crc = Crc_StartValue32 ^ CRC32P4_XOR;
+  }
+
+  u32Crc = Crc_Update32(u32Crc, Crc_Table32P4, &Crc_Clmul32P4, Crc_DataPtr, Crc_Length);
+
+  return u32Crc ^ CRC32P4_XOR;
+}
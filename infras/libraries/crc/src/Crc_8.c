@@ -0,0 +1,48 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2026 Parai Wang <parai@foxmail.com>
+ *
+ * ref:
+ * https://www.autosar.org/fileadmin/user_upload/standards/classic/4-3/AUTOSAR_SWS_CRCLibrary.pdf
+ */
+/* ================================ [ INCLUDES  ] ============================================== */
+#include "Crc.h"
+#include "Crc_Priv.h"
+/* ================================ [ MACROS    ] ============================================== */
+/* SAE-J1850 */
+#define CRC8_INIT 0xFFu
+#define CRC8_XOR 0xFFu
+/* ================================ [ TYPES     ] ============================================== */
+/* ================================ [ DECLARES  ] ============================================== */
+/* ================================ [ DATAS     ] ============================================== */
+/* ================================ [ LOCALS    ] ============================================== */
+/* ================================ [ FUNCTIONS ] ============================================== */
+uint8_t Crc_CalculateCRC8(const uint8_t *Crc_DataPtr, uint32_t Crc_Length, uint8_t Crc_StartValue8,
+                          boolean Crc_IsFirstCall) {
+  uint8_t u8Crc;
+
+  if (Crc_IsFirstCall) {
+    u8Crc = CRC8_INIT;
+  } else {
+    u8Crc = Crc_StartValue8 ^ CRC8_XOR;
+  }
+
+#ifndef CRC_DISABLE_SLICING_BY_8
+  while (Crc_Length >= 8) {
+    u8Crc = Crc_Table8[7][u8Crc ^ Crc_DataPtr[0]] ^ Crc_Table8[6][Crc_DataPtr[1]] ^
+            Crc_Table8[5][Crc_DataPtr[2]] ^ Crc_Table8[4][Crc_DataPtr[3]] ^
+            Crc_Table8[3][Crc_DataPtr[4]] ^ Crc_Table8[2][Crc_DataPtr[5]] ^
+            Crc_Table8[1][Crc_DataPtr[6]] ^ Crc_Table8[0][Crc_DataPtr[7]];
+    Crc_DataPtr += 8;
+    Crc_Length -= 8;
+  }
+#endif
+
+  while (Crc_Length > 0) {
+    u8Crc = Crc_Table8[0][u8Crc ^ *Crc_DataPtr];
+    Crc_DataPtr++;
+    Crc_Length--;
+  }
+
+  return u8Crc ^ CRC8_XOR;
+}
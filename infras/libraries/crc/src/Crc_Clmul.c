@@ -0,0 +1,94 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2026 Parai Wang <parai@foxmail.com>
+ *
+ * ref:
+ * https://www.intel.com/content/dam/www/public/us/en/documents/white-papers/fast-crc-computation-generic-polynomials-pclmulqdq-paper.pdf
+ */
+/* ================================ [ INCLUDES  ] ============================================== */
+#include "Crc_Priv.h"
+#ifdef CRC_USE_PCLMUL
+#include <stdlib.h>
+#include <immintrin.h>
+/* ================================ [ MACROS    ] ============================================== */
+#define CRC_CLMUL_TARGET __attribute__((target("pclmul,sse2")))
+/* ================================ [ TYPES     ] ============================================== */
+/* ================================ [ DECLARES  ] ============================================== */
+/* ================================ [ DATAS     ] ============================================== */
+static int8_t lClmulSupported = -1;
+/* ================================ [ LOCALS    ] ============================================== */
+static CRC_CLMUL_TARGET inline __m128i Crc_Fold128(__m128i x, __m128i k, __m128i data) {
+  __m128i lo = _mm_clmulepi64_si128(x, k, 0x00);
+  __m128i hi = _mm_clmulepi64_si128(x, k, 0x11);
+  return _mm_xor_si128(_mm_xor_si128(lo, hi), data);
+}
+/* ================================ [ FUNCTIONS ] ============================================== */
+boolean Crc_ClmulSupported(void) {
+  if (lClmulSupported < 0) {
+    __builtin_cpu_init();
+    /* CRC_DISABLE_PCLMUL in the environment is kept for benchmarking the table path */
+    if ((NULL == getenv("CRC_DISABLE_PCLMUL")) && __builtin_cpu_supports("pclmul")) {
+      lClmulSupported = 1;
+    } else {
+      lClmulSupported = 0;
+    }
+  }
+
+  return (lClmulSupported > 0);
+}
+
+CRC_CLMUL_TARGET uint32_t Crc_ClmulFold32(uint32_t crc, const Crc_ClmulConstantsType *clmul,
+                                          const uint8_t *data, uint32_t length) {
+  const __m128i mask32 = _mm_set_epi32(0, 0, 0, -1);
+  __m128i x1, x2, x3, x4, k, t;
+
+  x1 = _mm_loadu_si128((const __m128i *)&data[0]);
+  x2 = _mm_loadu_si128((const __m128i *)&data[16]);
+  x3 = _mm_loadu_si128((const __m128i *)&data[32]);
+  x4 = _mm_loadu_si128((const __m128i *)&data[48]);
+  x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int)crc));
+  data += 64;
+  length -= 64;
+
+  /* fold 4x128 bits in parallel */
+  k = _mm_set_epi64x((long long)clmul->k2, (long long)clmul->k1);
+  while (length >= 64) {
+    x1 = Crc_Fold128(x1, k, _mm_loadu_si128((const __m128i *)&data[0]));
+    x2 = Crc_Fold128(x2, k, _mm_loadu_si128((const __m128i *)&data[16]));
+    x3 = Crc_Fold128(x3, k, _mm_loadu_si128((const __m128i *)&data[32]));
+    x4 = Crc_Fold128(x4, k, _mm_loadu_si128((const __m128i *)&data[48]));
+    data += 64;
+    length -= 64;
+  }
+
+  /* reduce to a single 128 bits lane */
+  k = _mm_set_epi64x((long long)clmul->k4, (long long)clmul->k3);
+  x1 = Crc_Fold128(x1, k, x2);
+  x1 = Crc_Fold128(x1, k, x3);
+  x1 = Crc_Fold128(x1, k, x4);
+  while (length >= 16) {
+    x1 = Crc_Fold128(x1, k, _mm_loadu_si128((const __m128i *)data));
+    data += 16;
+    length -= 16;
+  }
+
+  /* 128 -> 64 bits */
+  t = _mm_clmulepi64_si128(k, x1, 0x01);
+  x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), t);
+
+  /* 64 -> 32 bits */
+  k = _mm_set_epi64x(0, (long long)clmul->k5);
+  t = _mm_clmulepi64_si128(_mm_and_si128(x1, mask32), k, 0x00);
+  x1 = _mm_xor_si128(_mm_srli_si128(x1, 4), t);
+
+  /* Barrett reduction */
+  k = _mm_set_epi64x((long long)clmul->mu, (long long)clmul->poly);
+  t = _mm_and_si128(x1, mask32);
+  t = _mm_clmulepi64_si128(t, k, 0x10);
+  t = _mm_and_si128(t, mask32);
+  t = _mm_clmulepi64_si128(t, k, 0x00);
+  x1 = _mm_xor_si128(x1, t);
+
+  return (uint32_t)_mm_cvtsi128_si32(_mm_srli_si128(x1, 4));
+}
+#endif /* CRC_USE_PCLMUL */
@@ -0,0 +1,56 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2026 Parai Wang <parai@foxmail.com>
+ */
+#ifndef CRC_PRIV_H
+#define CRC_PRIV_H
+/* ================================ [ INCLUDES  ] ============================================== */
+#include "Std_Types.h"
+/* ================================ [ MACROS    ] ============================================== */
+/* carry-less multiply folding for the reflected 32 bit CRCs, x86-64 only */
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(CRC_DISABLE_PCLMUL)
+#define CRC_USE_PCLMUL
+#endif
+
+/* the slicing-by-8 tables, only the first one is generated without slicing */
+#ifdef CRC_DISABLE_SLICING_BY_8
+#define CRC_TABLE_SLICES 1
+#else
+#define CRC_TABLE_SLICES 8
+#endif
+
+/* the clmul folding needs at least 4x128 bits */
+#define CRC_CLMUL_MIN_LENGTH 64
+/* ================================ [ TYPES     ] ============================================== */
+/* folding constants x^n mod P(x), bit reflected, see gen_tables.py */
+typedef struct {
+  uint64_t k1; /* x^(4*128+32) */
+  uint64_t k2; /* x^(4*128-32) */
+  uint64_t k3; /* x^(128+32) */
+  uint64_t k4; /* x^(128-32) */
+  uint64_t k5; /* x^64 */
+  uint64_t poly;
+  uint64_t mu; /* x^64 / P(x) */
+} Crc_ClmulConstantsType;
+/* ================================ [ DECLARES  ] ============================================== */
+extern const uint8_t Crc_Table8[CRC_TABLE_SLICES][256];
+extern const uint16_t Crc_Table16[CRC_TABLE_SLICES][256];
+extern const uint32_t Crc_Table32[CRC_TABLE_SLICES][256];
+extern const uint32_t Crc_Table32P4[CRC_TABLE_SLICES][256];
+extern const Crc_ClmulConstantsType Crc_Clmul32;
+extern const Crc_ClmulConstantsType Crc_Clmul32P4;
+/* ================================ [ DATAS     ] ============================================== */
+/* ================================ [ LOCALS    ] ============================================== */
+/* ================================ [ FUNCTIONS ] ============================================== */
+/* update the raw register of a reflected 32 bit CRC, no init/xorout applied.
+ * The clmul constants are optional, NULL forces the slicing-by-8 path. */
+uint32_t Crc_Update32(uint32_t crc, const uint32_t table[CRC_TABLE_SLICES][256],
+                      const Crc_ClmulConstantsType *clmul, const uint8_t *data, uint32_t length);
+
+#ifdef CRC_USE_PCLMUL
+boolean Crc_ClmulSupported(void);
+/* length must be a multiple of 16 and not less than CRC_CLMUL_MIN_LENGTH */
+uint32_t Crc_ClmulFold32(uint32_t crc, const Crc_ClmulConstantsType *clmul, const uint8_t *data,
+                         uint32_t length);
+#endif
+#endif /* CRC_PRIV_H */
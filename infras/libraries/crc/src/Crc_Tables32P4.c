@@ -0,0 +1,295 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2026 Parai Wang <parai@foxmail.com>
+ *
+ * Generated by gen_tables.py, do not modify.
+ */
+/* ================================ [ INCLUDES  ] ============================================== */
+#include "Crc_Priv.h"
+/* ================================ [ DATAS     ] ============================================== */
+const uint32_t Crc_Table32P4[CRC_TABLE_SLICES][256] = {
+  {
+    0x00000000, 0x30850FF5, 0x610A1FEA, 0x518F101F, 0xC2143FD4, 0xF2913021, 0xA31E203E, 0x939B2FCB,
+    0x159615F7, 0x25131A02, 0x749C0A1D, 0x441905E8, 0xD7822A23, 0xE70725D6, 0xB68835C9, 0x860D3A3C,
+    0x2B2C2BEE, 0x1BA9241B, 0x4A263404, 0x7AA33BF1, 0xE938143A, 0xD9BD1BCF, 0x88320BD0, 0xB8B70425,
+    0x3EBA3E19, 0x0E3F31EC, 0x5FB021F3, 0x6F352E06, 0xFCAE01CD, 0xCC2B0E38, 0x9DA41E27, 0xAD2111D2,
+    0x565857DC, 0x66DD5829, 0x37524836, 0x07D747C3, 0x944C6808, 0xA4C967FD, 0xF54677E2, 0xC5C37817,
+    0x43CE422B, 0x734B4DDE, 0x22C45DC1, 0x12415234, 0x81DA7DFF, 0xB15F720A, 0xE0D06215, 0xD0556DE0,
+    0x7D747C32, 0x4DF173C7, 0x1C7E63D8, 0x2CFB6C2D, 0xBF6043E6, 0x8FE54C13, 0xDE6A5C0C, 0xEEEF53F9,
+    0x68E269C5, 0x58676630, 0x09E8762F, 0x396D79DA, 0xAAF65611, 0x9A7359E4, 0xCBFC49FB, 0xFB79460E,
+    0xACB0AFB8, 0x9C35A04D, 0xCDBAB052, 0xFD3FBFA7, 0x6EA4906C, 0x5E219F99, 0x0FAE8F86, 0x3F2B8073,
+    0xB926BA4F, 0x89A3B5BA, 0xD82CA5A5, 0xE8A9AA50, 0x7B32859B, 0x4BB78A6E, 0x1A389A71, 0x2ABD9584,
+    0x879C8456, 0xB7198BA3, 0xE6969BBC, 0xD6139449, 0x4588BB82, 0x750DB477, 0x2482A468, 0x1407AB9D,
+    0x920A91A1, 0xA28F9E54, 0xF3008E4B, 0xC38581BE, 0x501EAE75, 0x609BA180, 0x3114B19F, 0x0191BE6A,
+    0xFAE8F864, 0xCA6DF791, 0x9BE2E78E, 0xAB67E87B, 0x38FCC7B0, 0x0879C845, 0x59F6D85A, 0x6973D7AF,
+    0xEF7EED93, 0xDFFBE266, 0x8E74F279, 0xBEF1FD8C, 0x2D6AD247, 0x1DEFDDB2, 0x4C60CDAD, 0x7CE5C258,
+    0xD1C4D38A, 0xE141DC7F, 0xB0CECC60, 0x804BC395, 0x13D0EC5E, 0x2355E3AB, 0x72DAF3B4, 0x425FFC41,
+    0xC452C67D, 0xF4D7C988, 0xA558D997, 0x95DDD662, 0x0646F9A9, 0x36C3F65C, 0x674CE643, 0x57C9E9B6,
+    0xC8DF352F, 0xF85A3ADA, 0xA9D52AC5, 0x99502530, 0x0ACB0AFB, 0x3A4E050E, 0x6BC11511, 0x5B441AE4,
+    0xDD4920D8, 0xEDCC2F2D, 0xBC433F32, 0x8CC630C7, 0x1F5D1F0C, 0x2FD810F9, 0x7E5700E6, 0x4ED20F13,
+    0xE3F31EC1, 0xD3761134, 0x82F9012B, 0xB27C0EDE, 0x21E72115, 0x11622EE0, 0x40ED3EFF, 0x7068310A,
+    0xF6650B36, 0xC6E004C3, 0x976F14DC, 0xA7EA1B29, 0x347134E2, 0x04F43B17, 0x557B2B08, 0x65FE24FD,
+    0x9E8762F3, 0xAE026D06, 0xFF8D7D19, 0xCF0872EC, 0x5C935D27, 0x6C1652D2, 0x3D9942CD, 0x0D1C4D38,
+    0x8B117704, 0xBB9478F1, 0xEA1B68EE, 0xDA9E671B, 0x490548D0, 0x79804725, 0x280F573A, 0x188A58CF,
+    0xB5AB491D, 0x852E46E8, 0xD4A156F7, 0xE4245902, 0x77BF76C9, 0x473A793C, 0x16B56923, 0x263066D6,
+    0xA03D5CEA, 0x90B8531F, 0xC1374300, 0xF1B24CF5, 0x6229633E, 0x52AC6CCB, 0x03237CD4, 0x33A67321,
+    0x646F9A97, 0x54EA9562, 0x0565857D, 0x35E08A88, 0xA67BA543, 0x96FEAAB6, 0xC771BAA9, 0xF7F4B55C,
+    0x71F98F60, 0x417C8095, 0x10F3908A, 0x20769F7F, 0xB3EDB0B4, 0x8368BF41, 0xD2E7AF5E, 0xE262A0AB,
+    0x4F43B179, 0x7FC6BE8C, 0x2E49AE93, 0x1ECCA166, 0x8D578EAD, 0xBDD28158, 0xEC5D9147, 0xDCD89EB2,
+    0x5AD5A48E, 0x6A50AB7B, 0x3BDFBB64, 0x0B5AB491, 0x98C19B5A, 0xA84494AF, 0xF9CB84B0, 0xC94E8B45,
+    0x3237CD4B, 0x02B2C2BE, 0x533DD2A1, 0x63B8DD54, 0xF023F29F, 0xC0A6FD6A, 0x9129ED75, 0xA1ACE280,
+    0x27A1D8BC, 0x1724D749, 0x46ABC756, 0x762EC8A3, 0xE5B5E768, 0xD530E89D, 0x84BFF882, 0xB43AF777,
+    0x191BE6A5, 0x299EE950, 0x7811F94F, 0x4894F6BA, 0xDB0FD971, 0xEB8AD684, 0xBA05C69B, 0x8A80C96E,
+    0x0C8DF352, 0x3C08FCA7, 0x6D87ECB8, 0x5D02E34D, 0xCE99CC86, 0xFE1CC373, 0xAF93D36C, 0x9F16DC99,
+  },
+#ifndef CRC_DISABLE_SLICING_BY_8
+  {
+    0x00000000, 0xEBBA538B, 0x46CACD49, 0xAD709EC2, 0x8D959A92, 0x662FC919, 0xCB5F57DB, 0x20E50450,
+    0x8A955F7B, 0x612F0CF0, 0xCC5F9232, 0x27E5C1B9, 0x0700C5E9, 0xECBA9662, 0x41CA08A0, 0xAA705B2B,
+    0x8494D4A9, 0x6F2E8722, 0xC25E19E0, 0x29E44A6B, 0x09014E3B, 0xE2BB1DB0, 0x4FCB8372, 0xA471D0F9,
+    0x0E018BD2, 0xE5BBD859, 0x48CB469B, 0xA3711510, 0x83941140, 0x682E42CB, 0xC55EDC09, 0x2EE48F82,
+    0x9897C30D, 0x732D9086, 0xDE5D0E44, 0x35E75DCF, 0x1502599F, 0xFEB80A14, 0x53C894D6, 0xB872C75D,
+    0x12029C76, 0xF9B8CFFD, 0x54C8513F, 0xBF7202B4, 0x9F9706E4, 0x742D556F, 0xD95DCBAD, 0x32E79826,
+    0x1C0317A4, 0xF7B9442F, 0x5AC9DAED, 0xB1738966, 0x91968D36, 0x7A2CDEBD, 0xD75C407F, 0x3CE613F4,
+    0x969648DF, 0x7D2C1B54, 0xD05C8596, 0x3BE6D61D, 0x1B03D24D, 0xF0B981C6, 0x5DC91F04, 0xB6734C8F,
+    0xA091EC45, 0x4B2BBFCE, 0xE65B210C, 0x0DE17287, 0x2D0476D7, 0xC6BE255C, 0x6BCEBB9E, 0x8074E815,
+    0x2A04B33E, 0xC1BEE0B5, 0x6CCE7E77, 0x87742DFC, 0xA79129AC, 0x4C2B7A27, 0xE15BE4E5, 0x0AE1B76E,
+    0x240538EC, 0xCFBF6B67, 0x62CFF5A5, 0x8975A62E, 0xA990A27E, 0x422AF1F5, 0xEF5A6F37, 0x04E03CBC,
+    0xAE906797, 0x452A341C, 0xE85AAADE, 0x03E0F955, 0x2305FD05, 0xC8BFAE8E, 0x65CF304C, 0x8E7563C7,
+    0x38062F48, 0xD3BC7CC3, 0x7ECCE201, 0x9576B18A, 0xB593B5DA, 0x5E29E651, 0xF3597893, 0x18E32B18,
+    0xB2937033, 0x592923B8, 0xF459BD7A, 0x1FE3EEF1, 0x3F06EAA1, 0xD4BCB92A, 0x79CC27E8, 0x92767463,
+    0xBC92FBE1, 0x5728A86A, 0xFA5836A8, 0x11E26523, 0x31076173, 0xDABD32F8, 0x77CDAC3A, 0x9C77FFB1,
+    0x3607A49A, 0xDDBDF711, 0x70CD69D3, 0x9B773A58, 0xBB923E08, 0x50286D83, 0xFD58F341, 0x16E2A0CA,
+    0xD09DB2D5, 0x3B27E15E, 0x96577F9C, 0x7DED2C17, 0x5D082847, 0xB6B27BCC, 0x1BC2E50E, 0xF078B685,
+    0x5A08EDAE, 0xB1B2BE25, 0x1CC220E7, 0xF778736C, 0xD79D773C, 0x3C2724B7, 0x9157BA75, 0x7AEDE9FE,
+    0x5409667C, 0xBFB335F7, 0x12C3AB35, 0xF979F8BE, 0xD99CFCEE, 0x3226AF65, 0x9F5631A7, 0x74EC622C,
+    0xDE9C3907, 0x35266A8C, 0x9856F44E, 0x73ECA7C5, 0x5309A395, 0xB8B3F01E, 0x15C36EDC, 0xFE793D57,
+    0x480A71D8, 0xA3B02253, 0x0EC0BC91, 0xE57AEF1A, 0xC59FEB4A, 0x2E25B8C1, 0x83552603, 0x68EF7588,
+    0xC29F2EA3, 0x29257D28, 0x8455E3EA, 0x6FEFB061, 0x4F0AB431, 0xA4B0E7BA, 0x09C07978, 0xE27A2AF3,
+    0xCC9EA571, 0x2724F6FA, 0x8A546838, 0x61EE3BB3, 0x410B3FE3, 0xAAB16C68, 0x07C1F2AA, 0xEC7BA121,
+    0x460BFA0A, 0xADB1A981, 0x00C13743, 0xEB7B64C8, 0xCB9E6098, 0x20243313, 0x8D54ADD1, 0x66EEFE5A,
+    0x700C5E90, 0x9BB60D1B, 0x36C693D9, 0xDD7CC052, 0xFD99C402, 0x16239789, 0xBB53094B, 0x50E95AC0,
+    0xFA9901EB, 0x11235260, 0xBC53CCA2, 0x57E99F29, 0x770C9B79, 0x9CB6C8F2, 0x31C65630, 0xDA7C05BB,
+    0xF4988A39, 0x1F22D9B2, 0xB2524770, 0x59E814FB, 0x790D10AB, 0x92B74320, 0x3FC7DDE2, 0xD47D8E69,
+    0x7E0DD542, 0x95B786C9, 0x38C7180B, 0xD37D4B80, 0xF3984FD0, 0x18221C5B, 0xB5528299, 0x5EE8D112,
+    0xE89B9D9D, 0x0321CE16, 0xAE5150D4, 0x45EB035F, 0x650E070F, 0x8EB45484, 0x23C4CA46, 0xC87E99CD,
+    0x620EC2E6, 0x89B4916D, 0x24C40FAF, 0xCF7E5C24, 0xEF9B5874, 0x04210BFF, 0xA951953D, 0x42EBC6B6,
+    0x6C0F4934, 0x87B51ABF, 0x2AC5847D, 0xC17FD7F6, 0xE19AD3A6, 0x0A20802D, 0xA7501EEF, 0x4CEA4D64,
+    0xE69A164F, 0x0D2045C4, 0xA050DB06, 0x4BEA888D, 0x6B0F8CDD, 0x80B5DF56, 0x2DC54194, 0xC67F121F,
+  },
+  {
+    0x00000000, 0x8C2D8A94, 0x89E57F77, 0x05C8F5E3, 0x827494B1, 0x0E591E25, 0x0B91EBC6, 0x87BC6152,
+    0x9557433D, 0x197AC9A9, 0x1CB23C4A, 0x909FB6DE, 0x1723D78C, 0x9B0E5D18, 0x9EC6A8FB, 0x12EB226F,
+    0xBB10EC25, 0x373D66B1, 0x32F59352, 0xBED819C6, 0x39647894, 0xB549F200, 0xB08107E3, 0x3CAC8D77,
+    0x2E47AF18, 0xA26A258C, 0xA7A2D06F, 0x2B8F5AFB, 0xAC333BA9, 0x201EB13D, 0x25D644DE, 0xA9FBCE4A,
+    0xE79FB215, 0x6BB23881, 0x6E7ACD62, 0xE25747F6, 0x65EB26A4, 0xE9C6AC30, 0xEC0E59D3, 0x6023D347,
+    0x72C8F128, 0xFEE57BBC, 0xFB2D8E5F, 0x770004CB, 0xF0BC6599, 0x7C91EF0D, 0x79591AEE, 0xF574907A,
+    0x5C8F5E30, 0xD0A2D4A4, 0xD56A2147, 0x5947ABD3, 0xDEFBCA81, 0x52D64015, 0x571EB5F6, 0xDB333F62,
+    0xC9D81D0D, 0x45F59799, 0x403D627A, 0xCC10E8EE, 0x4BAC89BC, 0xC7810328, 0xC249F6CB, 0x4E647C5F,
+    0x5E810E75, 0xD2AC84E1, 0xD7647102, 0x5B49FB96, 0xDCF59AC4, 0x50D81050, 0x5510E5B3, 0xD93D6F27,
+    0xCBD64D48, 0x47FBC7DC, 0x4233323F, 0xCE1EB8AB, 0x49A2D9F9, 0xC58F536D, 0xC047A68E, 0x4C6A2C1A,
+    0xE591E250, 0x69BC68C4, 0x6C749D27, 0xE05917B3, 0x67E576E1, 0xEBC8FC75, 0xEE000996, 0x622D8302,
+    0x70C6A16D, 0xFCEB2BF9, 0xF923DE1A, 0x750E548E, 0xF2B235DC, 0x7E9FBF48, 0x7B574AAB, 0xF77AC03F,
+    0xB91EBC60, 0x353336F4, 0x30FBC317, 0xBCD64983, 0x3B6A28D1, 0xB747A245, 0xB28F57A6, 0x3EA2DD32,
+    0x2C49FF5D, 0xA06475C9, 0xA5AC802A, 0x29810ABE, 0xAE3D6BEC, 0x2210E178, 0x27D8149B, 0xABF59E0F,
+    0x020E5045, 0x8E23DAD1, 0x8BEB2F32, 0x07C6A5A6, 0x807AC4F4, 0x0C574E60, 0x099FBB83, 0x85B23117,
+    0x97591378, 0x1B7499EC, 0x1EBC6C0F, 0x9291E69B, 0x152D87C9, 0x99000D5D, 0x9CC8F8BE, 0x10E5722A,
+    0xBD021CEA, 0x312F967E, 0x34E7639D, 0xB8CAE909, 0x3F76885B, 0xB35B02CF, 0xB693F72C, 0x3ABE7DB8,
+    0x28555FD7, 0xA478D543, 0xA1B020A0, 0x2D9DAA34, 0xAA21CB66, 0x260C41F2, 0x23C4B411, 0xAFE93E85,
+    0x0612F0CF, 0x8A3F7A5B, 0x8FF78FB8, 0x03DA052C, 0x8466647E, 0x084BEEEA, 0x0D831B09, 0x81AE919D,
+    0x9345B3F2, 0x1F683966, 0x1AA0CC85, 0x968D4611, 0x11312743, 0x9D1CADD7, 0x98D45834, 0x14F9D2A0,
+    0x5A9DAEFF, 0xD6B0246B, 0xD378D188, 0x5F555B1C, 0xD8E93A4E, 0x54C4B0DA, 0x510C4539, 0xDD21CFAD,
+    0xCFCAEDC2, 0x43E76756, 0x462F92B5, 0xCA021821, 0x4DBE7973, 0xC193F3E7, 0xC45B0604, 0x48768C90,
+    0xE18D42DA, 0x6DA0C84E, 0x68683DAD, 0xE445B739, 0x63F9D66B, 0xEFD45CFF, 0xEA1CA91C, 0x66312388,
+    0x74DA01E7, 0xF8F78B73, 0xFD3F7E90, 0x7112F404, 0xF6AE9556, 0x7A831FC2, 0x7F4BEA21, 0xF36660B5,
+    0xE383129F, 0x6FAE980B, 0x6A666DE8, 0xE64BE77C, 0x61F7862E, 0xEDDA0CBA, 0xE812F959, 0x643F73CD,
+    0x76D451A2, 0xFAF9DB36, 0xFF312ED5, 0x731CA441, 0xF4A0C513, 0x788D4F87, 0x7D45BA64, 0xF16830F0,
+    0x5893FEBA, 0xD4BE742E, 0xD17681CD, 0x5D5B0B59, 0xDAE76A0B, 0x56CAE09F, 0x5302157C, 0xDF2F9FE8,
+    0xCDC4BD87, 0x41E93713, 0x4421C2F0, 0xC80C4864, 0x4FB02936, 0xC39DA3A2, 0xC6555641, 0x4A78DCD5,
+    0x041CA08A, 0x88312A1E, 0x8DF9DFFD, 0x01D45569, 0x8668343B, 0x0A45BEAF, 0x0F8D4B4C, 0x83A0C1D8,
+    0x914BE3B7, 0x1D666923, 0x18AE9CC0, 0x94831654, 0x133F7706, 0x9F12FD92, 0x9ADA0871, 0x16F782E5,
+    0xBF0C4CAF, 0x3321C63B, 0x36E933D8, 0xBAC4B94C, 0x3D78D81E, 0xB155528A, 0xB49DA769, 0x38B02DFD,
+    0x2A5B0F92, 0xA6768506, 0xA3BE70E5, 0x2F93FA71, 0xA82F9B23, 0x240211B7, 0x21CAE454, 0xADE76EC0,
+  },
+  {
+    0x00000000, 0x216B0C9F, 0x42D6193E, 0x63BD15A1, 0x85AC327C, 0xA4C73EE3, 0xC77A2B42, 0xE61127DD,
+    0x9AE60EA7, 0xBB8D0238, 0xD8301799, 0xF95B1B06, 0x1F4A3CDB, 0x3E213044, 0x5D9C25E5, 0x7CF7297A,
+    0xA4727711, 0x85197B8E, 0xE6A46E2F, 0xC7CF62B0, 0x21DE456D, 0x00B549F2, 0x63085C53, 0x426350CC,
+    0x3E9479B6, 0x1FFF7529, 0x7C426088, 0x5D296C17, 0xBB384BCA, 0x9A534755, 0xF9EE52F4, 0xD8855E6B,
+    0xD95A847D, 0xF83188E2, 0x9B8C9D43, 0xBAE791DC, 0x5CF6B601, 0x7D9DBA9E, 0x1E20AF3F, 0x3F4BA3A0,
+    0x43BC8ADA, 0x62D78645, 0x016A93E4, 0x20019F7B, 0xC610B8A6, 0xE77BB439, 0x84C6A198, 0xA5ADAD07,
+    0x7D28F36C, 0x5C43FFF3, 0x3FFEEA52, 0x1E95E6CD, 0xF884C110, 0xD9EFCD8F, 0xBA52D82E, 0x9B39D4B1,
+    0xE7CEFDCB, 0xC6A5F154, 0xA518E4F5, 0x8473E86A, 0x6262CFB7, 0x4309C328, 0x20B4D689, 0x01DFDA16,
+    0x230B62A5, 0x02606E3A, 0x61DD7B9B, 0x40B67704, 0xA6A750D9, 0x87CC5C46, 0xE47149E7, 0xC51A4578,
+    0xB9ED6C02, 0x9886609D, 0xFB3B753C, 0xDA5079A3, 0x3C415E7E, 0x1D2A52E1, 0x7E974740, 0x5FFC4BDF,
+    0x877915B4, 0xA612192B, 0xC5AF0C8A, 0xE4C40015, 0x02D527C8, 0x23BE2B57, 0x40033EF6, 0x61683269,
+    0x1D9F1B13, 0x3CF4178C, 0x5F49022D, 0x7E220EB2, 0x9833296F, 0xB95825F0, 0xDAE53051, 0xFB8E3CCE,
+    0xFA51E6D8, 0xDB3AEA47, 0xB887FFE6, 0x99ECF379, 0x7FFDD4A4, 0x5E96D83B, 0x3D2BCD9A, 0x1C40C105,
+    0x60B7E87F, 0x41DCE4E0, 0x2261F141, 0x030AFDDE, 0xE51BDA03, 0xC470D69C, 0xA7CDC33D, 0x86A6CFA2,
+    0x5E2391C9, 0x7F489D56, 0x1CF588F7, 0x3D9E8468, 0xDB8FA3B5, 0xFAE4AF2A, 0x9959BA8B, 0xB832B614,
+    0xC4C59F6E, 0xE5AE93F1, 0x86138650, 0xA7788ACF, 0x4169AD12, 0x6002A18D, 0x03BFB42C, 0x22D4B8B3,
+    0x4616C54A, 0x677DC9D5, 0x04C0DC74, 0x25ABD0EB, 0xC3BAF736, 0xE2D1FBA9, 0x816CEE08, 0xA007E297,
+    0xDCF0CBED, 0xFD9BC772, 0x9E26D2D3, 0xBF4DDE4C, 0x595CF991, 0x7837F50E, 0x1B8AE0AF, 0x3AE1EC30,
+    0xE264B25B, 0xC30FBEC4, 0xA0B2AB65, 0x81D9A7FA, 0x67C88027, 0x46A38CB8, 0x251E9919, 0x04759586,
+    0x7882BCFC, 0x59E9B063, 0x3A54A5C2, 0x1B3FA95D, 0xFD2E8E80, 0xDC45821F, 0xBFF897BE, 0x9E939B21,
+    0x9F4C4137, 0xBE274DA8, 0xDD9A5809, 0xFCF15496, 0x1AE0734B, 0x3B8B7FD4, 0x58366A75, 0x795D66EA,
+    0x05AA4F90, 0x24C1430F, 0x477C56AE, 0x66175A31, 0x80067DEC, 0xA16D7173, 0xC2D064D2, 0xE3BB684D,
+    0x3B3E3626, 0x1A553AB9, 0x79E82F18, 0x58832387, 0xBE92045A, 0x9FF908C5, 0xFC441D64, 0xDD2F11FB,
+    0xA1D83881, 0x80B3341E, 0xE30E21BF, 0xC2652D20, 0x24740AFD, 0x051F0662, 0x66A213C3, 0x47C91F5C,
+    0x651DA7EF, 0x4476AB70, 0x27CBBED1, 0x06A0B24E, 0xE0B19593, 0xC1DA990C, 0xA2678CAD, 0x830C8032,
+    0xFFFBA948, 0xDE90A5D7, 0xBD2DB076, 0x9C46BCE9, 0x7A579B34, 0x5B3C97AB, 0x3881820A, 0x19EA8E95,
+    0xC16FD0FE, 0xE004DC61, 0x83B9C9C0, 0xA2D2C55F, 0x44C3E282, 0x65A8EE1D, 0x0615FBBC, 0x277EF723,
+    0x5B89DE59, 0x7AE2D2C6, 0x195FC767, 0x3834CBF8, 0xDE25EC25, 0xFF4EE0BA, 0x9CF3F51B, 0xBD98F984,
+    0xBC472392, 0x9D2C2F0D, 0xFE913AAC, 0xDFFA3633, 0x39EB11EE, 0x18801D71, 0x7B3D08D0, 0x5A56044F,
+    0x26A12D35, 0x07CA21AA, 0x6477340B, 0x451C3894, 0xA30D1F49, 0x826613D6, 0xE1DB0677, 0xC0B00AE8,
+    0x18355483, 0x395E581C, 0x5AE34DBD, 0x7B884122, 0x9D9966FF, 0xBCF26A60, 0xDF4F7FC1, 0xFE24735E,
+    0x82D35A24, 0xA3B856BB, 0xC005431A, 0xE16E4F85, 0x077F6858, 0x261464C7, 0x45A97166, 0x64C27DF9,
+  },
+  {
+    0x00000000, 0x65DF4FF1, 0xCBBE9FE2, 0xAE61D013, 0x06C3559B, 0x631C1A6A, 0xCD7DCA79, 0xA8A28588,
+    0x0D86AB36, 0x6859E4C7, 0xC63834D4, 0xA3E77B25, 0x0B45FEAD, 0x6E9AB15C, 0xC0FB614F, 0xA5242EBE,
+    0x1B0D566C, 0x7ED2199D, 0xD0B3C98E, 0xB56C867F, 0x1DCE03F7, 0x78114C06, 0xD6709C15, 0xB3AFD3E4,
+    0x168BFD5A, 0x7354B2AB, 0xDD3562B8, 0xB8EA2D49, 0x1048A8C1, 0x7597E730, 0xDBF63723, 0xBE2978D2,
+    0x361AACD8, 0x53C5E329, 0xFDA4333A, 0x987B7CCB, 0x30D9F943, 0x5506B6B2, 0xFB6766A1, 0x9EB82950,
+    0x3B9C07EE, 0x5E43481F, 0xF022980C, 0x95FDD7FD, 0x3D5F5275, 0x58801D84, 0xF6E1CD97, 0x933E8266,
+    0x2D17FAB4, 0x48C8B545, 0xE6A96556, 0x83762AA7, 0x2BD4AF2F, 0x4E0BE0DE, 0xE06A30CD, 0x85B57F3C,
+    0x20915182, 0x454E1E73, 0xEB2FCE60, 0x8EF08191, 0x26520419, 0x438D4BE8, 0xEDEC9BFB, 0x8833D40A,
+    0x6C3559B0, 0x09EA1641, 0xA78BC652, 0xC25489A3, 0x6AF60C2B, 0x0F2943DA, 0xA14893C9, 0xC497DC38,
+    0x61B3F286, 0x046CBD77, 0xAA0D6D64, 0xCFD22295, 0x6770A71D, 0x02AFE8EC, 0xACCE38FF, 0xC911770E,
+    0x77380FDC, 0x12E7402D, 0xBC86903E, 0xD959DFCF, 0x71FB5A47, 0x142415B6, 0xBA45C5A5, 0xDF9A8A54,
+    0x7ABEA4EA, 0x1F61EB1B, 0xB1003B08, 0xD4DF74F9, 0x7C7DF171, 0x19A2BE80, 0xB7C36E93, 0xD21C2162,
+    0x5A2FF568, 0x3FF0BA99, 0x91916A8A, 0xF44E257B, 0x5CECA0F3, 0x3933EF02, 0x97523F11, 0xF28D70E0,
+    0x57A95E5E, 0x327611AF, 0x9C17C1BC, 0xF9C88E4D, 0x516A0BC5, 0x34B54434, 0x9AD49427, 0xFF0BDBD6,
+    0x4122A304, 0x24FDECF5, 0x8A9C3CE6, 0xEF437317, 0x47E1F69F, 0x223EB96E, 0x8C5F697D, 0xE980268C,
+    0x4CA40832, 0x297B47C3, 0x871A97D0, 0xE2C5D821, 0x4A675DA9, 0x2FB81258, 0x81D9C24B, 0xE4068DBA,
+    0xD86AB360, 0xBDB5FC91, 0x13D42C82, 0x760B6373, 0xDEA9E6FB, 0xBB76A90A, 0x15177919, 0x70C836E8,
+    0xD5EC1856, 0xB03357A7, 0x1E5287B4, 0x7B8DC845, 0xD32F4DCD, 0xB6F0023C, 0x1891D22F, 0x7D4E9DDE,
+    0xC367E50C, 0xA6B8AAFD, 0x08D97AEE, 0x6D06351F, 0xC5A4B097, 0xA07BFF66, 0x0E1A2F75, 0x6BC56084,
+    0xCEE14E3A, 0xAB3E01CB, 0x055FD1D8, 0x60809E29, 0xC8221BA1, 0xADFD5450, 0x039C8443, 0x6643CBB2,
+    0xEE701FB8, 0x8BAF5049, 0x25CE805A, 0x4011CFAB, 0xE8B34A23, 0x8D6C05D2, 0x230DD5C1, 0x46D29A30,
+    0xE3F6B48E, 0x8629FB7F, 0x28482B6C, 0x4D97649D, 0xE535E115, 0x80EAAEE4, 0x2E8B7EF7, 0x4B543106,
+    0xF57D49D4, 0x90A20625, 0x3EC3D636, 0x5B1C99C7, 0xF3BE1C4F, 0x966153BE, 0x380083AD, 0x5DDFCC5C,
+    0xF8FBE2E2, 0x9D24AD13, 0x33457D00, 0x569A32F1, 0xFE38B779, 0x9BE7F888, 0x3586289B, 0x5059676A,
+    0xB45FEAD0, 0xD180A521, 0x7FE17532, 0x1A3E3AC3, 0xB29CBF4B, 0xD743F0BA, 0x792220A9, 0x1CFD6F58,
+    0xB9D941E6, 0xDC060E17, 0x7267DE04, 0x17B891F5, 0xBF1A147D, 0xDAC55B8C, 0x74A48B9F, 0x117BC46E,
+    0xAF52BCBC, 0xCA8DF34D, 0x64EC235E, 0x01336CAF, 0xA991E927, 0xCC4EA6D6, 0x622F76C5, 0x07F03934,
+    0xA2D4178A, 0xC70B587B, 0x696A8868, 0x0CB5C799, 0xA4174211, 0xC1C80DE0, 0x6FA9DDF3, 0x0A769202,
+    0x82454608, 0xE79A09F9, 0x49FBD9EA, 0x2C24961B, 0x84861393, 0xE1595C62, 0x4F388C71, 0x2AE7C380,
+    0x8FC3ED3E, 0xEA1CA2CF, 0x447D72DC, 0x21A23D2D, 0x8900B8A5, 0xECDFF754, 0x42BE2747, 0x276168B6,
+    0x99481064, 0xFC975F95, 0x52F68F86, 0x3729C077, 0x9F8B45FF, 0xFA540A0E, 0x5435DA1D, 0x31EA95EC,
+    0x94CEBB52, 0xF111F4A3, 0x5F7024B0, 0x3AAF6B41, 0x920DEEC9, 0xF7D2A138, 0x59B3712B, 0x3C6C3EDA,
+  },
+  {
+    0x00000000, 0x29FB361F, 0x53F66C3E, 0x7A0D5A21, 0xA7ECD87C, 0x8E17EE63, 0xF41AB442, 0xDDE1825D,
+    0xDE67DAA7, 0xF79CECB8, 0x8D91B699, 0xA46A8086, 0x798B02DB, 0x507034C4, 0x2A7D6EE5, 0x038658FA,
+    0x2D71DF11, 0x048AE90E, 0x7E87B32F, 0x577C8530, 0x8A9D076D, 0xA3663172, 0xD96B6B53, 0xF0905D4C,
+    0xF31605B6, 0xDAED33A9, 0xA0E06988, 0x891B5F97, 0x54FADDCA, 0x7D01EBD5, 0x070CB1F4, 0x2EF787EB,
+    0x5AE3BE22, 0x7318883D, 0x0915D21C, 0x20EEE403, 0xFD0F665E, 0xD4F45041, 0xAEF90A60, 0x87023C7F,
+    0x84846485, 0xAD7F529A, 0xD77208BB, 0xFE893EA4, 0x2368BCF9, 0x0A938AE6, 0x709ED0C7, 0x5965E6D8,
+    0x77926133, 0x5E69572C, 0x24640D0D, 0x0D9F3B12, 0xD07EB94F, 0xF9858F50, 0x8388D571, 0xAA73E36E,
+    0xA9F5BB94, 0x800E8D8B, 0xFA03D7AA, 0xD3F8E1B5, 0x0E1963E8, 0x27E255F7, 0x5DEF0FD6, 0x741439C9,
+    0xB5C77C44, 0x9C3C4A5B, 0xE631107A, 0xCFCA2665, 0x122BA438, 0x3BD09227, 0x41DDC806, 0x6826FE19,
+    0x6BA0A6E3, 0x425B90FC, 0x3856CADD, 0x11ADFCC2, 0xCC4C7E9F, 0xE5B74880, 0x9FBA12A1, 0xB64124BE,
+    0x98B6A355, 0xB14D954A, 0xCB40CF6B, 0xE2BBF974, 0x3F5A7B29, 0x16A14D36, 0x6CAC1717, 0x45572108,
+    0x46D179F2, 0x6F2A4FED, 0x152715CC, 0x3CDC23D3, 0xE13DA18E, 0xC8C69791, 0xB2CBCDB0, 0x9B30FBAF,
+    0xEF24C266, 0xC6DFF479, 0xBCD2AE58, 0x95299847, 0x48C81A1A, 0x61332C05, 0x1B3E7624, 0x32C5403B,
+    0x314318C1, 0x18B82EDE, 0x62B574FF, 0x4B4E42E0, 0x96AFC0BD, 0xBF54F6A2, 0xC559AC83, 0xECA29A9C,
+    0xC2551D77, 0xEBAE2B68, 0x91A37149, 0xB8584756, 0x65B9C50B, 0x4C42F314, 0x364FA935, 0x1FB49F2A,
+    0x1C32C7D0, 0x35C9F1CF, 0x4FC4ABEE, 0x663F9DF1, 0xBBDE1FAC, 0x922529B3, 0xE8287392, 0xC1D3458D,
+    0xFA3092D7, 0xD3CBA4C8, 0xA9C6FEE9, 0x803DC8F6, 0x5DDC4AAB, 0x74277CB4, 0x0E2A2695, 0x27D1108A,
+    0x24574870, 0x0DAC7E6F, 0x77A1244E, 0x5E5A1251, 0x83BB900C, 0xAA40A613, 0xD04DFC32, 0xF9B6CA2D,
+    0xD7414DC6, 0xFEBA7BD9, 0x84B721F8, 0xAD4C17E7, 0x70AD95BA, 0x5956A3A5, 0x235BF984, 0x0AA0CF9B,
+    0x09269761, 0x20DDA17E, 0x5AD0FB5F, 0x732BCD40, 0xAECA4F1D, 0x87317902, 0xFD3C2323, 0xD4C7153C,
+    0xA0D32CF5, 0x89281AEA, 0xF32540CB, 0xDADE76D4, 0x073FF489, 0x2EC4C296, 0x54C998B7, 0x7D32AEA8,
+    0x7EB4F652, 0x574FC04D, 0x2D429A6C, 0x04B9AC73, 0xD9582E2E, 0xF0A31831, 0x8AAE4210, 0xA355740F,
+    0x8DA2F3E4, 0xA459C5FB, 0xDE549FDA, 0xF7AFA9C5, 0x2A4E2B98, 0x03B51D87, 0x79B847A6, 0x504371B9,
+    0x53C52943, 0x7A3E1F5C, 0x0033457D, 0x29C87362, 0xF429F13F, 0xDDD2C720, 0xA7DF9D01, 0x8E24AB1E,
+    0x4FF7EE93, 0x660CD88C, 0x1C0182AD, 0x35FAB4B2, 0xE81B36EF, 0xC1E000F0, 0xBBED5AD1, 0x92166CCE,
+    0x91903434, 0xB86B022B, 0xC266580A, 0xEB9D6E15, 0x367CEC48, 0x1F87DA57, 0x658A8076, 0x4C71B669,
+    0x62863182, 0x4B7D079D, 0x31705DBC, 0x188B6BA3, 0xC56AE9FE, 0xEC91DFE1, 0x969C85C0, 0xBF67B3DF,
+    0xBCE1EB25, 0x951ADD3A, 0xEF17871B, 0xC6ECB104, 0x1B0D3359, 0x32F60546, 0x48FB5F67, 0x61006978,
+    0x151450B1, 0x3CEF66AE, 0x46E23C8F, 0x6F190A90, 0xB2F888CD, 0x9B03BED2, 0xE10EE4F3, 0xC8F5D2EC,
+    0xCB738A16, 0xE288BC09, 0x9885E628, 0xB17ED037, 0x6C9F526A, 0x45646475, 0x3F693E54, 0x1692084B,
+    0x38658FA0, 0x119EB9BF, 0x6B93E39E, 0x4268D581, 0x9F8957DC, 0xB67261C3, 0xCC7F3BE2, 0xE5840DFD,
+    0xE6025507, 0xCFF96318, 0xB5F43939, 0x9C0F0F26, 0x41EE8D7B, 0x6815BB64, 0x1218E145, 0x3BE3D75A,
+  },
+  {
+    0x00000000, 0xAD08EAE4, 0xCBAFBF97, 0x66A75573, 0x06E11571, 0xABE9FF95, 0xCD4EAAE6, 0x60464002,
+    0x0DC22AE2, 0xA0CAC006, 0xC66D9575, 0x6B657F91, 0x0B233F93, 0xA62BD577, 0xC08C8004, 0x6D846AE0,
+    0x1B8455C4, 0xB68CBF20, 0xD02BEA53, 0x7D2300B7, 0x1D6540B5, 0xB06DAA51, 0xD6CAFF22, 0x7BC215C6,
+    0x16467F26, 0xBB4E95C2, 0xDDE9C0B1, 0x70E12A55, 0x10A76A57, 0xBDAF80B3, 0xDB08D5C0, 0x76003F24,
+    0x3708AB88, 0x9A00416C, 0xFCA7141F, 0x51AFFEFB, 0x31E9BEF9, 0x9CE1541D, 0xFA46016E, 0x574EEB8A,
+    0x3ACA816A, 0x97C26B8E, 0xF1653EFD, 0x5C6DD419, 0x3C2B941B, 0x91237EFF, 0xF7842B8C, 0x5A8CC168,
+    0x2C8CFE4C, 0x818414A8, 0xE72341DB, 0x4A2BAB3F, 0x2A6DEB3D, 0x876501D9, 0xE1C254AA, 0x4CCABE4E,
+    0x214ED4AE, 0x8C463E4A, 0xEAE16B39, 0x47E981DD, 0x27AFC1DF, 0x8AA72B3B, 0xEC007E48, 0x410894AC,
+    0x6E115710, 0xC319BDF4, 0xA5BEE887, 0x08B60263, 0x68F04261, 0xC5F8A885, 0xA35FFDF6, 0x0E571712,
+    0x63D37DF2, 0xCEDB9716, 0xA87CC265, 0x05742881, 0x65326883, 0xC83A8267, 0xAE9DD714, 0x03953DF0,
+    0x759502D4, 0xD89DE830, 0xBE3ABD43, 0x133257A7, 0x737417A5, 0xDE7CFD41, 0xB8DBA832, 0x15D342D6,
+    0x78572836, 0xD55FC2D2, 0xB3F897A1, 0x1EF07D45, 0x7EB63D47, 0xD3BED7A3, 0xB51982D0, 0x18116834,
+    0x5919FC98, 0xF411167C, 0x92B6430F, 0x3FBEA9EB, 0x5FF8E9E9, 0xF2F0030D, 0x9457567E, 0x395FBC9A,
+    0x54DBD67A, 0xF9D33C9E, 0x9F7469ED, 0x327C8309, 0x523AC30B, 0xFF3229EF, 0x99957C9C, 0x349D9678,
+    0x429DA95C, 0xEF9543B8, 0x893216CB, 0x243AFC2F, 0x447CBC2D, 0xE97456C9, 0x8FD303BA, 0x22DBE95E,
+    0x4F5F83BE, 0xE257695A, 0x84F03C29, 0x29F8D6CD, 0x49BE96CF, 0xE4B67C2B, 0x82112958, 0x2F19C3BC,
+    0xDC22AE20, 0x712A44C4, 0x178D11B7, 0xBA85FB53, 0xDAC3BB51, 0x77CB51B5, 0x116C04C6, 0xBC64EE22,
+    0xD1E084C2, 0x7CE86E26, 0x1A4F3B55, 0xB747D1B1, 0xD70191B3, 0x7A097B57, 0x1CAE2E24, 0xB1A6C4C0,
+    0xC7A6FBE4, 0x6AAE1100, 0x0C094473, 0xA101AE97, 0xC147EE95, 0x6C4F0471, 0x0AE85102, 0xA7E0BBE6,
+    0xCA64D106, 0x676C3BE2, 0x01CB6E91, 0xACC38475, 0xCC85C477, 0x618D2E93, 0x072A7BE0, 0xAA229104,
+    0xEB2A05A8, 0x4622EF4C, 0x2085BA3F, 0x8D8D50DB, 0xEDCB10D9, 0x40C3FA3D, 0x2664AF4E, 0x8B6C45AA,
+    0xE6E82F4A, 0x4BE0C5AE, 0x2D4790DD, 0x804F7A39, 0xE0093A3B, 0x4D01D0DF, 0x2BA685AC, 0x86AE6F48,
+    0xF0AE506C, 0x5DA6BA88, 0x3B01EFFB, 0x9609051F, 0xF64F451D, 0x5B47AFF9, 0x3DE0FA8A, 0x90E8106E,
+    0xFD6C7A8E, 0x5064906A, 0x36C3C519, 0x9BCB2FFD, 0xFB8D6FFF, 0x5685851B, 0x3022D068, 0x9D2A3A8C,
+    0xB233F930, 0x1F3B13D4, 0x799C46A7, 0xD494AC43, 0xB4D2EC41, 0x19DA06A5, 0x7F7D53D6, 0xD275B932,
+    0xBFF1D3D2, 0x12F93936, 0x745E6C45, 0xD95686A1, 0xB910C6A3, 0x14182C47, 0x72BF7934, 0xDFB793D0,
+    0xA9B7ACF4, 0x04BF4610, 0x62181363, 0xCF10F987, 0xAF56B985, 0x025E5361, 0x64F90612, 0xC9F1ECF6,
+    0xA4758616, 0x097D6CF2, 0x6FDA3981, 0xC2D2D365, 0xA2949367, 0x0F9C7983, 0x693B2CF0, 0xC433C614,
+    0x853B52B8, 0x2833B85C, 0x4E94ED2F, 0xE39C07CB, 0x83DA47C9, 0x2ED2AD2D, 0x4875F85E, 0xE57D12BA,
+    0x88F9785A, 0x25F192BE, 0x4356C7CD, 0xEE5E2D29, 0x8E186D2B, 0x231087CF, 0x45B7D2BC, 0xE8BF3858,
+    0x9EBF077C, 0x33B7ED98, 0x5510B8EB, 0xF818520F, 0x985E120D, 0x3556F8E9, 0x53F1AD9A, 0xFEF9477E,
+    0x937D2D9E, 0x3E75C77A, 0x58D29209, 0xF5DA78ED, 0x959C38EF, 0x3894D20B, 0x5E338778, 0xF33B6D9C,
+  },
+  {
+    0x00000000, 0xF08EFA75, 0x70A39EB5, 0x802D64C0, 0xE1473D6A, 0x11C9C71F, 0x91E4A3DF, 0x616A59AA,
+    0x5330108B, 0xA3BEEAFE, 0x23938E3E, 0xD31D744B, 0xB2772DE1, 0x42F9D794, 0xC2D4B354, 0x325A4921,
+    0xA6602116, 0x56EEDB63, 0xD6C3BFA3, 0x264D45D6, 0x47271C7C, 0xB7A9E609, 0x378482C9, 0xC70A78BC,
+    0xF550319D, 0x05DECBE8, 0x85F3AF28, 0x757D555D, 0x14170CF7, 0xE499F682, 0x64B49242, 0x943A6837,
+    0xDD7E2873, 0x2DF0D206, 0xADDDB6C6, 0x5D534CB3, 0x3C391519, 0xCCB7EF6C, 0x4C9A8BAC, 0xBC1471D9,
+    0x8E4E38F8, 0x7EC0C28D, 0xFEEDA64D, 0x0E635C38, 0x6F090592, 0x9F87FFE7, 0x1FAA9B27, 0xEF246152,
+    0x7B1E0965, 0x8B90F310, 0x0BBD97D0, 0xFB336DA5, 0x9A59340F, 0x6AD7CE7A, 0xEAFAAABA, 0x1A7450CF,
+    0x282E19EE, 0xD8A0E39B, 0x588D875B, 0xA8037D2E, 0xC9692484, 0x39E7DEF1, 0xB9CABA31, 0x49444044,
+    0x2B423AB9, 0xDBCCC0CC, 0x5BE1A40C, 0xAB6F5E79, 0xCA0507D3, 0x3A8BFDA6, 0xBAA69966, 0x4A286313,
+    0x78722A32, 0x88FCD047, 0x08D1B487, 0xF85F4EF2, 0x99351758, 0x69BBED2D, 0xE99689ED, 0x19187398,
+    0x8D221BAF, 0x7DACE1DA, 0xFD81851A, 0x0D0F7F6F, 0x6C6526C5, 0x9CEBDCB0, 0x1CC6B870, 0xEC484205,
+    0xDE120B24, 0x2E9CF151, 0xAEB19591, 0x5E3F6FE4, 0x3F55364E, 0xCFDBCC3B, 0x4FF6A8FB, 0xBF78528E,
+    0xF63C12CA, 0x06B2E8BF, 0x869F8C7F, 0x7611760A, 0x177B2FA0, 0xE7F5D5D5, 0x67D8B115, 0x97564B60,
+    0xA50C0241, 0x5582F834, 0xD5AF9CF4, 0x25216681, 0x444B3F2B, 0xB4C5C55E, 0x34E8A19E, 0xC4665BEB,
+    0x505C33DC, 0xA0D2C9A9, 0x20FFAD69, 0xD071571C, 0xB11B0EB6, 0x4195F4C3, 0xC1B89003, 0x31366A76,
+    0x036C2357, 0xF3E2D922, 0x73CFBDE2, 0x83414797, 0xE22B1E3D, 0x12A5E448, 0x92888088, 0x62067AFD,
+    0x56847572, 0xA60A8F07, 0x2627EBC7, 0xD6A911B2, 0xB7C34818, 0x474DB26D, 0xC760D6AD, 0x37EE2CD8,
+    0x05B465F9, 0xF53A9F8C, 0x7517FB4C, 0x85990139, 0xE4F35893, 0x147DA2E6, 0x9450C626, 0x64DE3C53,
+    0xF0E45464, 0x006AAE11, 0x8047CAD1, 0x70C930A4, 0x11A3690E, 0xE12D937B, 0x6100F7BB, 0x918E0DCE,
+    0xA3D444EF, 0x535ABE9A, 0xD377DA5A, 0x23F9202F, 0x42937985, 0xB21D83F0, 0x3230E730, 0xC2BE1D45,
+    0x8BFA5D01, 0x7B74A774, 0xFB59C3B4, 0x0BD739C1, 0x6ABD606B, 0x9A339A1E, 0x1A1EFEDE, 0xEA9004AB,
+    0xD8CA4D8A, 0x2844B7FF, 0xA869D33F, 0x58E7294A, 0x398D70E0, 0xC9038A95, 0x492EEE55, 0xB9A01420,
+    0x2D9A7C17, 0xDD148662, 0x5D39E2A2, 0xADB718D7, 0xCCDD417D, 0x3C53BB08, 0xBC7EDFC8, 0x4CF025BD,
+    0x7EAA6C9C, 0x8E2496E9, 0x0E09F229, 0xFE87085C, 0x9FED51F6, 0x6F63AB83, 0xEF4ECF43, 0x1FC03536,
+    0x7DC64FCB, 0x8D48B5BE, 0x0D65D17E, 0xFDEB2B0B, 0x9C8172A1, 0x6C0F88D4, 0xEC22EC14, 0x1CAC1661,
+    0x2EF65F40, 0xDE78A535, 0x5E55C1F5, 0xAEDB3B80, 0xCFB1622A, 0x3F3F985F, 0xBF12FC9F, 0x4F9C06EA,
+    0xDBA66EDD, 0x2B2894A8, 0xAB05F068, 0x5B8B0A1D, 0x3AE153B7, 0xCA6FA9C2, 0x4A42CD02, 0xBACC3777,
+    0x88967E56, 0x78188423, 0xF835E0E3, 0x08BB1A96, 0x69D1433C, 0x995FB949, 0x1972DD89, 0xE9FC27FC,
+    0xA0B867B8, 0x50369DCD, 0xD01BF90D, 0x20950378, 0x41FF5AD2, 0xB171A0A7, 0x315CC467, 0xC1D23E12,
+    0xF3887733, 0x03068D46, 0x832BE986, 0x73A513F3, 0x12CF4A59, 0xE241B02C, 0x626CD4EC, 0x92E22E99,
+    0x06D846AE, 0xF656BCDB, 0x767BD81B, 0x86F5226E, 0xE79F7BC4, 0x171181B1, 0x973CE571, 0x67B21F04,
+    0x55E85625, 0xA566AC50, 0x254BC890, 0xD5C532E5, 0xB4AF6B4F, 0x4421913A, 0xC40CF5FA, 0x34820F8F,
+  },
+#endif
+};
+
+const Crc_ClmulConstantsType Crc_Clmul32P4 = {
+  0x14B462960,
+  0x018C71228,
+  0x050428A9C,
+  0x16130902A,
+  0x1B0D566C0,
+  0x191BE6A5F,
+  0x13CFDBF23,
+};
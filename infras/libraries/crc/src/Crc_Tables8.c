@@ -0,0 +1,157 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2026 Parai Wang <parai@foxmail.com>
+ *
+ * Generated by gen_tables.py, do not modify.
+ */
+/* ================================ [ INCLUDES  ] ============================================== */
+#include "Crc_Priv.h"
+/* ================================ [ DATAS     ] ============================================== */
+const uint8_t Crc_Table8[CRC_TABLE_SLICES][256] = {
+  {
+    0x00, 0x1D, 0x3A, 0x27, 0x74, 0x69, 0x4E, 0x53, 0xE8, 0xF5, 0xD2, 0xCF, 0x9C, 0x81, 0xA6, 0xBB,
+    0xCD, 0xD0, 0xF7, 0xEA, 0xB9, 0xA4, 0x83, 0x9E, 0x25, 0x38, 0x1F, 0x02, 0x51, 0x4C, 0x6B, 0x76,
+    0x87, 0x9A, 0xBD, 0xA0, 0xF3, 0xEE, 0xC9, 0xD4, 0x6F, 0x72, 0x55, 0x48, 0x1B, 0x06, 0x21, 0x3C,
+    0x4A, 0x57, 0x70, 0x6D, 0x3E, 0x23, 0x04, 0x19, 0xA2, 0xBF, 0x98, 0x85, 0xD6, 0xCB, 0xEC, 0xF1,
+    0x13, 0x0E, 0x29, 0x34, 0x67, 0x7A, 0x5D, 0x40, 0xFB, 0xE6, 0xC1, 0xDC, 0x8F, 0x92, 0xB5, 0xA8,
+    0xDE, 0xC3, 0xE4, 0xF9, 0xAA, 0xB7, 0x90, 0x8D, 0x36, 0x2B, 0x0C, 0x11, 0x42, 0x5F, 0x78, 0x65,
+    0x94, 0x89, 0xAE, 0xB3, 0xE0, 0xFD, 0xDA, 0xC7, 0x7C, 0x61, 0x46, 0x5B, 0x08, 0x15, 0x32, 0x2F,
+    0x59, 0x44, 0x63, 0x7E, 0x2D, 0x30, 0x17, 0x0A, 0xB1, 0xAC, 0x8B, 0x96, 0xC5, 0xD8, 0xFF, 0xE2,
+    0x26, 0x3B, 0x1C, 0x01, 0x52, 0x4F, 0x68, 0x75, 0xCE, 0xD3, 0xF4, 0xE9, 0xBA, 0xA7, 0x80, 0x9D,
+    0xEB, 0xF6, 0xD1, 0xCC, 0x9F, 0x82, 0xA5, 0xB8, 0x03, 0x1E, 0x39, 0x24, 0x77, 0x6A, 0x4D, 0x50,
+    0xA1, 0xBC, 0x9B, 0x86, 0xD5, 0xC8, 0xEF, 0xF2, 0x49, 0x54, 0x73, 0x6E, 0x3D, 0x20, 0x07, 0x1A,
+    0x6C, 0x71, 0x56, 0x4B, 0x18, 0x05, 0x22, 0x3F, 0x84, 0x99, 0xBE, 0xA3, 0xF0, 0xED, 0xCA, 0xD7,
+    0x35, 0x28, 0x0F, 0x12, 0x41, 0x5C, 0x7B, 0x66, 0xDD, 0xC0, 0xE7, 0xFA, 0xA9, 0xB4, 0x93, 0x8E,
+    0xF8, 0xE5, 0xC2, 0xDF, 0x8C, 0x91, 0xB6, 0xAB, 0x10, 0x0D, 0x2A, 0x37, 0x64, 0x79, 0x5E, 0x43,
+    0xB2, 0xAF, 0x88, 0x95, 0xC6, 0xDB, 0xFC, 0xE1, 0x5A, 0x47, 0x60, 0x7D, 0x2E, 0x33, 0x14, 0x09,
+    0x7F, 0x62, 0x45, 0x58, 0x0B, 0x16, 0x31, 0x2C, 0x97, 0x8A, 0xAD, 0xB0, 0xE3, 0xFE, 0xD9, 0xC4,
+  },
+#ifndef CRC_DISABLE_SLICING_BY_8
+  {
+    0x00, 0x4C, 0x98, 0xD4, 0x2D, 0x61, 0xB5, 0xF9, 0x5A, 0x16, 0xC2, 0x8E, 0x77, 0x3B, 0xEF, 0xA3,
+    0xB4, 0xF8, 0x2C, 0x60, 0x99, 0xD5, 0x01, 0x4D, 0xEE, 0xA2, 0x76, 0x3A, 0xC3, 0x8F, 0x5B, 0x17,
+    0x75, 0x39, 0xED, 0xA1, 0x58, 0x14, 0xC0, 0x8C, 0x2F, 0x63, 0xB7, 0xFB, 0x02, 0x4E, 0x9A, 0xD6,
+    0xC1, 0x8D, 0x59, 0x15, 0xEC, 0xA0, 0x74, 0x38, 0x9B, 0xD7, 0x03, 0x4F, 0xB6, 0xFA, 0x2E, 0x62,
+    0xEA, 0xA6, 0x72, 0x3E, 0xC7, 0x8B, 0x5F, 0x13, 0xB0, 0xFC, 0x28, 0x64, 0x9D, 0xD1, 0x05, 0x49,
+    0x5E, 0x12, 0xC6, 0x8A, 0x73, 0x3F, 0xEB, 0xA7, 0x04, 0x48, 0x9C, 0xD0, 0x29, 0x65, 0xB1, 0xFD,
+    0x9F, 0xD3, 0x07, 0x4B, 0xB2, 0xFE, 0x2A, 0x66, 0xC5, 0x89, 0x5D, 0x11, 0xE8, 0xA4, 0x70, 0x3C,
+    0x2B, 0x67, 0xB3, 0xFF, 0x06, 0x4A, 0x9E, 0xD2, 0x71, 0x3D, 0xE9, 0xA5, 0x5C, 0x10, 0xC4, 0x88,
+    0xC9, 0x85, 0x51, 0x1D, 0xE4, 0xA8, 0x7C, 0x30, 0x93, 0xDF, 0x0B, 0x47, 0xBE, 0xF2, 0x26, 0x6A,
+    0x7D, 0x31, 0xE5, 0xA9, 0x50, 0x1C, 0xC8, 0x84, 0x27, 0x6B, 0xBF, 0xF3, 0x0A, 0x46, 0x92, 0xDE,
+    0xBC, 0xF0, 0x24, 0x68, 0x91, 0xDD, 0x09, 0x45, 0xE6, 0xAA, 0x7E, 0x32, 0xCB, 0x87, 0x53, 0x1F,
+    0x08, 0x44, 0x90, 0xDC, 0x25, 0x69, 0xBD, 0xF1, 0x52, 0x1E, 0xCA, 0x86, 0x7F, 0x33, 0xE7, 0xAB,
+    0x23, 0x6F, 0xBB, 0xF7, 0x0E, 0x42, 0x96, 0xDA, 0x79, 0x35, 0xE1, 0xAD, 0x54, 0x18, 0xCC, 0x80,
+    0x97, 0xDB, 0x0F, 0x43, 0xBA, 0xF6, 0x22, 0x6E, 0xCD, 0x81, 0x55, 0x19, 0xE0, 0xAC, 0x78, 0x34,
+    0x56, 0x1A, 0xCE, 0x82, 0x7B, 0x37, 0xE3, 0xAF, 0x0C, 0x40, 0x94, 0xD8, 0x21, 0x6D, 0xB9, 0xF5,
+    0xE2, 0xAE, 0x7A, 0x36, 0xCF, 0x83, 0x57, 0x1B, 0xB8, 0xF4, 0x20, 0x6C, 0x95, 0xD9, 0x0D, 0x41,
+  },
+  {
+    0x00, 0x8F, 0x03, 0x8C, 0x06, 0x89, 0x05, 0x8A, 0x0C, 0x83, 0x0F, 0x80, 0x0A, 0x85, 0x09, 0x86,
+    0x18, 0x97, 0x1B, 0x94, 0x1E, 0x91, 0x1D, 0x92, 0x14, 0x9B, 0x17, 0x98, 0x12, 0x9D, 0x11, 0x9E,
+    0x30, 0xBF, 0x33, 0xBC, 0x36, 0xB9, 0x35, 0xBA, 0x3C, 0xB3, 0x3F, 0xB0, 0x3A, 0xB5, 0x39, 0xB6,
+    0x28, 0xA7, 0x2B, 0xA4, 0x2E, 0xA1, 0x2D, 0xA2, 0x24, 0xAB, 0x27, 0xA8, 0x22, 0xAD, 0x21, 0xAE,
+    0x60, 0xEF, 0x63, 0xEC, 0x66, 0xE9, 0x65, 0xEA, 0x6C, 0xE3, 0x6F, 0xE0, 0x6A, 0xE5, 0x69, 0xE6,
+    0x78, 0xF7, 0x7B, 0xF4, 0x7E, 0xF1, 0x7D, 0xF2, 0x74, 0xFB, 0x77, 0xF8, 0x72, 0xFD, 0x71, 0xFE,
+    0x50, 0xDF, 0x53, 0xDC, 0x56, 0xD9, 0x55, 0xDA, 0x5C, 0xD3, 0x5F, 0xD0, 0x5A, 0xD5, 0x59, 0xD6,
+    0x48, 0xC7, 0x4B, 0xC4, 0x4E, 0xC1, 0x4D, 0xC2, 0x44, 0xCB, 0x47, 0xC8, 0x42, 0xCD, 0x41, 0xCE,
+    0xC0, 0x4F, 0xC3, 0x4C, 0xC6, 0x49, 0xC5, 0x4A, 0xCC, 0x43, 0xCF, 0x40, 0xCA, 0x45, 0xC9, 0x46,
+    0xD8, 0x57, 0xDB, 0x54, 0xDE, 0x51, 0xDD, 0x52, 0xD4, 0x5B, 0xD7, 0x58, 0xD2, 0x5D, 0xD1, 0x5E,
+    0xF0, 0x7F, 0xF3, 0x7C, 0xF6, 0x79, 0xF5, 0x7A, 0xFC, 0x73, 0xFF, 0x70, 0xFA, 0x75, 0xF9, 0x76,
+    0xE8, 0x67, 0xEB, 0x64, 0xEE, 0x61, 0xED, 0x62, 0xE4, 0x6B, 0xE7, 0x68, 0xE2, 0x6D, 0xE1, 0x6E,
+    0xA0, 0x2F, 0xA3, 0x2C, 0xA6, 0x29, 0xA5, 0x2A, 0xAC, 0x23, 0xAF, 0x20, 0xAA, 0x25, 0xA9, 0x26,
+    0xB8, 0x37, 0xBB, 0x34, 0xBE, 0x31, 0xBD, 0x32, 0xB4, 0x3B, 0xB7, 0x38, 0xB2, 0x3D, 0xB1, 0x3E,
+    0x90, 0x1F, 0x93, 0x1C, 0x96, 0x19, 0x95, 0x1A, 0x9C, 0x13, 0x9F, 0x10, 0x9A, 0x15, 0x99, 0x16,
+    0x88, 0x07, 0x8B, 0x04, 0x8E, 0x01, 0x8D, 0x02, 0x84, 0x0B, 0x87, 0x08, 0x82, 0x0D, 0x81, 0x0E,
+  },
+  {
+    0x00, 0x9D, 0x27, 0xBA, 0x4E, 0xD3, 0x69, 0xF4, 0x9C, 0x01, 0xBB, 0x26, 0xD2, 0x4F, 0xF5, 0x68,
+    0x25, 0xB8, 0x02, 0x9F, 0x6B, 0xF6, 0x4C, 0xD1, 0xB9, 0x24, 0x9E, 0x03, 0xF7, 0x6A, 0xD0, 0x4D,
+    0x4A, 0xD7, 0x6D, 0xF0, 0x04, 0x99, 0x23, 0xBE, 0xD6, 0x4B, 0xF1, 0x6C, 0x98, 0x05, 0xBF, 0x22,
+    0x6F, 0xF2, 0x48, 0xD5, 0x21, 0xBC, 0x06, 0x9B, 0xF3, 0x6E, 0xD4, 0x49, 0xBD, 0x20, 0x9A, 0x07,
+    0x94, 0x09, 0xB3, 0x2E, 0xDA, 0x47, 0xFD, 0x60, 0x08, 0x95, 0x2F, 0xB2, 0x46, 0xDB, 0x61, 0xFC,
+    0xB1, 0x2C, 0x96, 0x0B, 0xFF, 0x62, 0xD8, 0x45, 0x2D, 0xB0, 0x0A, 0x97, 0x63, 0xFE, 0x44, 0xD9,
+    0xDE, 0x43, 0xF9, 0x64, 0x90, 0x0D, 0xB7, 0x2A, 0x42, 0xDF, 0x65, 0xF8, 0x0C, 0x91, 0x2B, 0xB6,
+    0xFB, 0x66, 0xDC, 0x41, 0xB5, 0x28, 0x92, 0x0F, 0x67, 0xFA, 0x40, 0xDD, 0x29, 0xB4, 0x0E, 0x93,
+    0x35, 0xA8, 0x12, 0x8F, 0x7B, 0xE6, 0x5C, 0xC1, 0xA9, 0x34, 0x8E, 0x13, 0xE7, 0x7A, 0xC0, 0x5D,
+    0x10, 0x8D, 0x37, 0xAA, 0x5E, 0xC3, 0x79, 0xE4, 0x8C, 0x11, 0xAB, 0x36, 0xC2, 0x5F, 0xE5, 0x78,
+    0x7F, 0xE2, 0x58, 0xC5, 0x31, 0xAC, 0x16, 0x8B, 0xE3, 0x7E, 0xC4, 0x59, 0xAD, 0x30, 0x8A, 0x17,
+    0x5A, 0xC7, 0x7D, 0xE0, 0x14, 0x89, 0x33, 0xAE, 0xC6, 0x5B, 0xE1, 0x7C, 0x88, 0x15, 0xAF, 0x32,
+    0xA1, 0x3C, 0x86, 0x1B, 0xEF, 0x72, 0xC8, 0x55, 0x3D, 0xA0, 0x1A, 0x87, 0x73, 0xEE, 0x54, 0xC9,
+    0x84, 0x19, 0xA3, 0x3E, 0xCA, 0x57, 0xED, 0x70, 0x18, 0x85, 0x3F, 0xA2, 0x56, 0xCB, 0x71, 0xEC,
+    0xEB, 0x76, 0xCC, 0x51, 0xA5, 0x38, 0x82, 0x1F, 0x77, 0xEA, 0x50, 0xCD, 0x39, 0xA4, 0x1E, 0x83,
+    0xCE, 0x53, 0xE9, 0x74, 0x80, 0x1D, 0xA7, 0x3A, 0x52, 0xCF, 0x75, 0xE8, 0x1C, 0x81, 0x3B, 0xA6,
+  },
+  {
+    0x00, 0x6A, 0xD4, 0xBE, 0xB5, 0xDF, 0x61, 0x0B, 0x77, 0x1D, 0xA3, 0xC9, 0xC2, 0xA8, 0x16, 0x7C,
+    0xEE, 0x84, 0x3A, 0x50, 0x5B, 0x31, 0x8F, 0xE5, 0x99, 0xF3, 0x4D, 0x27, 0x2C, 0x46, 0xF8, 0x92,
+    0xC1, 0xAB, 0x15, 0x7F, 0x74, 0x1E, 0xA0, 0xCA, 0xB6, 0xDC, 0x62, 0x08, 0x03, 0x69, 0xD7, 0xBD,
+    0x2F, 0x45, 0xFB, 0x91, 0x9A, 0xF0, 0x4E, 0x24, 0x58, 0x32, 0x8C, 0xE6, 0xED, 0x87, 0x39, 0x53,
+    0x9F, 0xF5, 0x4B, 0x21, 0x2A, 0x40, 0xFE, 0x94, 0xE8, 0x82, 0x3C, 0x56, 0x5D, 0x37, 0x89, 0xE3,
+    0x71, 0x1B, 0xA5, 0xCF, 0xC4, 0xAE, 0x10, 0x7A, 0x06, 0x6C, 0xD2, 0xB8, 0xB3, 0xD9, 0x67, 0x0D,
+    0x5E, 0x34, 0x8A, 0xE0, 0xEB, 0x81, 0x3F, 0x55, 0x29, 0x43, 0xFD, 0x97, 0x9C, 0xF6, 0x48, 0x22,
+    0xB0, 0xDA, 0x64, 0x0E, 0x05, 0x6F, 0xD1, 0xBB, 0xC7, 0xAD, 0x13, 0x79, 0x72, 0x18, 0xA6, 0xCC,
+    0x23, 0x49, 0xF7, 0x9D, 0x96, 0xFC, 0x42, 0x28, 0x54, 0x3E, 0x80, 0xEA, 0xE1, 0x8B, 0x35, 0x5F,
+    0xCD, 0xA7, 0x19, 0x73, 0x78, 0x12, 0xAC, 0xC6, 0xBA, 0xD0, 0x6E, 0x04, 0x0F, 0x65, 0xDB, 0xB1,
+    0xE2, 0x88, 0x36, 0x5C, 0x57, 0x3D, 0x83, 0xE9, 0x95, 0xFF, 0x41, 0x2B, 0x20, 0x4A, 0xF4, 0x9E,
+    0x0C, 0x66, 0xD8, 0xB2, 0xB9, 0xD3, 0x6D, 0x07, 0x7B, 0x11, 0xAF, 0xC5, 0xCE, 0xA4, 0x1A, 0x70,
+    0xBC, 0xD6, 0x68, 0x02, 0x09, 0x63, 0xDD, 0xB7, 0xCB, 0xA1, 0x1F, 0x75, 0x7E, 0x14, 0xAA, 0xC0,
+    0x52, 0x38, 0x86, 0xEC, 0xE7, 0x8D, 0x33, 0x59, 0x25, 0x4F, 0xF1, 0x9B, 0x90, 0xFA, 0x44, 0x2E,
+    0x7D, 0x17, 0xA9, 0xC3, 0xC8, 0xA2, 0x1C, 0x76, 0x0A, 0x60, 0xDE, 0xB4, 0xBF, 0xD5, 0x6B, 0x01,
+    0x93, 0xF9, 0x47, 0x2D, 0x26, 0x4C, 0xF2, 0x98, 0xE4, 0x8E, 0x30, 0x5A, 0x51, 0x3B, 0x85, 0xEF,
+  },
+  {
+    0x00, 0x46, 0x8C, 0xCA, 0x05, 0x43, 0x89, 0xCF, 0x0A, 0x4C, 0x86, 0xC0, 0x0F, 0x49, 0x83, 0xC5,
+    0x14, 0x52, 0x98, 0xDE, 0x11, 0x57, 0x9D, 0xDB, 0x1E, 0x58, 0x92, 0xD4, 0x1B, 0x5D, 0x97, 0xD1,
+    0x28, 0x6E, 0xA4, 0xE2, 0x2D, 0x6B, 0xA1, 0xE7, 0x22, 0x64, 0xAE, 0xE8, 0x27, 0x61, 0xAB, 0xED,
+    0x3C, 0x7A, 0xB0, 0xF6, 0x39, 0x7F, 0xB5, 0xF3, 0x36, 0x70, 0xBA, 0xFC, 0x33, 0x75, 0xBF, 0xF9,
+    0x50, 0x16, 0xDC, 0x9A, 0x55, 0x13, 0xD9, 0x9F, 0x5A, 0x1C, 0xD6, 0x90, 0x5F, 0x19, 0xD3, 0x95,
+    0x44, 0x02, 0xC8, 0x8E, 0x41, 0x07, 0xCD, 0x8B, 0x4E, 0x08, 0xC2, 0x84, 0x4B, 0x0D, 0xC7, 0x81,
+    0x78, 0x3E, 0xF4, 0xB2, 0x7D, 0x3B, 0xF1, 0xB7, 0x72, 0x34, 0xFE, 0xB8, 0x77, 0x31, 0xFB, 0xBD,
+    0x6C, 0x2A, 0xE0, 0xA6, 0x69, 0x2F, 0xE5, 0xA3, 0x66, 0x20, 0xEA, 0xAC, 0x63, 0x25, 0xEF, 0xA9,
+    0xA0, 0xE6, 0x2C, 0x6A, 0xA5, 0xE3, 0x29, 0x6F, 0xAA, 0xEC, 0x26, 0x60, 0xAF, 0xE9, 0x23, 0x65,
+    0xB4, 0xF2, 0x38, 0x7E, 0xB1, 0xF7, 0x3D, 0x7B, 0xBE, 0xF8, 0x32, 0x74, 0xBB, 0xFD, 0x37, 0x71,
+    0x88, 0xCE, 0x04, 0x42, 0x8D, 0xCB, 0x01, 0x47, 0x82, 0xC4, 0x0E, 0x48, 0x87, 0xC1, 0x0B, 0x4D,
+    0x9C, 0xDA, 0x10, 0x56, 0x99, 0xDF, 0x15, 0x53, 0x96, 0xD0, 0x1A, 0x5C, 0x93, 0xD5, 0x1F, 0x59,
+    0xF0, 0xB6, 0x7C, 0x3A, 0xF5, 0xB3, 0x79, 0x3F, 0xFA, 0xBC, 0x76, 0x30, 0xFF, 0xB9, 0x73, 0x35,
+    0xE4, 0xA2, 0x68, 0x2E, 0xE1, 0xA7, 0x6D, 0x2B, 0xEE, 0xA8, 0x62, 0x24, 0xEB, 0xAD, 0x67, 0x21,
+    0xD8, 0x9E, 0x54, 0x12, 0xDD, 0x9B, 0x51, 0x17, 0xD2, 0x94, 0x5E, 0x18, 0xD7, 0x91, 0x5B, 0x1D,
+    0xCC, 0x8A, 0x40, 0x06, 0xC9, 0x8F, 0x45, 0x03, 0xC6, 0x80, 0x4A, 0x0C, 0xC3, 0x85, 0x4F, 0x09,
+  },
+  {
+    0x00, 0x5D, 0xBA, 0xE7, 0x69, 0x34, 0xD3, 0x8E, 0xD2, 0x8F, 0x68, 0x35, 0xBB, 0xE6, 0x01, 0x5C,
+    0xB9, 0xE4, 0x03, 0x5E, 0xD0, 0x8D, 0x6A, 0x37, 0x6B, 0x36, 0xD1, 0x8C, 0x02, 0x5F, 0xB8, 0xE5,
+    0x6F, 0x32, 0xD5, 0x88, 0x06, 0x5B, 0xBC, 0xE1, 0xBD, 0xE0, 0x07, 0x5A, 0xD4, 0x89, 0x6E, 0x33,
+    0xD6, 0x8B, 0x6C, 0x31, 0xBF, 0xE2, 0x05, 0x58, 0x04, 0x59, 0xBE, 0xE3, 0x6D, 0x30, 0xD7, 0x8A,
+    0xDE, 0x83, 0x64, 0x39, 0xB7, 0xEA, 0x0D, 0x50, 0x0C, 0x51, 0xB6, 0xEB, 0x65, 0x38, 0xDF, 0x82,
+    0x67, 0x3A, 0xDD, 0x80, 0x0E, 0x53, 0xB4, 0xE9, 0xB5, 0xE8, 0x0F, 0x52, 0xDC, 0x81, 0x66, 0x3B,
+    0xB1, 0xEC, 0x0B, 0x56, 0xD8, 0x85, 0x62, 0x3F, 0x63, 0x3E, 0xD9, 0x84, 0x0A, 0x57, 0xB0, 0xED,
+    0x08, 0x55, 0xB2, 0xEF, 0x61, 0x3C, 0xDB, 0x86, 0xDA, 0x87, 0x60, 0x3D, 0xB3, 0xEE, 0x09, 0x54,
+    0xA1, 0xFC, 0x1B, 0x46, 0xC8, 0x95, 0x72, 0x2F, 0x73, 0x2E, 0xC9, 0x94, 0x1A, 0x47, 0xA0, 0xFD,
+    0x18, 0x45, 0xA2, 0xFF, 0x71, 0x2C, 0xCB, 0x96, 0xCA, 0x97, 0x70, 0x2D, 0xA3, 0xFE, 0x19, 0x44,
+    0xCE, 0x93, 0x74, 0x29, 0xA7, 0xFA, 0x1D, 0x40, 0x1C, 0x41, 0xA6, 0xFB, 0x75, 0x28, 0xCF, 0x92,
+    0x77, 0x2A, 0xCD, 0x90, 0x1E, 0x43, 0xA4, 0xF9, 0xA5, 0xF8, 0x1F, 0x42, 0xCC, 0x91, 0x76, 0x2B,
+    0x7F, 0x22, 0xC5, 0x98, 0x16, 0x4B, 0xAC, 0xF1, 0xAD, 0xF0, 0x17, 0x4A, 0xC4, 0x99, 0x7E, 0x23,
+    0xC6, 0x9B, 0x7C, 0x21, 0xAF, 0xF2, 0x15, 0x48, 0x14, 0x49, 0xAE, 0xF3, 0x7D, 0x20, 0xC7, 0x9A,
+    0x10, 0x4D, 0xAA, 0xF7, 0x79, 0x24, 0xC3, 0x9E, 0xC2, 0x9F, 0x78, 0x25, 0xAB, 0xF6, 0x11, 0x4C,
+    0xA9, 0xF4, 0x13, 0x4E, 0xC0, 0x9D, 0x7A, 0x27, 0x7B, 0x26, 0xC1, 0x9C, 0x12, 0x4F, 0xA8, 0xF5,
+  },
+  {
+    0x00, 0x5F, 0xBE, 0xE1, 0x61, 0x3E, 0xDF, 0x80, 0xC2, 0x9D, 0x7C, 0x23, 0xA3, 0xFC, 0x1D, 0x42,
+    0x99, 0xC6, 0x27, 0x78, 0xF8, 0xA7, 0x46, 0x19, 0x5B, 0x04, 0xE5, 0xBA, 0x3A, 0x65, 0x84, 0xDB,
+    0x2F, 0x70, 0x91, 0xCE, 0x4E, 0x11, 0xF0, 0xAF, 0xED, 0xB2, 0x53, 0x0C, 0x8C, 0xD3, 0x32, 0x6D,
+    0xB6, 0xE9, 0x08, 0x57, 0xD7, 0x88, 0x69, 0x36, 0x74, 0x2B, 0xCA, 0x95, 0x15, 0x4A, 0xAB, 0xF4,
+    0x5E, 0x01, 0xE0, 0xBF, 0x3F, 0x60, 0x81, 0xDE, 0x9C, 0xC3, 0x22, 0x7D, 0xFD, 0xA2, 0x43, 0x1C,
+    0xC7, 0x98, 0x79, 0x26, 0xA6, 0xF9, 0x18, 0x47, 0x05, 0x5A, 0xBB, 0xE4, 0x64, 0x3B, 0xDA, 0x85,
+    0x71, 0x2E, 0xCF, 0x90, 0x10, 0x4F, 0xAE, 0xF1, 0xB3, 0xEC, 0x0D, 0x52, 0xD2, 0x8D, 0x6C, 0x33,
+    0xE8, 0xB7, 0x56, 0x09, 0x89, 0xD6, 0x37, 0x68, 0x2A, 0x75, 0x94, 0xCB, 0x4B, 0x14, 0xF5, 0xAA,
+    0xBC, 0xE3, 0x02, 0x5D, 0xDD, 0x82, 0x63, 0x3C, 0x7E, 0x21, 0xC0, 0x9F, 0x1F, 0x40, 0xA1, 0xFE,
+    0x25, 0x7A, 0x9B, 0xC4, 0x44, 0x1B, 0xFA, 0xA5, 0xE7, 0xB8, 0x59, 0x06, 0x86, 0xD9, 0x38, 0x67,
+    0x93, 0xCC, 0x2D, 0x72, 0xF2, 0xAD, 0x4C, 0x13, 0x51, 0x0E, 0xEF, 0xB0, 0x30, 0x6F, 0x8E, 0xD1,
+    0x0A, 0x55, 0xB4, 0xEB, 0x6B, 0x34, 0xD5, 0x8A, 0xC8, 0x97, 0x76, 0x29, 0xA9, 0xF6, 0x17, 0x48,
+    0xE2, 0xBD, 0x5C, 0x03, 0x83, 0xDC, 0x3D, 0x62, 0x20, 0x7F, 0x9E, 0xC1, 0x41, 0x1E, 0xFF, 0xA0,
+    0x7B, 0x24, 0xC5, 0x9A, 0x1A, 0x45, 0xA4, 0xFB, 0xB9, 0xE6, 0x07, 0x58, 0xD8, 0x87, 0x66, 0x39,
+    0xCD, 0x92, 0x73, 0x2C, 0xAC, 0xF3, 0x12, 0x4D, 0x0F, 0x50, 0xB1, 0xEE, 0x6E, 0x31, 0xD0, 0x8F,
+    0x54, 0x0B, 0xEA, 0xB5, 0x35, 0x6A, 0x8B, 0xD4, 0x96, 0xC9, 0x28, 0x77, 0xF7, 0xA8, 0x49, 0x16,
+  },
+#endif
+};
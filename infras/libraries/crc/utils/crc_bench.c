@@ -0,0 +1,150 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2026 Parai Wang <parai@foxmail.com>
+ */
+/* ================================ [ INCLUDES  ] ============================================== */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "Crc.h"
+#include "Crc_Priv.h"
+/* ================================ [ MACROS    ] ============================================== */
+#define CRC_BENCH_BYTES (256u * 1024u * 1024u)
+#define CRC_BENCH_MAX_SIZE (1024u * 1024u)
+/* ================================ [ TYPES     ] ============================================== */
+typedef uint32_t (*bench_func_t)(const uint8_t *data, uint32_t length);
+
+typedef struct {
+  const char *name;
+  bench_func_t func;
+} bench_case_t;
+/* ================================ [ DECLARES  ] ============================================== */
+/* ================================ [ DATAS     ] ============================================== */
+static volatile uint32_t bench_sink;
+/* ================================ [ LOCALS    ] ============================================== */
+static uint64_t bench_now(void) {
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/* the byte at a time table lookup, as the library did before slicing-by-8 */
+static uint32_t bench_crc8_bytewise(const uint8_t *data, uint32_t length) {
+  uint8_t crc = 0xFF;
+
+  while (length--) {
+    crc = Crc_Table8[0][crc ^ *data++];
+  }
+
+  return crc ^ 0xFF;
+}
+
+static uint32_t bench_crc8(const uint8_t *data, uint32_t length) {
+  return Crc_CalculateCRC8(data, length, 0, TRUE);
+}
+
+static uint32_t bench_crc16_bytewise(const uint8_t *data, uint32_t length) {
+  uint16_t crc = 0xFFFF;
+
+  while (length--) {
+    crc = (uint16_t)(crc << 8) ^ Crc_Table16[0][(crc >> 8) ^ *data++];
+  }
+
+  return crc;
+}
+
+static uint32_t bench_crc16(const uint8_t *data, uint32_t length) {
+  return Crc_CalculateCRC16(data, length, 0, TRUE);
+}
+
+static uint32_t bench_crc32_bytewise(const uint8_t *data, uint32_t length) {
+  uint32_t crc = 0xFFFFFFFF;
+
+  while (length--) {
+    crc = (crc >> 8) ^ Crc_Table32[0][(crc ^ *data++) & 0xFF];
+  }
+
+  return ~crc;
+}
+
+static uint32_t bench_crc32_slicing(const uint8_t *data, uint32_t length) {
+  return ~Crc_Update32(0xFFFFFFFF, Crc_Table32, NULL, data, length);
+}
+
+static uint32_t bench_crc32(const uint8_t *data, uint32_t length) {
+  return Crc_CalculateCRC32(data, length, 0, TRUE);
+}
+
+static uint32_t bench_crc32p4_slicing(const uint8_t *data, uint32_t length) {
+  return ~Crc_Update32(0xFFFFFFFF, Crc_Table32P4, NULL, data, length);
+}
+
+static uint32_t bench_crc32p4(const uint8_t *data, uint32_t length) {
+  return Crc_CalculateCRC32P4(data, length, 0, TRUE);
+}
+
+static const bench_case_t bench_cases[] = {
+  {"crc8 bytewise", bench_crc8_bytewise},
+  {"crc8", bench_crc8},
+  {"crc16 bytewise", bench_crc16_bytewise},
+  {"crc16", bench_crc16},
+  {"crc32 bytewise", bench_crc32_bytewise},
+  {"crc32 slicing-by-8", bench_crc32_slicing},
+  {"crc32", bench_crc32},
+  {"crc32p4 slicing-by-8", bench_crc32p4_slicing},
+  {"crc32p4", bench_crc32p4},
+};
+
+static void bench_run(const bench_case_t *bc, const uint8_t *data, uint32_t size) {
+  uint32_t loops = CRC_BENCH_BYTES / size;
+  uint32_t sum = 0;
+  uint32_t i;
+  uint64_t start;
+  uint64_t elapsed;
+
+  if (loops > 2000000) {
+    loops = 2000000;
+  }
+
+  start = bench_now();
+  for (i = 0; i < loops; i++) {
+    sum += bc->func(data, size);
+  }
+  elapsed = bench_now() - start;
+  bench_sink = sum;
+
+  printf("  %-22s %8u bytes: %7.2f GB/s\n", bc->name, size,
+         (double)loops * size / (double)elapsed);
+}
+/* ================================ [ FUNCTIONS ] ============================================== */
+int main(int argc, char *argv[]) {
+  static const uint32_t sizes[] = {16, 64, 1024, 64 * 1024, CRC_BENCH_MAX_SIZE};
+  uint8_t *data;
+  uint32_t i;
+  uint32_t j;
+
+  data = malloc(CRC_BENCH_MAX_SIZE);
+  srand(0);
+  for (i = 0; i < CRC_BENCH_MAX_SIZE; i++) {
+    data[i] = (uint8_t)rand();
+  }
+
+#ifdef CRC_USE_PCLMUL
+  printf("pclmul: %s\n", Crc_ClmulSupported() ? "yes" : "no");
+#else
+  printf("pclmul: disabled\n");
+#endif
+  for (i = 0; i < ARRAY_SIZE(bench_cases); i++) {
+    printf("%s\n", bench_cases[i].name);
+    for (j = 0; j < ARRAY_SIZE(sizes); j++) {
+      bench_run(&bench_cases[i], data, sizes[j]);
+    }
+  }
+
+  free(data);
+
+  return 0;
+}
@@ -10,16 +10,280 @@
 /* ================================ [ MACROS    ] ============================================== */
 #define AS_LOG_MCI 0
 #define AS_LOG_MCE 3
+
+#ifdef STD_NAMED_LOCK
+#define mpEnterCritical(mp) EnterCriticalLock(&(mp)->lock)
+#define mpExitCritical(mp) ExitCriticalLock(&(mp)->lock)
+#else
+#define mpEnterCritical(mp) EnterCritical()
+#define mpExitCritical(mp) ExitCritical()
+#endif
+
+#define MP_LF_MAGIC_FREE 0x46524545
+#define MP_LF_MAGIC_USED 0x55534544
+
+#define MP_LF_TAG_INC 0x10000u
+#define MP_LF_TAG_MASK 0xFFFF0000u
+#define MP_LF_INDEX(head) ((uint16_t)((head)&0xFFFFu))
+
+#define MP_LF_HEADER(mc, pool, index)                                                              \
+  ((lf_mp_header_t *)&(mc)->configs[pool]                                                          \
+     .buffer[(uint32_t)(index)*MP_LF_BLOCK_SIZE((mc)->configs[pool].size)])
+
+#ifdef USE_MEMPOOL_STATS
+#ifdef __GNUC__
+#define MP_STATS_INC(v) __atomic_add_fetch(&(v), 1, __ATOMIC_RELAXED)
+#define MP_STATS_DEC(v) __atomic_sub_fetch(&(v), 1, __ATOMIC_RELAXED)
+#else
+#define MP_STATS_INC(v) (++(v))
+#define MP_STATS_DEC(v) (--(v))
+#endif
+#endif
+
+#if MEMPOOL_LF_CACHE_SIZE > 0
+#ifndef MEMPOOL_LF_CACHE_CLUSTERS
+#define MEMPOOL_LF_CACHE_CLUSTERS 4
+#endif
+#ifndef MEMPOOL_LF_CACHE_POOLS
+#define MEMPOOL_LF_CACHE_POOLS 8
+#endif
+#endif
 /* ================================ [ TYPES     ] ============================================== */
+#if MEMPOOL_LF_CACHE_SIZE > 0
+typedef struct {
+  uint16_t count;
+  uint16_t index[MEMPOOL_LF_CACHE_SIZE];
+} lf_mp_cache_t;
+
+typedef struct {
+  const lf_mem_cluster_t *mc;
+  lf_mp_cache_t pools[MEMPOOL_LF_CACHE_POOLS];
+} lf_mc_cache_t;
+#endif
 /* ================================ [ DECLARES  ] ============================================== */
 /* ================================ [ DATAS     ] ============================================== */
+#if MEMPOOL_LF_CACHE_SIZE > 0
+static __thread lf_mc_cache_t lfCaches[MEMPOOL_LF_CACHE_CLUSTERS];
+#endif
 /* ================================ [ LOCALS    ] ============================================== */
+#ifdef USE_MEMPOOL_STATS
+static void mp_stats_alloc(mp_stats_t *stats, uint16_t cls, uint32_t clsSize, uint32_t size,
+                           uint16_t pool, uint8_t *buffer) {
+  uint32_t bucket = 0;
+  uint32_t inUse;
+  uint32_t highWater;
+
+  if (size > clsSize) {
+    bucket = MEMPOOL_STATS_HISTOGRAM_SIZE - 1;
+  } else if (size > 0) {
+    bucket = ((size - 1) * (uint64_t)MEMPOOL_STATS_HISTOGRAM_SIZE) / clsSize;
+  } else {
+    /* empty request, first bucket */
+  }
+  MP_STATS_INC(stats[cls].histogram[bucket]);
+
+  if (NULL == buffer) {
+    MP_STATS_INC(stats[cls].failures);
+  } else {
+    if (pool > cls) {
+      MP_STATS_INC(stats[cls].fallbacks);
+    } else if (pool < cls) {
+      MP_STATS_INC(stats[cls].downgrades);
+    } else {
+      /* served by its own class */
+    }
+    inUse = MP_STATS_INC(stats[pool].inUse);
+#ifdef __GNUC__
+    highWater = __atomic_load_n(&stats[pool].highWater, __ATOMIC_RELAXED);
+    while ((inUse > highWater) &&
+           (!__atomic_compare_exchange_n(&stats[pool].highWater, &highWater, inUse, 1,
+                                         __ATOMIC_RELAXED, __ATOMIC_RELAXED))) {
+    }
+#else
+    highWater = stats[pool].highWater;
+    if (inUse > highWater) {
+      stats[pool].highWater = inUse;
+    }
+#endif
+  }
+}
+
+static int mp_get_stats(const mp_stats_t *stats, uint16_t numOfPools, uint16_t pool,
+                        mp_stats_t *out) {
+  int r = -1;
+
+  if (pool < numOfPools) {
+    EnterCritical();
+    *out = stats[pool];
+    ExitCritical();
+    r = 0;
+  }
+
+  return r;
+}
+
+static void mp_reset_stats(mp_stats_t *stats, uint16_t numOfPools) {
+  uint16_t i;
+  uint16_t j;
+
+  EnterCritical();
+  for (i = 0; i < numOfPools; i++) {
+    stats[i].highWater = stats[i].inUse;
+    stats[i].failures = 0;
+    stats[i].fallbacks = 0;
+    stats[i].downgrades = 0;
+    for (j = 0; j < MEMPOOL_STATS_HISTOGRAM_SIZE; j++) {
+      stats[i].histogram[j] = 0;
+    }
+  }
+  ExitCritical();
+}
+#endif
+
+#ifdef __GNUC__
+static uint16_t lf_mp_pop(lf_mempool_t *mp, const lf_mem_cluster_cfg_t *config) {
+  uint32_t head = __atomic_load_n(&mp->head, __ATOMIC_ACQUIRE);
+  uint32_t newHead;
+  uint16_t index;
+  uint16_t next;
+
+  do {
+    index = MP_LF_INDEX(head);
+    if (MP_LF_NIL == index) {
+      break;
+    }
+    /* the link may be stale if another thread won the block, the tag makes the CAS fail then */
+    next = __atomic_load_n(&config->next[index], __ATOMIC_RELAXED);
+    newHead = ((head + MP_LF_TAG_INC) & MP_LF_TAG_MASK) | next;
+  } while (!__atomic_compare_exchange_n(&mp->head, &head, newHead, 1, __ATOMIC_ACQ_REL,
+                                        __ATOMIC_ACQUIRE));
+
+  return index;
+}
+
+static void lf_mp_push(lf_mempool_t *mp, const lf_mem_cluster_cfg_t *config, uint16_t index) {
+  uint32_t head = __atomic_load_n(&mp->head, __ATOMIC_RELAXED);
+  uint32_t newHead;
+
+  do {
+    __atomic_store_n(&config->next[index], MP_LF_INDEX(head), __ATOMIC_RELAXED);
+    newHead = ((head + MP_LF_TAG_INC) & MP_LF_TAG_MASK) | index;
+  } while (!__atomic_compare_exchange_n(&mp->head, &head, newHead, 1, __ATOMIC_RELEASE,
+                                        __ATOMIC_RELAXED));
+}
+#else
+static uint16_t lf_mp_pop(lf_mempool_t *mp, const lf_mem_cluster_cfg_t *config) {
+  uint16_t index;
+
+  EnterCritical();
+  index = MP_LF_INDEX(mp->head);
+  if (MP_LF_NIL != index) {
+    mp->head = ((mp->head + MP_LF_TAG_INC) & MP_LF_TAG_MASK) | config->next[index];
+  }
+  ExitCritical();
+
+  return index;
+}
+
+static void lf_mp_push(lf_mempool_t *mp, const lf_mem_cluster_cfg_t *config, uint16_t index) {
+  EnterCritical();
+  config->next[index] = MP_LF_INDEX(mp->head);
+  mp->head = ((mp->head + MP_LF_TAG_INC) & MP_LF_TAG_MASK) | index;
+  ExitCritical();
+}
+#endif
+
+#ifdef __GNUC__
+/* the magic is switched with a CAS so that only one of two racing frees of a block wins */
+static boolean lf_mp_mark_free(lf_mp_header_t *header) {
+  uint32_t magic = MP_LF_MAGIC_USED;
+
+  return __atomic_compare_exchange_n(&header->magic, &magic, MP_LF_MAGIC_FREE, 0,
+                                     __ATOMIC_ACQ_REL, __ATOMIC_RELAXED);
+}
+#else
+static boolean lf_mp_mark_free(lf_mp_header_t *header) {
+  boolean marked = FALSE;
+
+  EnterCritical();
+  if (MP_LF_MAGIC_USED == header->magic) {
+    header->magic = MP_LF_MAGIC_FREE;
+    marked = TRUE;
+  }
+  ExitCritical();
+
+  return marked;
+}
+#endif
+
+#if MEMPOOL_LF_CACHE_SIZE > 0
+static uint16_t lf_mc_cache_limit(const lf_mem_cluster_t *mc, uint16_t pool) {
+  uint16_t limit = mc->configs[pool].number / MEMPOOL_LF_CACHE_DIVISOR;
+
+  if (limit > MEMPOOL_LF_CACHE_SIZE) {
+    limit = MEMPOOL_LF_CACHE_SIZE;
+  }
+
+  return limit;
+}
+
+static lf_mp_cache_t *lf_mc_get_cache(const lf_mem_cluster_t *mc, uint16_t pool) {
+  lf_mp_cache_t *cache = NULL;
+  uint16_t i;
+
+  if (pool < MEMPOOL_LF_CACHE_POOLS) {
+    for (i = 0; i < MEMPOOL_LF_CACHE_CLUSTERS; i++) {
+      if (mc == lfCaches[i].mc) {
+        cache = &lfCaches[i].pools[pool];
+        break;
+      } else if (NULL == lfCaches[i].mc) {
+        lfCaches[i].mc = mc;
+        cache = &lfCaches[i].pools[pool];
+        break;
+      } else {
+        /* slot owned by another cluster */
+      }
+    }
+  }
+
+  return cache;
+}
+#endif
+
+static uint8_t *lf_mp_alloc(const lf_mem_cluster_t *mc, uint16_t pool) {
+  uint8_t *buffer = NULL;
+  uint16_t index = MP_LF_NIL;
+  lf_mp_header_t *header;
+#if MEMPOOL_LF_CACHE_SIZE > 0
+  lf_mp_cache_t *cache = lf_mc_get_cache(mc, pool);
+
+  if ((NULL != cache) && (cache->count > 0)) {
+    cache->count--;
+    index = cache->index[cache->count];
+  }
+#endif
+
+  if (MP_LF_NIL == index) {
+    index = lf_mp_pop(&mc->pools[pool], &mc->configs[pool]);
+  }
+
+  if (MP_LF_NIL != index) {
+    header = MP_LF_HEADER(mc, pool, index);
+    header->magic = MP_LF_MAGIC_USED;
+    buffer = (uint8_t *)&header[1];
+  }
+
+  return buffer;
+}
 /* ================================ [ FUNCTIONS ] ============================================== */
 void mp_init(mempool_t *mp, uint8_t *buffer, uint32_t size, uint16_t number) {
   uint16_t i;
   mp_pool_t *pool;
 
   SLIST_INIT(&mp->head);
+#ifdef STD_NAMED_LOCK
+  mp->lock.name = "mempool";
+#endif
   for (i = 0; i < number; i++) {
     pool = (mp_pool_t *)&buffer[size * i];
     SLIST_INSERT_HEAD(&mp->head, pool, entry);
@@ -29,12 +293,12 @@ void mp_init(mempool_t *mp, uint8_t *buffer, uint32_t size, uint16_t number) {
 uint8_t *mp_alloc(mempool_t *mp) {
   uint8_t *buffer = NULL;
 
-  EnterCritical();
+  mpEnterCritical(mp);
   if (NULL != SLIST_FIRST(&mp->head)) {
     buffer = (uint8_t *)SLIST_FIRST(&mp->head);
     SLIST_REMOVE_HEAD(&mp->head, entry);
   }
-  ExitCritical();
+  mpExitCritical(mp);
 
   return buffer;
 }
@@ -42,9 +306,9 @@ uint8_t *mp_alloc(mempool_t *mp) {
 void mp_free(mempool_t *mp, uint8_t *buffer) {
   mp_pool_t *pool = (mp_pool_t *)buffer;
 
-  EnterCritical();
+  mpEnterCritical(mp);
   SLIST_INSERT_HEAD(&mp->head, pool, entry);
-  ExitCritical();
+  mpExitCritical(mp);
 }
 
 void mc_init(const mem_cluster_t *mc) {
@@ -56,23 +320,29 @@ void mc_init(const mem_cluster_t *mc) {
 }
 
 uint8_t *mc_alloc(const mem_cluster_t *mc, uint32_t size) {
-  uint16_t i = 0;
-  mempool_t *mp = NULL;
+  uint16_t i;
   uint8_t *buffer = NULL;
+#ifdef USE_MEMPOOL_STATS
+  uint16_t cls = mc->numOfPools;
+#endif
 
-  do {
-    mp = NULL;
-    for (; i < mc->numOfPools; i++) {
-      if (mc->configs[i].size >= size) {
-        mp = &mc->pools[i];
-        break;
+  for (i = 0; (i < mc->numOfPools) && (NULL == buffer); i++) {
+    if (mc->configs[i].size >= size) {
+#ifdef USE_MEMPOOL_STATS
+      if (cls == mc->numOfPools) {
+        cls = i;
       }
+#endif
+      buffer = mp_alloc(&mc->pools[i]);
     }
+  }
 
-    if (mp != NULL) {
-      buffer = mp_alloc(mp);
-    }
-  } while ((i < mc->numOfPools) && (NULL == buffer));
+#ifdef USE_MEMPOOL_STATS
+  if (cls == mc->numOfPools) {
+    cls = mc->numOfPools - 1;
+  }
+  mp_stats_alloc(mc->stats, cls, mc->configs[cls].size, size, i - 1, buffer);
+#endif
 
   if (NULL == buffer) {
     ASLOG(MCE, ("alloc %u fail\n", size));
@@ -84,33 +354,38 @@ uint8_t *mc_alloc(const mem_cluster_t *mc, uint32_t size) {
 }
 
 uint8_t *mc_get(const mem_cluster_t *mc, uint32_t *size) {
-  uint16_t i = 0;
-  uint16_t j = 0;
-  mempool_t *mp = NULL;
+  uint16_t i;
+  uint16_t j = mc->numOfPools;
+  uint16_t pool = 0;
   uint8_t *buffer = NULL;
+#ifdef USE_MEMPOOL_STATS
+  uint32_t reqSize = *size;
+#endif
 
-  do {
-    mp = NULL;
-    for (; i < mc->numOfPools; i++) {
-      if (mc->configs[i].size >= *size) {
-        if (0 == j) {
-          j = i;
-        }
-        mp = &mc->pools[i];
-        break;
+  for (i = 0; (i < mc->numOfPools) && (NULL == buffer); i++) {
+    if (mc->configs[i].size >= *size) {
+      if (j == mc->numOfPools) {
+        j = i;
       }
+      pool = i;
+      buffer = mp_alloc(&mc->pools[i]);
     }
+  }
 
-    if (mp != NULL) {
-      buffer = mp_alloc(mp);
+  for (i = j; (i > 0) && (NULL == buffer); i--) {
+    pool = i - 1;
+    buffer = mp_alloc(&mc->pools[pool]);
+    if (NULL != buffer) {
+      *size = mc->configs[pool].size;
     }
-  } while ((i < mc->numOfPools) && (NULL == buffer));
+  }
 
-  for (i = 0; (i < j) && (NULL == buffer); i++) {
-    mp = &mc->pools[j - 1 - i];
-    *size = mc->configs[j - 1 - i].size;
-    buffer = mp_alloc(mp);
+#ifdef USE_MEMPOOL_STATS
+  if (j == mc->numOfPools) {
+    j = mc->numOfPools - 1;
   }
+  mp_stats_alloc(mc->stats, j, mc->configs[j].size, reqSize, pool, buffer);
+#endif
 
   if (NULL == buffer) {
     ASLOG(MCE, ("alloc %u fail\n", *size));
@@ -137,8 +412,172 @@ void mc_free(const mem_cluster_t *mc, uint8_t *buffer) {
 
   if (mp) {
     ASLOG(MCI, ("free %p to %p\n", buffer, mc));
+#ifdef USE_MEMPOOL_STATS
+    MP_STATS_DEC(mc->stats[i].inUse);
+#endif
     mp_free(mp, buffer);
   } else {
     ASLOG(MCE, ("free %p fail\n", buffer));
   }
-}
\ No newline at end of file
+}
+
+void lf_mc_init(const lf_mem_cluster_t *mc) {
+  uint16_t i;
+  uint16_t j;
+  const lf_mem_cluster_cfg_t *config;
+  lf_mp_header_t *header;
+
+  for (i = 0; i < mc->numOfPools; i++) {
+    config = &mc->configs[i];
+    for (j = 0; j < config->number; j++) {
+      header = MP_LF_HEADER(mc, i, j);
+      header->pool = i;
+      header->index = j;
+      header->magic = MP_LF_MAGIC_FREE;
+      config->next[j] = ((j + 1) < config->number) ? (j + 1) : MP_LF_NIL;
+    }
+    mc->pools[i].head = (config->number > 0) ? 0 : MP_LF_NIL;
+  }
+}
+
+uint8_t *lf_mc_alloc(const lf_mem_cluster_t *mc, uint32_t size) {
+  uint16_t i;
+  uint8_t *buffer = NULL;
+#ifdef USE_MEMPOOL_STATS
+  uint16_t cls = mc->numOfPools;
+#endif
+
+  for (i = 0; (i < mc->numOfPools) && (NULL == buffer); i++) {
+    if (mc->configs[i].size >= size) {
+#ifdef USE_MEMPOOL_STATS
+      if (cls == mc->numOfPools) {
+        cls = i;
+      }
+#endif
+      buffer = lf_mp_alloc(mc, i);
+    }
+  }
+
+#ifdef USE_MEMPOOL_STATS
+  if (cls == mc->numOfPools) {
+    cls = mc->numOfPools - 1;
+  }
+  mp_stats_alloc(mc->stats, cls, mc->configs[cls].size, size, i - 1, buffer);
+#endif
+
+  if (NULL == buffer) {
+    ASLOG(MCE, ("alloc %u fail\n", size));
+  } else {
+    ASLOG(MCI, ("alloc %u @%p from %p\n", size, buffer, mc));
+  }
+
+  return buffer;
+}
+
+uint8_t *lf_mc_get(const lf_mem_cluster_t *mc, uint32_t *size) {
+  uint16_t i;
+  uint16_t j = mc->numOfPools;
+  uint16_t pool = 0;
+  uint8_t *buffer = NULL;
+#ifdef USE_MEMPOOL_STATS
+  uint32_t reqSize = *size;
+#endif
+
+  for (i = 0; (i < mc->numOfPools) && (NULL == buffer); i++) {
+    if (mc->configs[i].size >= *size) {
+      if (j == mc->numOfPools) {
+        j = i;
+      }
+      pool = i;
+      buffer = lf_mp_alloc(mc, i);
+    }
+  }
+
+  for (i = j; (i > 0) && (NULL == buffer); i--) {
+    pool = i - 1;
+    buffer = lf_mp_alloc(mc, pool);
+    if (NULL != buffer) {
+      *size = mc->configs[pool].size;
+    }
+  }
+
+#ifdef USE_MEMPOOL_STATS
+  if (j == mc->numOfPools) {
+    j = mc->numOfPools - 1;
+  }
+  mp_stats_alloc(mc->stats, j, mc->configs[j].size, reqSize, pool, buffer);
+#endif
+
+  if (NULL == buffer) {
+    ASLOG(MCE, ("alloc %u fail\n", *size));
+  } else {
+    ASLOG(MCI, ("alloc %u @%p from %p\n", *size, buffer, mc));
+  }
+
+  return buffer;
+}
+
+void lf_mc_free(const lf_mem_cluster_t *mc, uint8_t *buffer) {
+  lf_mp_header_t *header = &((lf_mp_header_t *)buffer)[-1];
+  uint16_t pool = header->pool;
+  uint16_t index = header->index;
+#if MEMPOOL_LF_CACHE_SIZE > 0
+  lf_mp_cache_t *cache;
+#endif
+
+  if ((pool < mc->numOfPools) && (index < mc->configs[pool].number) &&
+      (header == MP_LF_HEADER(mc, pool, index)) && lf_mp_mark_free(header)) {
+    ASLOG(MCI, ("free %p to %p\n", buffer, mc));
+#ifdef USE_MEMPOOL_STATS
+    MP_STATS_DEC(mc->stats[pool].inUse);
+#endif
+#if MEMPOOL_LF_CACHE_SIZE > 0
+    cache = lf_mc_get_cache(mc, pool);
+    if ((NULL != cache) && (cache->count < lf_mc_cache_limit(mc, pool))) {
+      cache->index[cache->count] = index;
+      cache->count++;
+    } else {
+      lf_mp_push(&mc->pools[pool], &mc->configs[pool], index);
+    }
+#else
+    lf_mp_push(&mc->pools[pool], &mc->configs[pool], index);
+#endif
+  } else {
+    ASLOG(MCE, ("free %p fail\n", buffer));
+  }
+}
+
+void lf_mc_flush(const lf_mem_cluster_t *mc) {
+#if MEMPOOL_LF_CACHE_SIZE > 0
+  uint16_t i;
+  lf_mp_cache_t *cache;
+
+  for (i = 0; i < mc->numOfPools; i++) {
+    cache = lf_mc_get_cache(mc, i);
+    while ((NULL != cache) && (cache->count > 0)) {
+      cache->count--;
+      lf_mp_push(&mc->pools[i], &mc->configs[i], cache->index[cache->count]);
+    }
+  }
+#else
+  (void)mc;
+#endif
+}
+
+#ifdef USE_MEMPOOL_STATS
+int mc_get_stats(const mem_cluster_t *mc, uint16_t pool, mp_stats_t *stats) {
+  return mp_get_stats(mc->stats, mc->numOfPools, pool, stats);
+}
+
+void mc_reset_stats(const mem_cluster_t *mc) {
+  mp_reset_stats(mc->stats, mc->numOfPools);
+}
+
+int lf_mc_get_stats(const lf_mem_cluster_t *mc, uint16_t pool, mp_stats_t *stats) {
+  return mp_get_stats(mc->stats, mc->numOfPools, pool, stats);
+}
+
+void lf_mc_reset_stats(const lf_mem_cluster_t *mc) {
+  mp_reset_stats(mc->stats, mc->numOfPools);
+}
+#endif
\ No newline at end of file
@@ -7,7 +7,36 @@
 /* ================================ [ INCLUDES  ] ============================================== */
 #include <stdint.h>
 #include <sys/queue.h>
+#include "Std_Critical.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
 /* ================================ [ MACROS    ] ============================================== */
+#define MP_LF_NIL 0xFFFF
+/* stride of a lock free block, keeps every block 8 bytes aligned */
+#define MP_LF_BLOCK_SIZE(size) (sizeof(lf_mp_header_t) + (((uint32_t)(size) + 7u) & ~7u))
+
+/* blocks of each pool kept in the per thread cache of the lock free cluster, 0 to disable */
+#ifndef MEMPOOL_LF_CACHE_SIZE
+#if defined(__GNUC__) && (defined(linux) || defined(_WIN32))
+#define MEMPOOL_LF_CACHE_SIZE 4
+#else
+#define MEMPOOL_LF_CACHE_SIZE 0
+#endif
+#endif
+
+/* a thread caches at most number / MEMPOOL_LF_CACHE_DIVISOR blocks of a pool, so that the caches
+ * of several threads can't strand a small pool, pools with fewer blocks are never cached */
+#ifndef MEMPOOL_LF_CACHE_DIVISOR
+#define MEMPOOL_LF_CACHE_DIVISOR 16
+#endif
+
+#ifdef USE_MEMPOOL_STATS
+/* buckets of the request size histogram, spread evenly over (0, size of the class] */
+#ifndef MEMPOOL_STATS_HISTOGRAM_SIZE
+#define MEMPOOL_STATS_HISTOGRAM_SIZE 8
+#endif
+#endif
 /* ================================ [ TYPES     ] ============================================== */
 typedef struct mp_pool_s {
   SLIST_ENTRY(mp_pool_s) entry;
@@ -15,6 +44,9 @@ typedef struct mp_pool_s {
 
 typedef struct {
   SLIST_HEAD(mp_head, mp_pool_s) head;
+#ifdef STD_NAMED_LOCK
+  Std_LockType lock;
+#endif
 } mempool_t;
 
 typedef struct {
@@ -23,11 +55,56 @@ typedef struct {
   uint16_t number;
 } mem_cluster_cfg_t;
 
+#ifdef USE_MEMPOOL_STATS
+/* The class of a request is the smallest pool that fits it, or the largest pool if none fits.
+ * inUse and highWater count blocks served by this pool, the others count requests of this class. */
+typedef struct {
+  uint32_t inUse;
+  uint32_t highWater;
+  uint32_t failures;
+  uint32_t fallbacks;  /* served by a larger pool as this one was empty */
+  uint32_t downgrades; /* served by a smaller pool, mc_get only */
+  uint32_t histogram[MEMPOOL_STATS_HISTOGRAM_SIZE];
+} mp_stats_t;
+#endif
+
 typedef struct {
   mempool_t *pools;
   const mem_cluster_cfg_t *configs;
   uint16_t numOfPools;
+#ifdef USE_MEMPOOL_STATS
+  mp_stats_t *stats; /* one per pool */
+#endif
 } mem_cluster_t;
+
+/* Lock free cluster: each pool is a Treiber stack of block indexes, the head carries an ABA tag in
+ * the high 16 bits and the index of the first free block in the low 16 bits. Every block is
+ * preceded by a header telling its pool and index, so free needs no search. */
+typedef struct {
+  uint16_t pool;
+  uint16_t index;
+  uint32_t magic;
+} lf_mp_header_t;
+
+typedef struct {
+  uint32_t head;
+} lf_mempool_t;
+
+typedef struct {
+  uint8_t *buffer;  /* number * MP_LF_BLOCK_SIZE(size) */
+  uint16_t *next;   /* free list links, one per block */
+  uint32_t size;    /* usable size of a block */
+  uint16_t number;  /* less than MP_LF_NIL */
+} lf_mem_cluster_cfg_t;
+
+typedef struct {
+  lf_mempool_t *pools;
+  const lf_mem_cluster_cfg_t *configs;
+  uint16_t numOfPools;
+#ifdef USE_MEMPOOL_STATS
+  mp_stats_t *stats; /* one per pool */
+#endif
+} lf_mem_cluster_t;
 /* ================================ [ DECLARES  ] ============================================== */
 /* ================================ [ DATAS     ] ============================================== */
 /* ================================ [ LOCALS    ] ============================================== */
@@ -40,4 +117,23 @@ void mc_init(const mem_cluster_t *mc);
 uint8_t *mc_alloc(const mem_cluster_t *mc, uint32_t size);
 uint8_t *mc_get(const mem_cluster_t *mc, uint32_t *size);
 void mc_free(const mem_cluster_t *mc, uint8_t *buffer);
+
+void lf_mc_init(const lf_mem_cluster_t *mc);
+uint8_t *lf_mc_alloc(const lf_mem_cluster_t *mc, uint32_t size);
+uint8_t *lf_mc_get(const lf_mem_cluster_t *mc, uint32_t *size);
+void lf_mc_free(const lf_mem_cluster_t *mc, uint8_t *buffer);
+/* give the blocks cached by the calling thread back, call it before the thread exits */
+void lf_mc_flush(const lf_mem_cluster_t *mc);
+
+#ifdef USE_MEMPOOL_STATS
+/* copy the counters of one pool, return 0 on success, -1 if the pool does not exist */
+int mc_get_stats(const mem_cluster_t *mc, uint16_t pool, mp_stats_t *stats);
+/* clear the counters, the high water marks restart from the blocks in use */
+void mc_reset_stats(const mem_cluster_t *mc);
+int lf_mc_get_stats(const lf_mem_cluster_t *mc, uint16_t pool, mp_stats_t *stats);
+void lf_mc_reset_stats(const lf_mem_cluster_t *mc);
+#endif
+#ifdef __cplusplus
+}
+#endif
 #endif /* _MEM_POOL_H */
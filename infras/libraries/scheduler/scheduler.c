@@ -0,0 +1,305 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2026 Parai Wang <parai@foxmail.com>
+ */
+/* ================================ [ INCLUDES  ] ============================================== */
+#ifdef linux
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#endif
+#include "scheduler.h"
+#include "Std_Types.h"
+#include "Std_Debug.h"
+/* ================================ [ MACROS    ] ============================================== */
+#define AS_LOG_SCHED 0
+#define AS_LOG_SCHEDI 2
+#define AS_LOG_SCHEDE 3
+
+#ifndef SCHED_MAX_TASKS
+#define SCHED_MAX_TASKS 8
+#endif
+/* ================================ [ TYPES     ] ============================================== */
+#ifdef linux
+typedef struct {
+  const sched_task_cfg_t *cfg;
+  pthread_t thread;
+  Std_LockType lock; /* protects stats */
+  sched_task_stats_t stats;
+  pthread_mutex_t mutex; /* for tasks with a deadline hook */
+  pthread_cond_t cond;
+  boolean wakeup;
+} sched_task_t;
+#endif
+/* ================================ [ DECLARES  ] ============================================== */
+/* ================================ [ DATAS     ] ============================================== */
+#ifdef linux
+static sched_task_t schedTasks[SCHED_MAX_TASKS];
+static uint16_t schedNumOfTasks = 0;
+static boolean schedRunning = FALSE;
+#endif
+/* ================================ [ LOCALS    ] ============================================== */
+#ifdef linux
+static uint64_t sched_now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static void sched_sleep_until(uint64_t time) {
+  struct timespec ts;
+  ts.tv_sec = time / 1000000;
+  ts.tv_nsec = (time % 1000000) * 1000;
+  while (EINTR == clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL)) {
+  }
+}
+
+/* sleep until the release, the deadline or a wakeup, return the planned time */
+static uint64_t sched_wait(sched_task_t *task, uint64_t release) {
+  uint64_t planned = task->cfg->deadline();
+  struct timespec ts;
+  int r = 0;
+
+  if (planned > release) {
+    planned = release;
+  }
+  ts.tv_sec = planned / 1000000;
+  ts.tv_nsec = (planned % 1000000) * 1000;
+
+  pthread_mutex_lock(&task->mutex);
+  while ((FALSE == task->wakeup) && (ETIMEDOUT != r) &&
+         __atomic_load_n(&schedRunning, __ATOMIC_RELAXED)) {
+    r = pthread_cond_timedwait(&task->cond, &task->mutex, &ts);
+  }
+  if (task->wakeup) {
+    task->wakeup = FALSE;
+    planned = sched_now();
+  }
+  pthread_mutex_unlock(&task->mutex);
+
+  return planned;
+}
+
+static void sched_config_thread(sched_task_t *task) {
+  const sched_task_cfg_t *cfg = task->cfg;
+  struct sched_param param;
+  cpu_set_t cpus;
+  int r;
+
+  if (cfg->cpu >= 0) {
+    CPU_ZERO(&cpus);
+    CPU_SET(cfg->cpu, &cpus);
+    r = pthread_setaffinity_np(task->thread, sizeof(cpus), &cpus);
+    if (0 != r) {
+      ASLOG(SCHEDE, ("%s: failed to pin to cpu %d: %d\n", cfg->name, cfg->cpu, r));
+    }
+  }
+
+  if (cfg->priority > 0) {
+    param.sched_priority = cfg->priority;
+    r = pthread_setschedparam(task->thread, SCHED_FIFO, &param);
+    if (0 != r) {
+      /* unprivileged, the period is still kept by the absolute sleeps */
+      ASLOG(SCHEDE, ("%s: failed to set priority %d: %d\n", cfg->name, cfg->priority, r));
+    }
+  }
+}
+
+static void sched_account(sched_task_t *task, uint32_t jitter, uint32_t exec, uint32_t overruns) {
+  sched_task_stats_t *stats = &task->stats;
+
+  EnterCriticalLock(&task->lock);
+  if ((0 == stats->activations) || (jitter < stats->jitterMin)) {
+    stats->jitterMin = jitter;
+  }
+  if (jitter > stats->jitterMax) {
+    stats->jitterMax = jitter;
+  }
+  if (exec > stats->execMax) {
+    stats->execMax = exec;
+  }
+  stats->jitterSum += jitter;
+  stats->execSum += exec;
+  stats->overruns += overruns;
+  stats->activations++;
+  ExitCriticalLock(&task->lock);
+}
+
+static void *sched_thread(void *arg) {
+  sched_task_t *task = (sched_task_t *)arg;
+  const sched_task_cfg_t *cfg = task->cfg;
+  uint64_t release = sched_now();
+  uint64_t planned;
+  uint64_t start;
+  uint64_t end;
+  uint32_t overruns;
+
+  (void)pthread_setname_np(pthread_self(), cfg->name);
+  ASLOG(SCHED, ("%s: started, period %u us\n", cfg->name, cfg->period));
+  while (__atomic_load_n(&schedRunning, __ATOMIC_RELAXED)) {
+    if (NULL != cfg->deadline) {
+      planned = sched_wait(task, release);
+    } else {
+      sched_sleep_until(release);
+      planned = release;
+    }
+    start = sched_now();
+    if (NULL != cfg->lock) {
+      EnterCriticalLock(cfg->lock);
+      cfg->main();
+      ExitCriticalLock(cfg->lock);
+    } else {
+      cfg->main();
+    }
+    end = sched_now();
+
+    overruns = 0;
+    if (start >= release) {
+      release += cfg->period;
+      while (release <= end) {
+        /* drop the missed releases instead of running them back to back */
+        release += cfg->period;
+        overruns++;
+      }
+    }
+    sched_account(task, (uint32_t)(start - planned), (uint32_t)(end - start), overruns);
+  }
+
+  return NULL;
+}
+#endif
+/* ================================ [ FUNCTIONS ] ============================================== */
+#ifdef linux
+int sched_start(const sched_task_cfg_t *tasks, uint16_t number) {
+  int ret = 0;
+  uint16_t i;
+  sched_task_t *task;
+  pthread_condattr_t attr;
+
+  if ((number > SCHED_MAX_TASKS) || (0 != schedNumOfTasks)) {
+    /* an error only, a running scheduler is left alone */
+    ASLOG(SCHEDE, ("invalid number of tasks %u or already started\n", number));
+    ret = -1;
+  } else {
+    __atomic_store_n(&schedRunning, TRUE, __ATOMIC_RELAXED);
+  }
+
+  for (i = 0; (i < number) && (0 == ret); i++) {
+    task = &schedTasks[i];
+    task->cfg = &tasks[i];
+    task->lock.name = tasks[i].name;
+    task->wakeup = FALSE;
+    pthread_mutex_init(&task->mutex, NULL);
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&task->cond, &attr);
+    pthread_condattr_destroy(&attr);
+    if (0 != pthread_create(&task->thread, NULL, sched_thread, task)) {
+      ASLOG(SCHEDE, ("%s: failed to create thread\n", tasks[i].name));
+      ret = -1;
+    } else {
+      sched_config_thread(task);
+      schedNumOfTasks++;
+    }
+  }
+
+  if ((0 != ret) && (i > 0)) {
+    /* stop the threads created before the failure */
+    sched_stop();
+  }
+
+  return ret;
+}
+
+void sched_stop(void) {
+  uint16_t i;
+
+  __atomic_store_n(&schedRunning, FALSE, __ATOMIC_RELAXED);
+  for (i = 0; i < schedNumOfTasks; i++) {
+    sched_wakeup(schedTasks[i].cfg);
+    (void)pthread_join(schedTasks[i].thread, NULL);
+  }
+  schedNumOfTasks = 0;
+}
+
+void sched_wakeup(const sched_task_cfg_t *task) {
+  uint16_t i;
+
+  for (i = 0; i < schedNumOfTasks; i++) {
+    if ((task == schedTasks[i].cfg) && (NULL != task->deadline)) {
+      pthread_mutex_lock(&schedTasks[i].mutex);
+      schedTasks[i].wakeup = TRUE;
+      pthread_cond_signal(&schedTasks[i].cond);
+      pthread_mutex_unlock(&schedTasks[i].mutex);
+    }
+  }
+}
+
+int sched_get_stats(uint16_t task, sched_task_stats_t *stats) {
+  int ret = -1;
+
+  if (task < schedNumOfTasks) {
+    EnterCriticalLock(&schedTasks[task].lock);
+    *stats = schedTasks[task].stats;
+    ExitCriticalLock(&schedTasks[task].lock);
+    ret = 0;
+  }
+
+  return ret;
+}
+
+void sched_reset_stats(void) {
+  uint16_t i;
+
+  for (i = 0; i < schedNumOfTasks; i++) {
+    EnterCriticalLock(&schedTasks[i].lock);
+    memset(&schedTasks[i].stats, 0, sizeof(sched_task_stats_t));
+    ExitCriticalLock(&schedTasks[i].lock);
+  }
+}
+
+void sched_report(void) {
+  uint16_t i;
+  sched_task_stats_t stats;
+
+  for (i = 0; i < schedNumOfTasks; i++) {
+    if ((0 == sched_get_stats(i, &stats)) && (stats.activations > 0)) {
+      ASLOG(SCHEDI,
+            ("%-10s period %6u us: %u runs, %u overruns, jitter min/avg/max %u/%u/%u us, "
+             "exec avg/max %u/%u us\n",
+             schedTasks[i].cfg->name, schedTasks[i].cfg->period, stats.activations, stats.overruns,
+             stats.jitterMin, (uint32_t)(stats.jitterSum / stats.activations), stats.jitterMax,
+             (uint32_t)(stats.execSum / stats.activations), stats.execMax));
+    }
+  }
+}
+#else
+int sched_start(const sched_task_cfg_t *tasks, uint16_t number) {
+  (void)tasks;
+  (void)number;
+  return -1;
+}
+
+void sched_stop(void) {
+}
+
+void sched_wakeup(const sched_task_cfg_t *task) {
+  (void)task;
+}
+
+int sched_get_stats(uint16_t task, sched_task_stats_t *stats) {
+  (void)task;
+  (void)stats;
+  return -1;
+}
+
+void sched_reset_stats(void) {
+}
+
+void sched_report(void) {
+}
+#endif
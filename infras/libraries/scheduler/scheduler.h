@@ -0,0 +1,47 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2026 Parai Wang <parai@foxmail.com>
+ */
+#ifndef _SCHEDULER_H
+#define _SCHEDULER_H
+/* ================================ [ INCLUDES  ] ============================================== */
+#include <stdint.h>
+#include "Std_Critical.h"
+/* ================================ [ MACROS    ] ============================================== */
+#define SCHED_ANY_CPU -1
+/* ================================ [ TYPES     ] ============================================== */
+typedef struct {
+  const char *name;
+  void (*main)(void);
+  uint32_t period; /* us */
+  int priority;    /* SCHED_FIFO priority, 0 to stay SCHED_OTHER */
+  int cpu;         /* core the thread is pinned to, or SCHED_ANY_CPU */
+  /* held while main runs, tasks that touch the same modules must share it, NULL for none */
+  Std_LockType *lock;
+  /* optional, absolute CLOCK_MONOTONIC time in us at which main is due before the next period,
+   * the task can also be woken up early by sched_wakeup */
+  uint64_t (*deadline)(void);
+} sched_task_cfg_t;
+
+typedef struct {
+  uint32_t activations;
+  uint32_t overruns;   /* releases missed because the previous activation ran too long */
+  uint32_t jitterMin;  /* us between the planned release and the wakeup */
+  uint32_t jitterMax;
+  uint64_t jitterSum;
+  uint32_t execMax;    /* us spent in main, lock wait included */
+  uint64_t execSum;
+} sched_task_stats_t;
+/* ================================ [ DECLARES  ] ============================================== */
+/* ================================ [ DATAS     ] ============================================== */
+/* ================================ [ LOCALS    ] ============================================== */
+/* ================================ [ FUNCTIONS ] ============================================== */
+/* start one thread per task, return 0 on success, -1 if the platform has no scheduler */
+int sched_start(const sched_task_cfg_t *tasks, uint16_t number);
+void sched_stop(void);
+/* run the task now if it has a deadline hook, safe from any thread */
+void sched_wakeup(const sched_task_cfg_t *task);
+int sched_get_stats(uint16_t task, sched_task_stats_t *stats);
+void sched_reset_stats(void);
+void sched_report(void);
+#endif /* _SCHEDULER_H */
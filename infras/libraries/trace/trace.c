@@ -0,0 +1,265 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2026 Parai Wang <parai@foxmail.com>
+ */
+/* ================================ [ INCLUDES  ] ============================================== */
+#ifdef linux
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/syscall.h>
+#endif
+#include "trace.h"
+#include "Std_Types.h"
+#include "Std_Debug.h"
+#ifdef TRACE_ENABLED
+/* ================================ [ MACROS    ] ============================================== */
+#define AS_LOG_TRACE 2
+#define AS_LOG_TRACEE 3
+
+/* events kept per thread, power of 2 */
+#ifndef TRACE_RING_SIZE
+#define TRACE_RING_SIZE 4096
+#endif
+/* ================================ [ TYPES     ] ============================================== */
+typedef struct {
+  const trace_point_t *point;
+  uint64_t start;
+  uint64_t duration;
+} trace_event_t;
+
+typedef struct trace_ring_s {
+  uint64_t head; /* written by the owner thread only */
+  int tid;
+  char name[16];
+  struct trace_ring_s *next;
+  trace_event_t events[TRACE_RING_SIZE];
+} trace_ring_t;
+/* ================================ [ DECLARES  ] ============================================== */
+/* ================================ [ DATAS     ] ============================================== */
+static __thread trace_ring_t *traceRing = NULL;
+static trace_ring_t *traceRings = NULL;
+static trace_point_t *tracePoints = NULL;
+/* ================================ [ LOCALS    ] ============================================== */
+static uint32_t trace_bucket(uint64_t duration) {
+  uint32_t bucket = (uint32_t)duration;
+  uint32_t msb;
+
+  if (duration >= 4) {
+    msb = 63 - __builtin_clzll(duration);
+    bucket = (msb - 1) * 4 + (uint32_t)((duration >> (msb - 2)) & 3);
+  }
+
+  return bucket;
+}
+
+/* middle of the durations that fall into the bucket */
+static uint64_t trace_bucket_value(uint32_t bucket) {
+  uint64_t value = bucket;
+  uint32_t msb;
+
+  if (bucket >= 4) {
+    msb = bucket / 4 + 1;
+    value = ((uint64_t)(4 + (bucket % 4)) << (msb - 2)) + ((1ull << (msb - 2)) >> 1);
+  }
+
+  return value;
+}
+
+static trace_ring_t *trace_get_ring(void) {
+  trace_ring_t *ring = traceRing;
+
+  if (NULL == ring) {
+    ring = (trace_ring_t *)calloc(1, sizeof(trace_ring_t));
+    if (NULL != ring) {
+      ring->tid = (int)syscall(SYS_gettid);
+      (void)pthread_getname_np(pthread_self(), ring->name, sizeof(ring->name));
+      ring->next = __atomic_load_n(&traceRings, __ATOMIC_RELAXED);
+      while (!__atomic_compare_exchange_n(&traceRings, &ring->next, ring, 1, __ATOMIC_RELEASE,
+                                          __ATOMIC_RELAXED)) {
+      }
+      traceRing = ring;
+    }
+  }
+
+  return ring;
+}
+
+static void trace_register(trace_point_t *point) {
+  uint32_t expected = 0;
+
+  if (__atomic_compare_exchange_n(&point->registered, &expected, 1, 0, __ATOMIC_RELAXED,
+                                  __ATOMIC_RELAXED)) {
+    point->next = __atomic_load_n(&tracePoints, __ATOMIC_RELAXED);
+    while (!__atomic_compare_exchange_n(&tracePoints, &point->next, point, 1, __ATOMIC_RELEASE,
+                                        __ATOMIC_RELAXED)) {
+    }
+  }
+}
+
+/* the minimum is kept plus one so that a zeroed point needs no initialization */
+static void trace_update_min(uint64_t *value, uint64_t duration) {
+  uint64_t old = __atomic_load_n(value, __ATOMIC_RELAXED);
+
+  duration++;
+  while (((0 == old) || (duration < old)) && (!__atomic_compare_exchange_n(value, &old, duration, 1,
+                                                           __ATOMIC_RELAXED, __ATOMIC_RELAXED))) {
+  }
+}
+
+static void trace_update_max(uint64_t *value, uint64_t duration) {
+  uint64_t old = __atomic_load_n(value, __ATOMIC_RELAXED);
+
+  while ((duration > old) && (!__atomic_compare_exchange_n(value, &old, duration, 1,
+                                                           __ATOMIC_RELAXED, __ATOMIC_RELAXED))) {
+  }
+}
+/* ================================ [ FUNCTIONS ] ============================================== */
+uint64_t trace_now(void) {
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+void trace_record(trace_point_t *point, uint64_t start) {
+  uint64_t duration = trace_now() - start;
+  trace_ring_t *ring = trace_get_ring();
+  trace_event_t *event;
+  uint64_t head;
+
+  if (0 == __atomic_load_n(&point->registered, __ATOMIC_RELAXED)) {
+    trace_register(point);
+  }
+
+  __atomic_add_fetch(&point->count, 1, __ATOMIC_RELAXED);
+  __atomic_add_fetch(&point->sum, duration, __ATOMIC_RELAXED);
+  __atomic_add_fetch(&point->histogram[trace_bucket(duration)], 1, __ATOMIC_RELAXED);
+  trace_update_min(&point->min, duration);
+  trace_update_max(&point->max, duration);
+
+  if (NULL != ring) {
+    head = ring->head;
+    event = &ring->events[head & (TRACE_RING_SIZE - 1)];
+    __atomic_store_n(&event->point, point, __ATOMIC_RELAXED);
+    __atomic_store_n(&event->start, start, __ATOMIC_RELAXED);
+    __atomic_store_n(&event->duration, duration, __ATOMIC_RELAXED);
+    __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+  }
+}
+
+trace_point_t *trace_get_next(trace_point_t *point) {
+  trace_point_t *next;
+
+  if (NULL == point) {
+    next = __atomic_load_n(&tracePoints, __ATOMIC_ACQUIRE);
+  } else {
+    next = point->next;
+  }
+
+  return next;
+}
+
+void trace_get_summary(const trace_point_t *point, trace_summary_t *summary) {
+  uint64_t rank;
+  uint64_t seen = 0;
+  uint32_t i;
+
+  summary->name = point->name;
+  summary->count = __atomic_load_n(&point->count, __ATOMIC_RELAXED);
+  summary->min = __atomic_load_n(&point->min, __ATOMIC_RELAXED);
+  if (summary->min > 0) {
+    summary->min--;
+  }
+  summary->max = __atomic_load_n(&point->max, __ATOMIC_RELAXED);
+  summary->avg = 0;
+  summary->p99 = 0;
+  if (summary->count > 0) {
+    summary->avg = __atomic_load_n(&point->sum, __ATOMIC_RELAXED) / summary->count;
+    rank = ((uint64_t)summary->count * 99 + 99) / 100;
+    for (i = 0; i < TRACE_HISTOGRAM_SIZE; i++) {
+      seen += __atomic_load_n(&point->histogram[i], __ATOMIC_RELAXED);
+      if (seen >= rank) {
+        summary->p99 = trace_bucket_value(i);
+        break;
+      }
+    }
+    if (summary->p99 > summary->max) {
+      summary->p99 = summary->max;
+    }
+  }
+}
+
+void trace_report(void) {
+  trace_point_t *point;
+  trace_summary_t summary;
+
+  for (point = trace_get_next(NULL); NULL != point; point = trace_get_next(point)) {
+    trace_get_summary(point, &summary);
+    ASLOG(TRACE, ("%-24s %8u calls, min/avg/p99/max %llu/%llu/%llu/%llu ns\n", summary.name,
+                  summary.count, (unsigned long long)summary.min,
+                  (unsigned long long)summary.avg, (unsigned long long)summary.p99,
+                  (unsigned long long)summary.max));
+  }
+}
+
+int trace_dump_chrome(const char *path) {
+  int ret = 0;
+  FILE *fp = fopen(path, "w");
+  trace_ring_t *ring;
+  trace_event_t *events = (trace_event_t *)malloc(sizeof(trace_event_t) * TRACE_RING_SIZE);
+  trace_event_t *event;
+  const char *sep = "";
+  uint64_t head;
+  uint64_t from;
+  uint64_t first;
+  uint64_t i;
+  int pid = (int)getpid();
+
+  if ((NULL == fp) || (NULL == events)) {
+    ASLOG(TRACEE, ("failed to dump trace to %s\n", path));
+    ret = -1;
+  } else {
+    fprintf(fp, "{\"traceEvents\":[");
+    for (ring = __atomic_load_n(&traceRings, __ATOMIC_ACQUIRE); NULL != ring; ring = ring->next) {
+      fprintf(fp, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,"
+                  "\"args\":{\"name\":\"%s\"}}",
+              sep, pid, ring->tid, ring->name);
+      sep = ",";
+      head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+      from = (head > TRACE_RING_SIZE) ? (head - TRACE_RING_SIZE) : 0;
+      for (i = from; i < head; i++) {
+        event = &ring->events[i & (TRACE_RING_SIZE - 1)];
+        events[i - from].point = __atomic_load_n(&event->point, __ATOMIC_RELAXED);
+        events[i - from].start = __atomic_load_n(&event->start, __ATOMIC_RELAXED);
+        events[i - from].duration = __atomic_load_n(&event->duration, __ATOMIC_RELAXED);
+      }
+      /* drop the events the owner may have overwritten while they were copied */
+      first = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+      first = (first >= TRACE_RING_SIZE) ? (first - TRACE_RING_SIZE + 1) : 0;
+      if (first < from) {
+        first = from;
+      }
+      for (i = first; i < head; i++) {
+        event = &events[i - from];
+        fprintf(fp,
+                ",\n{\"name\":\"%s\",\"cat\":\"bsw\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,"
+                "\"pid\":%d,\"tid\":%d}",
+                event->point->name, (double)event->start / 1000.0,
+                (double)event->duration / 1000.0, pid, ring->tid);
+      }
+    }
+    fprintf(fp, "\n]}\n");
+  }
+
+  if (NULL != fp) {
+    fclose(fp);
+  }
+  free(events);
+
+  return ret;
+}
+#endif /* TRACE_ENABLED */
@@ -0,0 +1,66 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2026 Parai Wang <parai@foxmail.com>
+ */
+#ifndef _TRACE_H
+#define _TRACE_H
+/* ================================ [ INCLUDES  ] ============================================== */
+#include <stdint.h>
+/* ================================ [ MACROS    ] ============================================== */
+#if defined(USE_TRACE) && defined(linux)
+#define TRACE_ENABLED
+#endif
+
+/* log-linear buckets of the call durations in ns, 4 per power of 2 */
+#define TRACE_HISTOGRAM_SIZE 256
+
+#define TRACE_POINT_INIT(name) { name }
+
+#ifdef TRACE_ENABLED
+/* time a call of fn(void), e.g. TRACE_CALL(Com_MainFunction) */
+#define TRACE_CALL(fn)                                                                             \
+  do {                                                                                             \
+    static trace_point_t _tracePoint = TRACE_POINT_INIT(#fn);                                      \
+    uint64_t _traceStart = trace_now();                                                            \
+    fn();                                                                                          \
+    trace_record(&_tracePoint, _traceStart);                                                       \
+  } while (0)
+#else
+#define TRACE_CALL(fn) fn()
+#endif
+/* ================================ [ TYPES     ] ============================================== */
+typedef struct trace_point_s {
+  const char *name;
+  uint32_t registered;
+  uint32_t count;
+  uint64_t sum; /* ns */
+  uint64_t min;
+  uint64_t max;
+  uint32_t histogram[TRACE_HISTOGRAM_SIZE];
+  struct trace_point_s *next;
+} trace_point_t;
+
+typedef struct {
+  const char *name;
+  uint32_t count;
+  uint64_t min; /* ns */
+  uint64_t avg;
+  uint64_t p99;
+  uint64_t max;
+} trace_summary_t;
+/* ================================ [ DECLARES  ] ============================================== */
+/* ================================ [ DATAS     ] ============================================== */
+/* ================================ [ LOCALS    ] ============================================== */
+/* ================================ [ FUNCTIONS ] ============================================== */
+#ifdef TRACE_ENABLED
+uint64_t trace_now(void);
+/* the events go to a ring of the calling thread, the oldest ones are overwritten */
+void trace_record(trace_point_t *point, uint64_t start);
+/* walk the points recorded at least once, pass NULL to get the first one */
+trace_point_t *trace_get_next(trace_point_t *point);
+void trace_get_summary(const trace_point_t *point, trace_summary_t *summary);
+void trace_report(void);
+/* write the events of all threads as a Chrome/Perfetto trace, return 0 on success */
+int trace_dump_chrome(const char *path);
+#endif
+#endif /* _TRACE_H */
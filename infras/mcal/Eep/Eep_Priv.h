@@ -10,7 +10,9 @@
 #include "Std_Types.h"
 /* ================================ [ MACROS    ] ============================================== */
 #define FLS_CFG_H
+#ifndef EEP_ADDRESS_TYPE_U32
 #define FLS_ADDRESS_TYPE_U16
+#endif
 
 #define Fls_AddressType Eep_AddressType
 #define Fls_LengthType Eep_LengthType
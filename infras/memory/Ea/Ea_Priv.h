@@ -9,12 +9,13 @@
 /* ================================ [ INCLUDES  ] ============================================== */
 #include "Std_Types.h"
 #include "MemIf.h"
+#include "Eep.h"
 /* ================================ [ MACROS    ] ============================================== */
 /* ================================ [ TYPES     ] ============================================== */
 typedef struct {        /* @ECUC_Ea_00040 */
   uint16_t BlockNumber; /* @ECUC_Ea_00130: The block numbers 0x0000 and 0xFFFF shall not be
                          * configurable for a logical block */
-  uint16_t BlockAddress;
+  Eep_AddressType BlockAddress;
   uint16_t BlockSize;   /* with CRC */
   /* boolean ImmediateData; */
   uint32_t NumberOfWriteCycles;
@@ -0,0 +1,295 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2026 Parai Wang <parai@foxmail.com>
+ */
+/* ================================ [ INCLUDES  ] ============================================== */
+#include "Std_Timer.h"
+#include "Std_Critical.h"
+#include "Std_Types.h"
+#include "Std_Debug.h"
+#ifdef STD_TIMER_WHEEL
+/* ================================ [ MACROS    ] ============================================== */
+#define AS_LOG_TMW 0
+
+/* 4 levels of 64 slots cover 2^24 ticks, later timers wait in the last level and are re-filed */
+#define TMW_LEVELS 4
+#define TMW_BITS 6
+#define TMW_SLOTS (1 << TMW_BITS)
+#define TMW_MASK (TMW_SLOTS - 1)
+#define TMW_RANGE(level) ((uint64_t)1 << (TMW_BITS * ((level) + 1)))
+#define TMW_INDEX(tick, level) ((uint32_t)((tick) >> (TMW_BITS * (level))) & TMW_MASK)
+
+#ifdef STD_NAMED_LOCK
+#define tmwEnterCritical() EnterCriticalLock(&tmwLock)
+#define tmwExitCritical() ExitCriticalLock(&tmwLock)
+#else
+#define tmwEnterCritical() EnterCritical()
+#define tmwExitCritical() ExitCritical()
+#endif
+/* ================================ [ TYPES     ] ============================================== */
+/* ================================ [ DECLARES  ] ============================================== */
+/* ================================ [ DATAS     ] ============================================== */
+static Std_TimerEntryType tmwSlots[TMW_LEVELS][TMW_SLOTS];
+static uint64_t tmwOccupied[TMW_LEVELS];
+static uint64_t tmwTick;     /* last processed tick */
+static uint64_t tmwNextTick; /* last value handed out by Std_TimerWheelGetNextExpiry */
+static void (*tmwNotify)(void) = NULL;
+#ifdef STD_NAMED_LOCK
+static STD_LOCK_DEFINE(tmwLock, 0);
+#endif
+/* ================================ [ LOCALS    ] ============================================== */
+static void tmwListInit(Std_TimerEntryType *head) {
+  head->next = head;
+  head->prev = head;
+}
+
+static void tmwListAdd(Std_TimerEntryType *head, Std_TimerEntryType *entry) {
+  entry->next = head;
+  entry->prev = head->prev;
+  head->prev->next = entry;
+  head->prev = entry;
+}
+
+static void tmwListDel(Std_TimerEntryType *entry) {
+  entry->prev->next = entry->next;
+  entry->next->prev = entry->prev;
+  entry->next = NULL;
+  entry->prev = NULL;
+}
+
+static void tmwInsert(Std_TimerEntryType *entry) {
+  uint64_t expire = entry->expire;
+  uint64_t delta = expire - tmwTick;
+  uint32_t level = 0;
+  uint32_t slot;
+
+  while ((level < (TMW_LEVELS - 1)) && (delta >= TMW_RANGE(level))) {
+    level++;
+  }
+
+  if (delta >= TMW_RANGE(level)) {
+    expire = tmwTick + TMW_RANGE(level) - 1;
+  }
+
+  slot = TMW_INDEX(expire, level);
+  tmwListAdd(&tmwSlots[level][slot], entry);
+  tmwOccupied[level] |= (uint64_t)1 << slot;
+}
+
+static void tmwCascade(uint32_t level, uint32_t slot) {
+  Std_TimerEntryType *head = &tmwSlots[level][slot];
+  Std_TimerEntryType *entry;
+
+  tmwOccupied[level] &= ~((uint64_t)1 << slot);
+  while (head->next != head) {
+    entry = head->next;
+    tmwListDel(entry);
+    tmwInsert(entry);
+  }
+}
+
+/* The earliest tick after tmwTick at which a slot has to be run or cascaded. Stopping a timer
+ * leaves its occupied bit set, stale bits of empty slots are cleared here. */
+static uint64_t tmwGetNextTick(void) {
+  uint64_t next = STD_TIME64_MAX;
+  uint64_t pending;
+  uint64_t tick;
+  uint32_t level;
+  uint32_t current;
+  uint32_t distance;
+  uint32_t slot;
+  boolean found;
+
+  for (level = 0; level < TMW_LEVELS; level++) {
+    found = FALSE;
+    while ((FALSE == found) && (0 != tmwOccupied[level])) {
+      current = TMW_INDEX(tmwTick, level);
+      /* rotate so that bit 0 is the slot after the current one */
+      if (TMW_MASK == current) {
+        pending = tmwOccupied[level];
+      } else {
+        pending = (tmwOccupied[level] >> (current + 1)) |
+                  (tmwOccupied[level] << (TMW_SLOTS - current - 1));
+      }
+      distance = (uint32_t)__builtin_ctzll(pending) + 1;
+      slot = (current + distance) & TMW_MASK;
+      if (tmwSlots[level][slot].next == &tmwSlots[level][slot]) {
+        tmwOccupied[level] &= ~((uint64_t)1 << slot);
+      } else {
+        found = TRUE;
+        tick = ((tmwTick >> (TMW_BITS * level)) + distance) << (TMW_BITS * level);
+        if (tick < next) {
+          next = tick;
+        }
+      }
+    }
+  }
+
+  return next;
+}
+
+/* the list heads are set up on first use, so that a module may arm a timer before or without
+ * Std_TimerWheelInit, called with the lock held */
+static void tmwLazyInit(void) {
+  uint32_t level;
+  uint32_t slot;
+
+  if (NULL == tmwSlots[0][0].next) {
+    for (level = 0; level < TMW_LEVELS; level++) {
+      for (slot = 0; slot < TMW_SLOTS; slot++) {
+        tmwListInit(&tmwSlots[level][slot]);
+      }
+      tmwOccupied[level] = 0;
+    }
+    tmwTick = Std_GetTime64() / STD_TIMER_WHEEL_TICK;
+    tmwNextTick = STD_TIME64_MAX;
+  }
+}
+
+static void tmwRun(Std_TimerEntryType *expired) {
+  Std_TimerEntryType *entry;
+  Std_TimerCallbackType callback;
+  void *param = NULL;
+  boolean more = TRUE;
+
+  while (more) {
+    callback = NULL;
+    tmwEnterCritical();
+    if (expired->next != expired) {
+      entry = expired->next;
+      tmwListDel(entry);
+      callback = entry->callback;
+      param = entry->param;
+      if (0 != entry->period) {
+        entry->expire += entry->period;
+        if (entry->expire <= tmwTick) {
+          /* late, no catch up */
+          entry->expire = tmwTick + 1;
+        }
+        tmwInsert(entry);
+      }
+    } else {
+      more = FALSE;
+    }
+    tmwExitCritical();
+
+    /* called unlocked so that the callback may restart or stop timers */
+    if (NULL != callback) {
+      callback(param);
+    }
+  }
+}
+/* ================================ [ FUNCTIONS ] ============================================== */
+void Std_TimerWheelInit(void (*notify)(void)) {
+  tmwEnterCritical();
+  /* keeps the timers already armed */
+  tmwLazyInit();
+  tmwNotify = notify;
+  tmwExitCritical();
+}
+
+void Std_TimerEntryInit(Std_TimerEntryType *entry, Std_TimerCallbackType callback, void *param) {
+  entry->next = NULL;
+  entry->prev = NULL;
+  entry->period = 0;
+  entry->callback = callback;
+  entry->param = param;
+}
+
+void Std_TimerEntryStart(Std_TimerEntryType *entry, std_time64_t timeout, std_time64_t period) {
+  boolean notify = FALSE;
+
+  tmwEnterCritical();
+  tmwLazyInit();
+  if (NULL != entry->prev) {
+    tmwListDel(entry);
+  }
+  /* round up, a timer never fires early */
+  entry->expire = (Std_GetTime64() + timeout + STD_TIMER_WHEEL_TICK - 1) / STD_TIMER_WHEEL_TICK;
+  entry->period = (period + STD_TIMER_WHEEL_TICK - 1) / STD_TIMER_WHEEL_TICK;
+  if ((0 != period) && (0 == entry->period)) {
+    entry->period = 1;
+  }
+  if (entry->expire <= tmwTick) {
+    entry->expire = tmwTick + 1;
+  }
+  tmwInsert(entry);
+  if (entry->expire < tmwNextTick) {
+    tmwNextTick = entry->expire;
+    notify = TRUE;
+  }
+  tmwExitCritical();
+
+  ASLOG(TMW, ("start %p expire @%llu period %llu\n", entry, (unsigned long long)entry->expire,
+              (unsigned long long)entry->period));
+  if (notify && (NULL != tmwNotify)) {
+    tmwNotify();
+  }
+}
+
+void Std_TimerEntryStop(Std_TimerEntryType *entry) {
+  tmwEnterCritical();
+  if (NULL != entry->prev) {
+    tmwListDel(entry);
+  }
+  entry->period = 0;
+  tmwExitCritical();
+}
+
+bool Std_IsTimerEntryStarted(Std_TimerEntryType *entry) {
+  return (NULL != entry->prev);
+}
+
+std_time64_t Std_TimerWheelGetNextExpiry(void) {
+  uint64_t next;
+
+  tmwEnterCritical();
+  tmwLazyInit();
+  next = tmwGetNextTick();
+  tmwNextTick = next;
+  tmwExitCritical();
+
+  if (STD_TIME64_MAX != next) {
+    next = next * STD_TIMER_WHEEL_TICK;
+  }
+
+  return next;
+}
+
+void Std_TimerWheelMainFunction(void) {
+  Std_TimerEntryType expired;
+  Std_TimerEntryType *head;
+  Std_TimerEntryType *entry;
+  uint64_t now = Std_GetTime64() / STD_TIMER_WHEEL_TICK;
+  uint64_t next;
+  uint32_t level;
+  uint32_t slot;
+
+  tmwListInit(&expired);
+  tmwEnterCritical();
+  tmwLazyInit();
+  while (tmwTick < now) {
+    /* skip the ticks with nothing to run or cascade */
+    next = tmwGetNextTick();
+    if (next > now) {
+      tmwTick = now;
+    } else {
+      tmwTick = next;
+      for (level = 1; (level < TMW_LEVELS) && (0 == TMW_INDEX(tmwTick, level - 1)); level++) {
+        tmwCascade(level, TMW_INDEX(tmwTick, level));
+      }
+      slot = TMW_INDEX(tmwTick, 0);
+      head = &tmwSlots[0][slot];
+      tmwOccupied[0] &= ~((uint64_t)1 << slot);
+      while (head->next != head) {
+        entry = head->next;
+        tmwListDel(entry);
+        tmwListAdd(&expired, entry);
+      }
+    }
+  }
+  tmwExitCritical();
+
+  tmwRun(&expired);
+}
+#endif /* STD_TIMER_WHEEL */
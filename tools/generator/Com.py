@@ -178,6 +178,150 @@ def gen_msg(msg, C, network):
     C.write('  },\n')
 
 
+def get_signal_bytes(sig):
+    # (byte, mask, shift) per PDU byte touched, value bits = (data[byte] & mask) << shift
+    L = []
+    byte = int(sig['start']/8)
+    bit = sig['start'] & 7
+    size = sig['size']
+    if sig['endian'] == 'big':
+        v = size - 1
+        while v >= 0:
+            n = min(bit + 1, v + 1)
+            L.append((byte, ((1 << n) - 1) << (bit - n + 1), v - bit))
+            v -= n
+            byte += 1
+            bit = 7
+    else:
+        v = 0
+        while v < size:
+            n = min(8 - bit, size - v)
+            L.append((byte, ((1 << n) - 1) << bit, v - bit))
+            v += n
+            byte += 1
+            bit = 0
+    return L
+
+
+def paren(expr):
+    if expr.startswith('(') and expr.endswith(')'):
+        depth = 0
+        for i, c in enumerate(expr):
+            depth += {'(': 1, ')': -1}.get(c, 0)
+            if depth == 0 and i < len(expr) - 1:
+                break
+        else:
+            return expr
+    return '(%s)' % (expr)
+
+
+def get_pack_signals(msg):
+    # group signals are packed through their members which sit at their PDU position
+    return [sig for sig in msg['signals'] if not sig.get('isGroup', False)]
+
+
+def gen_shadow_type(msg, H):
+    H.write('typedef struct {\n')
+    for sig in get_pack_signals(msg):
+        t0, t1, nBytes = get_signal_info(sig)
+        if t0 in ['UINT8N', 'SINT8N']:
+            H.write('  %s %s[%s];\n' % (t1, sig['name'], nBytes))
+        else:
+            H.write('  %s %s;\n' % (t1, sig['name']))
+    H.write('} Com_Shadow_%sType;\n\n' % (msg['name']))
+
+
+def gen_shadow_offsets(msg, C):
+    # shadow offset of each entry of Com_IPduSignals_<msg>, groups live in no shadow field
+    C.write('static const uint16_t Com_ShadowOffsets_%s[] = {\n' % (msg['name']))
+    for sig in msg['signals']:
+        if sig.get('isGroup', False):
+            C.write('  COM_SHADOW_GROUP, /* %s */\n' % (sig['name']))
+        else:
+            C.write('  offsetof(Com_Shadow_%sType, %s),\n' % (msg['name'], sig['name']))
+    C.write('};\n\n')
+
+
+def gen_pack_entry(msg, C):
+    C.write('  {\n')
+    C.write('    Com_UnpackIPdu_%s,\n' % (msg['name']))
+    C.write('    Com_PackIPdu_%s,\n' % (msg['name']))
+    C.write('    Com_ShadowOffsets_%s,\n' % (msg['name']))
+    C.write('    sizeof(Com_Shadow_%sType),\n' % (msg['name']))
+    C.write('  },\n')
+
+
+def gen_pack_adapter(msg, C):
+    C.write('static void Com_UnpackIPdu_%s(const uint8_t *data, void *shadow) {\n' % (msg['name']))
+    C.write('  Com_Unpack_%s(data, (Com_Shadow_%sType *)shadow);\n' % (msg['name'], msg['name']))
+    C.write('}\n\n')
+    C.write('static void Com_PackIPdu_%s(uint8_t *data, const void *shadow) {\n' % (msg['name']))
+    C.write('  Com_Pack_%s(data, (const Com_Shadow_%sType *)shadow);\n' % (
+        msg['name'], msg['name']))
+    C.write('}\n\n')
+
+
+def gen_unpack(msg, C):
+    C.write('void Com_Unpack_%s(const uint8_t *data, Com_Shadow_%sType *shadow) {\n' % (
+        msg['name'], msg['name']))
+    for sig in get_pack_signals(msg):
+        t0, t1, nBytes = get_signal_info(sig)
+        if t0 in ['UINT8N', 'SINT8N']:
+            C.write('  memcpy(shadow->%s, &data[%s], %s);\n' %
+                    (sig['name'], int(sig['start']/8), nBytes))
+            continue
+        terms = []
+        for byte, mask, shift in get_signal_bytes(sig):
+            v = 'data[%s]' % (byte) if mask == 0xFF else '(data[%s] & 0x%02Xu)' % (byte, mask)
+            if shift > 0:
+                if t0.endswith('INT32'):
+                    v = '(uint32_t)' + v
+                v = '(%s << %s)' % (v, shift)
+            elif shift < 0:
+                v = '(%s >> %s)' % (v, -shift)
+            terms.append(v)
+        expr = ' | '.join(terms)
+        width = {'INT8': 8, 'INT16': 16, 'INT32': 32}[t0[1:]]
+        if t0.startswith('S') and sig['size'] < width:
+            m = '0x%Xu' % (1 << (sig['size'] - 1))
+            expr = '(int32_t)(((uint32_t)(%s) ^ %s) - %s)' % (expr, m, m)
+        C.write('  shadow->%s = (%s)%s;\n' % (sig['name'], t1, paren(expr)))
+    C.write('}\n\n')
+
+
+def gen_pack(msg, C):
+    C.write('void Com_Pack_%s(uint8_t *data, const Com_Shadow_%sType *shadow) {\n' % (
+        msg['name'], msg['name']))
+    bytes = {}
+    for sig in get_pack_signals(msg):
+        t0, t1, nBytes = get_signal_info(sig)
+        if t0 in ['UINT8N', 'SINT8N']:
+            C.write('  memcpy(&data[%s], shadow->%s, %s);\n' %
+                    (int(sig['start']/8), sig['name'], nBytes))
+            continue
+        for byte, mask, shift in get_signal_bytes(sig):
+            v = 'shadow->%s' % (sig['name'])
+            if t0.startswith('S'):
+                v = '(uint32_t)' + v
+            if shift > 0:
+                v = '(%s >> %s)' % (v, shift)
+            elif shift < 0:
+                v = '(%s << %s)' % (v, -shift)
+            if mask != 0xFF:
+                v = '(%s & 0x%02Xu)' % (v, mask)
+            bytes.setdefault(byte, []).append((mask, v))
+    for byte in sorted(bytes.keys()):
+        mask = 0
+        for m, _ in bytes[byte]:
+            mask |= m
+        terms = [v for _, v in bytes[byte]]
+        if mask != 0xFF:
+            # keep the bits owned by no signal, e.g. update bits
+            terms.insert(0, '(data[%s] & 0x%02Xu)' % (byte, (~mask) & 0xFF))
+        C.write('  data[%s] = (uint8_t)%s;\n' % (byte, paren(' | '.join(terms))))
+    C.write('}\n\n')
+
+
 def Gen_Com(cfg, dir):
     H = open('%s/Com_Cfg.h' % (dir), 'w')
     GenHeader(H)
@@ -185,6 +329,7 @@ def Gen_Com(cfg, dir):
     H.write('#define COM_CFG_H\n')
     H.write(
         '/* ================================ [ INCLUDES  ] ============================================== */\n')
+    H.write('#include "Std_Types.h"\n')
     H.write(
         '/* ================================ [ MACROS    ] ============================================== */\n')
     H.write('#ifndef COM_MAIN_FUNCTION_PERIOD\n')
@@ -200,6 +345,7 @@ def Gen_Com(cfg, dir):
         H.write('#define COM_USE_%s\n' % (nt))
     H.write('//#define COM_USE_SIGNAL_CONFIG\n')
     H.write('#define COM_USE_SIGNAL_UPDATE_BIT\n')
+    H.write('#define COM_USE_PACK_ROUTINES\n')
     H.write('\n')
     for network in cfg['networks']:
         H.write('#define COM_RX_FOR_%s(id, PduInfoPtr) \\\n' %
@@ -270,6 +416,10 @@ def Gen_Com(cfg, dir):
                 msg['name'], network['name']))
     H.write(
         '/* ================================ [ TYPES     ] ============================================== */\n')
+    H.write('/* shadow of the signals of each I-PDU, in their application types */\n')
+    for network in cfg['networks']:
+        for msg in network['messages']:
+            gen_shadow_type(msg, H)
     H.write(
         '/* ================================ [ DECLARES  ] ============================================== */\n')
     H.write(
@@ -278,6 +428,14 @@ def Gen_Com(cfg, dir):
         '/* ================================ [ LOCALS    ] ============================================== */\n')
     H.write(
         '/* ================================ [ FUNCTIONS ] ============================================== */\n')
+    H.write('#ifdef COM_USE_PACK_ROUTINES\n')
+    for network in cfg['networks']:
+        for msg in network['messages']:
+            H.write('void Com_Unpack_%s(const uint8_t *data, Com_Shadow_%sType *shadow);\n' % (
+                msg['name'], msg['name']))
+            H.write('void Com_Pack_%s(uint8_t *data, const Com_Shadow_%sType *shadow);\n' % (
+                msg['name'], msg['name']))
+    H.write('#endif\n')
     H.write('#endif /* COM_CFG_H */\n')
     H.close()
 
@@ -288,6 +446,8 @@ def Gen_Com(cfg, dir):
     C.write('#include "Com_Cfg.h"\n')
     C.write('#include "Com.h"\n')
     C.write('#include "Com_Priv.h"\n')
+    C.write('#include <string.h>\n')
+    C.write('#include <stddef.h>\n')
     C.write(
         '/* ================================ [ MACROS    ] ============================================== */\n')
     C.write(
@@ -327,6 +487,14 @@ def Gen_Com(cfg, dir):
                                 (InvalidNotification))
                     if RxTOut != 'NULL':
                         C.write('extern void %s(void);\n' % (RxNotification))
+    C.write('#ifdef COM_USE_PACK_ROUTINES\n')
+    for network in cfg['networks']:
+        for msg in network['messages']:
+            C.write('static void Com_UnpackIPdu_%s(const uint8_t *data, void *shadow);\n' % (
+                msg['name']))
+            C.write('static void Com_PackIPdu_%s(uint8_t *data, const void *shadow);\n' % (
+                msg['name']))
+    C.write('#endif\n')
     C.write(
         '/* ================================ [ DATAS     ] ============================================== */\n')
     for network in cfg['networks']:
@@ -384,6 +552,16 @@ def Gen_Com(cfg, dir):
                     'G' if sig.get('isGroup', False) else 'S',
                     sig['name']))
             C.write('};\n\n')
+    C.write('#ifdef COM_USE_PACK_ROUTINES\n')
+    for network in cfg['networks']:
+        for msg in network['messages']:
+            gen_shadow_offsets(msg, C)
+    C.write('const Com_IPduPackConfigType Com_IPduPackConfigs[] = {\n')
+    for network in cfg['networks']:
+        for msg in network['messages']:
+            gen_pack_entry(msg, C)
+    C.write('};\n\n')
+    C.write('#endif /* COM_USE_PACK_ROUTINES */\n')
     for network in cfg['networks']:
         for msg in network['messages']:
             gen_cfg = gen_rx_msg_cfg
@@ -408,8 +586,19 @@ def Gen_Com(cfg, dir):
     C.write('};\n\n')
     C.write(
         '/* ================================ [ LOCALS    ] ============================================== */\n')
+    C.write('#ifdef COM_USE_PACK_ROUTINES\n')
+    for network in cfg['networks']:
+        for msg in network['messages']:
+            gen_pack_adapter(msg, C)
+    C.write('#endif /* COM_USE_PACK_ROUTINES */\n')
     C.write(
         '/* ================================ [ FUNCTIONS ] ============================================== */\n')
+    C.write('#ifdef COM_USE_PACK_ROUTINES\n')
+    for network in cfg['networks']:
+        for msg in network['messages']:
+            gen_unpack(msg, C)
+            gen_pack(msg, C)
+    C.write('#endif /* COM_USE_PACK_ROUTINES */\n')
     C.close()
 
 
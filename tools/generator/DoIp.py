@@ -23,6 +23,9 @@ def Gen_DoIp(cfg, dir):
     H.write('\n#define DOIP_MAX_TESTER_CONNECTIONS %s\n\n' %
             (cfg['max_connections']))
     H.write('#define DOIP_MAIN_FUNCTION_PERIOD 10\n')
+    # the inline ACK area of each connection is sized for the largest NumByteDiagAckNack
+    H.write('#define DOIP_MAX_NUM_BYTE_DIAG_ACK_NACK %s\n' %
+            (max([tester.get('NumByteDiagAckNack', 8) for tester in cfg['testers']] + [0])))
     H.write('#define DOIP_CONVERT_MS_TO_MAIN_CYCLES(x) \\\n')
     H.write('  ((x + DOIP_MAIN_FUNCTION_PERIOD - 1) / DOIP_MAIN_FUNCTION_PERIOD)\n\n')
     for i, target in enumerate(cfg['targets']):
@@ -124,7 +127,8 @@ def Gen_DoIp(cfg, dir):
     C.write('static const DoIP_TesterType DoIP_Testers[] = {\n')
     for tester in cfg['testers']:
         C.write('  {\n')
-        C.write('    8, /* NumByteDiagAckNack */\n')
+        C.write('    %s, /* NumByteDiagAckNack */\n' %
+                (tester.get('NumByteDiagAckNack', 8)))
         C.write('    %s, /* TesterSA */\n' % (tester['address']))
         C.write('    DoIP_%s_RoutingActivationRefs,\n' % (tester['name']))
         C.write('    ARRAY_SIZE(DoIP_%s_RoutingActivationRefs),\n' %
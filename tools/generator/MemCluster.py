@@ -41,6 +41,10 @@ def Gen_MC(cfg, dir):
     H.write('uint8_t* %s_MemAlloc(uint32_t size);\n' % (cfg['name']))
     H.write('uint8_t* %s_MemGet(uint32_t* size);\n' % (cfg['name']))
     H.write('void %s_MemFree(uint8_t* buffer);\n' % (cfg['name']))
+    H.write('#ifdef USE_MEMPOOL_STATS\n')
+    H.write('int %s_MemGetStats(uint16_t pool, mp_stats_t* stats);\n' % (cfg['name']))
+    H.write('void %s_MemResetStats(void);\n' % (cfg['name']))
+    H.write('#endif\n')
     H.write('#endif /* %s_MEM_H */\n' % (cfg['name'].upper()))
     H.close()
 
@@ -59,41 +63,67 @@ def Gen_MC(cfg, dir):
         '/* ================================ [ DATAS     ] ============================================== */\n')
     mps = cfg['clusters']
     mps.sort(key=lambda x: eval(str(x['size'])))
+    lf = 'lf_' if cfg.get('lockfree', False) else ''
     for mp in mps:
-        tsz = eval(str(mp['size'])) * eval(str(mp['number']))
-        C.write('static uint32_t MC_%s_%s_Buffer[(%s+sizeof(uint32_t) - 1)/sizeof(uint32_t)];\n' % (
-            cfg['name'], mp['name'], tsz))
-    C.write('static const mem_cluster_cfg_t MC_%sCfgs[] = {\n' % (cfg['name']))
+        if lf:
+            number = eval(str(mp['number']))
+            assert number < 0xFFFF, 'lock free pool %s has too many blocks' % (mp['name'])
+            tsz = 'MP_LF_BLOCK_SIZE(%s)*%s' % (mp['size'], number)
+            C.write('static uint64_t MC_%s_%s_Buffer[(%s+sizeof(uint64_t) - 1)/sizeof(uint64_t)];\n' % (
+                cfg['name'], mp['name'], tsz))
+            C.write('static uint16_t MC_%s_%s_Next[%s];\n' % (
+                cfg['name'], mp['name'], number))
+        else:
+            tsz = eval(str(mp['size'])) * eval(str(mp['number']))
+            C.write('static uint32_t MC_%s_%s_Buffer[(%s+sizeof(uint32_t) - 1)/sizeof(uint32_t)];\n' % (
+                cfg['name'], mp['name'], tsz))
+    C.write('static const %smem_cluster_cfg_t MC_%sCfgs[] = {\n' % (lf, cfg['name']))
     for mp in mps:
         C.write('  {\n')
         C.write('    (uint8_t*)MC_%s_%s_Buffer,\n' % (cfg['name'], mp['name']))
+        if lf:
+            C.write('    MC_%s_%s_Next,\n' % (cfg['name'], mp['name']))
         C.write('    %s,\n' % (mp['size']))
         C.write('    %s,\n' % (mp['number']))
         C.write('  },\n')
     C.write('};\n\n')
-    C.write('static mempool_t MC_%sPools[%s];\n' % (
-        cfg['name'], len(mps)))
-    C.write('static const mem_cluster_t MC_%s = {\n' % (cfg['name']))
+    C.write('static %smempool_t MC_%sPools[%s];\n' % (
+        lf, cfg['name'], len(mps)))
+    C.write('#ifdef USE_MEMPOOL_STATS\n')
+    C.write('static mp_stats_t MC_%sStats[%s];\n' % (cfg['name'], len(mps)))
+    C.write('#endif\n')
+    C.write('static const %smem_cluster_t MC_%s = {\n' % (lf, cfg['name']))
     C.write('  MC_%sPools,\n' % (cfg['name']))
     C.write('  MC_%sCfgs,\n' % (cfg['name']))
     C.write('  %s,\n' % (len(mps)))
+    C.write('#ifdef USE_MEMPOOL_STATS\n')
+    C.write('  MC_%sStats,\n' % (cfg['name']))
+    C.write('#endif\n')
     C.write('};\n\n')
     C.write(
         '/* ================================ [ LOCALS    ] ============================================== */\n')
     C.write(
         '/* ================================ [ FUNCTIONS ] ============================================== */\n')
     C.write('void %s_MemInit(void) {\n' % (cfg['name']))
-    C.write('  mc_init(&MC_%s);\n' % (cfg['name']))
+    C.write('  %smc_init(&MC_%s);\n' % (lf, cfg['name']))
     C.write('};\n\n')
     C.write('uint8_t* %s_MemAlloc(uint32_t size) {\n' % (cfg['name']))
-    C.write('  return mc_alloc(&MC_%s, size);\n' % (cfg['name']))
+    C.write('  return %smc_alloc(&MC_%s, size);\n' % (lf, cfg['name']))
     C.write('};\n\n')
     C.write('uint8_t* %s_MemGet(uint32_t *size) {\n' % (cfg['name']))
-    C.write('  return mc_get(&MC_%s, size);\n' % (cfg['name']))
+    C.write('  return %smc_get(&MC_%s, size);\n' % (lf, cfg['name']))
     C.write('};\n\n')
     C.write('void %s_MemFree(uint8_t* buffer) {\n' % (cfg['name']))
-    C.write('  mc_free(&MC_%s, buffer);\n' % (cfg['name']))
+    C.write('  %smc_free(&MC_%s, buffer);\n' % (lf, cfg['name']))
     C.write('};\n\n')
+    C.write('#ifdef USE_MEMPOOL_STATS\n')
+    C.write('int %s_MemGetStats(uint16_t pool, mp_stats_t* stats) {\n' % (cfg['name']))
+    C.write('  return %smc_get_stats(&MC_%s, pool, stats);\n' % (lf, cfg['name']))
+    C.write('};\n\n')
+    C.write('void %s_MemResetStats(void) {\n' % (cfg['name']))
+    C.write('  %smc_reset_stats(&MC_%s);\n' % (lf, cfg['name']))
+    C.write('};\n')
+    C.write('#endif\n')
 
     C.close()
 
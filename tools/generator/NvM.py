@@ -110,6 +110,13 @@ def Gen_Ea(cfg, dir):
     C.write('#include "Ea_Priv.h"\n')
     C.write(
         '/* ================================ [ MACROS    ] ============================================== */\n')
+    End = 0
+    for block in cfg['blocks']:
+        End += int(((GetBlockSize(block)+2+3)/4))*4 * block.get('repeat', 1)
+    if End > 0xFFFF:
+        C.write('#ifndef EEP_ADDRESS_TYPE_U32\n')
+        C.write('#error "the blocks end at %s, EEP_ADDRESS_TYPE_U32 is required"\n' % (hex(End)))
+        C.write('#endif\n')
     C.write(
         '/* ================================ [ TYPES     ] ============================================== */\n')
     C.write(
@@ -10,6 +10,37 @@ HIGH_MODULES = ['Dcm']
 TP_MODULES = ['DoIP', 'CanTp', 'LinTp']
 LOW_MODULES = TP_MODULES + ['CanIf']
 
+API_FIELDS = ['StartOfReception', 'CopyRxData', 'TpRxIndication',
+              'Transmit', 'CopyTxData', 'TxConfirmation']
+
+
+def getApis(hasGW):
+    apis = {'Dcm': {'StartOfReception': 'Dcm_StartOfReception',
+                    'CopyRxData': 'Dcm_CopyRxData',
+                    'TpRxIndication': 'Dcm_TpRxIndication',
+                    'CopyTxData': 'Dcm_CopyTxData',
+                    'TxConfirmation': 'Dcm_TpTxConfirmation'},
+            'DoIP': {'Transmit': 'DoIP_TpTransmit'},
+            'CanTp': {'Transmit': 'CanTp_Transmit'}}
+    if hasGW:
+        for mod in ['DoIP', 'CanTp']:
+            apis[mod]['StartOfReception'] = 'PduR_%sGwStartOfReception' % (mod)
+            apis[mod]['CopyRxData'] = 'PduR_%sGwCopyRxData' % (mod)
+            apis[mod]['TpRxIndication'] = 'PduR_%sGwRxIndication' % (mod)
+            apis[mod]['CopyTxData'] = 'PduR_%sGwCopyTxData' % (mod)
+            apis[mod]['TxConfirmation'] = 'PduR_%sGwTxConfirmation' % (mod)
+    # the buffered routing paths, the PduR itself is the destination and the source
+    apis['PduR'] = {'StartOfReception': 'PduR_GwStartOfReception',
+                    'CopyRxData': 'PduR_GwCopyRxData',
+                    'TpRxIndication': 'PduR_GwRxIndication',
+                    'CopyTxData': 'PduR_GwCopyTxData',
+                    'TxConfirmation': 'PduR_GwTxConfirmation'}
+    return apis
+
+
+def getApi(apis, mod, api):
+    return apis.get(mod, {}).get(api, 'NULL')
+
 
 def getBaseId(groups, modsFrom=[], modsTo=[]):
     index = 0
@@ -29,11 +60,13 @@ def Gen_PduR(cfg, dir):
     groups = {}
     modules = []
     hasGW = False
+    routines = {}
     for rt in cfg['routines']:
         fr = rt['from']
         to = rt['to']
         if fr in TP_MODULES and to in TP_MODULES:
             hasGW = True
+        routines[rt['name']] = rt
         if fr not in groups:
             groups[fr] = {'high': {}, 'low': {}}
         if to in HIGH_MODULES:
@@ -48,6 +81,30 @@ def Gen_PduR(cfg, dir):
             modules.append(fr)
         if to not in modules:
             modules.append(to)
+    # a routine with "fanout" is one more destination of the named primary routine, the
+    # received data is shared by all the destinations of the primary
+    fanouts = {}
+    for rt in cfg['routines']:
+        if 'fanout' in rt:
+            primary = routines.get(rt['fanout'], None)
+            if primary is None or 'fanout' in primary or primary['from'] != rt['from']:
+                raise Exception('invalid fanout %s of routine %s' % (rt['fanout'], rt['name']))
+            if primary['name'] not in fanouts:
+                fanouts[primary['name']] = []
+            fanouts[primary['name']].append(rt)
+            hasGW = True
+    pathIds = {}
+    for fr, grphls in groups.items():
+        for hl, grptos in grphls.items():
+            for to, rts in grptos.items():
+                for rt in rts:
+                    pathIds[rt['name']] = len(pathIds)
+
+    def isBuffered(rt):
+        if rt['from'] in TP_MODULES and rt['to'] in TP_MODULES:
+            return True
+        return (rt['name'] in fanouts) or ('fanout' in rt)
+    apis = getApis(hasGW)
     H = open('%s/PduR_Cfg.h' % (dir), 'w')
     GenHeader(H)
     H.write('#ifndef PDUR_CFG_H\n')
@@ -99,50 +156,15 @@ def Gen_PduR(cfg, dir):
         '/* ================================ [ DECLARES  ] ============================================== */\n')
     C.write(
         '/* ================================ [ DATAS     ] ============================================== */\n')
-    if 'Dcm' in modules:
-        C.write('const PduR_ApiType PduR_DcmApi = {\n')
-        C.write('  Dcm_StartOfReception,\n')
-        C.write('  Dcm_CopyRxData,\n')
-        C.write('  { Dcm_TpRxIndication },\n')
-        C.write('  NULL,\n')
-        C.write('  Dcm_CopyTxData,\n')
-        C.write('  Dcm_TpTxConfirmation,\n')
-        C.write('};\n\n')
-    if 'DoIP' in modules:
-        C.write('const PduR_ApiType PduR_DoIPApi = {\n')
-        if(hasGW):
-            C.write('  PduR_DoIPGwStartOfReception,\n')
-            C.write('  PduR_DoIPGwCopyRxData,\n')
-            C.write('  { PduR_DoIPGwRxIndication },\n')
-        else:
-            C.write('  NULL,\n')
-            C.write('  NULL,\n')
-            C.write('  { NULL },\n')
-        C.write('  DoIP_TpTransmit,\n')
-        if(hasGW):
-            C.write('  PduR_DoIPGwCopyTxData,\n')
-            C.write('  PduR_DoIPGwTxConfirmation,\n')
-        else:
-            C.write('  NULL,\n')
-            C.write('  NULL,\n')
-        C.write('};\n\n')
-    if 'CanTp' in modules:
-        C.write('const PduR_ApiType PduR_CanTpApi = {\n')
-        if(hasGW):
-            C.write('  PduR_CanTpGwStartOfReception,\n')
-            C.write('  PduR_CanTpGwCopyRxData,\n')
-            C.write('  {PduR_CanTpGwRxIndication},\n')
-        else:
-            C.write('  NULL,\n')
-            C.write('  NULL,\n')
-            C.write('  { NULL },\n')
-        C.write('  CanTp_Transmit,\n')
-        if(hasGW):
-            C.write('  PduR_CanTpGwCopyTxData,\n')
-            C.write('  PduR_CanTpGwTxConfirmation,\n')
-        else:
-            C.write('  NULL,\n')
-            C.write('  NULL,\n')
+    for mod in ['Dcm', 'DoIP', 'CanTp']:
+        if mod not in modules:
+            continue
+        C.write('const PduR_ApiType PduR_%sApi = {\n' % (mod))
+        for api in API_FIELDS:
+            if api == 'TpRxIndication':
+                C.write('  { %s },\n' % (getApi(apis, mod, api)))
+            else:
+                C.write('  %s,\n' % (getApi(apis, mod, api)))
         C.write('};\n\n')
     for rt in cfg['routines']:
         fr, to, name = rt['from'], rt['to'], rt['name']
@@ -155,15 +177,22 @@ def Gen_PduR(cfg, dir):
 
         C.write(
             'static const PduR_PduType PduR_DstPdu_%s_%s_%s[]={\n' % (fr, to, name))
-        C.write('  {\n')
-        C.write('    PDUR_MODULE_%s,\n' % (to.upper()))
-        C.write('    %s_%s,\n' % (to.upper(), name))
-        C.write('    &PduR_%sApi,\n' % (to))
-        C.write('  },\n')
+        for dst in [rt] + fanouts.get(name, []):
+            C.write('  {\n')
+            C.write('    PDUR_MODULE_%s,\n' % (dst['to'].upper()))
+            C.write('    %s_%s,\n' % (dst['to'].upper(), dst['name']))
+            C.write('    &PduR_%sApi,\n' % (dst['to']))
+            C.write('  },\n')
         C.write('};\n\n')
-        if fr in TP_MODULES and to in TP_MODULES:
-            C.write(
-                'static PduR_BufferType PduR_Buffer_%s = { NULL, 0, 0 };\n' % (name))
+        if name in fanouts:
+            C.write('static const PduIdType PduR_FanOut_%s[] = {%s};\n\n' %
+                    (name, ', '.join(['%s' % (pathIds[dst['name']]) for dst in [rt] + fanouts[name]])))
+    # the buffer owners go first as the fan-out legs refer to them
+    for rt in [rt for rt in cfg['routines'] if 'fanout' not in rt] + \
+            [rt for rt in cfg['routines'] if 'fanout' in rt]:
+        if isBuffered(rt):
+            C.write('static PduR_BufferType PduR_Buffer_%s = { NULL, 0, 0, 0, &PduR_Buffer_%s };\n' %
+                    (rt['name'], rt.get('fanout', rt['name'])))
     C.write('static const PduR_RoutingPathType PduR_RoutingPaths[] = {\n')
     index = 0
     for fr, grphls in groups.items():
@@ -177,10 +206,28 @@ def Gen_PduR(cfg, dir):
                     C.write('    PduR_DstPdu_%s_%s_%s,\n' % (fr, to, name))
                     C.write('    ARRAY_SIZE(PduR_DstPdu_%s_%s_%s),\n' %
                             (fr, to, name))
-                    if fr in TP_MODULES and to in TP_MODULES:
-                        C.write('  &PduR_Buffer_%s,\n' % (name))
+                    if isBuffered(rt):
+                        C.write('    &PduR_Buffer_%s,\n' % (name))
+                        dstId = srcId = index
+                        rxMod = txMod = 'PduR'
+                    else:
+                        C.write('    NULL,\n')
+                        dstId = '%s_%s' % (to.upper(), name)
+                        srcId = '%s_%s' % (fr.upper(), name)
+                        rxMod, txMod = to, fr
+                    C.write('    { /* dispatch */\n')
+                    C.write('      %s,\n' % (dstId))
+                    C.write('      %s,\n' % (srcId))
+                    C.write('      %s,\n' % (getApi(apis, to, 'Transmit')))
+                    for api in ['StartOfReception', 'CopyRxData', 'TpRxIndication']:
+                        C.write('      %s,\n' % (getApi(apis, rxMod, api)))
+                    for api in ['CopyTxData', 'TxConfirmation']:
+                        C.write('      %s,\n' % (getApi(apis, txMod, api)))
+                    C.write('    },\n')
+                    if name in fanouts:
+                        C.write('    PduR_FanOut_%s,\n' % (name))
                     else:
-                        C.write('  NULL,\n')
+                        C.write('    NULL,\n')
                     C.write('  },\n')
                     index += 1
     C.write('};\n\n')
@@ -5,11 +5,14 @@ import os
 from .helper import *
 
 
-def Gen_Sock(C, RxPduId, SoConId, GID, isGroup):
+def Gen_Sock(C, RxPduId, SoConId, GID, isGroup, rxRing='NULL'):
     C.write('  {\n')
     C.write('#ifdef DISABLE_NET_MEM\n')
     C.write('    SoAd_RxBuf,           /* rxBuf */\n')
     C.write('#endif\n')
+    C.write('#ifdef SOAD_USE_RX_RING\n')
+    C.write('    %s, /* rxRing */\n' % (rxRing))
+    C.write('#endif\n')
     C.write('    %s,      /* RxPduId */\n' % (RxPduId))
     C.write('    %s, /* SoConId */\n' % (SoConId))
     C.write('#ifdef DISABLE_NET_MEM\n')
@@ -138,23 +141,36 @@ def Gen_SoAd(cfg, dir):
     C.write('static uint8_t SoAd_RxBuf[1400];\n')
     C.write('#endif\n\n')
 
+    C.write('#ifdef SOAD_USE_RX_RING\n')
+    for sock in cfg['sockets']:
+        if (sock['protocol'] == 'UDP') or ('client' in sock):
+            C.write('static SoAd_RxRingType SoAd_RxRing_%s;\n' % (sock['name']))
+        elif 'server' in sock:
+            for i in range(sock['listen']):
+                C.write('static SoAd_RxRingType SoAd_RxRing_%s_APT%s;\n' % (sock['name'], i))
+    C.write('#endif\n\n')
+
     C.write(
         'static const SoAd_SocketConnectionType SoAd_SocketConnections[] = {\n')
     for GID, sock in enumerate(cfg['sockets']):
         RxPduId = sock['RxPduId']
+        rxRing = 'NULL'
         if sock['protocol'] == 'UDP':
             SoConId = 'SOAD_SOCKID_%s' % (sock['name'])
+            rxRing = '&SoAd_RxRing_%s' % (sock['name'])
         elif 'server' in sock:
             SoConId = 'SOAD_SOCKID_%s_SERVER' % (sock['name'])
             RxPduId = -1
         elif 'client' in sock:
             SoConId = 'SOAD_SOCKID_%s' % (sock['name'])
-        Gen_Sock(C, RxPduId, SoConId, GID, True)
+            rxRing = '&SoAd_RxRing_%s' % (sock['name'])
+        Gen_Sock(C, RxPduId, SoConId, GID, True, rxRing)
         if ('server' in sock) and (sock['protocol'] == 'TCP'):
             for i in range(sock['listen']):
                 RxPduId = '%s%s' % (sock['RxPduId'], i)
                 SoConId = 'SOAD_SOCKID_%s_APT%s' % (sock['name'], i)
-                Gen_Sock(C, RxPduId, SoConId, GID, False)
+                rxRing = '&SoAd_RxRing_%s_APT%s' % (sock['name'], i)
+                Gen_Sock(C, RxPduId, SoConId, GID, False, rxRing)
     C.write('};\n\n')
 
     C.write(
@@ -5,16 +5,26 @@ import os
 from .helper import *
 
 
+def Gen_IndexTable(C, name, ids):
+    # sorted by ID for the binary search, the position in the array breaks the tie
+    C.write('static const SomeIp_IndexType %s[] = {\n' % (name))
+    for id, index in sorted([(int(str(id), 0), i) for i, id in enumerate(ids)]):
+        C.write('  {%s, %s},\n' % (hex(id), index))
+    C.write("};\n\n")
+
+
 def Gen_MethodRxTxTp(C, service, method):
     C.write('Std_ReturnType SomeIp_%s_%s_OnTpCopyRxData(uint16_t conId, SomeIp_TpMessageType *msg) {\n' % (
         service['name'], method['name']))
     C.write('  Std_ReturnType ret = E_OK;\n')
-    C.write('  if ((msg->offset + msg->length) < sizeof(%s_%sTpRxBuf)) {\n' % (
+    C.write('  if ((msg->slot < ARRAY_SIZE(%s_%sTpRxBuf)) &&\n' % (
         service['name'], method['name']))
-    C.write('    memcpy(&%s_%sTpRxBuf[msg->offset], msg->data, msg->length);\n' % (
+    C.write('      ((msg->offset + msg->length) <= sizeof(%s_%sTpRxBuf[0]))) {\n' % (
+        service['name'], method['name']))
+    C.write('    memcpy(&%s_%sTpRxBuf[msg->slot][msg->offset], msg->data, msg->length);\n' % (
         service['name'], method['name']))
     C.write('    if (FALSE == msg->moreSegmentsFlag) {\n')
-    C.write('      msg->data = %s_%sTpRxBuf;\n' %
+    C.write('      msg->data = %s_%sTpRxBuf[msg->slot];\n' %
             (service['name'], method['name']))
     C.write('    }\n')
     C.write('  } else {\n')
@@ -61,7 +71,7 @@ def Gen_ServerService(service, dir):
                 (service['name'], method['name']))
         H.write('Std_ReturnType SomeIp_%s_%s_OnFireForgot(uint16_t conId, SomeIp_MessageType* res);\n' %
                 (service['name'], method['name']))
-        H.write('Std_ReturnType SomeIp_%s_%s_OnAsyncRequest(uint16_t conId, SomeIp_MessageType* res);\n' %
+        H.write('Std_ReturnType SomeIp_%s_%s_OnAsyncRequest(uint16_t conId, SomeIp_MessageType* req, SomeIp_MessageType* res);\n' %
                 (service['name'], method['name']))
         if method.get('tp', False):
             H.write('Std_ReturnType SomeIp_%s_%s_OnTpCopyRxData(uint16_t conId, SomeIp_TpMessageType *msg);\n' %
@@ -89,8 +99,10 @@ def Gen_ServerService(service, dir):
         '/* ================================ [ DATAS     ] ============================================== */\n')
     for method in service['methods']:
         if method.get('tp', False):
-            C.write('static uint8_t %s_%sTpRxBuf[%d];\n' % (
-                service['name'], method['name'], method.get('tpRxSize', 1*1024*1024)))
+            # one buffer per concurrent RX session of the method
+            C.write('static uint8_t %s_%sTpRxBuf[%d][%d];\n' % (
+                service['name'], method['name'], method.get('tpRxSessions', 2),
+                method.get('tpRxSize', 1*1024*1024)))
             C.write('static uint8_t %s_%sTpTxBuf[%d];\n' % (
                 service['name'], method['name'], method.get('tpTxSize', 1*1024*1024)))
     C.write(
@@ -124,7 +136,7 @@ def Gen_ServerService(service, dir):
             '                 req->data[0], req->data[1], req->data[2], req->data[3]));\n')
         C.write('  return E_OK;\n')
         C.write('}\n\n')
-        C.write('Std_ReturnType SomeIp_%s_%s_OnAsyncRequest(uint16_t conId, SomeIp_MessageType* res) {\n' %
+        C.write('Std_ReturnType SomeIp_%s_%s_OnAsyncRequest(uint16_t conId, SomeIp_MessageType* req, SomeIp_MessageType* res) {\n' %
                 (service['name'], method['name']))
         C.write('  return E_OK;\n')
         C.write('}\n\n')
@@ -190,8 +202,10 @@ def Gen_ClientService(service, dir):
         '/* ================================ [ DATAS     ] ============================================== */\n')
     for method in service['methods']:
         if method.get('tp', False):
-            C.write('static uint8_t %s_%sTpRxBuf[%d];\n' % (
-                service['name'], method['name'], method.get('tpRxSize', 1*1024*1024)))
+            # one buffer per concurrent RX session of the method
+            C.write('static uint8_t %s_%sTpRxBuf[%d][%d];\n' % (
+                service['name'], method['name'], method.get('tpRxSessions', 2),
+                method.get('tpRxSize', 1*1024*1024)))
             C.write('static uint8_t %s_%sTpTxBuf[%d];\n' % (
                 service['name'], method['name'], method.get('tpTxSize', 1*1024*1024)))
     C.write(
@@ -344,8 +358,17 @@ def Gen_SD(cfg, dir):
         C.write('static Sd_EventHandlerContextType Sd_EventHandlerContext_%s[%d];\n' % (
             service['name'], len(service['event-groups'])))
         for ge in service['event-groups']:
-            C.write('static Sd_EventHandlerSubscriberType Sd_EventHandlerSubscriber_%s_%s[3];\n' % (
-                service['name'], ge['name']))
+            maxSubscribers = ge.get('max-subscribers', 3)
+            # SomeIp tracks the subscribers to retry an event in a 32 bit mask
+            assert maxSubscribers <= 32, 'event group %s of %s has more than 32 subscribers' % (
+                ge['name'], service['name'])
+            C.write('static Sd_EventHandlerSubscriberType Sd_EventHandlerSubscriber_%s_%s[%s];\n' % (
+                service['name'], ge['name'], maxSubscribers))
+            if 'multicast' in ge:
+                # "224.244.224.245:30499"
+                ip, port = ge['multicast'].split(':')
+                C.write('static const TcpIp_SockAddrType Sd_EventHandlerMulticast_%s_%s = {%s, {%s}};\n' % (
+                    service['name'], ge['name'], port, ip.replace('.', ', ')))
         C.write('static const Sd_EventHandlerType Sd_EventHandlers_%s[] = {\n' % (
             service['name']))
         for ID, ge in enumerate(service['event-groups']):
@@ -353,7 +376,14 @@ def Gen_SD(cfg, dir):
             C.write('    SD_EVENT_HANDLER_%s_%s, /* HandleId */\n' %
                     (service['name'].upper(), ge['name'].upper()))
             C.write('    %s, /* EventGroupId */\n' % (ge['groupId']))
-            C.write('    0, /* MulticastThreshold */\n')
+            if 'multicast' in ge:
+                C.write('    %s, /* MulticastThreshold */\n' %
+                        (ge.get('multicast-threshold', 1)))
+                C.write('    &Sd_EventHandlerMulticast_%s_%s, /* MulticastAddr */\n' % (
+                    service['name'], ge['name']))
+            else:
+                C.write('    0, /* MulticastThreshold */\n')
+                C.write('    NULL, /* MulticastAddr */\n')
             C.write('    &Sd_EventHandlerContext_%s[%d],\n' % (
                 service['name'], ID))
             C.write('    Sd_EventHandlerSubscriber_%s_%s,\n' % (
@@ -476,6 +506,7 @@ def Gen_SD(cfg, dir):
     C.write('    sd_buffer,                     /*buffer */\n')
     C.write('    sizeof(sd_buffer),\n')
     C.write('    &sd_context,\n')
+    C.write('    %s, /* MulticastBudget */\n' % (cfg['SD'].get('multicast_budget', 0)))
     C.write('  },\n')
     C.write('};\n\n')
     C.write('static const Sd_ServerServiceType* Sd_ServerServicesMap[] = {\n')
@@ -684,11 +715,17 @@ def Gen_SOMEIP(cfg, dir):
             C.write('    %s /* resMaxLen */\n' % (resMaxLen))
             C.write('  },\n')
         C.write("};\n\n")
+        Gen_IndexTable(C, 'someIpServerMethodIndex_%s' % (service['name']),
+                       [method['methodId'] for method in service['methods']])
     for service in cfg['servers']:
         if 'event-groups' not in service:
             continue
+        numOfEvents = sum([len(egroup['events']) for egroup in service['event-groups']])
+        C.write('static SomeIp_ServerEventContextType someIpServerEventContext_%s[%s];\n\n' % (
+            service['name'], numOfEvents))
         C.write('static const SomeIp_ServerEventType someIpServerEvents_%s[] = {\n' % (
             service['name']))
+        ID = 0
         for egroup in service['event-groups']:
             for event in egroup['events']:
                 C.write('  {\n')
@@ -697,7 +734,9 @@ def Gen_SOMEIP(cfg, dir):
                 C.write('    %s, /* Event ID */\n' % (event['eventId']))
                 C.write('    %s, /* interface version */\n' %
                         (event['version']))
+                C.write('    &someIpServerEventContext_%s[%s],\n' % (service['name'], ID))
                 C.write('  },\n')
+                ID += 1
         C.write("};\n\n")
     for service in cfg['clients']:
         if 'methods' not in service:
@@ -720,6 +759,8 @@ def Gen_SOMEIP(cfg, dir):
                 C.write('    NULL,\n')
             C.write('  },\n')
         C.write("};\n\n")
+        Gen_IndexTable(C, 'someIpClientMethodIndex_%s' % (service['name']),
+                       [method['methodId'] for method in service['methods']])
     for service in cfg['clients']:
         if 'event-groups' not in service:
             continue
@@ -735,6 +776,8 @@ def Gen_SOMEIP(cfg, dir):
                     service['name'], egroup['name'], event['name']))
                 C.write('  },\n')
         C.write("};\n\n")
+        Gen_IndexTable(C, 'someIpClientEventIndex_%s' % (service['name']),
+                       [event['eventId'] for egroup in service['event-groups'] for event in egroup['events']])
     for service in cfg['servers']:
         if 'reliable' in service:
             numOfConnections = service['listen'] if 'listen' in service else 3
@@ -784,6 +827,10 @@ def Gen_SOMEIP(cfg, dir):
         C.write('  someIpServerServiceConnections_%s,\n' % (service['name']))
         C.write('  ARRAY_SIZE(someIpServerServiceConnections_%s),\n' %
                 (service['name']))
+        if 'methods' not in service:
+            C.write('  NULL, /* methodIndex */\n')
+        else:
+            C.write('  someIpServerMethodIndex_%s,\n' % (service['name']))
         C.write('};\n\n')
     for service in cfg['clients']:
         if 'reliable' in service:
@@ -817,6 +864,14 @@ def Gen_SOMEIP(cfg, dir):
             C.write('  &someIpTcpBuffer_%s,\n' % (service['name']))
         else:
             C.write('  NULL,\n')
+        if 'methods' not in service:
+            C.write('  NULL, /* methodIndex */\n')
+        else:
+            C.write('  someIpClientMethodIndex_%s,\n' % (service['name']))
+        if 'event-groups' not in service:
+            C.write('  NULL, /* eventIndex */\n')
+        else:
+            C.write('  someIpClientEventIndex_%s,\n' % (service['name']))
         C.write('};\n\n')
     C.write('static const SomeIp_ServiceType SomeIp_Services[] = {\n')
     for service in cfg['servers']:
@@ -13,6 +13,11 @@
 #include <sys/ioctl.h>
 #include <sys/socket.h>
 #endif
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/uio.h>
+#include <time.h>
+#endif
 #include <assert.h>
 #include <errno.h>
 #include <pthread.h>
@@ -85,6 +90,20 @@
 #endif
 
 //#define USE_RX_DAEMON
+
+#ifdef __linux__
+/* frames kept for the slowest node, a node lagging further behind loses the oldest ones */
+#ifndef CAN_SIM_RING_SIZE
+#define CAN_SIM_RING_SIZE 4096
+#endif
+/* frames waiting for the log thread, the log drops frames rather than slowing down the bus */
+#ifndef CAN_SIM_LOG_SIZE
+#define CAN_SIM_LOG_SIZE 4096
+#endif
+#define CAN_SIM_IOV_MAX 64
+#define CAN_SIM_RX_FRAMES 32
+#define CAN_SIM_REPORT_PERIOD 10 /* seconds */
+#endif
 /* ================================ [ TYPES     ] ============================================== */
 /**
  * struct can_frame - basic CAN frame structure
@@ -125,6 +144,40 @@ struct Can_Filter_s {
 struct Can_FilterList_s {
   STAILQ_HEAD(, Can_Filter_s) head;
 };
+
+#ifdef __linux__
+struct Can_SimMeta_s {
+  uint64_t timestamp; /* CLOCK_MONOTONIC us when received */
+  int origin;         /* node that sent it, it is not echoed back */
+};
+
+struct Can_SimNode_s {
+  int s;
+  int id;
+  int pollout;
+  uint64_t cursor; /* sequence number of the next frame of the ring to send */
+  uint64_t dropped;
+  /* tail of a frame that was only partially sent, the ring slot may be reused meanwhile */
+  uint8_t partial[CAN_MTU];
+  uint32_t partialLen;
+  uint32_t rxLen;
+  uint8_t rxBuf[CAN_MTU * CAN_SIM_RX_FRAMES];
+};
+
+struct Can_SimLog_s {
+  struct can_frame frame;
+  uint64_t timestamp;
+};
+
+struct Can_SimStats_s {
+  uint64_t rxFrames;
+  uint64_t txFrames;
+  uint64_t latencySum;
+  uint64_t latencyMax;
+  uint64_t dropped;
+  uint64_t logDropped;
+};
+#endif
 /* ================================ [ DECLARES  ] ============================================== */
 /* ================================ [ DATAS     ] ============================================== */
 static struct Can_SocketHandleList_s *socketH = NULL;
@@ -133,6 +186,24 @@ static pthread_mutex_t socketLock = PTHREAD_MUTEX_INITIALIZER;
 #endif
 static struct timeval m0;
 static struct Can_FilterList_s *canFilterH = NULL;
+#ifdef __linux__
+static int simEpoll = -1;
+static struct Can_SimNode_s *simNodes[CAN_BUS_NODE_MAX];
+/* every received frame is stored once, each node sends from its own cursor */
+static struct can_frame simFrames[CAN_SIM_RING_SIZE];
+static struct Can_SimMeta_s simMeta[CAN_SIM_RING_SIZE];
+static uint64_t simHead = 0;
+static struct Can_SimStats_s simStats;
+static uint64_t simT0;
+static int simReportPeriod = CAN_SIM_REPORT_PERIOD;
+
+static int simLogEnabled = TRUE;
+static struct Can_SimLog_s simLog[CAN_SIM_LOG_SIZE];
+static uint64_t simLogW = 0; /* written by the bus thread only */
+static uint64_t simLogR = 0; /* written by the log thread only */
+static pthread_mutex_t simLogLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t simLogCond = PTHREAD_COND_INITIALIZER;
+#endif
 /* ================================ [ LOCALS    ] ============================================== */
 #ifdef _WIN32
 #else
@@ -206,6 +277,7 @@ static int init_socket(int port) {
 
   return TRUE;
 }
+#ifndef __linux__
 static void try_accept(void) {
   struct Can_SocketHandle_s *handle;
   /* struct timeval tv; */
@@ -262,15 +334,9 @@ static void remove_socket(struct Can_SocketHandle_s *h) {
   closesocket(h->s);
   free(h);
 }
-static void log_msg(struct can_frame *frame, float rtim) {
+#endif
+static int log_filter(struct can_frame *frame) {
   int bOut = FALSE;
-  static float lastTime = -1;
-  int nSame = 0;
-
-  if (-1 == lastTime) {
-    lastTime = rtim;
-  }
-
   struct Can_Filter_s *filter;
 
   if (NULL == canFilterH) {
@@ -283,7 +349,17 @@ static void log_msg(struct can_frame *frame, float rtim) {
     }
   }
 
-  if (bOut) {
+  return bOut;
+}
+static void log_msg(struct can_frame *frame, float rtim) {
+  static float lastTime = -1;
+  int nSame = 0;
+
+  if (-1 == lastTime) {
+    lastTime = rtim;
+  }
+
+  if (log_filter(frame)) {
     int i;
     int dlc;
     printf("canid=%08X,dlc=%02d,data=[", mCANID(frame), mCANDLC(frame));
@@ -337,6 +413,7 @@ static void log_msg(struct can_frame *frame, float rtim) {
     lastTime = rtim;
   }
 }
+#ifndef __linux__
 static void try_recv_forward(void) {
   int len;
   struct can_frame frame;
@@ -409,6 +486,360 @@ static void schedule(void) {
 #endif
   try_recv_forward();
 }
+#else
+static uint64_t sim_now(void) {
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static void *sim_log_daemon(void *param) {
+  uint64_t r = 0;
+  struct Can_SimLog_s *log;
+  (void)param;
+
+  for (;;) {
+    pthread_mutex_lock(&simLogLock);
+    while (r == __atomic_load_n(&simLogW, __ATOMIC_ACQUIRE)) {
+      pthread_cond_wait(&simLogCond, &simLogLock);
+    }
+    pthread_mutex_unlock(&simLogLock);
+    while (r != __atomic_load_n(&simLogW, __ATOMIC_ACQUIRE)) {
+      log = &simLog[r & (CAN_SIM_LOG_SIZE - 1)];
+      flockfile(stdout); /* keep the report of the bus thread out of the line */
+      log_msg(&log->frame, (float)(log->timestamp - simT0) / 1000000.0);
+      funlockfile(stdout);
+      r++;
+      __atomic_store_n(&simLogR, r, __ATOMIC_RELEASE);
+    }
+    fflush(stdout);
+  }
+
+  return NULL;
+}
+
+static void sim_log(struct can_frame *frame, uint64_t timestamp) {
+  struct Can_SimLog_s *log;
+
+  if (log_filter(frame)) {
+    if ((simLogW - __atomic_load_n(&simLogR, __ATOMIC_ACQUIRE)) >= CAN_SIM_LOG_SIZE) {
+      simStats.logDropped++;
+    } else {
+      log = &simLog[simLogW & (CAN_SIM_LOG_SIZE - 1)];
+      memcpy(&log->frame, frame, CAN_MTU);
+      log->timestamp = timestamp;
+      __atomic_store_n(&simLogW, simLogW + 1, __ATOMIC_RELEASE);
+    }
+  }
+}
+
+static void sim_log_notify(void) {
+  /* once per batch of frames, the waiter checks simLogW under the same lock */
+  pthread_mutex_lock(&simLogLock);
+  pthread_cond_signal(&simLogCond);
+  pthread_mutex_unlock(&simLogLock);
+}
+
+static void sim_accept(void) {
+  struct Can_SimNode_s *node;
+  struct epoll_event ev;
+  int s;
+  int id;
+  int iMode = 1;
+
+  while ((s = accept(socketH->s, NULL, NULL)) >= 0) {
+    ioctl(s, FIONBIO, (char *)&iMode);
+    for (id = 0; (id < CAN_BUS_NODE_MAX) && (NULL != simNodes[id]); id++) {
+    }
+    node = NULL;
+    if (id < CAN_BUS_NODE_MAX) {
+      node = malloc(sizeof(struct Can_SimNode_s));
+    }
+    if (NULL == node) {
+      printf("can socket %X rejected, too many nodes!\n", s);
+      closesocket(s);
+      continue;
+    }
+    memset(node, 0, sizeof(struct Can_SimNode_s));
+    node->s = s;
+    node->id = id;
+    node->cursor = simHead; /* only frames sent from now on */
+    ev.events = EPOLLIN;
+    ev.data.ptr = node;
+    if (0 != epoll_ctl(simEpoll, EPOLL_CTL_ADD, s, &ev)) {
+      printf("epoll add failed with error: %d\n", WSAGetLastError());
+      closesocket(s);
+      free(node);
+      continue;
+    }
+    simNodes[id] = node;
+    printf("can socket %X on-line!\n", s);
+  }
+}
+
+/* the node is freed by sim_reap once no event of the current batch can refer to it anymore */
+static void sim_close(struct Can_SimNode_s *node, const char *reason) {
+  if (node->s >= 0) {
+    printf("%s failed with error: %d, remove this node %X!\n", reason, errno, node->s);
+    (void)epoll_ctl(simEpoll, EPOLL_CTL_DEL, node->s, NULL);
+    closesocket(node->s);
+    node->s = -1;
+  }
+}
+
+static void sim_reap(void) {
+  int id;
+
+  for (id = 0; id < CAN_BUS_NODE_MAX; id++) {
+    if ((NULL != simNodes[id]) && (simNodes[id]->s < 0)) {
+      free(simNodes[id]);
+      simNodes[id] = NULL;
+    }
+  }
+}
+
+static void sim_recv(struct Can_SimNode_s *node) {
+  ssize_t len;
+  uint32_t offset = 0;
+  uint32_t idx;
+  uint64_t now;
+
+  len = recv(node->s, node->rxBuf + node->rxLen, sizeof(node->rxBuf) - node->rxLen, 0);
+  if (len > 0) {
+    node->rxLen += (uint32_t)len;
+    now = sim_now();
+    while ((node->rxLen - offset) >= CAN_MTU) {
+      idx = simHead & (CAN_SIM_RING_SIZE - 1);
+      memcpy(&simFrames[idx], &node->rxBuf[offset], CAN_MTU);
+      simMeta[idx].timestamp = now;
+      simMeta[idx].origin = node->id;
+      simHead++;
+      simStats.rxFrames++;
+      if (simLogEnabled) {
+        sim_log(&simFrames[idx], now);
+      }
+      offset += CAN_MTU;
+    }
+    node->rxLen -= offset;
+    if (node->rxLen > 0) {
+      memmove(node->rxBuf, &node->rxBuf[offset], node->rxLen);
+    }
+  } else if (0 == len) {
+    errno = ECONNRESET;
+    sim_close(node, "recv");
+  } else if ((EAGAIN != errno) && (EINTR != errno)) {
+    sim_close(node, "recv");
+  } else {
+    /* Resource temporarily unavailable. */
+  }
+}
+
+/* account what writev sent, return FALSE when the kernel buffer of the node is full */
+static int sim_consume(struct Can_SimNode_s *node, size_t len, uint64_t now) {
+  uint32_t idx;
+  uint64_t latency;
+  size_t sz;
+
+  if (node->partialLen > 0) {
+    sz = (len < node->partialLen) ? len : node->partialLen;
+    node->partialLen -= (uint32_t)sz;
+    memmove(node->partial, &node->partial[sz], node->partialLen);
+    len -= sz;
+  }
+
+  while ((0 == node->partialLen) && (node->cursor != simHead)) {
+    idx = node->cursor & (CAN_SIM_RING_SIZE - 1);
+    if (simMeta[idx].origin == node->id) {
+      node->cursor++;
+    } else if (len >= CAN_MTU) {
+      latency = now - simMeta[idx].timestamp;
+      simStats.txFrames++;
+      simStats.latencySum += latency;
+      if (latency > simStats.latencyMax) {
+        simStats.latencyMax = latency;
+      }
+      len -= CAN_MTU;
+      node->cursor++;
+    } else if (len > 0) {
+      node->partialLen = CAN_MTU - (uint32_t)len;
+      memcpy(node->partial, &((uint8_t *)&simFrames[idx])[len], node->partialLen);
+      len = 0;
+      node->cursor++;
+    } else {
+      break;
+    }
+  }
+
+  return (0 == node->partialLen) && (node->cursor == simHead);
+}
+
+/* send the frames of the other nodes in batches, return TRUE when nothing is left */
+static int sim_flush(struct Can_SimNode_s *node) {
+  struct iovec iov[CAN_SIM_IOV_MAX];
+  int n;
+  uint64_t seq;
+  uint32_t idx;
+  ssize_t len;
+  int done = FALSE;
+
+  if ((simHead - node->cursor) > CAN_SIM_RING_SIZE) {
+    node->dropped += simHead - node->cursor - CAN_SIM_RING_SIZE;
+    simStats.dropped += simHead - node->cursor - CAN_SIM_RING_SIZE;
+    node->cursor = simHead - CAN_SIM_RING_SIZE;
+  }
+
+  while ((FALSE == done) && (node->s >= 0)) {
+    n = 0;
+    if (node->partialLen > 0) {
+      iov[n].iov_base = node->partial;
+      iov[n].iov_len = node->partialLen;
+      n++;
+    }
+    for (seq = node->cursor; (seq != simHead) && (n < CAN_SIM_IOV_MAX); seq++) {
+      idx = seq & (CAN_SIM_RING_SIZE - 1);
+      if (simMeta[idx].origin == node->id) {
+        continue;
+      }
+      if ((n > 0) && (((uint8_t *)iov[n - 1].iov_base + iov[n - 1].iov_len) ==
+                      (uint8_t *)&simFrames[idx])) {
+        iov[n - 1].iov_len += CAN_MTU;
+      } else {
+        iov[n].iov_base = &simFrames[idx];
+        iov[n].iov_len = CAN_MTU;
+        n++;
+      }
+    }
+    if (0 == n) {
+      node->cursor = simHead; /* only its own frames were pending */
+      done = TRUE;
+    } else {
+      len = writev(node->s, iov, n);
+      if (len > 0) {
+        done = sim_consume(node, (size_t)len, sim_now());
+      } else if ((len < 0) && (EINTR == errno)) {
+      } else if ((len < 0) && (EAGAIN == errno)) {
+        break;
+      } else {
+        sim_close(node, "send");
+      }
+    }
+  }
+
+  return done;
+}
+
+static void sim_pollout(struct Can_SimNode_s *node, int pollout) {
+  struct epoll_event ev;
+
+  if ((node->s >= 0) && (pollout != node->pollout)) {
+    ev.events = EPOLLIN | (pollout ? EPOLLOUT : 0);
+    ev.data.ptr = node;
+    if (0 == epoll_ctl(simEpoll, EPOLL_CTL_MOD, node->s, &ev)) {
+      node->pollout = pollout;
+    } else {
+      sim_close(node, "epoll");
+    }
+  }
+}
+
+static void sim_report(uint64_t elapsed) {
+  int id;
+  int nodes = 0;
+
+  for (id = 0; id < CAN_BUS_NODE_MAX; id++) {
+    if (NULL != simNodes[id]) {
+      nodes++;
+    }
+  }
+  printf("can bus: %d nodes, rx %.0f frames/s, tx %.0f frames/s, latency avg %.1f max %u us, "
+         "dropped %u, log dropped %u\n",
+         nodes, (double)simStats.rxFrames * 1000000.0 / elapsed,
+         (double)simStats.txFrames * 1000000.0 / elapsed,
+         simStats.txFrames ? (double)simStats.latencySum / simStats.txFrames : 0.0,
+         (uint32_t)simStats.latencyMax, (uint32_t)simStats.dropped,
+         (uint32_t)simStats.logDropped);
+  fflush(stdout);
+}
+
+static int sim_run(void) {
+  struct epoll_event events[CAN_BUS_NODE_MAX + 1];
+  struct epoll_event ev;
+  struct Can_SimNode_s *node;
+  pthread_t logThread;
+  uint64_t lastHead;
+  uint64_t lastReport;
+  uint64_t now;
+  int timeout = -1;
+  int n;
+  int i;
+
+  simT0 = sim_now();
+  lastReport = simT0;
+  simEpoll = epoll_create1(0);
+  if (simEpoll < 0) {
+    printf("epoll_create failed with error: %d\n", WSAGetLastError());
+    return -1;
+  }
+  ev.events = EPOLLIN;
+  ev.data.ptr = NULL;
+  if (0 != epoll_ctl(simEpoll, EPOLL_CTL_ADD, socketH->s, &ev)) {
+    printf("epoll add failed with error: %d\n", WSAGetLastError());
+    return -1;
+  }
+  if (simLogEnabled && (0 != pthread_create(&logThread, NULL, sim_log_daemon, NULL))) {
+    return -1;
+  }
+
+  for (;;) {
+    if (simReportPeriod > 0) {
+      now = sim_now();
+      timeout = 0;
+      if ((now - lastReport) < simReportPeriod * 1000000ull) {
+        timeout = (int)((lastReport + simReportPeriod * 1000000ull - now) / 1000) + 1;
+      }
+    }
+    n = epoll_wait(simEpoll, events, CAN_BUS_NODE_MAX + 1, timeout);
+    lastHead = simHead;
+    for (i = 0; i < n; i++) {
+      node = (struct Can_SimNode_s *)events[i].data.ptr;
+      if (NULL == node) {
+        sim_accept();
+      } else if ((node->s >= 0) && (events[i].events & (EPOLLIN | EPOLLERR | EPOLLHUP))) {
+        sim_recv(node);
+      } else {
+        /* EPOLLOUT, flushed below */
+      }
+    }
+    for (i = 0; i < CAN_BUS_NODE_MAX; i++) {
+      node = simNodes[i];
+      if ((NULL != node) && (node->s >= 0) &&
+          ((node->cursor != simHead) || (node->partialLen > 0))) {
+        sim_pollout(node, !sim_flush(node));
+      } else if ((NULL != node) && (node->pollout)) {
+        sim_pollout(node, FALSE);
+      }
+    }
+    sim_reap();
+    if (simLogEnabled && (lastHead != simHead)) {
+      sim_log_notify();
+    }
+    if (simReportPeriod > 0) {
+      now = sim_now();
+      if ((now - lastReport) >= simReportPeriod * 1000000ull) {
+        if ((simStats.rxFrames > 0) || (simStats.dropped > 0)) {
+          sim_report(now - lastReport);
+        }
+        memset(&simStats, 0, sizeof(simStats));
+        lastReport = now;
+      }
+    }
+  }
+
+  return 0;
+}
+#endif
 
 static void arg_filter(char *s) {
   char *code;
@@ -435,6 +866,10 @@ int main(int argc, char *argv[]) {
   if (argc < 2) {
     printf("Usage:%s <port> : 'port' is a number start from 0\n"
            "  -f <Mask>#<Code> : optional parameter for CAN log Mask and Code, in hex\n"
+#ifdef __linux__
+           "  -q : do not log the frames\n"
+           "  -r <seconds> : period of the frames/s and latency report, 0 to disable\n"
+#endif
            "Example:\n"
            "  %s 0 -f 700#300",
            argv[0], argv[0]);
@@ -447,8 +882,19 @@ int main(int argc, char *argv[]) {
 
   argc = argc - 2;
   argv = argv + 2;
-  while (argc >= 2) {
-    if (0 == strcmp(argv[0], "-f")) {
+  while (argc >= 1) {
+#ifdef __linux__
+    if (0 == strcmp(argv[0], "-q")) {
+      simLogEnabled = FALSE;
+      argc = argc - 1;
+      argv = argv + 1;
+      continue;
+    }
+    if ((argc >= 2) && (0 == strcmp(argv[0], "-r"))) {
+      simReportPeriod = atoi(argv[1]);
+    }
+#endif
+    if ((argc >= 2) && (0 == strcmp(argv[0], "-f"))) {
       arg_filter(argv[1]);
     }
 
@@ -456,6 +902,9 @@ int main(int argc, char *argv[]) {
     argv = argv + 2;
   }
 
+#ifdef __linux__
+  return sim_run();
+#else
 #ifdef USE_RX_DAEMON
   if (0 == pthread_create(&(socketH->rx_thread), NULL, rx_daemon, NULL)) {
   } else {
@@ -468,4 +917,5 @@ int main(int argc, char *argv[]) {
   }
 
   return 0;
+#endif
 }
@@ -0,0 +1,200 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2026 Parai Wang <parai@foxmail.com>
+ *
+ */
+/* ================================ [ INCLUDES  ] ============================================== */
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <time.h>
+#include "doip_client.h"
+/* ================================ [ MACROS    ] ============================================== */
+/* the doip client buffer holds 4096 bytes, header, sa and ta included */
+#define DOIP_BENCH_MAX_LENGTH (4096 - 12)
+
+/* count the heap allocations of the bench through the glibc entry points */
+#ifdef __GLIBC__
+#define DOIP_BENCH_COUNT_ALLOCS
+#endif
+/* ================================ [ TYPES     ] ============================================== */
+/* ================================ [ DECLARES  ] ============================================== */
+#ifdef DOIP_BENCH_COUNT_ALLOCS
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t number, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+#endif
+/* ================================ [ DATAS     ] ============================================== */
+static uint8_t txData[DOIP_BENCH_MAX_LENGTH];
+static uint8_t rxData[DOIP_BENCH_MAX_LENGTH];
+static unsigned long benchAllocs;
+/* ================================ [ LOCALS    ] ============================================== */
+static void usage(char *prog) {
+  printf("usage: %s [-i UDP_TEST_EQUIPMENT_REQUEST] [-p port] [-s sa] [-a activation type] "
+         "[-t target address] [-l block length] [-n blocks]\n"
+         "  send TransferData (0x36) blocks back to back and report the diagnostic round trip\n",
+         prog);
+}
+
+static uint64_t bench_now(void) {
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+/* ================================ [ FUNCTIONS ] ============================================== */
+#ifdef DOIP_BENCH_COUNT_ALLOCS
+void *malloc(size_t size) {
+  __atomic_add_fetch(&benchAllocs, 1, __ATOMIC_RELAXED);
+  return __libc_malloc(size);
+}
+
+void *calloc(size_t number, size_t size) {
+  __atomic_add_fetch(&benchAllocs, 1, __ATOMIC_RELAXED);
+  return __libc_calloc(number, size);
+}
+
+void *realloc(void *ptr, size_t size) {
+  __atomic_add_fetch(&benchAllocs, 1, __ATOMIC_RELAXED);
+  return __libc_realloc(ptr, size);
+}
+#endif
+
+int main(int argc, char *argv[]) {
+  int r = 0;
+  int ch;
+  char *ip = "224.244.224.245";
+  int port = 13400;
+  doip_client_t *client;
+  doip_node_t *node;
+  uint16_t sa = 0xbeef;
+  uint8_t at = 0xda;
+  uint16_t ta = 0xdead;
+  int length = DOIP_BENCH_MAX_LENGTH;
+  int blocks = 1000;
+  int positive = 0;
+  int negative = 0;
+  int i;
+  uint64_t start;
+  uint64_t t0;
+  uint64_t elapsed;
+  uint64_t latency;
+  uint64_t latencyMax = 0;
+  unsigned long allocs;
+
+  opterr = 0;
+  while ((ch = getopt(argc, argv, "a:hi:l:n:p:s:t:")) != -1) {
+    switch (ch) {
+    case 'a':
+      at = strtoul(optarg, NULL, 16);
+      break;
+    case 'h':
+      usage(argv[0]);
+      return 0;
+      break;
+    case 'i':
+      ip = optarg;
+      break;
+    case 'l':
+      length = atoi(optarg);
+      break;
+    case 'n':
+      blocks = atoi(optarg);
+      break;
+    case 'p':
+      port = atoi(optarg);
+      break;
+    case 's':
+      sa = strtoul(optarg, NULL, 16);
+      break;
+    case 't':
+      ta = strtoul(optarg, NULL, 16);
+      break;
+    default:
+      break;
+    }
+  }
+  if ((NULL == ip) || (port < 0) || (length < 2) || (length > DOIP_BENCH_MAX_LENGTH) ||
+      (blocks <= 0)) {
+    usage(argv[0]);
+    return -1;
+  }
+
+  client = doip_create_client(ip, port);
+
+  if (NULL == client) {
+    printf("Failed to clreate doip client <%s:%d>\n", ip, port);
+    return -2;
+  }
+
+  r = doip_await_vehicle_announcement(client, &node, 1, 3000);
+  if (r <= 0) {
+    node = doip_request(client);
+    if (NULL == node) {
+      r = -1;
+      printf("target is not reachable\n");
+    } else {
+      r = 0;
+    }
+  } else {
+    r = 0;
+  }
+
+  if (0 == r) {
+    r = doip_connect(node);
+    if (0 != r) {
+      printf("connect failed\n");
+    }
+  }
+
+  if (0 == r) {
+    r = doip_activate(node, sa, at, NULL, 0);
+    if (0 != r) {
+      printf("activate failed\n");
+    }
+  }
+
+  if (0 == r) {
+    for (i = 2; i < length; i++) {
+      txData[i] = (uint8_t)i;
+    }
+    txData[0] = 0x36;
+    allocs = __atomic_load_n(&benchAllocs, __ATOMIC_RELAXED);
+    start = bench_now();
+    for (i = 0; (i < blocks) && (r >= 0); i++) {
+      txData[1] = (uint8_t)(i + 1); /* blockSequenceCounter */
+      t0 = bench_now();
+      r = doip_transmit(node, ta, txData, length, rxData, sizeof(rxData));
+      latency = bench_now() - t0;
+      if (latency > latencyMax) {
+        latencyMax = latency;
+      }
+      if ((r > 0) && (0x76 == rxData[0])) {
+        positive++;
+      } else if (r > 0) {
+        negative++; /* e.g. no download session, the DoIP path is exercised all the same */
+      } else {
+        printf("block %d failed with error %d\n", i, r);
+      }
+    }
+    elapsed = bench_now() - start;
+    allocs = __atomic_load_n(&benchAllocs, __ATOMIC_RELAXED) - allocs;
+    if (0 == elapsed) {
+      elapsed = 1;
+    }
+    printf("%d blocks of %d bytes in %.3f s: %.1f blocks/s, %.1f KB/s, latency avg %.3f max %.3f "
+           "ms, %d positive, %d negative responses, %lu heap allocations\n",
+           i, length, elapsed / 1000000.0, i * 1000000.0 / elapsed,
+           (double)i * length * 1000000.0 / 1024 / elapsed, elapsed / 1000.0 / i,
+           latencyMax / 1000.0, positive, negative, allocs);
+    if (r > 0) {
+      r = 0;
+    }
+  }
+
+  doip_destory_client(client);
+
+  return r;
+}
\ No newline at end of file
@@ -350,6 +350,28 @@ py::object PyFee_Image(py::bytes raw) {
   }
 }
 
+static py::dict PyFee_JobStatistics(const Fls_AcJobStatisticsType &stats) {
+  py::dict D;
+  D["count"] = stats.count;
+  D["last_us"] = stats.lastUs;
+  D["max_us"] = stats.maxUs;
+  D["total_us"] = stats.totalUs;
+  return D;
+}
+
+py::dict PyFee_Statistics(void) {
+  Fls_AcStatisticsType stats;
+  py::dict D;
+
+  Fls_AcGetStatistics(&stats);
+  D["erase"] = PyFee_JobStatistics(stats.erase);
+  D["write"] = PyFee_JobStatistics(stats.write);
+  D["queued"] = stats.queued;
+  D["max_queued"] = stats.maxQueued;
+
+  return D;
+}
+
 py::object PyFee_Read(std::string name, bool blocking = true) {
   py::object r = py::none();
 
@@ -396,4 +418,6 @@ PYBIND11_MODULE(PyFee, m) {
         py::arg("blocking") = true);
   m.def("result", &PyFee_Result, "get job result\n");
   m.def("img", &PyFee_Image, "read/write image raw\n", py::arg("raw") = py::bytes());
+  m.def("statistics", &PyFee_Statistics,
+        "\tFls AC erase/write job latencies in us and the engine queue depth\n");
 }
\ No newline at end of file
@@ -65,6 +65,7 @@ def normal(**kwargs):
                                 (n, name, data, lastDatas[name]))
         PyFee.power_off()
         print('Fee normal test %s/%s times PASS' % (n, nLoops))
+    print('Fls AC statistics:', PyFee.statistics())
     with open('Fls-normal-%s.img' % (NUM_BANKS), 'wb') as f:
         f.write(PyFee.img())
 
@@ -142,6 +143,7 @@ def abnormal(**kwargs):
             lastDatas[name] = [data]
         PyFee.power_off()
         print('Fee abnormal test %s/%s times PASS' % (n, nLoops))
+    print('Fls AC statistics:', PyFee.statistics())
     with open('Fls-abnormal-%s.img' % (NUM_BANKS), 'wb') as f:
         f.write(PyFee.img())
 
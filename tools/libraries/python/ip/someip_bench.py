@@ -0,0 +1,83 @@
+# SSAS - Simple Smart Automotive Software
+# Copyright (C) 2026 Parai Wang <parai@foxmail.com>
+
+# SOME/IP over TCP throughput against a local server, by default the server0 of app/app:
+# many small requests are packed into one send to stress the TCP deframer of the server.
+
+import PyIP
+import argparse
+import struct
+import time
+
+SOMEIP_MSG_REQUEST = 0x00
+SOMEIP_MSG_REQUEST_NO_RETURN = 0x01
+SOMEIP_MSG_RESPONSE = 0x80
+
+
+def build(args, session, payload):
+    msgType = SOMEIP_MSG_REQUEST_NO_RETURN if args.fire_forget else SOMEIP_MSG_REQUEST
+    return struct.pack('>HHIHHBBBB', args.service, args.method, len(payload) + 8, args.client,
+                       session, 1, args.version, msgType, 0) + payload
+
+
+def deframe(stream):
+    msgs = []
+    offset = 0
+    while len(stream) - offset >= 16:
+        length = struct.unpack('>I', stream[offset + 4:offset + 8])[0] + 8
+        if len(stream) - offset < length:
+            break
+        msgs.append(stream[offset:offset + length])
+        offset += length
+    return msgs, stream[offset:]
+
+
+def bench(args):
+    sock = PyIP.socket(PyIP.socket.TCP)
+    sock.connect(args.ip, args.port)
+    payload = bytes([i & 0xFF for i in range(args.size)])
+    msgSize = 16 + args.size
+    batch = min(args.batch, 65535 // msgSize)
+    sent = 0
+    received = 0
+    errors = 0
+    stream = b''
+    session = 1
+    start = time.time()
+    while sent < args.count:
+        n = min(batch, args.count - sent)
+        data = b''
+        for _ in range(n):
+            data += build(args, session, payload)
+            session = (session % 0xFFFF) + 1
+        sock.send(data)
+        sent += n
+        if args.fire_forget:
+            continue
+        # keep at most one batch in flight so the server TCP window is the only limit
+        while received < sent:
+            stream += sock.recv()
+            msgs, stream = deframe(stream)
+            for msg in msgs:
+                received += 1
+                if (msg[14] != SOMEIP_MSG_RESPONSE) or (msg[16:] != payload[::-1]):
+                    errors += 1
+    elapsed = time.time() - start
+    print('%d messages of %d bytes, %d per send: %.0f msg/s, %.2f MB/s, %d responses, %d errors' % (
+        sent, args.size, batch, sent / elapsed, sent * msgSize / elapsed / 1e6, received, errors))
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description='SOME/IP TCP throughput benchmark')
+    parser.add_argument('-i', '--ip', type=str, default='127.0.0.1', help='server ip address')
+    parser.add_argument('-p', '--port', type=int, default=30560, help='server TCP port')
+    parser.add_argument('--service', type=lambda x: int(x, 0), default=0x1234, help='service ID')
+    parser.add_argument('--method', type=lambda x: int(x, 0), default=0x421, help='method ID')
+    parser.add_argument('--version', type=lambda x: int(x, 0), default=0, help='interface version')
+    parser.add_argument('--client', type=lambda x: int(x, 0), default=0x4444, help='client ID')
+    parser.add_argument('-s', '--size', type=int, default=16, help='payload bytes per message')
+    parser.add_argument('-b', '--batch', type=int, default=64, help='messages per send')
+    parser.add_argument('-n', '--count', type=int, default=100000, help='number of messages')
+    parser.add_argument('-f', '--fire-forget', action='store_true',
+                        help='send REQUEST_NO_RETURN, no responses')
+    bench(parser.parse_args())
@@ -0,0 +1,240 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2026 Parai Wang <parai@foxmail.com>
+ *
+ */
+/* ================================ [ INCLUDES  ] ============================================== */
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <stdio.h>
+#include <stdarg.h>
+
+#define WEAK_ALIAS_PRINTF
+#include "Std_Debug.h"
+#include "mempool.h"
+extern "C" {
+#include "NetMem.h"
+#include "PduRMem.h"
+}
+
+namespace py = pybind11;
+/* ================================ [ MACROS    ] ============================================== */
+/* ================================ [ TYPES     ] ============================================== */
+typedef struct {
+  uint8_t *(*alloc)(uint32_t size);
+  uint8_t *(*get)(uint32_t *size);
+  void (*free)(uint8_t *buffer);
+  int (*getStats)(uint16_t pool, mp_stats_t *stats);
+  void (*resetStats)(void);
+} live_cluster_api_t;
+/* ================================ [ DECLARES  ] ============================================== */
+/* ================================ [ DATAS     ] ============================================== */
+static const live_cluster_api_t netMemApi = {
+  Net_MemAlloc, Net_MemGet, Net_MemFree, Net_MemGetStats, Net_MemResetStats,
+};
+
+static const live_cluster_api_t pdurMemApi = {
+  PduR_MemAlloc, PduR_MemGet, PduR_MemFree, PduR_MemGetStats, PduR_MemResetStats,
+};
+/* ================================ [ LOCALS    ] ============================================== */
+static py::dict statsToDict(const mp_stats_t &stats) {
+  py::dict D;
+  D["in_use"] = stats.inUse;
+  D["high_water"] = stats.highWater;
+  D["failures"] = stats.failures;
+  D["fallbacks"] = stats.fallbacks;
+  D["downgrades"] = stats.downgrades;
+  D["histogram"] =
+    std::vector<uint32_t>(stats.histogram, stats.histogram + MEMPOOL_STATS_HISTOGRAM_SIZE);
+  return D;
+}
+/* ================================ [ FUNCTIONS ] ============================================== */
+extern "C" int std_printf(const char *fmt, ...) {
+  (void)fmt;
+  return 0;
+}
+
+/* A memory cluster built at runtime, used to replay allocation traces and size the clusters of
+ * Mempool.json/PduRMem.json from the collected statistics. */
+class PyCluster {
+public:
+  PyCluster(std::vector<std::pair<uint32_t, uint16_t>> pools, bool lockfree)
+    : m_LockFree(lockfree) {
+    std::sort(pools.begin(), pools.end());
+    for (auto &pool : pools) {
+      if ((0 == pool.first) || (0 == pool.second) || (pool.second >= MP_LF_NIL)) {
+        throw std::runtime_error("invalid pool size " + std::to_string(pool.first) + " number " +
+                                 std::to_string(pool.second));
+      }
+    }
+    m_Buffers.resize(pools.size());
+    m_Next.resize(pools.size());
+    m_Pools.resize(pools.size());
+    m_LfPools.resize(pools.size());
+    m_Stats.resize(pools.size());
+    for (size_t i = 0; i < pools.size(); i++) {
+      uint32_t size = pools[i].first;
+      uint16_t number = pools[i].second;
+      uint32_t blockSize = lockfree ? MP_LF_BLOCK_SIZE(size) : ((size + 7u) & ~7u);
+      m_Buffers[i].resize((blockSize * number + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+      m_Next[i].resize(number);
+      if (lockfree) {
+        m_LfCfgs.push_back({(uint8_t *)m_Buffers[i].data(), m_Next[i].data(), size, number});
+      } else {
+        m_Cfgs.push_back({(uint8_t *)m_Buffers[i].data(), blockSize, number});
+      }
+    }
+    m_Cluster = {m_Pools.data(), m_Cfgs.data(), (uint16_t)pools.size(), m_Stats.data()};
+    m_LfCluster = {m_LfPools.data(), m_LfCfgs.data(), (uint16_t)pools.size(), m_Stats.data()};
+    if (lockfree) {
+      lf_mc_init(&m_LfCluster);
+    } else {
+      mc_init(&m_Cluster);
+    }
+  }
+
+  py::object alloc(uint32_t size) {
+    uint8_t *buffer;
+    if (m_LockFree) {
+      buffer = lf_mc_alloc(&m_LfCluster, size);
+    } else {
+      buffer = mc_alloc(&m_Cluster, size);
+    }
+    if (nullptr == buffer) {
+      return py::none();
+    }
+    return py::int_((uintptr_t)buffer);
+  }
+
+  py::object get(uint32_t size) {
+    uint8_t *buffer;
+    if (m_LockFree) {
+      buffer = lf_mc_get(&m_LfCluster, &size);
+    } else {
+      buffer = mc_get(&m_Cluster, &size);
+    }
+    if (nullptr == buffer) {
+      return py::none();
+    }
+    return py::make_tuple((uintptr_t)buffer, size);
+  }
+
+  void free(uintptr_t buffer) {
+    if (m_LockFree) {
+      lf_mc_free(&m_LfCluster, (uint8_t *)buffer);
+    } else {
+      mc_free(&m_Cluster, (uint8_t *)buffer);
+    }
+  }
+
+  py::list stats() {
+    py::list L;
+    mp_stats_t stats;
+    for (uint16_t i = 0; i < m_Stats.size(); i++) {
+      if (m_LockFree) {
+        (void)lf_mc_get_stats(&m_LfCluster, i, &stats);
+      } else {
+        (void)mc_get_stats(&m_Cluster, i, &stats);
+      }
+      py::dict D = statsToDict(stats);
+      D["size"] = m_LockFree ? m_LfCfgs[i].size : m_Cfgs[i].size;
+      D["number"] = m_LockFree ? m_LfCfgs[i].number : m_Cfgs[i].number;
+      L.append(D);
+    }
+    return L;
+  }
+
+  void reset_stats() {
+    if (m_LockFree) {
+      lf_mc_reset_stats(&m_LfCluster);
+    } else {
+      mc_reset_stats(&m_Cluster);
+    }
+  }
+
+private:
+  bool m_LockFree;
+  std::vector<std::vector<uint64_t>> m_Buffers;
+  std::vector<std::vector<uint16_t>> m_Next;
+  std::vector<mempool_t> m_Pools;
+  std::vector<lf_mempool_t> m_LfPools;
+  std::vector<mem_cluster_cfg_t> m_Cfgs;
+  std::vector<lf_mem_cluster_cfg_t> m_LfCfgs;
+  std::vector<mp_stats_t> m_Stats;
+  mem_cluster_t m_Cluster;
+  lf_mem_cluster_t m_LfCluster;
+};
+
+/* The Net and PduR clusters generated from app/app/config/Net, the same Net_Mem and PduR_Mem
+ * code as the application, read through Net_MemGetStats/PduR_MemGetStats. The pools are listed
+ * in increasing block size, as sorted by the generator. */
+class PyLiveCluster {
+public:
+  PyLiveCluster(const live_cluster_api_t *api) : m_Api(api) {
+  }
+
+  py::object alloc(uint32_t size) {
+    uint8_t *buffer = m_Api->alloc(size);
+    if (nullptr == buffer) {
+      return py::none();
+    }
+    return py::int_((uintptr_t)buffer);
+  }
+
+  py::object get(uint32_t size) {
+    uint8_t *buffer = m_Api->get(&size);
+    if (nullptr == buffer) {
+      return py::none();
+    }
+    return py::make_tuple((uintptr_t)buffer, size);
+  }
+
+  void free(uintptr_t buffer) {
+    m_Api->free((uint8_t *)buffer);
+  }
+
+  py::list stats() {
+    py::list L;
+    mp_stats_t stats;
+    for (uint16_t i = 0; 0 == m_Api->getStats(i, &stats); i++) {
+      L.append(statsToDict(stats));
+    }
+    return L;
+  }
+
+  void reset_stats() {
+    m_Api->resetStats();
+  }
+
+private:
+  const live_cluster_api_t *m_Api;
+};
+
+PYBIND11_MODULE(PyMemPool, m) {
+  m.doc() = "pybind11 PyMemPool library";
+
+  py::class_<PyCluster>(m, "cluster")
+    .def(py::init<std::vector<std::pair<uint32_t, uint16_t>>, bool>(), py::arg("pools"),
+         py::arg("lockfree") = true)
+    .def("alloc", &PyCluster::alloc, py::arg("size"))
+    .def("get", &PyCluster::get, py::arg("size"))
+    .def("free", &PyCluster::free, py::arg("buffer"))
+    .def("stats", &PyCluster::stats)
+    .def("reset_stats", &PyCluster::reset_stats);
+
+  py::class_<PyLiveCluster>(m, "live_cluster")
+    .def("alloc", &PyLiveCluster::alloc, py::arg("size"))
+    .def("get", &PyLiveCluster::get, py::arg("size"))
+    .def("free", &PyLiveCluster::free, py::arg("buffer"))
+    .def("stats", &PyLiveCluster::stats)
+    .def("reset_stats", &PyLiveCluster::reset_stats);
+
+  Net_MemInit();
+  PduR_MemInit();
+  m.attr("net") = PyLiveCluster(&netMemApi);
+  m.attr("pdur") = PyLiveCluster(&pdurMemApi);
+}